@@ -35,6 +35,9 @@
 #define MPU6050_ADDRESS_AD0_HIGH    0x69 // address pin high (VCC)
 #define MPU6050_DEFAULT_ADDRESS     MPU6050_ADDRESS_AD0_LOW
 
+#define MPU6050_MOTION6_BYTES       12 // accel and gyro sample size in the FIFO
+#define MPU6050_FIFO_BURST_SAMPLES  21 // samples per FIFO burst read (252 bytes, max I2C_readBytes length)
+
 #define MPU6050_RA_XG_OFFS_TC       0x00 //[7] PWR_MODE, [6:1] XG_OFFS_TC, [0] OTP_BNK_VLD
 #define MPU6050_RA_YG_OFFS_TC       0x01 //[7] PWR_MODE, [6:1] YG_OFFS_TC, [0] OTP_BNK_VLD
 #define MPU6050_RA_ZG_OFFS_TC       0x02 //[7] PWR_MODE, [6:1] ZG_OFFS_TC, [0] OTP_BNK_VLD
@@ -2648,6 +2651,29 @@ void MPU6050_setFIFOByte(uint8_t data);
  */
 void MPU6050_getFIFOBytes(uint8_t *data, uint8_t length);
 
+/** Store accelerometer and gyroscope samples in the FIFO.
+ * Resets the FIFO and enables it with only the accelerometer and the three
+ * gyroscope axes, 12 bytes per sample (ax, ay, az, gx, gy, gz), the format read
+ * by MPU6050_getMotion6FIFO(). Samples are stored at the Sample Rate.
+ * @see setRate()
+ * @see getMotion6FIFO()
+ * @see MPU6050_RA_FIFO_EN
+ */
+void MPU6050_setMotion6FIFO();
+
+/** Get the raw 6-axis samples stored in the FIFO.
+ * Whole samples available in the FIFO (up to max_samples) are read in I2C
+ * bursts of MPU6050_FIFO_BURST_SAMPLES samples, instead of one getMotion6()
+ * transaction per sample, and decoded to ax, ay, az, gx, gy, gz per sample.
+ * The FIFO must be configured with setMotion6FIFO().
+ * @param samples 16-bit signed integer container of 6 * max_samples values
+ * @param max_samples Maximum number of samples to read
+ * @return Number of samples read
+ * @see setMotion6FIFO()
+ * @see getMotion6()
+ */
+uint16_t MPU6050_getMotion6FIFO(int16_t *samples, uint16_t max_samples);
+
 // WHO_AM_I register
 /** Get Device ID.
  * This register is used to verify the identity of the device (0b110100, 0x34).
@@ -2732,6 +2732,39 @@ void MPU6050_getFIFOBytes(uint8_t *data, uint8_t length) {
     	*data = 0;
     }
 }
+/** Store accelerometer and gyroscope samples in the FIFO.
+ * @see MPU6050_RA_FIFO_EN
+ */
+void MPU6050_setMotion6FIFO() {
+    MPU6050_setFIFOEnabled(false);
+    I2C_writeByte(devAddr, MPU6050_RA_FIFO_EN, (1 << MPU6050_ACCEL_FIFO_EN_BIT) | (1 << MPU6050_XG_FIFO_EN_BIT) |
+                  (1 << MPU6050_YG_FIFO_EN_BIT) | (1 << MPU6050_ZG_FIFO_EN_BIT));
+    MPU6050_resetFIFO();
+    MPU6050_setFIFOEnabled(true);
+}
+/** Get the raw 6-axis samples stored in the FIFO.
+ * @see MPU6050_RA_FIFO_R_W
+ */
+uint16_t MPU6050_getMotion6FIFO(int16_t *samples, uint16_t max_samples) {
+    uint8_t burst[MPU6050_FIFO_BURST_SAMPLES * MPU6050_MOTION6_BYTES];
+    uint16_t n_samples = MPU6050_getFIFOCount() / MPU6050_MOTION6_BYTES;
+    if(n_samples > max_samples){
+        n_samples = max_samples;
+    }
+    uint16_t read = 0;
+    while(read < n_samples){
+        uint16_t chunk = n_samples - read;
+        if(chunk > MPU6050_FIFO_BURST_SAMPLES){
+            chunk = MPU6050_FIFO_BURST_SAMPLES;
+        }
+        MPU6050_getFIFOBytes(burst, chunk * MPU6050_MOTION6_BYTES);
+        for(uint16_t i = 0; i < chunk * MPU6050_MOTION6_BYTES; i += 2){
+            *samples++ = (((int16_t)burst[i]) << 8) | burst[i + 1];
+        }
+        read += chunk;
+    }
+    return n_samples;
+}
 /** Write byte to FIFO buffer.
  * @see getFIFOByte()
  * @see MPU6050_RA_FIFO_R_W
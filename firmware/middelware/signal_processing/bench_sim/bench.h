@@ -0,0 +1,41 @@
+#ifndef _bench_h_
+#define _bench_h_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dsps_fir.h"
+
+// Buffers of a kernel under test, allocated by its setup function
+typedef struct bench_ctx_s {
+    int size;               // Value of the swept parameter
+    int samples;            // Samples processed (or produced) by one call
+    float *x;               // Input
+    float *y;               // Output / in place work buffer
+    float *h;               // Coefficients, kernel or second operand
+    float *w;               // Filter state
+    int16_t *xs;
+    int16_t *ys;
+    int16_t *hs;
+    int16_t *ws;
+    fir_f32_t fir;
+    fir_s16_t fir_s16;
+} bench_ctx_t;
+
+typedef struct bench_kernel_s {
+    const char *name;
+    const char *param;      // Meaning of size: N, len, taps, n (n x n matrices)
+    const int *sizes;
+    int n_sizes;
+    bool (*setup)(bench_ctx_t *ctx);
+    // Restores the input of in place kernels before every call (NULL: none)
+    void (*prepare)(bench_ctx_t *ctx);
+    void (*run)(bench_ctx_t *ctx);
+} bench_kernel_t;
+
+extern const bench_kernel_t bench_kernels[];
+extern const int bench_kernels_count;
+
+void bench_ctx_free(bench_ctx_t *ctx);
+
+#endif // _bench_h_
@@ -0,0 +1,445 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "dsp_common.h"
+#include "dsps_fft2r.h"
+#include "dsps_fft4r.h"
+#include "dsps_fft_tables.h"
+#include "dsps_biquad.h"
+#include "dsps_biquad_gen.h"
+#include "dsps_fir.h"
+#include "dsps_dotprod.h"
+#include "dsps_conv.h"
+#include "dsps_corr.h"
+#include "dspm_mult.h"
+#include "dsps_wind.h"
+#include "dsps_add.h"
+#include "dsps_mul.h"
+
+// Input samples of every call to the filter and convolution kernels
+#define BENCH_BLOCK         1024
+#define FIRD_DECIMATION     4
+#define CASCADE_SECTIONS    4
+
+static const int fft_sizes[] = {64, 256, 1024, 4096};
+static const int block_sizes[] = {64, 256, 1024, 4096};
+static const int tap_sizes[] = {16, 64, 256};
+static const int vector_sizes[] = {16, 256, 4096};
+static const int matrix_sizes[] = {3, 4, 8, 12, 16, 32, 64};
+static const int window_sizes[] = {256, 1024, 4096};
+
+#define SIZES(sizes) sizes, sizeof(sizes) / sizeof(sizes[0])
+
+static float *bench_alloc_f32(int len)
+{
+    float *x = malloc(len * sizeof(float));
+    if (x != NULL) {
+        for (int i = 0 ; i < len ; i++) {
+            x[i] = (float)rand() / RAND_MAX - 0.5f;
+        }
+    }
+    return x;
+}
+
+static int16_t *bench_alloc_s16(int len)
+{
+    int16_t *x = malloc(len * sizeof(int16_t));
+    if (x != NULL) {
+        for (int i = 0 ; i < len ; i++) {
+            x[i] = (int16_t)(rand() % 16384 - 8192);
+        }
+    }
+    return x;
+}
+
+void bench_ctx_free(bench_ctx_t *ctx)
+{
+    free(ctx->x);
+    free(ctx->y);
+    free(ctx->h);
+    free(ctx->w);
+    free(ctx->xs);
+    free(ctx->ys);
+    free(ctx->hs);
+    free(ctx->ws);
+    int size = ctx->size;
+    memset(ctx, 0, sizeof(bench_ctx_t));
+    ctx->size = size;
+}
+
+/* FFT: butterflies and bit reversal of N complex samples, in place */
+
+static bool fft2r_fc32_setup(bench_ctx_t *ctx)
+{
+    ctx->samples = ctx->size;
+    ctx->x = bench_alloc_f32(2 * ctx->size);
+    ctx->y = bench_alloc_f32(2 * ctx->size);
+    return (dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE) == ESP_OK) && ctx->x && ctx->y;
+}
+
+static void fft_fc32_prepare(bench_ctx_t *ctx)
+{
+    memcpy(ctx->y, ctx->x, 2 * ctx->size * sizeof(float));
+}
+
+static void fft2r_fc32_run(bench_ctx_t *ctx)
+{
+    int pow = dsp_power_of_two(ctx->size);
+    dsps_fft2r_fc32_ansi(ctx->y, ctx->size);
+    dsps_bit_rev_lookup_fc32_ansi(ctx->y, dsps_fft2r_rev_tables_fc32_size[pow - 4], dsps_fft2r_rev_tables_fc32[pow - 4]);
+}
+
+static bool fft4r_fc32_setup(bench_ctx_t *ctx)
+{
+    ctx->samples = ctx->size;
+    ctx->x = bench_alloc_f32(2 * ctx->size);
+    ctx->y = bench_alloc_f32(2 * ctx->size);
+    return (dsps_fft4r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE) == ESP_OK) && ctx->x && ctx->y;
+}
+
+static void fft4r_fc32_run(bench_ctx_t *ctx)
+{
+    dsps_fft4r_fc32_ansi(ctx->y, ctx->size);
+    dsps_bit_rev4r_fc32(ctx->y, ctx->size);
+}
+
+static bool fft2r_sc16_setup(bench_ctx_t *ctx)
+{
+    ctx->samples = ctx->size;
+    ctx->xs = bench_alloc_s16(2 * ctx->size);
+    ctx->ys = bench_alloc_s16(2 * ctx->size);
+    return (dsps_fft2r_init_sc16(NULL, CONFIG_DSP_MAX_FFT_SIZE) == ESP_OK) && ctx->xs && ctx->ys;
+}
+
+static void fft2r_sc16_prepare(bench_ctx_t *ctx)
+{
+    memcpy(ctx->ys, ctx->xs, 2 * ctx->size * sizeof(int16_t));
+}
+
+static void fft2r_sc16_run(bench_ctx_t *ctx)
+{
+    dsps_fft2r_sc16_ansi(ctx->ys, ctx->size);
+    dsps_bit_rev_sc16_ansi(ctx->ys, ctx->size);
+}
+
+static void fft2r_sc16_rv32_run(bench_ctx_t *ctx)
+{
+    dsps_fft2r_sc16_rv32(ctx->ys, ctx->size);
+    dsps_bit_rev_sc16_ansi(ctx->ys, ctx->size);
+}
+
+/* IIR: blocks of len samples */
+
+static bool biquad_f32_setup(bench_ctx_t *ctx)
+{
+    ctx->samples = ctx->size;
+    ctx->x = bench_alloc_f32(ctx->size);
+    ctx->y = bench_alloc_f32(ctx->size);
+    ctx->h = calloc(5 * CASCADE_SECTIONS, sizeof(float));
+    ctx->w = calloc(2 * CASCADE_SECTIONS, sizeof(float));
+    if (!ctx->x || !ctx->y || !ctx->h || !ctx->w) {
+        return false;
+    }
+    for (int s = 0 ; s < CASCADE_SECTIONS ; s++) {
+        dsps_biquad_gen_lpf_f32(&ctx->h[5 * s], 0.1f, 0.7071f);
+    }
+    return true;
+}
+
+static void biquad_f32_run(bench_ctx_t *ctx)
+{
+    dsps_biquad_f32_ansi(ctx->x, ctx->y, ctx->size, ctx->h, ctx->w);
+}
+
+static void biquad_f32_rv32_run(bench_ctx_t *ctx)
+{
+    dsps_biquad_f32_rv32(ctx->x, ctx->y, ctx->size, ctx->h, ctx->w);
+}
+
+static void biquad_cascade_f32_run(bench_ctx_t *ctx)
+{
+    dsps_biquad_cascade_f32_ansi(ctx->x, ctx->y, ctx->size, CASCADE_SECTIONS, ctx->h, ctx->w);
+}
+
+/* FIR: blocks of BENCH_BLOCK input samples */
+
+static bool fir_f32_alloc(bench_ctx_t *ctx)
+{
+    ctx->samples = BENCH_BLOCK;
+    ctx->x = bench_alloc_f32(BENCH_BLOCK);
+    ctx->y = bench_alloc_f32(BENCH_BLOCK);
+    ctx->h = bench_alloc_f32(ctx->size);
+    // dsps_fir_init_f32() clears 4 more values than the delay line length
+    ctx->w = calloc(ctx->size + 4, sizeof(float));
+    return ctx->x && ctx->y && ctx->h && ctx->w;
+}
+
+static bool fir_f32_setup(bench_ctx_t *ctx)
+{
+    return fir_f32_alloc(ctx) && (dsps_fir_init_f32(&ctx->fir, ctx->h, ctx->w, ctx->size) == ESP_OK);
+}
+
+static void fir_f32_run(bench_ctx_t *ctx)
+{
+    dsps_fir_f32_ansi(&ctx->fir, ctx->x, ctx->y, BENCH_BLOCK);
+}
+
+static bool fird_f32_setup(bench_ctx_t *ctx)
+{
+    return fir_f32_alloc(ctx) && (dsps_fird_init_f32(&ctx->fir, ctx->h, ctx->w, ctx->size, FIRD_DECIMATION) == ESP_OK);
+}
+
+static void fird_f32_run(bench_ctx_t *ctx)
+{
+    dsps_fird_f32_ansi(&ctx->fir, ctx->x, ctx->y, BENCH_BLOCK / FIRD_DECIMATION);
+}
+
+static bool fird_s16_setup(bench_ctx_t *ctx)
+{
+    ctx->samples = BENCH_BLOCK;
+    ctx->xs = bench_alloc_s16(BENCH_BLOCK);
+    ctx->ys = bench_alloc_s16(BENCH_BLOCK);
+    ctx->hs = bench_alloc_s16(ctx->size);
+    ctx->ws = calloc(ctx->size, sizeof(int16_t));
+    return ctx->xs && ctx->ys && ctx->hs && ctx->ws &&
+           (dsps_fird_init_s16(&ctx->fir_s16, ctx->hs, ctx->ws, ctx->size, FIRD_DECIMATION, 0, 0) == ESP_OK);
+}
+
+static void fird_s16_run(bench_ctx_t *ctx)
+{
+    dsps_fird_s16_ansi(&ctx->fir_s16, ctx->xs, ctx->ys, BENCH_BLOCK / FIRD_DECIMATION);
+}
+
+static void fird_s16_rv32_run(bench_ctx_t *ctx)
+{
+    dsps_fird_s16_rv32(&ctx->fir_s16, ctx->xs, ctx->ys, BENCH_BLOCK / FIRD_DECIMATION);
+}
+
+/* Dot product of two vectors of len samples */
+
+static bool dotprod_f32_setup(bench_ctx_t *ctx)
+{
+    ctx->samples = ctx->size;
+    ctx->x = bench_alloc_f32(ctx->size);
+    ctx->h = bench_alloc_f32(ctx->size);
+    ctx->y = bench_alloc_f32(1);
+    return ctx->x && ctx->h && ctx->y;
+}
+
+static void dotprod_f32_run(bench_ctx_t *ctx)
+{
+    dsps_dotprod_f32_ansi(ctx->x, ctx->h, ctx->y, ctx->size);
+}
+
+static void dotprod_f32_rv32_run(bench_ctx_t *ctx)
+{
+    dsps_dotprod_f32_rv32(ctx->x, ctx->h, ctx->y, ctx->size);
+}
+
+static bool dotprod_s16_setup(bench_ctx_t *ctx)
+{
+    ctx->samples = ctx->size;
+    ctx->xs = bench_alloc_s16(ctx->size);
+    ctx->hs = bench_alloc_s16(ctx->size);
+    ctx->ys = bench_alloc_s16(1);
+    return ctx->xs && ctx->hs && ctx->ys;
+}
+
+static void dotprod_s16_run(bench_ctx_t *ctx)
+{
+    dsps_dotprod_s16_ansi(ctx->xs, ctx->hs, ctx->ys, ctx->size, 0);
+}
+
+static void dotprod_s16_rv32_run(bench_ctx_t *ctx)
+{
+    dsps_dotprod_s16_rv32(ctx->xs, ctx->hs, ctx->ys, ctx->size, 0);
+}
+
+/* Element wise add and multiply of two vectors of len samples */
+
+static bool vector_s16_setup(bench_ctx_t *ctx)
+{
+    ctx->samples = ctx->size;
+    ctx->xs = bench_alloc_s16(ctx->size);
+    ctx->hs = bench_alloc_s16(ctx->size);
+    ctx->ys = bench_alloc_s16(ctx->size);
+    return ctx->xs && ctx->hs && ctx->ys;
+}
+
+static void add_s16_run(bench_ctx_t *ctx)
+{
+    dsps_add_s16_ansi(ctx->xs, ctx->hs, ctx->ys, ctx->size, 1, 1, 1, 1);
+}
+
+static void add_s16_rv32_run(bench_ctx_t *ctx)
+{
+    dsps_add_s16_rv32(ctx->xs, ctx->hs, ctx->ys, ctx->size, 1, 1, 1, 1);
+}
+
+static void mul_s16_run(bench_ctx_t *ctx)
+{
+    dsps_mul_s16_ansi(ctx->xs, ctx->hs, ctx->ys, ctx->size, 1, 1, 1, 15);
+}
+
+static void mul_s16_rv32_run(bench_ctx_t *ctx)
+{
+    dsps_mul_s16_rv32(ctx->xs, ctx->hs, ctx->ys, ctx->size, 1, 1, 1, 15);
+}
+
+/* Convolution and correlation of BENCH_BLOCK samples with a kernel of taps samples */
+
+static bool conv_f32_setup(bench_ctx_t *ctx)
+{
+    ctx->samples = BENCH_BLOCK;
+    ctx->x = bench_alloc_f32(BENCH_BLOCK);
+    ctx->h = bench_alloc_f32(ctx->size);
+    ctx->y = bench_alloc_f32(BENCH_BLOCK + ctx->size - 1);
+    return ctx->x && ctx->h && ctx->y;
+}
+
+static void conv_f32_run(bench_ctx_t *ctx)
+{
+    dsps_conv_f32_ansi(ctx->x, BENCH_BLOCK, ctx->h, ctx->size, ctx->y);
+}
+
+static bool corr_f32_setup(bench_ctx_t *ctx)
+{
+    bool ok = conv_f32_setup(ctx);
+    ctx->samples = BENCH_BLOCK - ctx->size + 1;
+    return ok;
+}
+
+static void corr_f32_run(bench_ctx_t *ctx)
+{
+    dsps_corr_f32_ansi(ctx->x, BENCH_BLOCK, ctx->h, ctx->size, ctx->y);
+}
+
+/* Product of n x n matrices, one sample per output element */
+
+static bool mult_f32_setup(bench_ctx_t *ctx)
+{
+    int len = ctx->size * ctx->size;
+    ctx->samples = len;
+    ctx->x = bench_alloc_f32(len);
+    ctx->h = bench_alloc_f32(len);
+    ctx->y = bench_alloc_f32(len);
+    return ctx->x && ctx->h && ctx->y;
+}
+
+static void mult_f32_run(bench_ctx_t *ctx)
+{
+    dspm_mult_f32_ansi(ctx->x, ctx->h, ctx->y, ctx->size, ctx->size, ctx->size);
+}
+
+static void mult_f32_rv32_run(bench_ctx_t *ctx)
+{
+    dspm_mult_f32_rv32(ctx->x, ctx->h, ctx->y, ctx->size, ctx->size, ctx->size);
+}
+
+static void mult_bt_f32_run(bench_ctx_t *ctx)
+{
+    dspm_mult_bt_f32_ansi(ctx->x, ctx->h, ctx->y, ctx->size, ctx->size, ctx->size);
+}
+
+static void mult_bt_f32_rv32_run(bench_ctx_t *ctx)
+{
+    dspm_mult_bt_f32_rv32(ctx->x, ctx->h, ctx->y, ctx->size, ctx->size, ctx->size);
+}
+
+static bool mult_s16_setup(bench_ctx_t *ctx)
+{
+    int len = ctx->size * ctx->size;
+    ctx->samples = len;
+    ctx->xs = bench_alloc_s16(len);
+    ctx->hs = bench_alloc_s16(len);
+    ctx->ys = bench_alloc_s16(len);
+    return ctx->xs && ctx->hs && ctx->ys;
+}
+
+static void mult_s16_run(bench_ctx_t *ctx)
+{
+    dspm_mult_s16_ansi(ctx->xs, ctx->hs, ctx->ys, ctx->size, ctx->size, ctx->size, 0);
+}
+
+static void mult_s16_rv32_run(bench_ctx_t *ctx)
+{
+    dspm_mult_s16_rv32(ctx->xs, ctx->hs, ctx->ys, ctx->size, ctx->size, ctx->size, 0);
+}
+
+/* Windows of len samples */
+
+static bool wind_setup(bench_ctx_t *ctx)
+{
+    ctx->samples = ctx->size;
+    ctx->y = bench_alloc_f32(ctx->size);
+    return ctx->y != NULL;
+}
+
+static void wind_hann_run(bench_ctx_t *ctx)
+{
+    dsps_wind_hann_f32(ctx->y, ctx->size);
+}
+
+static void wind_blackman_run(bench_ctx_t *ctx)
+{
+    dsps_wind_blackman_f32(ctx->y, ctx->size);
+}
+
+static void wind_blackman_harris_run(bench_ctx_t *ctx)
+{
+    dsps_wind_blackman_harris_f32(ctx->y, ctx->size);
+}
+
+static void wind_blackman_nuttall_run(bench_ctx_t *ctx)
+{
+    dsps_wind_blackman_nuttall_f32(ctx->y, ctx->size);
+}
+
+static void wind_nuttall_run(bench_ctx_t *ctx)
+{
+    dsps_wind_nuttall_f32(ctx->y, ctx->size);
+}
+
+static void wind_flat_top_run(bench_ctx_t *ctx)
+{
+    dsps_wind_flat_top_f32(ctx->y, ctx->size);
+}
+
+const bench_kernel_t bench_kernels[] = {
+    {"fft2r_fc32", "N", SIZES(fft_sizes), fft2r_fc32_setup, fft_fc32_prepare, fft2r_fc32_run},
+    {"fft4r_fc32", "N", SIZES(fft_sizes), fft4r_fc32_setup, fft_fc32_prepare, fft4r_fc32_run},
+    {"fft2r_sc16", "N", SIZES(fft_sizes), fft2r_sc16_setup, fft2r_sc16_prepare, fft2r_sc16_run},
+    {"fft2r_sc16_rv32", "N", SIZES(fft_sizes), fft2r_sc16_setup, fft2r_sc16_prepare, fft2r_sc16_rv32_run},
+    {"biquad_f32", "len", SIZES(block_sizes), biquad_f32_setup, NULL, biquad_f32_run},
+    {"biquad_f32_rv32", "len", SIZES(block_sizes), biquad_f32_setup, NULL, biquad_f32_rv32_run},
+    {"biquad_cascade4_f32", "len", SIZES(block_sizes), biquad_f32_setup, NULL, biquad_cascade_f32_run},
+    {"fir_f32", "taps", SIZES(tap_sizes), fir_f32_setup, NULL, fir_f32_run},
+    {"fird4_f32", "taps", SIZES(tap_sizes), fird_f32_setup, NULL, fird_f32_run},
+    {"fird4_s16", "taps", SIZES(tap_sizes), fird_s16_setup, NULL, fird_s16_run},
+    {"fird4_s16_rv32", "taps", SIZES(tap_sizes), fird_s16_setup, NULL, fird_s16_rv32_run},
+    {"dotprod_f32", "len", SIZES(vector_sizes), dotprod_f32_setup, NULL, dotprod_f32_run},
+    {"dotprod_f32_rv32", "len", SIZES(vector_sizes), dotprod_f32_setup, NULL, dotprod_f32_rv32_run},
+    {"dotprod_s16", "len", SIZES(vector_sizes), dotprod_s16_setup, NULL, dotprod_s16_run},
+    {"dotprod_s16_rv32", "len", SIZES(vector_sizes), dotprod_s16_setup, NULL, dotprod_s16_rv32_run},
+    {"add_s16", "len", SIZES(vector_sizes), vector_s16_setup, NULL, add_s16_run},
+    {"add_s16_rv32", "len", SIZES(vector_sizes), vector_s16_setup, NULL, add_s16_rv32_run},
+    {"mul_s16", "len", SIZES(vector_sizes), vector_s16_setup, NULL, mul_s16_run},
+    {"mul_s16_rv32", "len", SIZES(vector_sizes), vector_s16_setup, NULL, mul_s16_rv32_run},
+    {"conv_f32", "taps", SIZES(tap_sizes), conv_f32_setup, NULL, conv_f32_run},
+    {"corr_f32", "taps", SIZES(tap_sizes), corr_f32_setup, NULL, corr_f32_run},
+    {"mult_f32", "n", SIZES(matrix_sizes), mult_f32_setup, NULL, mult_f32_run},
+    {"mult_f32_rv32", "n", SIZES(matrix_sizes), mult_f32_setup, NULL, mult_f32_rv32_run},
+    {"mult_bt_f32", "n", SIZES(matrix_sizes), mult_f32_setup, NULL, mult_bt_f32_run},
+    {"mult_bt_f32_rv32", "n", SIZES(matrix_sizes), mult_f32_setup, NULL, mult_bt_f32_rv32_run},
+    {"mult_s16", "n", SIZES(matrix_sizes), mult_s16_setup, NULL, mult_s16_run},
+    {"mult_s16_rv32", "n", SIZES(matrix_sizes), mult_s16_setup, NULL, mult_s16_rv32_run},
+    {"wind_hann_f32", "len", SIZES(window_sizes), wind_setup, NULL, wind_hann_run},
+    {"wind_blackman_f32", "len", SIZES(window_sizes), wind_setup, NULL, wind_blackman_run},
+    {"wind_blackman_harris_f32", "len", SIZES(window_sizes), wind_setup, NULL, wind_blackman_harris_run},
+    {"wind_blackman_nuttall_f32", "len", SIZES(window_sizes), wind_setup, NULL, wind_blackman_nuttall_run},
+    {"wind_nuttall_f32", "len", SIZES(window_sizes), wind_setup, NULL, wind_nuttall_run},
+    {"wind_flat_top_f32", "len", SIZES(window_sizes), wind_setup, NULL, wind_flat_top_run},
+};
+
+const int bench_kernels_count = sizeof(bench_kernels) / sizeof(bench_kernels[0]);
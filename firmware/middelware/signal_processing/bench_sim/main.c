@@ -0,0 +1,217 @@
+// Host benchmark of the esp-dsp ANSI kernels
+//
+// Usage: bench_dsp [--quick] [--json <file>] [kernel ...]
+//
+// Every kernel is run over its size sweep. Calls are timed in batches long enough for the
+// timers (kernels that work in place get their input restored before each call, out of
+// the timed region), and the median batch is reported as ns per call, ns per sample and
+// cycles per call. Kernel names given as arguments select the kernels starting with them.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench.h"
+#include "dsp_common.h"
+
+// Shortest timed batch, well above the resolution of both timers
+#define MIN_BATCH_NS        20000.0
+#define MAX_BATCH_CALLS     (1 << 20)
+#define MIN_REPETITIONS     5
+#define MAX_REPETITIONS     1000
+#define BUDGET_NS           100e6
+#define QUICK_BUDGET_NS     2e6
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CYCLES_SOURCE       "tsc"
+#else
+#define CYCLES_SOURCE       "monotonic_ns"
+#endif
+
+#ifndef BENCH_BUILD_TYPE
+#define BENCH_BUILD_TYPE    ""
+#endif
+
+typedef struct bench_result_s {
+    const char *kernel;
+    const char *param;
+    int size;
+    int samples;
+    long calls;
+    double ns_per_call;
+    double cycles_per_call;
+} bench_result_t;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Time of a batch of calls, in ns and cycles
+static void run_batch(const bench_kernel_t *kernel, bench_ctx_t *ctx, long calls, double *ns, double *cycles)
+{
+    if (kernel->prepare != NULL) {
+        kernel->prepare(ctx);
+    }
+    double start = now_ns();
+    uint32_t start_cycles = dsp_get_cpu_cycle_count();
+    for (long i = 0 ; i < calls ; i++) {
+        kernel->run(ctx);
+    }
+    *cycles = (uint32_t)(dsp_get_cpu_cycle_count() - start_cycles);
+    *ns = now_ns() - start;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double median(double *x, int len)
+{
+    qsort(x, len, sizeof(double), compare_double);
+    return (len % 2) ? x[len / 2] : 0.5 * (x[len / 2 - 1] + x[len / 2]);
+}
+
+static bool bench_run(const bench_kernel_t *kernel, int size, double budget_ns, bench_result_t *result)
+{
+    static double ns[MAX_REPETITIONS];
+    static double cycles[MAX_REPETITIONS];
+    bench_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.size = size;
+    if (!kernel->setup(&ctx)) {
+        bench_ctx_free(&ctx);
+        return false;
+    }
+    // Warm up caches and lazily initialized tables, then size the batch. In place kernels
+    // are restored before every call, so they are timed one call at a time.
+    long calls = 1;
+    run_batch(kernel, &ctx, calls, &ns[0], &cycles[0]);
+    if (kernel->prepare == NULL) {
+        run_batch(kernel, &ctx, calls, &ns[0], &cycles[0]);
+        while ((ns[0] < MIN_BATCH_NS) && (calls < MAX_BATCH_CALLS)) {
+            calls *= 2;
+            run_batch(kernel, &ctx, calls, &ns[0], &cycles[0]);
+        }
+    }
+    int reps = 0;
+    double total = 0;
+    while ((reps < MIN_REPETITIONS) || ((total < budget_ns) && (reps < MAX_REPETITIONS))) {
+        run_batch(kernel, &ctx, calls, &ns[reps], &cycles[reps]);
+        total += ns[reps];
+        ns[reps] /= calls;
+        cycles[reps] /= calls;
+        reps++;
+    }
+    result->kernel = kernel->name;
+    result->param = kernel->param;
+    result->size = size;
+    result->samples = ctx.samples;
+    result->calls = calls * reps;
+    result->ns_per_call = median(ns, reps);
+    result->cycles_per_call = median(cycles, reps);
+    bench_ctx_free(&ctx);
+    return true;
+}
+
+static bool selected(const char *name, int argc, char **argv, int first)
+{
+    if (first >= argc) {
+        return true;
+    }
+    for (int i = first ; i < argc ; i++) {
+        if (strncmp(name, argv[i], strlen(argv[i])) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void write_json(FILE *f, const bench_result_t *results, int n_results, bool quick)
+{
+    fprintf(f, "{\n");
+    fprintf(f, "  \"compiler\": \"%s\",\n", __VERSION__);
+    fprintf(f, "  \"build_type\": \"%s\",\n", BENCH_BUILD_TYPE);
+    fprintf(f, "  \"cycles_source\": \"%s\",\n", CYCLES_SOURCE);
+    fprintf(f, "  \"quick\": %s,\n", quick ? "true" : "false");
+    fprintf(f, "  \"results\": [\n");
+    for (int i = 0 ; i < n_results ; i++) {
+        const bench_result_t *r = &results[i];
+        fprintf(f, "    {\"kernel\": \"%s\", \"param\": \"%s\", \"size\": %d, \"samples\": %d, \"calls\": %ld, "
+                "\"ns_per_call\": %.3f, \"ns_per_sample\": %.4f, \"cycles_per_call\": %.1f, \"cycles_per_sample\": %.3f}%s\n",
+                r->kernel, r->param, r->size, r->samples, r->calls, r->ns_per_call, r->ns_per_call / r->samples,
+                r->cycles_per_call, r->cycles_per_call / r->samples, (i < n_results - 1) ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+int main(int argc, char **argv)
+{
+    bool quick = false;
+    const char *json = NULL;
+    int first = 1;
+    while (first < argc) {
+        if (strcmp(argv[first], "--quick") == 0) {
+            quick = true;
+        } else if ((strcmp(argv[first], "--json") == 0) && (first + 1 < argc)) {
+            json = argv[++first];
+        } else {
+            break;
+        }
+        first++;
+    }
+
+    int max_results = 0;
+    for (int k = 0 ; k < bench_kernels_count ; k++) {
+        max_results += bench_kernels[k].n_sizes;
+    }
+    bench_result_t *results = calloc(max_results, sizeof(bench_result_t));
+    int n_results = 0;
+    int failed = 0;
+    srand(1);
+
+    printf("%-26s | %5s | %7s | %12s | %13s | %15s\n", "kernel", "param", "size", "ns/call", "ns/sample", "cycles/call");
+    for (int k = 0 ; k < bench_kernels_count ; k++) {
+        const bench_kernel_t *kernel = &bench_kernels[k];
+        if (!selected(kernel->name, argc, argv, first)) {
+            continue;
+        }
+        for (int s = 0 ; s < kernel->n_sizes ; s++) {
+            bench_result_t *r = &results[n_results];
+            if (!bench_run(kernel, kernel->sizes[s], quick ? QUICK_BUDGET_NS : BUDGET_NS, r)) {
+                printf("Error: %s setup failed for %s = %d\n", kernel->name, kernel->param, kernel->sizes[s]);
+                failed++;
+                continue;
+            }
+            printf("%-26s | %5s | %7d | %12.1f | %13.3f | %15.0f\n", r->kernel, r->param, r->size,
+                   r->ns_per_call, r->ns_per_call / r->samples, r->cycles_per_call);
+            n_results++;
+        }
+    }
+
+    if (json != NULL) {
+        FILE *f = (strcmp(json, "-") == 0) ? stdout : fopen(json, "w");
+        if (f == NULL) {
+            printf("Error: can't write %s\n", json);
+            failed++;
+        } else {
+            write_json(f, results, n_results, quick);
+            if (f != stdout) {
+                fclose(f);
+            }
+        }
+    }
+    free(results);
+    if (failed) {
+        printf("Benchmark failed: %i\n", failed);
+        return EXIT_FAILURE;
+    }
+    printf("Benchmark done\n");
+    return EXIT_SUCCESS;
+}
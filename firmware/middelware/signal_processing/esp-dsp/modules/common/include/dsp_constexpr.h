@@ -0,0 +1,157 @@
+// Copyright 2018-2023 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsp_constexpr_H_
+#define _dsp_constexpr_H_
+
+/**
+* @brief Math functions usable in constant expressions (C++14), for coefficient and
+*   table generation at compile time. The <math.h> functions are not constexpr: these are
+*   series evaluated in double precision, accurate to a few ulp of double, well below the
+*   float precision of the generated tables. They are not meant for run time use.
+*/
+namespace dsp_constexpr {
+
+constexpr double pi = 3.14159265358979323846;
+constexpr double ln2 = 0.69314718055994530942;
+constexpr double ln10 = 2.30258509299404568402;
+
+constexpr double fabs(double x)
+{
+    return (x < 0) ? -x : x;
+}
+
+/**
+ * Angle reduced to [-pi, pi]
+ */
+constexpr double reduce_angle(double x)
+{
+    double turns = x / (2 * pi);
+    long long n = (long long)((turns < 0) ? (turns - 0.5) : (turns + 0.5));
+    return x - n * 2 * pi;
+}
+
+constexpr double cos(double x)
+{
+    x = reduce_angle(x);
+    double x2 = x * x;
+    double term = 1;
+    double sum = 1;
+    for (int k = 1; k < 30; k++) {
+        term *= -x2 / ((2 * k - 1) * (2 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double sin(double x)
+{
+    x = reduce_angle(x);
+    double x2 = x * x;
+    double term = x;
+    double sum = x;
+    for (int k = 1; k < 30; k++) {
+        term *= -x2 / ((2 * k) * (2 * k + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double tan(double x)
+{
+    return sin(x) / cos(x);
+}
+
+constexpr double sqrt(double x)
+{
+    if (x <= 0) {
+        return 0;
+    }
+    // Newton iterations from a power of two close to the root
+    double y = 1;
+    while (y * y < x) {
+        y *= 2;
+    }
+    while (y * y > 4 * x) {
+        y /= 2;
+    }
+    for (int i = 0; i < 8; i++) {
+        y = 0.5 * (y + x / y);
+    }
+    return y;
+}
+
+constexpr double exp(double x)
+{
+    // x = n * ln2 + r, |r| <= ln2 / 2
+    long long n = (long long)((x < 0) ? (x / ln2 - 0.5) : (x / ln2 + 0.5));
+    double r = x - n * ln2;
+    double term = 1;
+    double sum = 1;
+    for (int k = 1; k < 25; k++) {
+        term *= r / k;
+        sum += term;
+    }
+    for (; n > 0; n--) {
+        sum *= 2;
+    }
+    for (; n < 0; n++) {
+        sum /= 2;
+    }
+    return sum;
+}
+
+constexpr double log(double x)
+{
+    // x = 2^n * m, 1 <= m < 2, then Newton iterations of exp(y) = m
+    int n = 0;
+    while (x >= 2) {
+        x /= 2;
+        n++;
+    }
+    while (x < 1) {
+        x *= 2;
+        n--;
+    }
+    double y = x - 1;
+    for (int i = 0; i < 6; i++) {
+        double e = exp(y);
+        y += 2 * (x - e) / (x + e);
+    }
+    return y + n * ln2;
+}
+
+constexpr double pow10(double x)
+{
+    return exp(x * ln10);
+}
+
+constexpr double sinh(double x)
+{
+    return 0.5 * (exp(x) - exp(-x));
+}
+
+constexpr double cosh(double x)
+{
+    return 0.5 * (exp(x) + exp(-x));
+}
+
+constexpr double asinh(double x)
+{
+    return (x < 0) ? -log(-x + sqrt(x * x + 1)) : log(x + sqrt(x * x + 1));
+}
+
+} // namespace dsp_constexpr
+
+#endif // _dsp_constexpr_H_
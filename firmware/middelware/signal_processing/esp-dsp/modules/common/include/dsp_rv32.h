@@ -0,0 +1,67 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsp_rv32_H_
+#define _dsp_rv32_H_
+
+// Helpers of the _rv32 kernels, plain C written for RV32IMAC (ESP32-C6): no FPU, no
+// hardware loops, single cycle 32 bit multiplier and no fast misaligned access.
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * 32 bit load of two int16 values (lower address in the low half).
+ * The address must be 4 byte aligned, so the compiler emits a single lw.
+ */
+static inline uint32_t dsp_rv32_load_s16x2(const int16_t *p)
+{
+    uint32_t w;
+    memcpy(&w, __builtin_assume_aligned(p, 4), sizeof(w));
+    return w;
+}
+
+/**
+ * 32 bit store of two int16 values, the address must be 4 byte aligned.
+ */
+static inline void dsp_rv32_store_s16x2(int16_t *p, int32_t lo, int32_t hi)
+{
+    uint32_t w = (uint16_t)lo | ((uint32_t)(uint16_t)hi << 16);
+    memcpy(__builtin_assume_aligned(p, 4), &w, sizeof(w));
+}
+
+static inline int32_t dsp_rv32_lo(uint32_t w)
+{
+    return (int16_t)w;
+}
+
+static inline int32_t dsp_rv32_hi(uint32_t w)
+{
+    return (int32_t)w >> 16;
+}
+
+/**
+ * Sum of two int16 x int16 products, minus one.
+ *
+ * Each product is in [-2^30 + 2^15, 2^30], so the sum only overflows int32 for 2^31
+ * (both operands -32768 twice). Minus one it always fits: 64 bit accumulators take one
+ * 64 bit add per pair of products instead of one per product, and the caller adds the
+ * number of pairs back once.
+ */
+static inline int32_t dsp_rv32_mac2(int32_t a0, int32_t b0, int32_t a1, int32_t b1)
+{
+    return (int32_t)((uint32_t)(a0 * b0) + (uint32_t)(a1 * b1) - 1u);
+}
+
+#endif // _dsp_rv32_H_
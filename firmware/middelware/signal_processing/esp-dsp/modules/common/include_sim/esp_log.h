@@ -18,7 +18,14 @@
 #define _esp_log_h_
 
 #include <stdlib.h>
+#include <stdio.h>
 
-#define ESP_LOGD
+#define ESP_LOGD(tag, format, ...) ((void)(tag))
+#define ESP_LOGV(tag, format, ...) ((void)(tag))
+
+// Errors and warnings are printed, as they are reported by the checks under test
+#define ESP_LOGE(tag, format, ...) printf("E (%s) " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) printf("W (%s) " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) printf("I (%s) " format "\n", tag, ##__VA_ARGS__)
 
 #endif // _esp_log_h_
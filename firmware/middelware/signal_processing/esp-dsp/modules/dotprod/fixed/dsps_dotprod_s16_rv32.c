@@ -0,0 +1,65 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include "dsps_dotprod.h"
+#include "dsp_rv32.h"
+
+esp_err_t dsps_dotprod_s16_rv32(const int16_t *src1, const int16_t *src2, int16_t *dest, int len, int8_t shift)
+{
+    // Same rounding and result as dsps_dotprod_s16_ansi()
+    long long acc = 0x7fff >> shift;
+    int i = 0;
+
+    // Both vectors at the same 32 bit alignment: one halfword to align them, then two
+    // samples per load
+    if ((((uintptr_t)src1 ^ (uintptr_t)src2) & 3) == 0) {
+        if (((uintptr_t)src1 & 3) && (len > 0)) {
+            acc += (int32_t)src1[0] * (int32_t)src2[0];
+            i = 1;
+        }
+        int pairs = (len - i) / 2;
+        acc += pairs;
+        for (; i + 4 <= len ; i += 4) {
+            uint32_t x0 = dsp_rv32_load_s16x2(&src1[i]);
+            uint32_t y0 = dsp_rv32_load_s16x2(&src2[i]);
+            uint32_t x1 = dsp_rv32_load_s16x2(&src1[i + 2]);
+            uint32_t y1 = dsp_rv32_load_s16x2(&src2[i + 2]);
+            acc += dsp_rv32_mac2(dsp_rv32_lo(x0), dsp_rv32_lo(y0), dsp_rv32_hi(x0), dsp_rv32_hi(y0));
+            acc += dsp_rv32_mac2(dsp_rv32_lo(x1), dsp_rv32_lo(y1), dsp_rv32_hi(x1), dsp_rv32_hi(y1));
+        }
+        if (i + 2 <= len) {
+            uint32_t x0 = dsp_rv32_load_s16x2(&src1[i]);
+            uint32_t y0 = dsp_rv32_load_s16x2(&src2[i]);
+            acc += dsp_rv32_mac2(dsp_rv32_lo(x0), dsp_rv32_lo(y0), dsp_rv32_hi(x0), dsp_rv32_hi(y0));
+            i += 2;
+        }
+    } else {
+        acc += len / 2;
+        for (; i + 2 <= len ; i += 2) {
+            acc += dsp_rv32_mac2(src1[i], src2[i], src1[i + 1], src2[i + 1]);
+        }
+    }
+    if (i < len) {
+        acc += (int32_t)src1[i] * (int32_t)src2[i];
+    }
+
+    int final_shift = shift - 15;
+    if (final_shift > 0) {
+        *dest = (acc << final_shift);
+    } else {
+        *dest = (acc >> (-final_shift));
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,34 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_dotprod.h"
+
+esp_err_t dsps_dotprod_f32_rv32(const float *src1, const float *src2, float *dest, int len)
+{
+    // Unrolled by 4 with a single accumulator: same sum order (and result) as
+    // dsps_dotprod_f32_ansi(), without the loop overhead between the soft-float calls
+    float acc = 0;
+    int i = 0;
+    for (; i + 4 <= len ; i += 4) {
+        acc += src1[i] * src2[i];
+        acc += src1[i + 1] * src2[i + 1];
+        acc += src1[i + 2] * src2[i + 2];
+        acc += src1[i + 3] * src2[i + 3];
+    }
+    for (; i < len ; i++) {
+        acc += src1[i] * src2[i];
+    }
+    *dest = acc;
+    return ESP_OK;
+}
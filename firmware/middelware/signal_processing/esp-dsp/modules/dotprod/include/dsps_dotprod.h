@@ -43,6 +43,7 @@ extern "C"
  *      - One of the error codes from DSP library
  */
 esp_err_t dsps_dotprod_s16_ansi(const int16_t *src1, const int16_t *src2, int16_t *dest, int len, int8_t shift);
+esp_err_t dsps_dotprod_s16_rv32(const int16_t *src1, const int16_t *src2, int16_t *dest, int len, int8_t shift);
 esp_err_t dsps_dotprod_s16_ae32(const int16_t *src1, const int16_t *src2, int16_t *dest, int len, int8_t shift);
 /**@}*/
 
@@ -63,6 +64,7 @@ esp_err_t dsps_dotprod_s16_ae32(const int16_t *src1, const int16_t *src2, int16_
  *      - One of the error codes from DSP library
  */
 esp_err_t dsps_dotprod_f32_ansi(const float *src1, const float *src2, float *dest, int len);
+esp_err_t dsps_dotprod_f32_rv32(const float *src1, const float *src2, float *dest, int len);
 esp_err_t dsps_dotprod_f32_ae32(const float *src1, const float *src2, float *dest, int len);
 esp_err_t dsps_dotprod_f32_aes3(const float *src1, const float *src2, float *dest, int len);
 /**@}*/
@@ -117,4 +119,14 @@ esp_err_t dsps_dotprode_f32_ae32(const float *src1, const float *src2, float *de
 #define dsps_dotprode_f32 dsps_dotprode_f32_ansi
 #endif // CONFIG_DSP_OPTIMIZED
 
+// The _rv32 kernels are plain C, selected independently of CONFIG_DSP_OPTIMIZED (Xtensa only)
+#if (dsps_dotprod_s16_rv32_enabled == 1)
+#undef dsps_dotprod_s16
+#define dsps_dotprod_s16 dsps_dotprod_s16_rv32
+#endif
+#if (dsps_dotprod_f32_rv32_enabled == 1)
+#undef dsps_dotprod_f32
+#define dsps_dotprod_f32 dsps_dotprod_f32_rv32
+#endif
+
 #endif // _DSPI_DOTPROD_H_
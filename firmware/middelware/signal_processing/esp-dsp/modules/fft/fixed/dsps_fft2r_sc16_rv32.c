@@ -0,0 +1,69 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+#include "dsp_types.h"
+
+extern uint8_t dsps_fft2r_sc16_initialized;
+
+esp_err_t dsps_fft2r_sc16_rv32_(int16_t *data, int N, int16_t *sc_table)
+{
+    if (!dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (!dsps_fft2r_sc16_initialized) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+
+    uint32_t *w = (uint32_t *)sc_table;
+    uint32_t *in_data = (uint32_t *)data;
+
+    // Same butterflies as dsps_fft2r_sc16_ansi_(), with the twiddle products computed
+    // once for both outputs: 4 multiplications per butterfly instead of 8, and the
+    // scaled input and rounding constant shared by the sum and the difference.
+    int ie = 1;
+    for (int N2 = N / 2; N2 > 0; N2 >>= 1) {
+        int ia = 0;
+        for (int j = 0; j < ie; j++) {
+            sc16_t cs;
+            cs.data = w[j];
+            const int32_t c = cs.re;
+            const int32_t s = cs.im;
+            for (int i = 0; i < N2; i++) {
+                int m = ia + N2;
+                sc16_t m_data;
+                sc16_t a_data;
+                m_data.data = in_data[m];
+                a_data.data = in_data[ia];
+                int32_t t_re = c * m_data.re + s * m_data.im;
+                int32_t t_im = c * m_data.im - s * m_data.re;
+                int32_t a_re = a_data.re * 0x7fff + 0x7fff;
+                int32_t a_im = a_data.im * 0x7fff + 0x7fff;
+                sc16_t m1;
+                m1.re = (int16_t)((a_re - t_re) >> 16);
+                m1.im = (int16_t)((a_im - t_im) >> 16);
+                in_data[m] = m1.data;
+                sc16_t m2;
+                m2.re = (int16_t)((a_re + t_re) >> 16);
+                m2.im = (int16_t)((a_im + t_im) >> 16);
+                in_data[ia] = m2.data;
+                ia++;
+            }
+            ia += N2;
+        }
+        ie <<= 1;
+    }
+    return ESP_OK;
+}
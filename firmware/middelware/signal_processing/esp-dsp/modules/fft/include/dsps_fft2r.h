@@ -97,6 +97,7 @@ esp_err_t dsps_fft2r_fc32_aes3_(float *data, int N, float *w);
 esp_err_t dsps_fft2r_sc16_ansi_(int16_t *data, int N, int16_t *w);
 esp_err_t dsps_fft2r_sc16_ae32_(int16_t *data, int N, int16_t *w);
 esp_err_t dsps_fft2r_sc16_aes3_(int16_t *data, int N, int16_t *w);
+esp_err_t dsps_fft2r_sc16_rv32_(int16_t *data, int N, int16_t *w);
 /**@}*/
 // This is workaround because linker generates permanent error when assembler uses
 // direct access to the table pointer
@@ -106,6 +107,7 @@ esp_err_t dsps_fft2r_sc16_aes3_(int16_t *data, int N, int16_t *w);
 #define dsps_fft2r_sc16_aes3(data, N) dsps_fft2r_sc16_aes3_(data, N, dsps_fft_w_table_sc16)
 #define dsps_fft2r_fc32_ansi(data, N) dsps_fft2r_fc32_ansi_(data, N, dsps_fft_w_table_fc32)
 #define dsps_fft2r_sc16_ansi(data, N) dsps_fft2r_sc16_ansi_(data, N, dsps_fft_w_table_sc16)
+#define dsps_fft2r_sc16_rv32(data, N) dsps_fft2r_sc16_rv32_(data, N, dsps_fft_w_table_sc16)
 
 
 /**@{*/
@@ -242,4 +244,10 @@ esp_err_t dsps_gen_bitrev2r_table(int N, int step, char *name_ext);
 
 #endif // CONFIG_DSP_OPTIMIZED
 
+// The _rv32 kernels are plain C, selected independently of CONFIG_DSP_OPTIMIZED (Xtensa only)
+#if (dsps_fft2r_sc16_rv32_enabled == 1)
+#undef dsps_fft2r_sc16
+#define dsps_fft2r_sc16 dsps_fft2r_sc16_rv32
+#endif
+
 #endif // _dsps_fft2r_H_
@@ -32,5 +32,10 @@
 #define dsps_fft2r_sc16_aes3_enabled 1
 #endif
 
+// RV32IMAC (ESP32-C6): C kernels tuned for the core, selected by default unless
+// CONFIG_DSP_ANSI forces the reference implementations
+#if defined(__riscv) && (__riscv_xlen == 32) && !CONFIG_DSP_ANSI
+#define dsps_fft2r_sc16_rv32_enabled 1
+#endif // __riscv
 
 #endif // _dsps_fft2r_platform_H_
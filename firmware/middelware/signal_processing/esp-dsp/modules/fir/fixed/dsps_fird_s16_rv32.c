@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "dsps_fir.h"
+#include "dsp_rv32.h"
+
+// Products of one segment of the delay line, coefficients walked backwards. Returns the
+// sum minus the number of pairs (see dsp_rv32_mac2()).
+static inline long long fird_s16_rv32_segment(const int16_t *coeffs, const int16_t *delay, int len)
+{
+    long long acc = 0;
+    int n = 0;
+    for (; n + 4 <= len ; n += 4) {
+        acc += dsp_rv32_mac2(coeffs[-n], delay[n], coeffs[-n - 1], delay[n + 1]);
+        acc += dsp_rv32_mac2(coeffs[-n - 2], delay[n + 2], coeffs[-n - 3], delay[n + 3]);
+    }
+    for (; n + 2 <= len ; n += 2) {
+        acc += dsp_rv32_mac2(coeffs[-n], delay[n], coeffs[-n - 1], delay[n + 1]);
+    }
+    if (n < len) {
+        acc += (int32_t)coeffs[-n] * (int32_t)delay[n];
+    }
+    return acc;
+}
+
+int32_t dsps_fird_s16_rv32(fir_s16_t *fir, const int16_t *input, int16_t *output, int32_t len)
+{
+    int32_t result = 0;
+    int32_t input_pos = 0;
+    long long rounding = 0;
+    const int32_t final_shift = fir->shift - 15;
+    const int16_t *coeffs = fir->coeffs;
+    int16_t *delay = fir->delay;
+    const int32_t coeffs_len = fir->coeffs_len;
+
+    // Same rounding and result as dsps_fird_s16_ansi()
+    rounding = (long long)(fir->rounding_val);
+    if (fir->shift >= 0) {
+        rounding = (rounding >> fir->shift) & 0xFFFFFFFFFF;         // 40-bit mask
+    } else {
+        rounding = (rounding << (-fir->shift)) & 0xFFFFFFFFFF;      // 40-bit mask
+    }
+
+    int32_t pos = fir->pos;
+    for (int i = 0; i < len; i++) {
+        for (int j = 0; j < fir->decim - fir->d_pos; j++) {
+            if (pos >= coeffs_len) {
+                pos = 0;
+            }
+            delay[pos++] = input[input_pos++];
+        }
+        fir->d_pos = 0;
+
+        // Oldest sample (delay[pos]) by the last coefficient. Both segments have their
+        // pairs corrected together.
+        int32_t first = coeffs_len - pos;
+        long long acc = rounding + first / 2 + pos / 2;
+        acc += fird_s16_rv32_segment(&coeffs[coeffs_len - 1], &delay[pos], first);
+        if (pos > 0) {
+            acc += fird_s16_rv32_segment(&coeffs[pos - 1], delay, pos);
+        }
+
+        if (final_shift > 0) {
+            output[result++] = (int16_t)(acc << final_shift);
+        } else {
+            output[result++] = (int16_t)(acc >> (-final_shift));
+        }
+    }
+    fir->pos = pos;
+    return result;
+}
@@ -176,6 +176,7 @@ int dsps_fird_f32_aes3(fir_f32_t *fir, const float *input, float *output, int le
  *          depends on the previous state value could be [0..len/decimation]
  */
 int32_t dsps_fird_s16_ansi(fir_s16_t *fir, const int16_t *input, int16_t *output, int32_t len);
+int32_t dsps_fird_s16_rv32(fir_s16_t *fir, const int16_t *input, int16_t *output, int32_t len);
 int32_t dsps_fird_s16_ae32(fir_s16_t *fir, const int16_t *input, int16_t *output, int32_t len);
 int32_t dsps_fird_s16_aes3(fir_s16_t *fir, const int16_t *input, int16_t *output, int32_t len);
 /**@}*/
@@ -272,4 +273,10 @@ esp_err_t dsps_16_array_rev(int16_t *arr, int16_t len);
 
 #endif // CONFIG_DSP_OPTIMIZED
 
+// The _rv32 kernels are plain C, selected independently of CONFIG_DSP_OPTIMIZED (Xtensa only)
+#if (dsps_fird_s16_rv32_enabled == 1)
+#undef dsps_fird_s16
+#define dsps_fird_s16 dsps_fird_s16_rv32
+#endif
+
 #endif // _dsps_fir_H_
@@ -28,4 +28,10 @@
 #endif //
 #endif // __XTENSA__
 
+// RV32IMAC (ESP32-C6): C kernels tuned for the core, selected by default unless
+// CONFIG_DSP_ANSI forces the reference implementations
+#if defined(__riscv) && (__riscv_xlen == 32) && !CONFIG_DSP_ANSI
+#define dsps_fird_s16_rv32_enabled 1
+#endif // __riscv
+
 #endif // _dsps_fir_platform_H_
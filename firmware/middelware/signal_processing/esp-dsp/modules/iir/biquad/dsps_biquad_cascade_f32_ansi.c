@@ -0,0 +1,85 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dsps_biquad.h"
+
+// Sections processed in one pass over the block. Their coefficients and delay lines
+// are copied to local variables, so they can stay in registers between samples.
+#define BIQUAD_CASCADE_FUSED    4
+
+static inline float dsps_biquad_section_f32(float x, const float *coef, float *w0, float *w1)
+{
+    float d0 = x - coef[3] * *w0 - coef[4] * *w1;
+    float y = coef[0] * d0 + coef[1] * *w0 + coef[2] * *w1;
+    *w1 = *w0;
+    *w0 = d0;
+    return y;
+}
+
+static inline void dsps_biquad_cascade_block_f32(const float *input, float *output, int len, const int n_sections, const float *coef, float *w)
+{
+    float c[BIQUAD_CASCADE_FUSED * 5];
+    float w0[BIQUAD_CASCADE_FUSED];
+    float w1[BIQUAD_CASCADE_FUSED];
+    for (int k = 0 ; k < n_sections ; k++) {
+        for (int j = 0 ; j < 5 ; j++) {
+            c[k * 5 + j] = coef[k * 5 + j];
+        }
+        w0[k] = w[2 * k];
+        w1[k] = w[2 * k + 1];
+    }
+    for (int i = 0 ; i < len ; i++) {
+        float x = input[i];
+        for (int k = 0 ; k < n_sections ; k++) {
+            x = dsps_biquad_section_f32(x, &c[k * 5], &w0[k], &w1[k]);
+        }
+        output[i] = x;
+    }
+    for (int k = 0 ; k < n_sections ; k++) {
+        w[2 * k] = w0[k];
+        w[2 * k + 1] = w1[k];
+    }
+}
+
+esp_err_t dsps_biquad_cascade_f32_ansi(const float *input, float *output, int len, int n_sections, const float *coef, float *w)
+{
+    if (n_sections < 1) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    // Groups of up to BIQUAD_CASCADE_FUSED sections, the section count of each call is a
+    // constant so the inner loops are fully unrolled
+    while (n_sections > 0) {
+        switch (n_sections) {
+        case 1:
+            dsps_biquad_cascade_block_f32(input, output, len, 1, coef, w);
+            break;
+        case 2:
+            dsps_biquad_cascade_block_f32(input, output, len, 2, coef, w);
+            break;
+        case 3:
+            dsps_biquad_cascade_block_f32(input, output, len, 3, coef, w);
+            break;
+        default:
+            dsps_biquad_cascade_block_f32(input, output, len, BIQUAD_CASCADE_FUSED, coef, w);
+            break;
+        }
+        int fused = n_sections < BIQUAD_CASCADE_FUSED ? n_sections : BIQUAD_CASCADE_FUSED;
+        n_sections -= fused;
+        coef += 5 * fused;
+        w += 2 * fused;
+        input = output;
+    }
+    return ESP_OK;
+}
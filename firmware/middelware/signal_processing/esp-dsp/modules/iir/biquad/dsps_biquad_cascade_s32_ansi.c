@@ -0,0 +1,110 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dsps_biquad.h"
+
+// Sections processed in one pass over the block (see dsps_biquad_cascade_f32_ansi.c)
+#define BIQUAD_CASCADE_FUSED    4
+
+static inline int32_t dsps_biquad_sat_s32(int64_t acc)
+{
+    if (acc > INT32_MAX) {
+        return INT32_MAX;
+    }
+    if (acc < INT32_MIN) {
+        return INT32_MIN;
+    }
+    return (int32_t)acc;
+}
+
+static inline int32_t dsps_biquad_section_s32(int32_t x, const int32_t *coef, int32_t *x1, int32_t *x2, int32_t *y1, int32_t *y2)
+{
+    // Q31 data * Q30 coefficients, rounded back to Q31
+    int64_t acc = (int64_t)1 << 29;
+    acc += (int64_t)coef[0] * x + (int64_t)coef[1] * *x1 + (int64_t)coef[2] * *x2;
+    acc -= (int64_t)coef[3] * *y1 + (int64_t)coef[4] * *y2;
+    int32_t y = dsps_biquad_sat_s32(acc >> 30);
+    *x2 = *x1;
+    *x1 = x;
+    return y;
+}
+
+static inline void dsps_biquad_cascade_block_s32(const int32_t *input, int32_t *output, int len, const int n_sections, const int32_t *coef, int32_t *w)
+{
+    int32_t c[BIQUAD_CASCADE_FUSED * 5];
+    int32_t h1[BIQUAD_CASCADE_FUSED + 1];
+    int32_t h2[BIQUAD_CASCADE_FUSED + 1];
+    for (int k = 0 ; k < n_sections ; k++) {
+        for (int j = 0 ; j < 5 ; j++) {
+            c[k * 5 + j] = coef[k * 5 + j];
+        }
+    }
+    for (int k = 0 ; k <= n_sections ; k++) {
+        h1[k] = w[2 * k];
+        h2[k] = w[2 * k + 1];
+    }
+    for (int i = 0 ; i < len ; i++) {
+        int32_t x = input[i];
+        for (int k = 0 ; k < n_sections ; k++) {
+            x = dsps_biquad_section_s32(x, &c[k * 5], &h1[k], &h2[k], &h1[k + 1], &h2[k + 1]);
+        }
+        h2[n_sections] = h1[n_sections];
+        h1[n_sections] = x;
+        output[i] = x;
+    }
+    for (int k = 0 ; k <= n_sections ; k++) {
+        w[2 * k] = h1[k];
+        w[2 * k + 1] = h2[k];
+    }
+}
+
+esp_err_t dsps_biquad_cascade_s32_ansi(const int32_t *input, int32_t *output, int len, int n_sections, const int32_t *coef, int32_t *w)
+{
+    if (n_sections < 1) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    // The output history of the last section of a group is the input history of the next
+    // group: it is saved before the group writes back its end of block values, and restored
+    // for the next group (which writes back the same end of block values again)
+    int32_t boundary[2];
+    while (n_sections > 0) {
+        int fused = n_sections < BIQUAD_CASCADE_FUSED ? n_sections : BIQUAD_CASCADE_FUSED;
+        boundary[0] = w[2 * fused];
+        boundary[1] = w[2 * fused + 1];
+        switch (n_sections) {
+        case 1:
+            dsps_biquad_cascade_block_s32(input, output, len, 1, coef, w);
+            break;
+        case 2:
+            dsps_biquad_cascade_block_s32(input, output, len, 2, coef, w);
+            break;
+        case 3:
+            dsps_biquad_cascade_block_s32(input, output, len, 3, coef, w);
+            break;
+        default:
+            dsps_biquad_cascade_block_s32(input, output, len, BIQUAD_CASCADE_FUSED, coef, w);
+            break;
+        }
+        n_sections -= fused;
+        coef += 5 * fused;
+        w += 2 * fused;
+        input = output;
+        if (n_sections > 0) {
+            w[0] = boundary[0];
+            w[1] = boundary[1];
+        }
+    }
+    return ESP_OK;
+}
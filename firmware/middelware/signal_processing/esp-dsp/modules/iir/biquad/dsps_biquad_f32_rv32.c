@@ -0,0 +1,47 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_biquad.h"
+
+esp_err_t dsps_biquad_f32_rv32(const float *input, float *output, int len, float *coef, float *w)
+{
+    // Coefficients and delay line in local variables (output may alias them for the
+    // compiler), two samples per iteration so the delay line rotates without moves.
+    // Same operations in the same order as dsps_biquad_f32_ansi().
+    const float b0 = coef[0];
+    const float b1 = coef[1];
+    const float b2 = coef[2];
+    const float a1 = coef[3];
+    const float a2 = coef[4];
+    float w0 = w[0];
+    float w1 = w[1];
+    int i = 0;
+    for (; i + 2 <= len ; i += 2) {
+        float d0 = input[i] - a1 * w0 - a2 * w1;
+        output[i] = b0 * d0 + b1 * w0 + b2 * w1;
+        float d1 = input[i + 1] - a1 * d0 - a2 * w0;
+        output[i + 1] = b0 * d1 + b1 * d0 + b2 * w0;
+        w1 = d0;
+        w0 = d1;
+    }
+    if (i < len) {
+        float d0 = input[i] - a1 * w0 - a2 * w1;
+        output[i] = b0 * d0 + b1 * w0 + b2 * w1;
+        w1 = w0;
+        w0 = d0;
+    }
+    w[0] = w0;
+    w[1] = w1;
+    return ESP_OK;
+}
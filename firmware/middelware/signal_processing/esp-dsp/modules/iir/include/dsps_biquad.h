@@ -44,10 +44,60 @@ extern "C"
  *      - One of the error codes from DSP library
  */
 esp_err_t dsps_biquad_f32_ansi(const float *input, float *output, int len, float *coef, float *w);
+esp_err_t dsps_biquad_f32_rv32(const float *input, float *output, int len, float *coef, float *w);
 esp_err_t dsps_biquad_f32_ae32(const float *input, float *output, int len, float *coef, float *w);
 esp_err_t dsps_biquad_f32_aes3(const float *input, float *output, int len, float *coef, float *w);
 /**@}*/
 
+/**@{*/
+/**
+ * @brief   Cascade of IIR filters
+ *
+ * Cascade of 2nd order sections, direct form II. Every sample goes through all the
+ * sections before the next one is read, with the coefficients and delay lines of up to
+ * four sections held in local variables for the whole block. Same result as calling
+ * dsps_biquad_f32() once per section, with a single pass over the signal.
+ * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
+ *
+ * @param[in] input: input array
+ * @param output: output array (could be the same as input)
+ * @param len: length of input and output vectors
+ * @param n_sections: number of sections
+ * @param coef: array of coefficients. b0,b1,b2,a1,a2 of each section (5 * n_sections)
+ *              expected that a0 = 1. b0..b2 - numerator, a0..a2 - denominator
+ * @param w: delay lines w0,w1 of each section. Length of 2 * n_sections.
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_biquad_cascade_f32_ansi(const float *input, float *output, int len, int n_sections, const float *coef, float *w);
+/**@}*/
+
+/**@{*/
+/**
+ * @brief   Cascade of IIR filters, Q31
+ *
+ * Cascade of 2nd order sections, direct form I, for Q31 data. Each section accumulates
+ * in 64 bits and saturates its output to 32 bits. Consecutive sections share the
+ * delay line between them (the output history of a section is the input history of
+ * the next one). Same sample by sample processing as dsps_biquad_cascade_f32_ansi().
+ * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
+ *
+ * @param[in] input: input array (Q31)
+ * @param output: output array (Q31, could be the same as input)
+ * @param len: length of input and output vectors
+ * @param n_sections: number of sections
+ * @param coef: array of coefficients in Q30 (range -2..2). b0,b1,b2,a1,a2 of each section
+ *              (5 * n_sections), expected that a0 = 1.
+ * @param w: delay line. x[n-1],x[n-2] of the cascade input followed by y[n-1],y[n-2]
+ *           of each section. Length of 2 * (n_sections + 1).
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_biquad_cascade_s32_ansi(const int32_t *input, int32_t *output, int len, int n_sections, const int32_t *coef, int32_t *w);
+/**@}*/
+
 
 #ifdef __cplusplus
 }
@@ -63,11 +113,22 @@ esp_err_t dsps_biquad_f32_aes3(const float *input, float *output, int len, float
 #define dsps_biquad_f32 dsps_biquad_f32_ansi
 #endif
 
+#define dsps_biquad_cascade_f32 dsps_biquad_cascade_f32_ansi
+#define dsps_biquad_cascade_s32 dsps_biquad_cascade_s32_ansi
+
 #else // CONFIG_DSP_OPTIMIZED
 
 #define dsps_biquad_f32 dsps_biquad_f32_ansi
+#define dsps_biquad_cascade_f32 dsps_biquad_cascade_f32_ansi
+#define dsps_biquad_cascade_s32 dsps_biquad_cascade_s32_ansi
 
 #endif // CONFIG_DSP_OPTIMIZED
 
 
+// The _rv32 kernels are plain C, selected independently of CONFIG_DSP_OPTIMIZED (Xtensa only)
+#if (dsps_biquad_f32_rv32_enabled == 1)
+#undef dsps_biquad_f32
+#define dsps_biquad_f32 dsps_biquad_f32_rv32
+#endif
+
 #endif // _dsps_biquad_H_
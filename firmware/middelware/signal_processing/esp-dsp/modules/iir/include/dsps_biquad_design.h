@@ -0,0 +1,217 @@
+// Copyright 2018-2023 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_biquad_design_H_
+#define _dsps_biquad_design_H_
+
+#include "dsp_constexpr.h"
+
+/**
+* @brief Compile time biquad design (C++14, header only).
+*
+*   The same sections as dsps_biquad_gen_lpf_f32(), dsps_biquad_gen_hpf_f32() and
+*   dsps_biquad_gen_notch_f32() (zeros on the unit circle), plus Butterworth and Chebyshev
+*   type I cascades, as constant expressions: a constexpr object holds b0, b1, b2, a1, a2 of
+*   every section (dsps_biquad_f32 / dsps_biquad_cascade_f32 layout) and is placed in flash
+*   with no code run at start up.
+*
+*   Frequencies are normalized to the sample rate (0 < f < 0.5). Example:
+*       static constexpr auto lpf = dsps_design::butterworth_lpf<4>(50.0 / 1000.0);
+*       dsps_biquad_cascade_f32(x, y, len, lpf.SECTIONS, lpf.coeffs, w);
+*/
+namespace dsps_design {
+
+/**
+ * Cascade of Sections 2nd order sections: b0, b1, b2, a1, a2 of each one (a0 = 1)
+ */
+template <int Sections>
+struct sos {
+    static const int SECTIONS = Sections;   /*!< Number of sections*/
+    float coeffs[5 * Sections];             /*!< Coefficients*/
+};
+
+namespace detail {
+
+enum section_type {
+    LOW_PASS,
+    HIGH_PASS,
+    NOTCH
+};
+
+// Section of the bilinear transform of the analog prototype prewarped to
+// omega = tan(pi * f): cos(w0) and sin(w0) from tan(w0 / 2) (no atan needed)
+constexpr void section(float *coeffs, section_type type, double omega, double q_factor, double gain)
+{
+    if (q_factor <= 0.0001) {
+        q_factor = 0.0001;
+    }
+    double t2 = omega * omega;
+    double c = (1 - t2) / (1 + t2);
+    double s = 2 * omega / (1 + t2);
+    double alpha = s / (2 * q_factor);
+    double b0 = 0;
+    double b1 = 0;
+    switch (type) {
+    case LOW_PASS:
+        b0 = (1 - c) / 2;
+        b1 = 1 - c;
+        break;
+    case HIGH_PASS:
+        b0 = (1 + c) / 2;
+        b1 = -(1 + c);
+        break;
+    case NOTCH:
+        b0 = 1;
+        b1 = -2 * c;
+        break;
+    }
+    double a0 = 1 + alpha;
+    coeffs[0] = (float)(gain * b0 / a0);
+    coeffs[1] = (float)(gain * b1 / a0);
+    coeffs[2] = (float)(gain * b0 / a0);
+    coeffs[3] = (float)(-2 * c / a0);
+    coeffs[4] = (float)((1 - alpha) / a0);
+}
+
+template <int Order>
+constexpr sos<Order / 2> butterworth(section_type type, double f)
+{
+    static_assert((Order > 0) && (Order % 2 == 0), "Order must be even");
+    sos<Order / 2> filter{};
+    double omega = dsp_constexpr::tan(dsp_constexpr::pi * f);
+    // Q = 1 / (2 * cos(theta)), theta = (2k - 1) * pi / (2 * order), highest Q first as
+    // IIRFilterAddButterworth()
+    for (int k = Order / 2; k > 0; k--) {
+        double q_factor = 1 / (2 * dsp_constexpr::cos((2 * k - 1) * dsp_constexpr::pi / (2 * Order)));
+        section(&filter.coeffs[5 * (Order / 2 - k)], type, omega, q_factor, 1);
+    }
+    return filter;
+}
+
+template <int Order>
+constexpr sos<Order / 2> chebyshev1(section_type type, double f, double ripple_db)
+{
+    static_assert((Order > 0) && (Order % 2 == 0), "Order must be even");
+    sos<Order / 2> filter{};
+    double omega = dsp_constexpr::tan(dsp_constexpr::pi * f);
+    double eps = dsp_constexpr::sqrt(dsp_constexpr::pow10(ripple_db / 10) - 1);
+    double a = dsp_constexpr::asinh(1 / eps) / Order;
+    double sh = dsp_constexpr::sinh(a);
+    double ch = dsp_constexpr::cosh(a);
+    // Poles -sinh(a) * sin(theta) +- j * cosh(a) * cos(theta) of the prototype (ripple band
+    // edge at 1 rad/s), as sections of natural frequency w0 and Q = w0 / (2 * |re|). The
+    // even order response starts at the bottom of the ripple: 1 / sqrt(1 + eps^2).
+    double gain = 1 / dsp_constexpr::sqrt(1 + eps * eps);
+    for (int k = Order / 2; k > 0; k--) {
+        double theta = (2 * k - 1) * dsp_constexpr::pi / (2 * Order);
+        double re = sh * dsp_constexpr::sin(theta);
+        double im = ch * dsp_constexpr::cos(theta);
+        double w0 = dsp_constexpr::sqrt(re * re + im * im);
+        double section_omega = (type == LOW_PASS) ? (omega * w0) : (omega / w0);
+        section(&filter.coeffs[5 * (Order / 2 - k)], type, section_omega, w0 / (2 * re), (k == Order / 2) ? gain : 1);
+    }
+    return filter;
+}
+
+} // namespace detail
+
+/**
+ * Low pass section, as dsps_biquad_gen_lpf_f32()
+ *
+ * @param[in] f: cut-off frequency (0 < f < 0.5)
+ * @param[in] q_factor: Q factor
+ */
+constexpr sos<1> lpf(double f, double q_factor)
+{
+    sos<1> filter{};
+    detail::section(filter.coeffs, detail::LOW_PASS, dsp_constexpr::tan(dsp_constexpr::pi * f), q_factor, 1);
+    return filter;
+}
+
+/**
+ * High pass section, as dsps_biquad_gen_hpf_f32()
+ *
+ * @param[in] f: cut-off frequency (0 < f < 0.5)
+ * @param[in] q_factor: Q factor
+ */
+constexpr sos<1> hpf(double f, double q_factor)
+{
+    sos<1> filter{};
+    detail::section(filter.coeffs, detail::HIGH_PASS, dsp_constexpr::tan(dsp_constexpr::pi * f), q_factor, 1);
+    return filter;
+}
+
+/**
+ * Notch section with the zeros on the unit circle, as dsps_biquad_gen_notch_f32() with
+ * -INFINITY gain
+ *
+ * @param[in] f: notch frequency (0 < f < 0.5)
+ * @param[in] q_factor: Q factor
+ */
+constexpr sos<1> notch(double f, double q_factor)
+{
+    sos<1> filter{};
+    detail::section(filter.coeffs, detail::NOTCH, dsp_constexpr::tan(dsp_constexpr::pi * f), q_factor, 1);
+    return filter;
+}
+
+/**
+ * Butterworth low pass filter of even Order, Order / 2 sections
+ *
+ * @param[in] f: cut-off (-3 dB) frequency (0 < f < 0.5)
+ */
+template <int Order>
+constexpr sos<Order / 2> butterworth_lpf(double f)
+{
+    return detail::butterworth<Order>(detail::LOW_PASS, f);
+}
+
+/**
+ * Butterworth high pass filter of even Order, Order / 2 sections
+ *
+ * @param[in] f: cut-off (-3 dB) frequency (0 < f < 0.5)
+ */
+template <int Order>
+constexpr sos<Order / 2> butterworth_hpf(double f)
+{
+    return detail::butterworth<Order>(detail::HIGH_PASS, f);
+}
+
+/**
+ * Chebyshev type I low pass filter of even Order, Order / 2 sections
+ *
+ * @param[in] f: edge of the pass band (gain -ripple_db) (0 < f < 0.5)
+ * @param[in] ripple_db: pass band ripple in dB
+ */
+template <int Order>
+constexpr sos<Order / 2> chebyshev1_lpf(double f, double ripple_db)
+{
+    return detail::chebyshev1<Order>(detail::LOW_PASS, f, ripple_db);
+}
+
+/**
+ * Chebyshev type I high pass filter of even Order, Order / 2 sections
+ *
+ * @param[in] f: edge of the pass band (gain -ripple_db) (0 < f < 0.5)
+ * @param[in] ripple_db: pass band ripple in dB
+ */
+template <int Order>
+constexpr sos<Order / 2> chebyshev1_hpf(double f, double ripple_db)
+{
+    return detail::chebyshev1<Order>(detail::HIGH_PASS, f, ripple_db);
+}
+
+} // namespace dsps_design
+
+#endif // _dsps_biquad_design_H_
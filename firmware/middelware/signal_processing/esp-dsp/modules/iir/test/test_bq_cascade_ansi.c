@@ -0,0 +1,155 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "dsp_common.h"
+#include "esp_log.h"
+
+#include "dsps_tone_gen.h"
+#include "dsps_d_gen.h"
+#include "dsps_biquad_gen.h"
+#include "dsps_biquad.h"
+
+static const char *TAG = "dsps_biquad_cascade_ansi";
+
+// 8th order Butterworth low pass, cut-off frequency 0.1
+#define BQ_SECTIONS 4
+static const float bq_q[BQ_SECTIONS] = {2.5629154f, 0.8999762f, 0.6013449f, 0.5097956f};
+static const int bq_len = 1024;
+
+static void test_bq_cascade_gen(float *coeffs, int32_t *coeffs_q30)
+{
+    for (int k = 0 ; k < BQ_SECTIONS ; k++) {
+        dsps_biquad_gen_lpf_f32(&coeffs[5 * k], 0.1, bq_q[k]);
+        for (int j = 0 ; j < 5 ; j++) {
+            coeffs_q30[5 * k + j] = lroundf(coeffs[5 * k + j] * (1 << 30));
+        }
+    }
+}
+
+TEST_CASE("dsps_biquad_cascade_f32_ansi functionality", "[dsps]")
+{
+    float *x = calloc(bq_len, sizeof(float));
+    float *y = calloc(bq_len, sizeof(float));
+    float *z = calloc(bq_len, sizeof(float));
+
+    float coeffs[5 * BQ_SECTIONS];
+    int32_t coeffs_q30[5 * BQ_SECTIONS];
+    float w1[2 * BQ_SECTIONS] = {0};
+    float w2[2 * BQ_SECTIONS] = {0};
+    test_bq_cascade_gen(coeffs, coeffs_q30);
+    dsps_tone_gen_f32(x, bq_len, 0.5, 0.05, 0);
+
+    // Reference: one dsps_biquad_f32_ansi pass per section
+    dsps_biquad_f32_ansi(x, z, bq_len, &coeffs[0], &w1[0]);
+    for (int k = 1 ; k < BQ_SECTIONS ; k++) {
+        dsps_biquad_f32_ansi(z, z, bq_len, &coeffs[5 * k], &w1[2 * k]);
+    }
+    dsps_biquad_cascade_f32_ansi(x, y, bq_len, BQ_SECTIONS, coeffs, w2);
+
+    for (int i = 0 ; i < bq_len ; i++) {
+        if (fabsf(y[i] - z[i]) > 1e-6) {
+            ESP_LOGE(TAG, "[%i]calc = %f, expected=%f", i, y[i], z[i]);
+            TEST_ASSERT_MESSAGE (false, "Cascade differs from dsps_biquad_f32_ansi chain");
+        }
+    }
+    for (int k = 0 ; k < 2 * BQ_SECTIONS ; k++) {
+        TEST_ASSERT_EQUAL_FLOAT(w1[k], w2[k]);
+    }
+    free(x);
+    free(y);
+    free(z);
+}
+
+TEST_CASE("dsps_biquad_cascade_s32_ansi functionality", "[dsps]")
+{
+    float *x = calloc(bq_len, sizeof(float));
+    float *z = calloc(bq_len, sizeof(float));
+    int32_t *x_q31 = calloc(bq_len, sizeof(int32_t));
+    int32_t *y_q31 = calloc(bq_len, sizeof(int32_t));
+
+    float coeffs[5 * BQ_SECTIONS];
+    int32_t coeffs_q30[5 * BQ_SECTIONS];
+    float w1[2 * BQ_SECTIONS] = {0};
+    int32_t w2[2 * (BQ_SECTIONS + 1)] = {0};
+    test_bq_cascade_gen(coeffs, coeffs_q30);
+    dsps_tone_gen_f32(x, bq_len, 0.5, 0.05, 0);
+    for (int i = 0 ; i < bq_len ; i++) {
+        x_q31[i] = lroundf(x[i] * INT32_MAX);
+    }
+
+    dsps_biquad_cascade_f32_ansi(x, z, bq_len, BQ_SECTIONS, coeffs, w1);
+    dsps_biquad_cascade_s32_ansi(x_q31, y_q31, bq_len, BQ_SECTIONS, coeffs_q30, w2);
+
+    float max_error = 0;
+    for (int i = 0 ; i < bq_len ; i++) {
+        max_error = fmaxf(max_error, fabsf(y_q31[i] / (float)INT32_MAX - z[i]));
+    }
+    ESP_LOGI(TAG, "Q31 cascade max error = %e", max_error);
+    TEST_ASSERT_LESS_THAN_FLOAT(1e-4, max_error);
+    free(x);
+    free(z);
+    free(x_q31);
+    free(y_q31);
+}
+
+TEST_CASE("dsps_biquad_cascade_ansi benchmark", "[dsps]")
+{
+    float *x = calloc(bq_len, sizeof(float));
+    float *y = calloc(bq_len, sizeof(float));
+    int32_t *x_q31 = calloc(bq_len, sizeof(int32_t));
+    int32_t *y_q31 = calloc(bq_len, sizeof(int32_t));
+
+    float coeffs[5 * BQ_SECTIONS];
+    int32_t coeffs_q30[5 * BQ_SECTIONS];
+    float w[2 * BQ_SECTIONS] = {0};
+    int32_t w_q31[2 * (BQ_SECTIONS + 1)] = {0};
+    int repeat_count = 16;
+    test_bq_cascade_gen(coeffs, coeffs_q30);
+    dsps_d_gen_f32(x, bq_len, 0);
+
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    for (int i = 0 ; i < repeat_count ; i++) {
+        for (int k = 0 ; k < BQ_SECTIONS ; k++) {
+            dsps_biquad_f32(k == 0 ? x : y, y, bq_len, &coeffs[5 * k], &w[2 * k]);
+        }
+    }
+    unsigned int end_b = dsp_get_cpu_cycle_count();
+    float cycles_chain = (float)(end_b - start_b) / (bq_len * repeat_count);
+
+    start_b = dsp_get_cpu_cycle_count();
+    for (int i = 0 ; i < repeat_count ; i++) {
+        dsps_biquad_cascade_f32_ansi(x, y, bq_len, BQ_SECTIONS, coeffs, w);
+    }
+    end_b = dsp_get_cpu_cycle_count();
+    float cycles_f32 = (float)(end_b - start_b) / (bq_len * repeat_count);
+
+    start_b = dsp_get_cpu_cycle_count();
+    for (int i = 0 ; i < repeat_count ; i++) {
+        dsps_biquad_cascade_s32_ansi(x_q31, y_q31, bq_len, BQ_SECTIONS, coeffs_q30, w_q31);
+    }
+    end_b = dsp_get_cpu_cycle_count();
+    float cycles_s32 = (float)(end_b - start_b) / (bq_len * repeat_count);
+
+    ESP_LOGI(TAG, "8th order, %i x dsps_biquad_f32 - %f per sample", BQ_SECTIONS, cycles_chain);
+    ESP_LOGI(TAG, "8th order, dsps_biquad_cascade_f32_ansi - %f per sample", cycles_f32);
+    ESP_LOGI(TAG, "8th order, dsps_biquad_cascade_s32_ansi - %f per sample", cycles_s32);
+    free(x);
+    free(y);
+    free(x_q31);
+    free(y_q31);
+}
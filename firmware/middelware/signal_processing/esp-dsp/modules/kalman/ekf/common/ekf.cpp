@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "ekf.h"
+#include "mat_decomp.h"
 #include <float.h>
 
 ekf::ekf(int x, int w) : NUMX(x),
@@ -137,12 +138,10 @@ dspm::Mat ekf::qProduct(float *q)
 
 void ekf::CovariancePrediction(float dt)
 {
-    dspm::Mat f = this->F * dt;
+    dspm::Mat f = this->F * dt + dspm::Mat::eye(this->NUMX);
 
-    f = f + dspm::Mat::eye(this->NUMX);
-
-    dspm::Mat f_t = f.t();
-    this->P = ((f * this->P) * f_t) + (dt * dt) * ((G * Q) * G.t());
+    // Single pass, the transposes are read in place (see mat_expr.h)
+    this->P = f * this->P * f.t() + (dt * dt) * (G * Q * G.t());
 }
 
 void ekf::Update(dspm::Mat &H, float *measured, float *expected, float *R)
@@ -193,7 +192,9 @@ void ekf::UpdateRef(dspm::Mat &H, float *measured, float *expected, float *R)
         S(i, i) += R[i];
     }
 
-    dspm::Mat S_ = S.pinv(); // 1 / S
+    // S is a covariance (symmetric positive definite): Cholesky, general inverse if rounding broke it
+    dspm::MatCholesky S_chol(S);
+    dspm::Mat S_ = S_chol.valid ? S_chol.inverse() : S.pinv(); // 1 / S
 
     dspm::Mat K = (P * h_t) * S_;
     this->P = (dspm::Mat::eye(this->NUMX) - K * H) * P;
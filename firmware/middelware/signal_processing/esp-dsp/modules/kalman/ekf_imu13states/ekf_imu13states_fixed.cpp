@@ -0,0 +1,390 @@
+// Copyright 2018-2023 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include "ekf_imu13states_fixed.h"
+
+// Columns of the non zero elements of each row.
+// Integer test of the bits (+0 and -0 are zero), no float compare on the CPUs without FPU
+static void NonZeros(const float *m, int rows, int cols, uint8_t *col_idx, uint8_t *count)
+{
+    for (int i = 0; i < rows; i++) {
+        count[i] = 0;
+        for (int j = 0; j < cols; j++) {
+            uint32_t bits;
+            memcpy(&bits, &m[i * cols + j], sizeof(bits));
+            if ((bits << 1) != 0) {
+                col_idx[i * cols + count[i]++] = j;
+            }
+        }
+    }
+}
+
+// Transposed rotation matrix of quaternion q (ekf::quat2rotm(q).t())
+static void Quat2RotmT(const float *q, float *Rt)
+{
+    float q0 = q[0];
+    float q1 = q[1];
+    float q2 = q[2];
+    float q3 = q[3];
+
+    Rt[0] = q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3;
+    Rt[1] = 2.0f * (q1 * q2 + q0 * q3);
+    Rt[2] = 2.0f * (q1 * q3 - q0 * q2);
+    Rt[3] = 2.0f * (q1 * q2 - q0 * q3);
+    Rt[4] = (q0 * q0 - q1 * q1 + q2 * q2 - q3 * q3);
+    Rt[5] = 2.0f * (q2 * q3 + q0 * q1);
+    Rt[6] = 2.0f * (q1 * q3 + q0 * q2);
+    Rt[7] = 2.0f * (q2 * q3 - q0 * q1);
+    Rt[8] = (q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3);
+}
+
+// Derivative of vector v by inverted quaternion q (ekf::dFdq_inv()), 3x4 block of a matrix with stride cols
+static void DFdqInv(const float *v, const float *q, float *result, int stride)
+{
+    float *r0 = &result[0];
+    float *r1 = &result[stride];
+    float *r2 = &result[2 * stride];
+    r0[0] = 2 * (q[0] * v[0] + q[3] * v[1] - q[2] * v[2]);
+    r0[1] = 2 * (q[1] * v[0] + q[2] * v[1] + q[3] * v[2]);
+    r0[2] = 2 * (-q[2] * v[0] + q[1] * v[1] - q[0] * v[2]);
+    r0[3] = 2 * (-q[3] * v[0] + q[0] * v[1] + q[1] * v[2]);
+
+    r1[0] = 2 * (-q[3] * v[0] + q[0] * v[1] + q[1] * v[2]);
+    r1[1] = 2 * (q[2] * v[0] - q[1] * v[1] + q[0] * v[2]);
+    r1[2] = 2 * (q[1] * v[0] + q[2] * v[1] + q[3] * v[2]);
+    r1[3] = 2 * (-q[0] * v[0] - q[3] * v[1] + q[2] * v[2]);
+
+    r2[0] = 2 * (q[2] * v[0] - q[1] * v[1] + q[0] * v[2]);
+    r2[1] = 2 * (q[3] * v[0] - q[0] * v[1] - q[1] * v[2]);
+    r2[2] = 2 * (q[0] * v[0] + q[3] * v[1] - q[2] * v[2]);
+    r2[3] = 2 * (q[1] * v[0] + q[2] * v[1] + q[3] * v[2]);
+}
+
+ekf_imu13states_fixed::ekf_imu13states_fixed()
+{
+    this->X(0, 0) = 1; // direction to 0
+    NonZeros(this->F.data, NUMX, NUMX, &this->F_cols[0][0], this->F_count);
+    NonZeros(this->G.data, NUMX, NUMW, &this->G_cols[0][0], this->G_count);
+}
+
+void ekf_imu13states_fixed::Init()
+{
+    mag0(0, 0) = 1;
+    mag0(1, 0) = 0;
+    mag0(2, 0) = 0;
+
+    accel0(0, 0) = 0;
+    accel0(1, 0) = 0;
+    accel0(2, 0) = 1;
+
+    const float q_diag[NUMW / 3] = {0.1, 0.0001, 0.0001, 0.0001, 0.00001, 0.00001};
+    for (int i = 0; i < NUMW; i++) {
+        this->Q(i, i) = q_diag[i / 3];
+    }
+
+    this->X(0, 0) = 1; // Init quaternion
+    this->X(7, 0) = 1; // Initial magnetometer vector
+}
+
+void ekf_imu13states_fixed::Process(float *u, float dt)
+{
+    LinearizeFG(u);
+    RungeKutta(u, dt);
+    CovariancePrediction(dt);
+}
+
+void ekf_imu13states_fixed::StateXdot(const float *x, const float *u, float *xdot)
+{
+    float wx = u[0] - x[4]; // subtract the biases on gyros
+    float wy = u[1] - x[5];
+    float wz = u[2] - x[6];
+
+    // qdot = 0.5 * SkewSym4x4(w) * q
+    xdot[0] = 0.5f * (-wx * x[1] - wy * x[2] - wz * x[3]);
+    xdot[1] = 0.5f * (wx * x[0] + wz * x[2] - wy * x[3]);
+    xdot[2] = 0.5f * (wy * x[0] - wz * x[1] + wx * x[3]);
+    xdot[3] = 0.5f * (wz * x[0] + wy * x[1] - wx * x[2]);
+    // dwbias = 0
+    // dMang_Ampl = 0
+    // dMang_offset = 0
+    for (int i = 4; i < NUMX; i++) {
+        xdot[i] = 0;
+    }
+}
+
+void ekf_imu13states_fixed::LinearizeFG(const float *u)
+{
+    const float *x = this->X.data;
+    float w[3] = {(u[0] - x[4]), (u[1] - x[5]), (u[2] - x[6])}; // subtract the biases on gyros
+
+    this->F.clear();
+    this->G.clear();
+
+    // dqdot / dq - 0.5 * skew matrix
+    F(0, 1) = -0.5f * w[0];
+    F(0, 2) = -0.5f * w[1];
+    F(0, 3) = -0.5f * w[2];
+    F(1, 0) = 0.5f * w[0];
+    F(1, 2) = 0.5f * w[2];
+    F(1, 3) = -0.5f * w[1];
+    F(2, 0) = 0.5f * w[1];
+    F(2, 1) = -0.5f * w[2];
+    F(2, 3) = 0.5f * w[0];
+    F(3, 0) = 0.5f * w[2];
+    F(3, 1) = 0.5f * w[1];
+    F(3, 2) = -0.5f * w[0];
+
+    // dqdot / dnw and dqdot / dwbias: -0.5 * qProduct(q) without the first column
+    const float dq_q[4][3] = {
+        { 0.5f * x[1],  0.5f * x[2],  0.5f * x[3]},
+        {-0.5f * x[0],  0.5f * x[3], -0.5f * x[2]},
+        {-0.5f * x[3], -0.5f * x[0],  0.5f * x[1]},
+        { 0.5f * x[2], -0.5f * x[1], -0.5f * x[0]},
+    };
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 3; j++) {
+            G(i, j) = dq_q[i][j];
+            F(i, j + 4) = dq_q[i][j];
+        }
+    }
+
+    // -rotation matrix of the attitude
+    float Rt[9];
+    Quat2RotmT(x, Rt);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            G(7 + i, 6 + j) = -Rt[j * 3 + i];
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        G(4 + i, 3 + i) = 1;    // random noise wbias
+        G(7 + i, 12 + i) = 1;   // random noise magnetometer amplitude
+        G(10 + i, 9 + i) = 1;   // magnetometer offset constant
+        G(10 + i, 15 + i) = 1;  // random noise offset constant
+    }
+
+    NonZeros(this->F.data, NUMX, NUMX, &this->F_cols[0][0], this->F_count);
+    NonZeros(this->G.data, NUMX, NUMW, &this->G_cols[0][0], this->G_count);
+}
+
+void ekf_imu13states_fixed::RungeKutta(const float *u, float dt)
+{
+    float dt2 = dt / 2.0f;
+    float *x = this->X.data;
+
+    this->Xlast = this->X;
+    StateXdot(x, u, this->K1.data); // k1 = f(x, u)
+    for (int i = 0; i < NUMX; i++) {
+        x[i] = this->Xlast.data[i] + this->K1.data[i] * dt2;
+    }
+    StateXdot(x, u, this->K2.data); // k2 = f(x + 0.5*dT*k1, u)
+    for (int i = 0; i < NUMX; i++) {
+        x[i] = this->Xlast.data[i] + this->K2.data[i] * dt2;
+    }
+    StateXdot(x, u, this->K3.data); // k3 = f(x + 0.5*dT*k2, u)
+    for (int i = 0; i < NUMX; i++) {
+        x[i] = this->Xlast.data[i] + this->K3.data[i] * dt;
+    }
+    StateXdot(x, u, this->K4.data); // k4 = f(x + dT * k3, u)
+
+    // Xnew = X + dT * (k1 + 2 * k2 + 2 * k3 + k4) / 6
+    float dt6 = dt / 6.0f;
+    for (int i = 0; i < NUMX; i++) {
+        x[i] = this->Xlast.data[i] + (this->K1.data[i] + 2.0f * this->K2.data[i] + 2.0f * this->K3.data[i] + this->K4.data[i]) * dt6;
+    }
+}
+
+void ekf_imu13states_fixed::CovariancePrediction(float dt)
+{
+    // P = f * P * f' + dt^2 * G * Q * G', with f = I + F * dt
+
+    // FP = f * P = P + dt * F * P
+    this->FP = this->P;
+    for (int i = 0; i < NUMX; i++) {
+        float *fp_i = &this->FP.data[i * NUMX];
+        for (int n = 0; n < this->F_count[i]; n++) {
+            int k = this->F_cols[i][n];
+            float f = dt * this->F(i, k);
+            const float *p_k = &this->P.data[k * NUMX];
+            for (int j = 0; j < NUMX; j++) {
+                fp_i[j] += f * p_k[j];
+            }
+        }
+    }
+
+    // GQ = G * Q, Q is usually diagonal
+    NonZeros(this->Q.data, NUMW, NUMW, &this->Q_cols[0][0], this->Q_count);
+    this->GQ.clear();
+    for (int i = 0; i < NUMX; i++) {
+        float *gq_i = &this->GQ.data[i * NUMW];
+        for (int n = 0; n < this->G_count[i]; n++) {
+            int k = this->G_cols[i][n];
+            float g = this->G(i, k);
+            for (int l = 0; l < this->Q_count[k]; l++) {
+                int j = this->Q_cols[k][l];
+                gq_i[j] += g * this->Q(k, j);
+            }
+        }
+    }
+
+    // P = FP * f' + dt^2 * GQ * G', upper triangle mirrored to the lower one
+    float dt_2 = dt * dt;
+    for (int i = 0; i < NUMX; i++) {
+        const float *fp_i = &this->FP.data[i * NUMX];
+        const float *gq_i = &this->GQ.data[i * NUMW];
+        for (int j = i; j < NUMX; j++) {
+            float fpf = 0;
+            for (int n = 0; n < this->F_count[j]; n++) {
+                int k = this->F_cols[j][n];
+                fpf += fp_i[k] * this->F(j, k);
+            }
+            float gqg = 0;
+            for (int n = 0; n < this->G_count[j]; n++) {
+                int k = this->G_cols[j][n];
+                gqg += gq_i[k] * this->G(j, k);
+            }
+            this->P(i, j) = this->P(j, i) = fp_i[j] + dt * fpf + dt_2 * gqg;
+        }
+    }
+}
+
+void ekf_imu13states_fixed::Update(int rows, const float *measured, const float *expected, const float *R)
+{
+    NonZeros(this->H.data, rows, NUMX, &this->H_cols[0][0], this->H_count);
+    for (int m = 0; m < rows; m++) {
+        // HP = H * P
+        for (int j = 0; j < NUMX; j++) {
+            HP[j] = 0;
+        }
+        for (int n = 0; n < this->H_count[m]; n++) {
+            int k = this->H_cols[m][n];
+            float h = this->H(m, k);
+            const float *p_k = &this->P.data[k * NUMX];
+            for (int j = 0; j < NUMX; j++) {
+                HP[j] += h * p_k[j];
+            }
+        }
+        float HPHR = R[m]; // Find  HPHR = H*P*H' + R
+        for (int n = 0; n < this->H_count[m]; n++) {
+            int k = this->H_cols[m][n];
+            HPHR += HP[k] * this->H(m, k);
+        }
+        float invHPHR = 1.0f / HPHR;
+        for (int k = 0; k < NUMX; k++) {
+            Km[k] = HP[k] * invHPHR; // find K = HP/HPHR
+        }
+        for (int i = 0; i < NUMX; i++) {
+            // Find P(m)= P(m-1) + K*HP
+            for (int j = i; j < NUMX; j++) {
+                P(i, j) = P(j, i) = P(i, j) - Km[i] * HP[j];
+            }
+        }
+
+        float Error = measured[m] - expected[m];
+        for (int i = 0; i < NUMX; i++) {
+            // Find X(m)= X(m-1) + K*Error
+            X(i, 0) = X(i, 0) + Km[i] * Error;
+        }
+    }
+}
+
+void ekf_imu13states_fixed::ReferenceRows(const float *accel_data, const float *magn_data, float *measured, float *expected)
+{
+    const float *quat = this->X.data;
+    const float *magn = &this->X.data[7];
+    const float *magn_offset = &this->X.data[10];
+    Quat2RotmT(quat, this->Re.data);
+
+    // dMagn/dq
+    DFdqInv(magn, quat, &this->H(0, 0), NUMX);
+    // dAccel/dq
+    DFdqInv(this->accel0.data, quat, &this->H(3, 0), NUMX);
+
+    for (int i = 0; i < 3; i++) {
+        float expected_magn = magn_offset[i];
+        float expected_accel = 0;
+        for (int k = 0; k < 3; k++) {
+            expected_magn += this->Re(i, k) * magn[k];
+            expected_accel += this->Re(i, k) * this->accel0.data[k];
+        }
+        measured[i] = magn_data[i];
+        expected[i] = expected_magn;
+        measured[i + 3] = accel_data[i];
+        expected[i + 3] = expected_accel;
+    }
+}
+
+static void NormalizeQuat(float *q)
+{
+    float norm = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (int i = 0; i < 4; i++) {
+        q[i] /= norm;
+    }
+}
+
+void ekf_imu13states_fixed::UpdateRefMeasurement(float *accel_data, float *magn_data, float R[6])
+{
+    float measured_data[6];
+    float expected_data[6];
+    this->H.clear();
+    ReferenceRows(accel_data, magn_data, measured_data, expected_data);
+
+    Update(6, measured_data, expected_data, R);
+    NormalizeQuat(this->X.data);
+}
+
+void ekf_imu13states_fixed::UpdateRefMeasurementMagn(float *accel_data, float *magn_data, float R[6])
+{
+    float measured_data[6];
+    float expected_data[6];
+    this->H.clear();
+    ReferenceRows(accel_data, magn_data, measured_data, expected_data);
+
+    // We include these two blocks to update magnetometer initial state
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            this->H(i, 7 + j) = this->Re(i, j);
+        }
+        this->H(i, 10 + i) = 1;
+    }
+
+    Update(6, measured_data, expected_data, R);
+    NormalizeQuat(this->X.data);
+}
+
+void ekf_imu13states_fixed::UpdateRefMeasurement(float *accel_data, float *magn_data, float *attitude, float R[10])
+{
+    float measured_data[10];
+    float expected_data[10];
+    this->H.clear();
+    ReferenceRows(accel_data, magn_data, measured_data, expected_data);
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            this->H(i, 7 + j) = this->Re(i, j);
+        }
+        this->H(i, 10 + i) = 1;
+    }
+    // dq/dq, same columns as ekf_imu13states
+    for (int i = 0; i < 4; i++) {
+        this->H(6 + i, 1 + i) = 1;
+        measured_data[i + 6] = attitude[i];
+        expected_data[i + 6] = this->X.data[i];
+    }
+
+    Update(10, measured_data, expected_data, R);
+    NormalizeQuat(this->X.data);
+}
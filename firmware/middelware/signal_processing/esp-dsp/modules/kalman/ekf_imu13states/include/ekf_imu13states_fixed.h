@@ -0,0 +1,129 @@
+// Copyright 2018-2023 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _ekf_imu13states_fixed_H_
+#define _ekf_imu13states_fixed_H_
+
+#include <stdint.h>
+#include "mat_fixed.h"
+
+/**
+* @brief Allocation-free version of ekf_imu13states.
+*
+*   Same 13 states, inputs, noise model and results as ekf_imu13states, with every matrix
+*   (states, system, covariance and work matrices) of fixed size inside the object: the filter
+*   may be a static object and Process()/Update*() never use the heap.
+*
+*   Faster processing for the CPUs without FPU (ESP32-C6):
+*   - F, G, Q and H are mostly zeros: products only go through their non zero elements
+*   - P is symmetric: only the upper triangle is computed and it is mirrored
+*
+*   X[0..3] - attitude quaternion
+*   X[4..6] - gyroscope bias error, rad/sec
+*   X[7..9] - magnetometer vector value - magn_ampl
+*   X[10..12] - magnetometer offset value - magn_offset
+*/
+class ekf_imu13states_fixed {
+public:
+    static const int NUMX = 13;     /*!< Number of states*/
+    static const int NUMW = 18;     /*!< Number of control measurements and noise inputs*/
+    static const int NUMU = 3;      /*!< Number of control measurements*/
+    static const int NUMZ = 10;     /*!< Max number of reference measurements in an update*/
+
+    ekf_imu13states_fixed();
+
+    /**
+     * Initialization of the filter, same values as ekf_imu13states::Init().
+     * The method should be called before the first use of the filter.
+    */
+    void Init();
+
+    /**
+     * Main processing method of the filter.
+     *
+     * @param[in] u: gyroscope values in radian per seconds (rad/sec)
+     * @param[in] dt: time difference from the last call in seconds
+    */
+    void Process(float *u, float dt);
+
+    /**
+     * Update attitude and gyro bias by reference measurements accelerometer and magnetometer.
+     * See ekf_imu13states::UpdateRefMeasurement().
+     *
+     * @param[in] accel_data: accelerometer measurement vector XYZ in g, where 1 g ~ 9.81 m/s^2
+     * @param[in] magn_data: magnetometer measurement vector XYZ
+     * @param[in] R: measurement noise covariance values for diagonal covariance matrix
+     */
+    void UpdateRefMeasurement(float *accel_data, float *magn_data, float R[6]);
+    /**
+     * Update full system state by reference measurements accelerometer and magnetometer.
+     * See ekf_imu13states::UpdateRefMeasurementMagn().
+     *
+     * @param[in] accel_data: accelerometer measurement vector XYZ in g, where 1 g ~ 9.81 m/s^2
+     * @param[in] magn_data: magnetometer measurement vector XYZ
+     * @param[in] R: measurement noise covariance values for diagonal covariance matrix
+     */
+    void UpdateRefMeasurementMagn(float *accel_data, float *magn_data, float R[6]);
+    /**
+     * Update system state by reference measurements accelerometer, magnetometer and attitude quaternion.
+     * See ekf_imu13states::UpdateRefMeasurement().
+     *
+     * @param[in] accel_data: accelerometer measurement vector XYZ in g, where 1 g ~ 9.81 m/s^2
+     * @param[in] magn_data: magnetometer measurement vector XYZ
+     * @param[in] attitude: attitude quaternion
+     * @param[in] R: measurement noise covariance values for diagonal covariance matrix
+     */
+    void UpdateRefMeasurement(float *accel_data, float *magn_data, float *attitude, float R[10]);
+
+    dspm::MatFixed<NUMX, 1> X;          /*!< System state vector*/
+    dspm::MatFixed<NUMX, NUMX> F;       /*!< Linearized system matrix F, where x[n] = F*x[n-1] + G*u + W*/
+    dspm::MatFixed<NUMX, NUMW> G;       /*!< Linearized system matrix G, where x[n] = F*x[n-1] + G*u + W*/
+    dspm::MatFixed<NUMX, NUMX> P;       /*!< Covariance matrix*/
+    dspm::MatFixed<NUMW, NUMW> Q;       /*!< Input noise and measurement noise variances*/
+    dspm::MatFixed<3, 1> mag0;          /*!< Initial reference value for magnetometer*/
+    dspm::MatFixed<3, 1> accel0;        /*!< Initial reference value for accelerometer*/
+
+private:
+    void StateXdot(const float *x, const float *u, float *xdot);
+    void LinearizeFG(const float *u);
+    void RungeKutta(const float *u, float dt);
+    void CovariancePrediction(float dt);
+    void Update(int rows, const float *measured, const float *expected, const float *R);
+    void ReferenceRows(const float *accel_data, const float *magn_data, float *measured, float *expected);
+
+    // Work matrices
+    dspm::MatFixed<NUMX, 1> Xlast;
+    dspm::MatFixed<NUMX, 1> K1;
+    dspm::MatFixed<NUMX, 1> K2;
+    dspm::MatFixed<NUMX, 1> K3;
+    dspm::MatFixed<NUMX, 1> K4;
+    dspm::MatFixed<NUMX, NUMX> FP;      // (I + F*dt) * P
+    dspm::MatFixed<NUMX, NUMW> GQ;      // G * Q
+    dspm::MatFixed<NUMZ, NUMX> H;       // Measurement derivatives
+    dspm::MatFixed<3, 3> Re;            // Transposed rotation matrix of the attitude
+    float HP[NUMX];
+    float Km[NUMX];
+
+    // Columns of the non zero elements of each row of F, G, Q and H
+    uint8_t F_cols[NUMX][NUMX];
+    uint8_t F_count[NUMX];
+    uint8_t G_cols[NUMX][NUMW];
+    uint8_t G_count[NUMX];
+    uint8_t Q_cols[NUMW][NUMW];
+    uint8_t Q_count[NUMW];
+    uint8_t H_cols[NUMZ][NUMX];
+    uint8_t H_count[NUMZ];
+};
+
+#endif // _ekf_imu13states_fixed_H_
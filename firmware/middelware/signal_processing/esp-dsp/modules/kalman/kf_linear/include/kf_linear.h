@@ -0,0 +1,357 @@
+// Copyright 2018-2023 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _kf_linear_H_
+#define _kf_linear_H_
+
+#include <stdint.h>
+#include <math.h>
+
+/**
+* @brief Linear Kalman filter of a kinematic model with N = 1..3 states, header only.
+*
+*   The states are a measured value and its derivatives, the measurement is the first state:
+*   - N = 1: random walk, x = [value], process_noise in units^2/s
+*   - N = 2: constant velocity, x = [value, rate], process_noise (acceleration) in units^2/s^3
+*   - N = 3: constant acceleration, x = [value, rate, acceleration], process_noise (jerk) in units^2/s^5
+*
+*   x[n] = F*x[n-1] + w, z[n] = x0[n] + v, with F = exp(A*dt) of the integrator chain A and the
+*   covariance Q of w from a white noise on the last derivative. Every matrix is of fixed size
+*   inside the object (no heap), the measurement is a scalar (no inversion) and the 1 and 2
+*   states cases have closed form Predict()/Update().
+*/
+template <int N>
+class kf_linear {
+public:
+    static const int NUMX = N;          /*!< Number of states*/
+
+    kf_linear()
+    {
+        Init(1, 0, 1);
+    }
+
+    /**
+     * Set the model and reset the states to 0.
+     *
+     * @param[in] dt: time between measurements in seconds
+     * @param[in] process_noise: spectral density of the white noise on the last derivative
+     * @param[in] measurement_noise: variance of the measurements (units^2)
+    */
+    void Init(float dt, float process_noise, float measurement_noise)
+    {
+        static const float factorial[3] = {1, 1, 2};
+        this->dt = dt;
+        this->R = measurement_noise;
+        for (int i = 0; i < N; i++) {
+            this->F[i] = powf(dt, i) / factorial[i];
+        }
+        // Q(i, j) = q * dt^(2N-1-i-j) / ((N-1-i)! * (N-1-j)! * (2N-1-i-j))
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < N; j++) {
+                int k = 2 * N - 1 - i - j;
+                this->Q[i][j] = process_noise * powf(dt, k) / (factorial[N - 1 - i] * factorial[N - 1 - j] * k);
+            }
+        }
+        Reset(0);
+    }
+
+    /**
+     * Reset the states: x = [x0, 0, ...], with a large covariance (1000 * R) so that the first
+     * measurements set the states.
+     *
+     * @param[in] x0: first state value
+    */
+    void Reset(float x0)
+    {
+        for (int i = 0; i < N; i++) {
+            this->x[i] = 0;
+            this->K[i] = 0;
+            for (int j = 0; j < N; j++) {
+                this->P[i][j] = (i == j) ? 1000 * this->R : 0;
+            }
+        }
+        this->x[0] = x0;
+    }
+
+    /**
+     * Prediction: x = F*x, P = F*P*F' + Q
+    */
+    void Predict()
+    {
+        float FP[N][N];
+        for (int i = 0; i < N; i++) {
+            float xi = 0;
+            for (int k = i; k < N; k++) {
+                xi += this->F[k - i] * this->x[k];
+            }
+            this->x[i] = xi;
+            for (int j = 0; j < N; j++) {
+                float fp = 0;
+                for (int k = i; k < N; k++) {
+                    fp += this->F[k - i] * this->P[k][j];
+                }
+                FP[i][j] = fp;
+            }
+        }
+        for (int i = 0; i < N; i++) {
+            for (int j = i; j < N; j++) {
+                float p = this->Q[i][j];
+                for (int k = j; k < N; k++) {
+                    p += FP[i][k] * this->F[k - j];
+                }
+                this->P[i][j] = this->P[j][i] = p;
+            }
+        }
+    }
+
+    /**
+     * Correction with a measurement of the first state.
+     *
+     * @param[in] z: measurement
+    */
+    void Update(float z)
+    {
+        float inv_s = 1 / (this->P[0][0] + this->R);
+        float hp[N];
+        for (int i = 0; i < N; i++) {
+            hp[i] = this->P[0][i];
+            this->K[i] = hp[i] * inv_s;
+        }
+        float e = z - this->x[0];
+        for (int i = 0; i < N; i++) {
+            this->x[i] += this->K[i] * e;
+            for (int j = i; j < N; j++) {
+                this->P[i][j] = this->P[j][i] = this->P[i][j] - this->K[i] * hp[j];
+            }
+        }
+    }
+
+    /**
+     * Predict() and Update() with the next measurement.
+     *
+     * @param[in] z: measurement
+     *
+     * @return
+     *      - filtered value (first state)
+    */
+    float Filter(float z)
+    {
+        Predict();
+        Update(z);
+        return this->x[0];
+    }
+
+    /**
+     * Gain of the filter once the covariance has converged, the same for all the measurements
+     * of a constant dt. The filter itself is not modified.
+     *
+     * @param[out] gain: steady state gain K of each state
+     *
+     * @return
+     *      - true if the gain converged
+     *      - false otherwise (no process noise)
+    */
+    bool SteadyStateGain(float *gain) const
+    {
+        kf_linear<N> kf = *this;
+        for (int n = 0; n < 10000; n++) {
+            float last = kf.K[0];
+            kf.Predict();
+            kf.Update(kf.x[0]);
+            if ((n > 0) && (fabsf(kf.K[0] - last) <= 1e-7f * kf.K[0])) {
+                for (int i = 0; i < N; i++) {
+                    gain[i] = kf.K[i];
+                }
+                return kf.K[0] > 0;
+            }
+        }
+        return false;
+    }
+
+    float x[N];         /*!< States: value and its derivatives*/
+    float P[N][N];      /*!< Covariance matrix*/
+    float Q[N][N];      /*!< Process noise covariance*/
+    float F[N];         /*!< dt^k/k!, first row of the upper triangular Toeplitz system matrix*/
+    float K[N];         /*!< Gain of the last update*/
+    float R;            /*!< Measurement noise variance*/
+    float dt;           /*!< Time between measurements*/
+};
+
+// Closed forms of the 1 and 2 states filters
+
+template <>
+inline void kf_linear<1>::Predict()
+{
+    this->P[0][0] += this->Q[0][0];
+}
+
+template <>
+inline void kf_linear<1>::Update(float z)
+{
+    this->K[0] = this->P[0][0] / (this->P[0][0] + this->R);
+    this->x[0] += this->K[0] * (z - this->x[0]);
+    this->P[0][0] -= this->K[0] * this->P[0][0];
+}
+
+template <>
+inline void kf_linear<2>::Predict()
+{
+    float dt = this->dt;
+    this->x[0] += dt * this->x[1];
+    float p01 = this->P[0][1] + dt * this->P[1][1];
+    this->P[0][0] += dt * (this->P[0][1] + p01) + this->Q[0][0];
+    this->P[0][1] = this->P[1][0] = p01 + this->Q[0][1];
+    this->P[1][1] += this->Q[1][1];
+}
+
+template <>
+inline void kf_linear<2>::Update(float z)
+{
+    float p00 = this->P[0][0];
+    float p01 = this->P[0][1];
+    float inv_s = 1 / (p00 + this->R);
+    this->K[0] = p00 * inv_s;
+    this->K[1] = p01 * inv_s;
+    float e = z - this->x[0];
+    this->x[0] += this->K[0] * e;
+    this->x[1] += this->K[1] * e;
+    this->P[0][0] = p00 - this->K[0] * p00;
+    this->P[0][1] = this->P[1][0] = p01 - this->K[0] * p01;
+    this->P[1][1] -= this->K[1] * p01;
+}
+
+/**
+* @brief Fixed point steady state version of kf_linear, for cores without FPU.
+*
+*   Once the covariance has converged the gain is constant: the filter is the kf_linear
+*   prediction with the steady state gain (an alpha-beta(-gamma) filter), designed in float once
+*   and run on integers. States are per measurement (value, change per measurement, ...) so the
+*   prediction is additions and shifts only, and the update is one 32x64 bit product per state.
+*   Measurements are integers (raw sensor readings, mm, cm, ...). The value has shift fractional
+*   bits (|z| * 2^shift must fit in 31 bits) and each derivative RATE_BITS more than the previous
+*   one, as its change per measurement is small.
+*/
+template <int N>
+class kf_linear_fixed {
+public:
+    static const int NUMX = N;          /*!< Number of states*/
+    static const int RATE_BITS = 8;     /*!< Extra fractional bits of each derivative*/
+
+    kf_linear_fixed()
+    {
+        this->dt = 1;
+        this->shift = 0;
+        for (int i = 0; i < N; i++) {
+            this->K[i] = 0;
+        }
+        Reset(0);
+    }
+
+    /**
+     * Take the steady state gain of a float filter and reset the states to 0.
+     *
+     * @param[in] design: float filter with the model and noises (kf_linear::Init())
+     * @param[in] shift: fractional bits of the states (0..16)
+     *
+     * @return
+     *      - true on success
+     *      - false if the gain does not converge or is out of the fixed point range
+    */
+    bool Init(const kf_linear<N> &design, int shift)
+    {
+        static const float factorial[3] = {1, 1, 2};
+        float gain[N];
+        if ((shift < 0) || (shift > 16) || !design.SteadyStateGain(gain)) {
+            return false;
+        }
+        for (int i = 0; i < N; i++) {
+            // Gain of the state per measurement, Q30
+            double k = ldexp(gain[i] * pow(design.dt, i) / factorial[i], 30);
+            if (fabs(k) >= 2147483647.0) {
+                return false;
+            }
+            this->K[i] = (int32_t)lround(k);
+        }
+        this->dt = design.dt;
+        this->shift = shift;
+        Reset(0);
+        return true;
+    }
+
+    /**
+     * Reset the states: x = [x0, 0, ...]
+     *
+     * @param[in] x0: first state value, measurement units
+    */
+    void Reset(int32_t x0)
+    {
+        for (int i = 0; i < N; i++) {
+            this->x[i] = 0;
+        }
+        this->x[0] = x0 * (1 << this->shift);
+    }
+
+    /**
+     * Prediction and correction with the next measurement.
+     *
+     * @param[in] z: measurement
+     *
+     * @return
+     *      - filtered value (first state), rounded to measurement units
+    */
+    int32_t Filter(int32_t z)
+    {
+        // x = F*x per measurement: binomial coefficients (x0 += x1 + x2, x1 += 2*x2)
+        static const int32_t binomial[3][3] = {{1, 0, 0}, {1, 1, 0}, {1, 2, 1}};
+        for (int i = 0; i < N; i++) {
+            for (int j = i + 1; j < N; j++) {
+                this->x[i] += (binomial[j][i] * this->x[j]) >> (RATE_BITS * (j - i));
+            }
+        }
+        int64_t e = (int64_t)z * (1 << this->shift) - this->x[0];
+        for (int i = 0; i < N; i++) {
+            this->x[i] += (int32_t)((this->K[i] * e) >> (30 - RATE_BITS * i));
+        }
+        return Value();
+    }
+
+    /**
+     * @return
+     *      - filtered value (first state), rounded to measurement units
+    */
+    int32_t Value() const
+    {
+        return (this->x[0] + ((1 << this->shift) >> 1)) >> this->shift;
+    }
+
+    /**
+     * States in float, units per second as kf_linear::x
+     *
+     * @param[out] state: N states
+    */
+    void GetState(float *state) const
+    {
+        static const float factorial[3] = {1, 1, 2};
+        for (int i = 0; i < N; i++) {
+            state[i] = ldexpf((float)this->x[i], -this->shift - RATE_BITS * i) * factorial[i] / powf(this->dt, i);
+        }
+    }
+
+    int32_t x[N];       /*!< States per measurement, shift + RATE_BITS * i fractional bits*/
+    int32_t K[N];       /*!< Steady state gain per measurement, Q30*/
+    int shift;          /*!< Fractional bits of the states*/
+    float dt;           /*!< Time between measurements*/
+};
+
+#endif // _kf_linear_H_
@@ -0,0 +1,55 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_add.h"
+
+esp_err_t dsps_add_f32_rv32(const float *input1, const float *input2, float *output, int len, int step1, int step2, int step_out)
+{
+    if (NULL == input1) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == input2) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == output) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    // Pointers advanced instead of indexes multiplied by the steps, 4 samples per iteration
+    int i = 0;
+    for (; i + 4 <= len ; i += 4) {
+        float x0 = input1[0];
+        float x1 = input1[step1];
+        float x2 = input1[2 * step1];
+        float x3 = input1[3 * step1];
+        float y0 = input2[0];
+        float y1 = input2[step2];
+        float y2 = input2[2 * step2];
+        float y3 = input2[3 * step2];
+        output[0] = x0 + y0;
+        output[step_out] = x1 + y1;
+        output[2 * step_out] = x2 + y2;
+        output[3 * step_out] = x3 + y3;
+        input1 += 4 * step1;
+        input2 += 4 * step2;
+        output += 4 * step_out;
+    }
+    for (; i < len ; i++) {
+        *output = *input1 + *input2;
+        input1 += step1;
+        input2 += step2;
+        output += step_out;
+    }
+    return ESP_OK;
+}
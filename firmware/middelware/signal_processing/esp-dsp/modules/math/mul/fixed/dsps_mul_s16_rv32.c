@@ -0,0 +1,68 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include "dsps_mul.h"
+#include "dsp_rv32.h"
+
+esp_err_t dsps_mul_s16_rv32(const int16_t *input1, const int16_t *input2, int16_t *output, int len, int step1, int step2, int step_out, int shift)
+{
+    if (NULL == input1) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == input2) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == output) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    int i = 0;
+    // Contiguous vectors at the same 32 bit alignment: one halfword to align them, then
+    // two samples per load and store
+    if ((step1 == 1) && (step2 == 1) && (step_out == 1) &&
+            ((((uintptr_t)input1 ^ (uintptr_t)input2) | ((uintptr_t)input1 ^ (uintptr_t)output)) & 3) == 0) {
+        if (((uintptr_t)input1 & 3) && (len > 0)) {
+            int32_t a = input1[0];
+            int32_t b = input2[0];
+            output[0] = (a * b) >> shift;
+            i = 1;
+        }
+        for (; i + 2 <= len ; i += 2) {
+            uint32_t x = dsp_rv32_load_s16x2(&input1[i]);
+            uint32_t y = dsp_rv32_load_s16x2(&input2[i]);
+            int32_t a = dsp_rv32_lo(x);
+            int32_t b = dsp_rv32_lo(y);
+            int32_t lo = (a * b) >> shift;
+            a = dsp_rv32_hi(x);
+            b = dsp_rv32_hi(y);
+            dsp_rv32_store_s16x2(&output[i], lo, (a * b) >> shift);
+        }
+    } else {
+        for (; i + 2 <= len ; i += 2) {
+            int32_t a = input1[i * step1];
+            int32_t b = input2[i * step2];
+            output[i * step_out] = (a * b) >> shift;
+            a = input1[(i + 1) * step1];
+            b = input2[(i + 1) * step2];
+            output[(i + 1) * step_out] = (a * b) >> shift;
+        }
+    }
+    if (i < len) {
+        int32_t a = input1[i * step1];
+        int32_t b = input2[i * step2];
+        output[i * step_out] = (a * b) >> shift;
+    }
+    return ESP_OK;
+}
@@ -45,6 +45,7 @@ extern "C"
  *      - One of the error codes from DSP library
  */
 esp_err_t dsps_mul_f32_ansi(const float *input1, const float *input2, float *output, int len, int step1, int step2, int step_out);
+esp_err_t dsps_mul_f32_rv32(const float *input1, const float *input2, float *output, int len, int step1, int step2, int step_out);
 esp_err_t dsps_mul_f32_ae32(const float *input1, const float *input2, float *output, int len, int step1, int step2, int step_out);
 /**@}*/
 
@@ -71,6 +72,7 @@ esp_err_t dsps_mul_f32_ae32(const float *input1, const float *input2, float *out
  *      - One of the error codes from DSP library
  */
 esp_err_t dsps_mul_s16_ansi(const int16_t *input1, const int16_t *input2, int16_t *output, int len, int step1, int step2, int step_out, int shift);
+esp_err_t dsps_mul_s16_rv32(const int16_t *input1, const int16_t *input2, int16_t *output, int len, int step1, int step2, int step_out, int shift);
 esp_err_t dsps_mul_s16_ae32(const int16_t *input1, const int16_t *input2, int16_t *output, int len, int step1, int step2, int step_out, int shift);
 esp_err_t dsps_mul_s16_aes3(const int16_t *input1, const int16_t *input2, int16_t *output, int len, int step1, int step2, int step_out, int shift);
 
@@ -108,4 +110,14 @@ esp_err_t dsps_mul_s8_aes3(const int8_t *input1, const int8_t *input2, int8_t *o
 #define dsps_mul_s8  dsps_mul_s8_ansi
 #endif // CONFIG_DSP_OPTIMIZED
 
+// The _rv32 kernels are plain C, selected independently of CONFIG_DSP_OPTIMIZED (Xtensa only)
+#if (dsps_mul_s16_rv32_enabled == 1)
+#undef dsps_mul_s16
+#define dsps_mul_s16 dsps_mul_s16_rv32
+#endif
+#if (dsps_mul_f32_rv32_enabled == 1)
+#undef dsps_mul_f32
+#define dsps_mul_f32 dsps_mul_f32_rv32
+#endif
+
 #endif // _dsps_mul_H_
@@ -22,12 +22,41 @@
  * DSP library matrix namespace.
  */
 namespace dspm {
+class Mat;
+class MatTrans;
+
+/**
+ * @brief   Matrix expression
+ *
+ * Base of the lazy expressions returned by the matrix operators (see mat_expr.h).
+ * An expression is evaluated when it is assigned to a Mat or converted to a Mat.
+ */
+template <class E>
+class MatExpr {
+public:
+    /**
+     * @brief The expression itself
+     */
+    inline const E &self(void) const
+    {
+        return static_cast<const E &>(*this);
+    }
+
+    /**
+     * Transpose of the evaluated expression.
+     *
+     * @return
+     *      - transposed matrix
+     */
+    Mat t() const;
+};
+
 /**
  * @brief   Matrix
  *
  * The Mat class provides basic matrix operations on single-precision floating point values.
  */
-class Mat {
+class Mat : public MatExpr<Mat> {
 public:
 
     int rows;               /*!< Amount of rows*/
@@ -116,6 +145,27 @@ public:
      */
     Mat(const Mat &src);
 
+    /**
+     * @brief Move matrix.
+     *
+     * The buffer of src is taken without copy, src is left empty.
+     * Matrices with external buffer are copied as with the copy constructor.
+     *
+     * @param[in] src: source matrix
+     */
+    Mat(Mat &&src);
+
+    /**
+     * @brief Evaluate a matrix expression.
+     *
+     * The result of the expression is computed into the buffer of the new matrix,
+     * without intermediate matrices.
+     *
+     * @param[in] expr: matrix expression, e.g. A * B + C
+     */
+    template <class E>
+    Mat(const MatExpr<E> &expr);
+
     /**
      * @brief Create a subset of matrix as ROI (Region of Interest)
      *
@@ -207,6 +257,34 @@ public:
      */
     Mat &operator=(const Mat &src);
 
+    /**
+     * Move operator
+     *
+     * The buffer of src is taken when both matrices own their buffer, otherwise the data
+     * is copied as with the copy operator.
+     *
+     * @param[in] src: source matrix
+     *
+     * @return
+     *      - matrix
+     */
+    Mat &operator=(Mat &&src);
+
+    /**
+     * Expression assignment
+     *
+     * The expression is evaluated straight into the buffer of the matrix when it has the same
+     * size. An expression with a product that reads this matrix (e.g. P = F * P * F.t())
+     * is evaluated into a new buffer.
+     *
+     * @param[in] expr: matrix expression
+     *
+     * @return
+     *      - matrix
+     */
+    template <class E>
+    Mat &operator=(const MatExpr<E> &expr);
+
     /**
      * Access to the matrix elements.
      * @param[in] row: row position
@@ -243,6 +321,17 @@ public:
      */
     Mat &operator+=(const Mat &A);
 
+    /**
+     * += operator with a matrix expression, evaluated row by row
+     *
+     * @param[in] expr: matrix expression
+     *
+     * @return
+     *      - result matrix: result += expr
+     */
+    template <class E>
+    Mat &operator+=(const MatExpr<E> &expr);
+
     /**
      * += operator
      * The operator use DSP optimized implementation of multiplication.
@@ -264,6 +353,17 @@ public:
      */
     Mat &operator-=(const Mat &A);
 
+    /**
+     * -= operator with a matrix expression, evaluated row by row
+     *
+     * @param[in] expr: matrix expression
+     *
+     * @return
+     *      - result matrix: result -= expr
+     */
+    template <class E>
+    Mat &operator-=(const MatExpr<E> &expr);
+
     /**
      * -= operator
      * The operator use DSP optimized implementation of multiplication.
@@ -315,12 +415,13 @@ public:
      */
     Mat &operator/=(const Mat &B);
     /**
-     * ^= xor with constant operator
-     * The operator use DSP optimized implementation of multiplication.
-     * @param[in] C: constant value
+     * ^ power operator
+     * Exponentiation by squaring, log2(C) products.
+     * A negative power is the power of the inverse matrix.
+     * @param[in] C: power
      *
      * @return
-     *      - result matrix: result ^= C
+     *      - result matrix: result = this^C
      */
     Mat  operator^(int C);
 
@@ -333,11 +434,12 @@ public:
     /**
      * Matrix transpose.
      * Change rows and columns between each other.
+     * The transpose is read in place by the expression it is used in.
      *
      * @return
      *      - transposed matrix
      */
-    Mat t();
+    MatTrans t() const;
 
     /**
      * Create identity matrix.
@@ -412,12 +514,13 @@ public:
      * @brief   Solve the matrix
      *
      * Solve matrix. Find roots for the matrix A*x = b
+     * LU decomposition with partial pivoting (see MatLU, to reuse it for other b).
      *
      * @param[in] A: matrix [N]x[N] with input coefficients
-     * @param[in] b: vector [N]x[1] with result values
+     * @param[in] b: vector [N]x[1] with result values, or [N]x[M] for M right-hand sides
      *
      * @return
-     *      - matrix [N]x[1] with roots
+     *      - matrix [N]x[1] ([N]x[M]) with roots, [0]x[0] if A is singular
      */
     static Mat solve(Mat A, Mat b);
     /**
@@ -491,9 +594,10 @@ public:
 
     /**
      * Find the inverse matrix
+     * Closed form up to 3x3, LU decomposition with partial pivoting (see MatLU) above.
      *
      * @return
-     *      - inverse matrix
+     *      - inverse matrix, zeros if the matrix is singular
      */
     Mat inverse();
 
@@ -507,18 +611,53 @@ public:
 
     /**
      * Find determinant
-     * @param[in] n: element number in first row
+     * Closed form for 2x2 and 3x3, LU decomposition with partial pivoting (see MatLU) above.
+     * @param[in] n: size of the top left block (rows of the matrix for the whole matrix)
      *
      * @return
      *      - determinant value
      */
     float det(int n);
-private:
-    Mat cofactor(int row, int col, int n);
-    Mat adjoint();
 
+    /**
+     * Expression interface: row of the matrix
+     *
+     * @param[in] row: row position
+     * @param[in] buf: buffer for the row (not used)
+     * @param[in] scratch: scratch memory (not used)
+     *
+     * @return
+     *      - pointer to the row
+     */
+    inline const float *evalRow(int row, float *buf, float *scratch) const
+    {
+        return &this->data[row * this->stride];
+    }
+    /**
+     * Expression interface: scratch memory needed to evaluate a row
+     */
+    inline int evalScratch(void) const
+    {
+        return 0;
+    }
+    /**
+     * Expression interface: how the expression reads the memory [begin, end)
+     *
+     * @return
+     *      - 0 if it isn't read, 1 if it is read by rows, 2 if it is read as a whole
+     */
+    inline int evalAlias(const float *begin, const float *end) const
+    {
+        const float *last = this->data + (this->rows - 1) * this->stride + this->cols;
+        return ((this->data < end) && (begin < last)) ? 1 : 0;
+    }
+    static const bool error = false;   /*!< Expression interface: a matrix is always valid*/
+private:
     void allocate(); // Allocate buffer
-    Mat expHelper(const Mat &m, int num);
+    template <class E>
+    void evaluate(const E &e, int alias);       // Evaluate an expression into the buffer
+    template <class E>
+    void accumulate(const E &e, int sign);      // Add (sign > 0) or subtract an expression
 };
 /**
  * Print matrix to the standard iostream.
@@ -550,111 +689,6 @@ std::ostream &operator<<(std::ostream &os, const Mat::Rect &rect);
  */
 std::istream &operator>>(std::istream &is, Mat &m);
 
-/**
- * + operator, sum of two matrices
- * The operator use DSP optimized implementation of multiplication.
- *
- * @param[in] A: Input matrix A
- * @param[in] B: Input matrix B
- *
- * @return
- *     - result matrix A+B
-*/
-Mat operator+(const Mat &A, const Mat &B);
-/**
- * + operator, sum of matrix with constant
- * The operator use DSP optimized implementation of multiplication.
- *
- * @param[in] A: Input matrix A
- * @param[in] C: Input constant
- *
- * @return
- *     - result matrix A+C
-*/
-Mat operator+(const Mat &A, float C);
-
-/**
- * - operator, subtraction of two matrices
- * The operator use DSP optimized implementation of multiplication.
- *
- * @param[in] A: Input matrix A
- * @param[in] B: Input matrix B
- *
- * @return
- *     - result matrix A-B
-*/
-Mat operator-(const Mat &A, const Mat &B);
-/**
- * - operator, sum of matrix with constant
- * The operator use DSP optimized implementation of multiplication.
- *
- * @param[in] A: Input matrix A
- * @param[in] C: Input constant
- *
- * @return
- *     - result matrix A+C
-*/
-Mat operator-(const Mat &A, float C);
-
-/**
- * * operator, multiplication of two matrices.
- * The operator use DSP optimized implementation of multiplication.
- *
- * @param[in] A: Input matrix A
- * @param[in] B: Input matrix B
- *
- * @return
- *     - result matrix A*B
-*/
-Mat operator*(const Mat &A, const Mat &B);
-
-/**
- * * operator, multiplication of matrix with constant
- * The operator use DSP optimized implementation of multiplication.
- *
- * @param[in] A: Input matrix A
- * @param[in] C: floating point value
- *
- * @return
- *     - result matrix A*B
-*/
-Mat operator*(const Mat &A, float C);
-
-/**
- * * operator, multiplication of matrix with constant
- * The operator use DSP optimized implementation of multiplication.
- *
- * @param[in] C: floating point value
- * @param[in] A: Input matrix A
- *
- * @return
- *     - result matrix A*B
-*/
-Mat operator*(float C, const Mat &A);
-
-/**
- * / operator, divide of matrix by constant
- * The operator use DSP optimized implementation of multiplication.
- *
- * @param[in] A: Input matrix A
- * @param[in] C: floating point value
- *
- * @return
- *     - result matrix A*B
-*/
-Mat operator/(const Mat &A, float C);
-
-/**
- * / operator, divide matrix A by matrix B
- *
- * @param[in] A: Input matrix A
- * @param[in] B: Input matrix B
- *
- * @return
- *     - result matrix C, where C[i,j] = A[i,j]/B[i,j]
-*/
-Mat operator/(const Mat &A, const Mat &B);
-
 /**
  * == operator, compare two matrices
  *
@@ -668,4 +702,7 @@ Mat operator/(const Mat &A, const Mat &B);
 bool operator==(const Mat &A, const Mat &B);
 
 }
+
+#include "mat_expr.h"
+
 #endif //_dspm_mat_h_
@@ -0,0 +1,177 @@
+// Copyright 2018-2023 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dspm_mat_decomp_h_
+#define _dspm_mat_decomp_h_
+#include "mat.h"
+
+namespace dspm {
+/**
+ * @brief   LU decomposition with partial pivoting
+ *
+ * Factorise a square matrix once as P*A = L*U, then find its determinant, its inverse
+ * or the solution of A*x = b for as many right-hand sides as needed in O(N^2) each.
+ * Mat::det(), Mat::inverse() and Mat::solve() use it.
+ */
+class MatLU {
+public:
+    Mat LU;                 /*!< L (below the diagonal, unit diagonal not stored) and U (diagonal and above)*/
+    int *pivot;             /*!< Row of A at each row of LU (permutation P)*/
+    int sign;               /*!< Sign of the permutation: 1 or -1*/
+    bool valid;             /*!< Flag indicates that the matrix was factorised (square and not singular)*/
+
+    /**
+     * Empty decomposition, use decompose() before the other methods.
+     */
+    MatLU();
+
+    /**
+     * Decompose a matrix.
+     * @param[in] A: square matrix
+     */
+    explicit MatLU(const Mat &A);
+    ~MatLU();
+
+    MatLU(const MatLU &) = delete;
+    MatLU &operator=(const MatLU &) = delete;
+
+    /**
+     * Decompose a matrix.
+     * The buffers of the previous decomposition are reused when the size is the same.
+     *
+     * @param[in] A: square matrix
+     *
+     * @return
+     *      - true if the matrix was factorised
+     *      - false if the matrix is not square or is singular (a pivot below N * FLT_EPSILON times
+     *        the largest element of A)
+     */
+    bool decompose(const Mat &A);
+
+    /**
+     * Find determinant
+     *
+     * @return
+     *      - determinant value (0 for a singular matrix)
+     */
+    float det(void) const;
+
+    /**
+     * Solve A*x = b
+     * @param[in] b: right-hand sides, one per column, [N]x[M]
+     * @param[out] x: solutions [N]x[M], resized if needed. It must not share data with b
+     *
+     * @return
+     *      - true on success
+     *      - false if there is no decomposition or b has not N rows
+     */
+    bool solve(const Mat &b, Mat &x) const;
+
+    /**
+     * Solve A*x = b
+     * @param[in] b: right-hand sides, one per column, [N]x[M]
+     *
+     * @return
+     *      - matrix [N]x[M] with the solutions, or [0]x[0] on error
+     */
+    Mat solve(const Mat &b) const;
+
+    /**
+     * Find the inverse matrix
+     *
+     * @return
+     *      - inverse matrix (zeros if there is no decomposition)
+     */
+    Mat inverse(void) const;
+
+private:
+    void substitute(Mat &x) const;  // Forward and back substitution in place
+};
+
+/**
+ * @brief   Cholesky decomposition
+ *
+ * Factorise a symmetric positive definite matrix (e.g. a covariance) as A = L*L', half the
+ * work of the LU decomposition and without pivoting. Only the lower triangle of A is read.
+ */
+class MatCholesky {
+public:
+    Mat L;                  /*!< Lower triangular factor (zeros above the diagonal)*/
+    bool valid;             /*!< Flag indicates that the matrix was factorised (square and positive definite)*/
+
+    /**
+     * Empty decomposition, use decompose() before the other methods.
+     */
+    MatCholesky();
+
+    /**
+     * Decompose a matrix.
+     * @param[in] A: symmetric positive definite matrix
+     */
+    explicit MatCholesky(const Mat &A);
+
+    /**
+     * Decompose a matrix.
+     * The buffer of the previous decomposition is reused when the size is the same.
+     *
+     * @param[in] A: symmetric positive definite matrix
+     *
+     * @return
+     *      - true if the matrix was factorised
+     *      - false if the matrix is not square or not positive definite
+     */
+    bool decompose(const Mat &A);
+
+    /**
+     * Find determinant
+     *
+     * @return
+     *      - determinant value (0 if there is no decomposition)
+     */
+    float det(void) const;
+
+    /**
+     * Solve A*x = b
+     * @param[in] b: right-hand sides, one per column, [N]x[M]
+     * @param[out] x: solutions [N]x[M], resized if needed. It may be b itself
+     *
+     * @return
+     *      - true on success
+     *      - false if there is no decomposition or b has not N rows
+     */
+    bool solve(const Mat &b, Mat &x) const;
+
+    /**
+     * Solve A*x = b
+     * @param[in] b: right-hand sides, one per column, [N]x[M]
+     *
+     * @return
+     *      - matrix [N]x[M] with the solutions, or [0]x[0] on error
+     */
+    Mat solve(const Mat &b) const;
+
+    /**
+     * Find the inverse matrix
+     *
+     * @return
+     *      - inverse matrix (zeros if there is no decomposition)
+     */
+    Mat inverse(void) const;
+
+private:
+    void substitute(Mat &x) const;  // Forward and back substitution in place
+};
+
+}
+#endif //_dspm_mat_decomp_h_
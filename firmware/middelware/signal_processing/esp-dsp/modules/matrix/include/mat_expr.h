@@ -0,0 +1,623 @@
+// Copyright 2018-2023 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dspm_mat_expr_h_
+#define _dspm_mat_expr_h_
+// Lazy expression templates of the Mat operators, included by mat.h after the Mat class.
+//
+// The +, -, *, / operators don't compute anything: they return small objects that keep
+// references to their operands. The whole expression is evaluated row by row when it is
+// assigned to a Mat (or used where a Mat is expected), straight into the destination, so
+// element-wise chains like A + 2 * B - C take a single pass and products like A * B * C
+// only need one row of scratch memory per product (on the stack for rows up to
+// MAT_EXPR_STACK_SIZE values). The right operand of a product is read in place when it
+// is a Mat or a transposed Mat (M.t()), other right operands are evaluated into a
+// temporary matrix first.
+//
+// Expressions keep references to temporaries that only live until the end of the full
+// expression, so they must not be stored (e.g. with auto): assign them to a Mat.
+
+#include <string.h>
+#include "esp_log.h"
+#include "dsps_math.h"
+#include "dsps_dotprod.h"
+#include "dspm_matrix.h"
+
+/** Scratch memory (floats) of an expression evaluation taken from the stack, more is allocated */
+#ifndef MAT_EXPR_STACK_SIZE
+#define MAT_EXPR_STACK_SIZE     64
+#endif
+
+namespace dspm {
+
+/**
+ * @brief   Storage of an operand in an expression node
+ *
+ * Every operand is kept by reference, as it lives until the end of the full expression.
+ */
+template <class E>
+struct MatExprRef {
+    typedef const E &type;
+};
+
+/**
+ * @brief   Storage of the right operand of a product
+ *
+ * Matrices and transposed matrices are read in place, any other expression is evaluated
+ * into a temporary matrix when the product is built.
+ */
+template <class E>
+struct MatProdRight {
+    typedef const Mat type;
+};
+template <>
+struct MatProdRight<Mat> {
+    typedef const Mat &type;
+};
+template <>
+struct MatProdRight<MatTrans> {
+    typedef const MatTrans &type;
+};
+
+/**
+ * @brief   Transposed matrix
+ *
+ * Returned by Mat::t(). Row i is column i of the matrix.
+ */
+class MatTrans : public MatExpr<MatTrans> {
+public:
+    const Mat &m;       /*!< Transposed matrix*/
+    int rows;           /*!< Amount of rows*/
+    int cols;           /*!< Amount of columns*/
+    bool error;         /*!< Operands dimensions don't match*/
+
+    explicit MatTrans(const Mat &m) : m(m), rows(m.cols), cols(m.rows), error(false) {}
+
+    const float *evalRow(int row, float *buf, float *scratch) const
+    {
+        for (int col = 0; col < this->cols; col++) {
+            buf[col] = this->m.data[col * this->m.stride + row];
+        }
+        return buf;
+    }
+    int evalScratch(void) const
+    {
+        return 0;
+    }
+    int evalAlias(const float *begin, const float *end) const
+    {
+        return this->m.evalAlias(begin, end) ? 2 : 0;
+    }
+};
+
+/**
+ * @brief   Sum of two matrices
+ */
+template <class L, class R>
+class MatSum : public MatExpr<MatSum<L, R> > {
+public:
+    typename MatExprRef<L>::type left;      /*!< Left operand*/
+    typename MatExprRef<R>::type right;     /*!< Right operand*/
+    int rows;                               /*!< Amount of rows*/
+    int cols;                               /*!< Amount of columns*/
+    bool error;                             /*!< Operands dimensions don't match*/
+
+    MatSum(const L &left, const R &right) : left(left), right(right), rows(left.rows), cols(left.cols)
+    {
+        this->error = left.error || right.error || (left.rows != right.rows) || (left.cols != right.cols);
+        if ((left.rows != right.rows) || (left.cols != right.cols)) {
+            ESP_LOGW("Mat", "operator + Error: matrices do not have equal dimensions");
+        }
+    }
+
+    const float *evalRow(int row, float *buf, float *scratch) const
+    {
+        const float *a = this->left.evalRow(row, buf, scratch);
+        const float *b = this->right.evalRow(row, scratch, scratch + this->cols);
+        dsps_add_f32(a, b, buf, this->cols, 1, 1, 1);
+        return buf;
+    }
+    int evalScratch(void) const
+    {
+        int right_scratch = this->cols + this->right.evalScratch();
+        return (this->left.evalScratch() > right_scratch) ? this->left.evalScratch() : right_scratch;
+    }
+    int evalAlias(const float *begin, const float *end) const
+    {
+        int a = this->left.evalAlias(begin, end);
+        int b = this->right.evalAlias(begin, end);
+        return (a > b) ? a : b;
+    }
+};
+
+/**
+ * @brief   Subtraction of two matrices
+ */
+template <class L, class R>
+class MatDiff : public MatExpr<MatDiff<L, R> > {
+public:
+    typename MatExprRef<L>::type left;      /*!< Left operand*/
+    typename MatExprRef<R>::type right;     /*!< Right operand*/
+    int rows;                               /*!< Amount of rows*/
+    int cols;                               /*!< Amount of columns*/
+    bool error;                             /*!< Operands dimensions don't match*/
+
+    MatDiff(const L &left, const R &right) : left(left), right(right), rows(left.rows), cols(left.cols)
+    {
+        this->error = left.error || right.error || (left.rows != right.rows) || (left.cols != right.cols);
+        if ((left.rows != right.rows) || (left.cols != right.cols)) {
+            ESP_LOGW("Mat", "operator - Error: matrices do not have equal dimensions");
+        }
+    }
+
+    const float *evalRow(int row, float *buf, float *scratch) const
+    {
+        const float *a = this->left.evalRow(row, buf, scratch);
+        const float *b = this->right.evalRow(row, scratch, scratch + this->cols);
+        dsps_sub_f32(a, b, buf, this->cols, 1, 1, 1);
+        return buf;
+    }
+    int evalScratch(void) const
+    {
+        int right_scratch = this->cols + this->right.evalScratch();
+        return (this->left.evalScratch() > right_scratch) ? this->left.evalScratch() : right_scratch;
+    }
+    int evalAlias(const float *begin, const float *end) const
+    {
+        int a = this->left.evalAlias(begin, end);
+        int b = this->right.evalAlias(begin, end);
+        return (a > b) ? a : b;
+    }
+};
+
+/**
+ * @brief   Element by element division of two matrices
+ */
+template <class L, class R>
+class MatDiv : public MatExpr<MatDiv<L, R> > {
+public:
+    typename MatExprRef<L>::type left;      /*!< Left operand*/
+    typename MatExprRef<R>::type right;     /*!< Right operand*/
+    int rows;                               /*!< Amount of rows*/
+    int cols;                               /*!< Amount of columns*/
+    bool error;                             /*!< Operands dimensions don't match*/
+
+    MatDiv(const L &left, const R &right) : left(left), right(right), rows(left.rows), cols(left.cols)
+    {
+        this->error = left.error || right.error || (left.rows != right.rows) || (left.cols != right.cols);
+        if ((left.rows != right.rows) || (left.cols != right.cols)) {
+            ESP_LOGW("Mat", "operator / Error: matrices do not have equal dimensions");
+        }
+    }
+
+    const float *evalRow(int row, float *buf, float *scratch) const
+    {
+        const float *a = this->left.evalRow(row, buf, scratch);
+        const float *b = this->right.evalRow(row, scratch, scratch + this->cols);
+        for (int col = 0; col < this->cols; col++) {
+            buf[col] = a[col] / b[col];
+        }
+        return buf;
+    }
+    int evalScratch(void) const
+    {
+        int right_scratch = this->cols + this->right.evalScratch();
+        return (this->left.evalScratch() > right_scratch) ? this->left.evalScratch() : right_scratch;
+    }
+    int evalAlias(const float *begin, const float *end) const
+    {
+        int a = this->left.evalAlias(begin, end);
+        int b = this->right.evalAlias(begin, end);
+        return (a > b) ? a : b;
+    }
+};
+
+/**
+ * @brief   Matrix multiplied by a constant
+ */
+template <class E>
+class MatScale : public MatExpr<MatScale<E> > {
+public:
+    typename MatExprRef<E>::type m;         /*!< Operand*/
+    float C;                                /*!< Constant*/
+    int rows;                               /*!< Amount of rows*/
+    int cols;                               /*!< Amount of columns*/
+    bool error;                             /*!< Operands dimensions don't match*/
+
+    MatScale(const E &m, float C) : m(m), C(C), rows(m.rows), cols(m.cols), error(m.error) {}
+
+    const float *evalRow(int row, float *buf, float *scratch) const
+    {
+        const float *a = this->m.evalRow(row, buf, scratch);
+        dsps_mulc_f32_ansi(a, buf, this->cols, this->C, 1, 1);
+        return buf;
+    }
+    int evalScratch(void) const
+    {
+        return this->m.evalScratch();
+    }
+    int evalAlias(const float *begin, const float *end) const
+    {
+        return this->m.evalAlias(begin, end);
+    }
+};
+
+/**
+ * @brief   Matrix plus a constant
+ */
+template <class E>
+class MatAddC : public MatExpr<MatAddC<E> > {
+public:
+    typename MatExprRef<E>::type m;         /*!< Operand*/
+    float C;                                /*!< Constant*/
+    int rows;                               /*!< Amount of rows*/
+    int cols;                               /*!< Amount of columns*/
+    bool error;                             /*!< Operands dimensions don't match*/
+
+    MatAddC(const E &m, float C) : m(m), C(C), rows(m.rows), cols(m.cols), error(m.error) {}
+
+    const float *evalRow(int row, float *buf, float *scratch) const
+    {
+        const float *a = this->m.evalRow(row, buf, scratch);
+        dsps_addc_f32_ansi(a, buf, this->cols, this->C, 1, 1);
+        return buf;
+    }
+    int evalScratch(void) const
+    {
+        return this->m.evalScratch();
+    }
+    int evalAlias(const float *begin, const float *end) const
+    {
+        return this->m.evalAlias(begin, end);
+    }
+};
+
+/**
+ * @brief   Product of two matrices
+ *
+ * Row i of the product is row i of the left operand times the right operand, so chains
+ * A * B * C are evaluated one row at a time without intermediate matrices.
+ */
+template <class L, class R>
+class MatProd : public MatExpr<MatProd<L, R> > {
+public:
+    typename MatExprRef<L>::type left;      /*!< Left operand*/
+    typename MatProdRight<R>::type right;   /*!< Right operand (evaluated if it isn't a Mat or a MatTrans)*/
+    int rows;                               /*!< Amount of rows*/
+    int cols;                               /*!< Amount of columns*/
+    bool error;                             /*!< Operands dimensions don't match*/
+
+    MatProd(const L &left, const R &right) : left(left), right(right), rows(left.rows), cols(right.cols)
+    {
+        this->error = left.error || right.error || (left.cols != right.rows);
+        if (left.cols != right.rows) {
+            ESP_LOGW("Mat", "operator * Error: matrices do not have correct dimensions");
+        }
+    }
+
+    const float *evalRow(int row, float *buf, float *scratch) const
+    {
+        const float *a = this->left.evalRow(row, scratch, scratch + this->left.cols);
+        MultRow(a, this->left.cols, this->right, buf);
+        return buf;
+    }
+    int evalScratch(void) const
+    {
+        return this->left.cols + this->left.evalScratch();
+    }
+    int evalAlias(const float *begin, const float *end) const
+    {
+        // The whole right operand is read for every row
+        int a = this->left.evalAlias(begin, end);
+        return (this->right.evalAlias(begin, end) > 0) ? 2 : a;
+    }
+
+private:
+    static void MultRow(const float *a, int n, const Mat &B, float *out)
+    {
+        if (B.padding == 0) {
+            dspm_mult_f32(a, B.data, out, 1, n, B.cols);
+        } else {
+            dspm_mult_ex_f32(a, B.data, out, 1, n, B.cols, 0, B.padding, 0);
+        }
+    }
+    static void MultRow(const float *a, int n, const MatTrans &B, float *out)
+    {
+        // Column j of B' is row j of B: one dot product per output value
+        for (int col = 0; col < B.cols; col++) {
+            dsps_dotprod_f32(a, &B.m.data[col * B.m.stride], &out[col], n);
+        }
+    }
+};
+
+template <class E>
+Mat::Mat(const MatExpr<E> &expr)
+{
+    const E &e = expr.self();
+    this->sub_matrix = false;
+    this->padding = 0;
+    if (e.error) {
+        this->rows = 1;
+        this->cols = 1;
+    } else {
+        this->rows = e.rows;
+        this->cols = e.cols;
+    }
+    this->stride = this->cols;
+    allocate();
+    if (e.error) {
+        this->data[0] = 0;
+    } else {
+        evaluate(e, 0);
+    }
+}
+
+template <class E>
+Mat &Mat::operator=(const MatExpr<E> &expr)
+{
+    const E &e = expr.self();
+    if (e.error) {
+        return (*this = Mat());
+    }
+    int alias = e.evalAlias(this->data, this->data + (this->rows - 1) * this->stride + this->cols);
+    if ((alias > 1) || (this->rows != e.rows) || (this->cols != e.cols)) {
+        // Products that read this matrix (or a new size) need a new buffer
+        return (*this = Mat(e));
+    }
+    evaluate(e, alias);
+    return *this;
+}
+
+template <class E>
+Mat &Mat::operator+=(const MatExpr<E> &expr)
+{
+    const E &e = expr.self();
+    if (e.error || (this->rows != e.rows) || (this->cols != e.cols)) {
+        ESP_LOGW("Mat", "operator += Error: matrices do not have equal dimensions");
+        return *this;
+    }
+    if (e.evalAlias(this->data, this->data + (this->rows - 1) * this->stride + this->cols) > 1) {
+        return (*this += Mat(e));
+    }
+    accumulate(e, 1);
+    return *this;
+}
+
+template <class E>
+Mat &Mat::operator-=(const MatExpr<E> &expr)
+{
+    const E &e = expr.self();
+    if (e.error || (this->rows != e.rows) || (this->cols != e.cols)) {
+        ESP_LOGW("Mat", "operator -= Error: matrices do not have equal dimensions");
+        return *this;
+    }
+    if (e.evalAlias(this->data, this->data + (this->rows - 1) * this->stride + this->cols) > 1) {
+        return (*this -= Mat(e));
+    }
+    accumulate(e, -1);
+    return *this;
+}
+
+template <class E>
+void Mat::evaluate(const E &e, int alias)
+{
+    // Rows that read this matrix are computed in a row buffer first
+    int row_buffer = alias ? this->cols : 0;
+    int size = row_buffer + e.evalScratch();
+    float stack_scratch[MAT_EXPR_STACK_SIZE];
+    float *scratch = (size <= MAT_EXPR_STACK_SIZE) ? stack_scratch : new float[size];
+    for (int row = 0; row < this->rows; row++) {
+        float *dest = &this->data[row * this->stride];
+        float *buf = alias ? scratch : dest;
+        const float *result = e.evalRow(row, buf, scratch + row_buffer);
+        if (result != dest) {
+            memcpy(dest, result, this->cols * sizeof(float));
+        }
+    }
+    if (scratch != stack_scratch) {
+        delete[] scratch;
+    }
+}
+
+template <class E>
+void Mat::accumulate(const E &e, int sign)
+{
+    int size = this->cols + e.evalScratch();
+    float stack_scratch[MAT_EXPR_STACK_SIZE];
+    float *scratch = (size <= MAT_EXPR_STACK_SIZE) ? stack_scratch : new float[size];
+    for (int row = 0; row < this->rows; row++) {
+        float *dest = &this->data[row * this->stride];
+        const float *result = e.evalRow(row, scratch, scratch + this->cols);
+        if (sign > 0) {
+            dsps_add_f32(dest, result, dest, this->cols, 1, 1, 1);
+        } else {
+            dsps_sub_f32(dest, result, dest, this->cols, 1, 1, 1);
+        }
+    }
+    if (scratch != stack_scratch) {
+        delete[] scratch;
+    }
+}
+
+inline MatTrans Mat::t() const
+{
+    return MatTrans(*this);
+}
+
+template <class E>
+Mat MatExpr<E>::t() const
+{
+    Mat m(self());
+    return Mat(m.t());
+}
+
+/**
+ * + operator, sum of two matrices
+ * The operator use DSP optimized implementation of addition.
+ *
+ * @param[in] A: Input matrix A
+ * @param[in] B: Input matrix B
+ *
+ * @return
+ *     - result matrix A+B
+*/
+template <class L, class R>
+inline MatSum<L, R> operator+(const MatExpr<L> &A, const MatExpr<R> &B)
+{
+    return MatSum<L, R>(A.self(), B.self());
+}
+
+/**
+ * + operator, sum of matrix with constant
+ * The operator use DSP optimized implementation of addition.
+ *
+ * @param[in] A: Input matrix A
+ * @param[in] C: Input constant
+ *
+ * @return
+ *     - result matrix A+C
+*/
+template <class E>
+inline MatAddC<E> operator+(const MatExpr<E> &A, float C)
+{
+    return MatAddC<E>(A.self(), C);
+}
+
+/**
+ * - operator, subtraction of two matrices
+ * The operator use DSP optimized implementation of subtraction.
+ *
+ * @param[in] A: Input matrix A
+ * @param[in] B: Input matrix B
+ *
+ * @return
+ *     - result matrix A-B
+*/
+template <class L, class R>
+inline MatDiff<L, R> operator-(const MatExpr<L> &A, const MatExpr<R> &B)
+{
+    return MatDiff<L, R>(A.self(), B.self());
+}
+
+/**
+ * - operator, subtraction of constant from matrix
+ * The operator use DSP optimized implementation of addition.
+ *
+ * @param[in] A: Input matrix A
+ * @param[in] C: Input constant
+ *
+ * @return
+ *     - result matrix A-C
+*/
+template <class E>
+inline MatAddC<E> operator-(const MatExpr<E> &A, float C)
+{
+    return MatAddC<E>(A.self(), -C);
+}
+
+/**
+ * * operator, multiplication of two matrices.
+ * The operator use DSP optimized implementation of multiplication.
+ *
+ * @param[in] A: Input matrix A
+ * @param[in] B: Input matrix B
+ *
+ * @return
+ *     - result matrix A*B
+*/
+template <class L, class R>
+inline MatProd<L, R> operator*(const MatExpr<L> &A, const MatExpr<R> &B)
+{
+    return MatProd<L, R>(A.self(), B.self());
+}
+
+/**
+ * * operator, multiplication of matrix with constant
+ * The operator use DSP optimized implementation of multiplication.
+ *
+ * @param[in] A: Input matrix A
+ * @param[in] C: floating point value
+ *
+ * @return
+ *     - result matrix A*C
+*/
+template <class E>
+inline MatScale<E> operator*(const MatExpr<E> &A, float C)
+{
+    return MatScale<E>(A.self(), C);
+}
+
+/**
+ * * operator, multiplication of matrix with constant
+ * The operator use DSP optimized implementation of multiplication.
+ *
+ * @param[in] C: floating point value
+ * @param[in] A: Input matrix A
+ *
+ * @return
+ *     - result matrix C*A
+*/
+template <class E>
+inline MatScale<E> operator*(float C, const MatExpr<E> &A)
+{
+    return MatScale<E>(A.self(), C);
+}
+
+/**
+ * / operator, divide of matrix by constant
+ * The operator use DSP optimized implementation of multiplication.
+ *
+ * @param[in] A: Input matrix A
+ * @param[in] C: floating point value
+ *
+ * @return
+ *     - result matrix A/C
+*/
+template <class E>
+inline MatScale<E> operator/(const MatExpr<E> &A, float C)
+{
+    return MatScale<E>(A.self(), 1 / C);
+}
+
+/**
+ * / operator, divide matrix A by matrix B
+ *
+ * @param[in] A: Input matrix A
+ * @param[in] B: Input matrix B
+ *
+ * @return
+ *     - result matrix C, where C[i,j] = A[i,j]/B[i,j]
+*/
+template <class L, class R>
+inline MatDiv<L, R> operator/(const MatExpr<L> &A, const MatExpr<R> &B)
+{
+    return MatDiv<L, R>(A.self(), B.self());
+}
+
+/**
+ * Print a matrix expression to the standard iostream.
+ * @param[in] os: output stream
+ * @param[in] e: expression to print
+ *
+ * @return
+ *      - output stream
+ */
+template <class E>
+inline std::ostream &operator<<(std::ostream &os, const MatExpr<E> &e)
+{
+    return os << Mat(e);
+}
+
+}
+#endif //_dspm_mat_expr_h_
@@ -0,0 +1,578 @@
+// Copyright 2018-2023 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dspm_mat_fixed_h_
+#define _dspm_mat_fixed_h_
+#include <iostream>
+#include <string.h>
+#include <math.h>
+#include "esp_log.h"
+#include "dsps_math.h"
+#include "dspm_matrix.h"
+#include "mat.h"
+
+namespace dspm {
+/**
+ * @brief   Matrix with compile-time dimensions
+ *
+ * The MatFixed class provides the Mat operators for matrices whose size is known at compile
+ * time (3x3, 4x4, 13x13 control and filter matrices). Data lives inside the object, so
+ * matrices are placed on the stack, in static memory or inside other objects, and no operator
+ * allocates heap memory. Dimensions are checked by the compiler: A * B only compiles when
+ * A.cols == B.rows, += only with a matrix of the same size, etc.
+ *
+ * The same dspm_ and dsps_ kernels as Mat are used. view() gives a Mat over the same data
+ * (no copy, no allocation) for the functions that only take a Mat.
+ *
+ * @tparam Rows: amount of rows
+ * @tparam Cols: amount of columns
+ */
+template <int Rows, int Cols>
+class MatFixed {
+    static_assert((Rows > 0) && (Cols > 0), "MatFixed dimensions must be positive");
+public:
+    static constexpr int rows = Rows;               /*!< Amount of rows*/
+    static constexpr int cols = Cols;               /*!< Amount of columns*/
+    static constexpr int length = Rows * Cols;      /*!< Total amount of data in data array*/
+    alignas(16) float data[Rows * Cols];            /*!< Row-major matrix data*/
+
+    /**
+     * Constructor with initialization to 0
+     */
+    MatFixed()
+    {
+        clear();
+    }
+
+    /**
+     * Constructor from a buffer.
+     * @param[in] src: row-major matrix data (rows * cols values)
+     */
+    explicit MatFixed(const float *src)
+    {
+        memcpy(this->data, src, sizeof(this->data));
+    }
+
+    /**
+     * Constructor from a Mat (or a sub-matrix) of the same size.
+     * If the sizes don't match the matrix is filled with 0.
+     * @param[in] src: source matrix
+     */
+    explicit MatFixed(const Mat &src)
+    {
+        if ((src.rows != Rows) || (src.cols != Cols)) {
+            ESP_LOGW("MatFixed", "MatFixed(Mat) Error: matrix %dx%d doesn't fit in %dx%d", src.rows, src.cols, Rows, Cols);
+            clear();
+            return;
+        }
+        for (int row = 0; row < Rows; row++) {
+            memcpy(&this->data[row * Cols], &src.data[row * src.stride], Cols * sizeof(float));
+        }
+    }
+
+    /**
+     * @brief Mat header over the matrix data
+     *
+     * The returned Mat is a sub-matrix: it doesn't own nor copy the data, so the operations
+     * done on it (or on its copies) change this matrix.
+     *
+     * @return
+     *      - Mat [rows]x[cols] over data
+     */
+    Mat view()
+    {
+        return Mat(this->data, Rows, Cols, Cols);
+    }
+
+    /**
+     * Access to the matrix elements.
+     * @param[in] row: row position
+     * @param[in] col: column position
+     *
+     * @return
+     *      - element of matrix M[row][col]
+     */
+    inline float &operator()(int row, int col)
+    {
+        return data[row * Cols + col];
+    }
+
+    /**
+     * Access to the matrix elements.
+     * @param[in] row: row position
+     * @param[in] col: column position
+     *
+     * @return
+     *      - element of matrix M[row][col]
+     */
+    inline const float &operator()(int row, int col) const
+    {
+        return data[row * Cols + col];
+    }
+
+    /**
+     * += operator
+     * @param[in] A: source matrix
+     *
+     * @return
+     *      - result matrix: result += A
+     */
+    MatFixed &operator+=(const MatFixed &A)
+    {
+        dsps_add_f32(this->data, A.data, this->data, length, 1, 1, 1);
+        return *this;
+    }
+
+    /**
+     * += operator
+     * @param[in] C: constant
+     *
+     * @return
+     *      - result matrix: result += C
+     */
+    MatFixed &operator+=(float C)
+    {
+        dsps_addc_f32_ansi(this->data, this->data, length, C, 1, 1);
+        return *this;
+    }
+
+    /**
+     * -= operator
+     * @param[in] A: source matrix
+     *
+     * @return
+     *      - result matrix: result -= A
+     */
+    MatFixed &operator-=(const MatFixed &A)
+    {
+        dsps_sub_f32(this->data, A.data, this->data, length, 1, 1, 1);
+        return *this;
+    }
+
+    /**
+     * -= operator
+     * @param[in] C: constant
+     *
+     * @return
+     *      - result matrix: result -= C
+     */
+    MatFixed &operator-=(float C)
+    {
+        dsps_addc_f32_ansi(this->data, this->data, length, -C, 1, 1);
+        return *this;
+    }
+
+    /**
+     * *= operator, only for a square right operand (the result keeps its size).
+     * The product goes through a stack temporary, as dspm_mult_f32 can't work in place
+     * (A may be this matrix).
+     * @param[in] A: source matrix [cols]x[cols]
+     *
+     * @return
+     *      - result matrix: result *= A
+     */
+    MatFixed &operator*=(const MatFixed<Cols, Cols> &A)
+    {
+        MatFixed temp;
+        dspm_mult_f32(this->data, A.data, temp.data, Rows, Cols, Cols);
+        memcpy(this->data, temp.data, sizeof(this->data));
+        return *this;
+    }
+
+    /**
+     * *= with constant operator
+     * @param[in] C: constant value
+     *
+     * @return
+     *      - result matrix: result *= C
+     */
+    MatFixed &operator*=(float C)
+    {
+        dsps_mulc_f32_ansi(this->data, this->data, length, C, 1, 1);
+        return *this;
+    }
+
+    /**
+     * /= with constant operator
+     * @param[in] C: constant value
+     *
+     * @return
+     *      - result matrix: result /= C
+     */
+    MatFixed &operator/=(float C)
+    {
+        dsps_mulc_f32_ansi(this->data, this->data, length, 1 / C, 1, 1);
+        return *this;
+    }
+
+    /**
+     * /= operator
+     * @param[in] B: source matrix
+     *
+     * @return
+     *      - result matrix: result[i,j] = result[i,j]/B[i,j]
+     */
+    MatFixed &operator/=(const MatFixed &B)
+    {
+        for (int i = 0; i < length; i++) {
+            this->data[i] /= B.data[i];
+        }
+        return *this;
+    }
+
+    /**
+     * ^ operator, integer power of a square matrix by repeated squaring
+     * (about 2 * log2(C) products).
+     * @param[in] C: power (0: identity)
+     *
+     * @return
+     *      - result matrix: this^C
+     */
+    MatFixed operator^(int C) const
+    {
+        static_assert(Rows == Cols, "MatFixed power of a non square matrix");
+        MatFixed result = eye();
+        MatFixed base(*this);
+        while (C > 0) {
+            if (C & 1) {
+                result *= base;
+            }
+            C >>= 1;
+            if (C > 0) {
+                base *= base;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Swap two rows between each other.
+     * @param[in] row1: position of first row
+     * @param[in] row2: position of second row
+     */
+    void swapRows(int row1, int row2)
+    {
+        if ((row1 >= Rows) || (row2 >= Rows)) {
+            ESP_LOGW("MatFixed", "swapRows Error: row %d or %d out of matrix row %d range", row1, row2, Rows);
+            return;
+        }
+        for (int i = 0; i < Cols; i++) {
+            float temp = (*this)(row1, i);
+            (*this)(row1, i) = (*this)(row2, i);
+            (*this)(row2, i) = temp;
+        }
+    }
+
+    /**
+     * Matrix transpose.
+     *
+     * @return
+     *      - transposed matrix [cols]x[rows]
+     */
+    MatFixed<Cols, Rows> t() const
+    {
+        MatFixed<Cols, Rows> ret;
+        for (int i = 0; i < Rows; ++i) {
+            for (int j = 0; j < Cols; ++j) {
+                ret(j, i) = (*this)(i, j);
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * Create identity matrix (square matrices only).
+     *
+     * @return
+     *      - matrix [N]x[N] with 1 in diagonal
+     */
+    static MatFixed eye()
+    {
+        static_assert(Rows == Cols, "MatFixed identity of a non square matrix");
+        MatFixed temp;
+        for (int i = 0; i < Rows; ++i) {
+            temp(i, i) = 1;
+        }
+        return temp;
+    }
+
+    /**
+     * Create matrix with all elements 1.
+     *
+     * @return
+     *      - matrix [rows]x[cols] with 1 in all elements
+     */
+    static MatFixed ones()
+    {
+        MatFixed temp;
+        temp += 1;
+        return temp;
+    }
+
+    /**
+     * Return part of matrix from defined position (startRow, startCol) as a matrix[BlockRows x BlockCols].
+     * If the block doesn't fit in the matrix, the result is filled with 0.
+     *
+     * @param[in] startRow: start row position
+     * @param[in] startCol: start column position
+     *
+     * @return
+     *      - matrix [BlockRows]x[BlockCols]
+     */
+    template <int BlockRows, int BlockCols>
+    MatFixed<BlockRows, BlockCols> block(int startRow, int startCol) const
+    {
+        static_assert((BlockRows <= Rows) && (BlockCols <= Cols), "MatFixed block bigger than the matrix");
+        MatFixed<BlockRows, BlockCols> result;
+        if (((startRow + BlockRows) > Rows) || ((startCol + BlockCols) > Cols)) {
+            ESP_LOGW("MatFixed", "block Error: block out of matrix range");
+            return result;
+        }
+        for (int row = 0; row < BlockRows; row++) {
+            memcpy(&result.data[row * BlockCols], &this->data[(row + startRow) * Cols + startCol], BlockCols * sizeof(float));
+        }
+        return result;
+    }
+
+    /**
+     * Copy a smaller matrix into this one.
+     * @param[in] src: source matrix
+     * @param[in] row_pos: start row position of destination matrix
+     * @param[in] col_pos: start col position of destination matrix
+     */
+    template <int SrcRows, int SrcCols>
+    void Copy(const MatFixed<SrcRows, SrcCols> &src, int row_pos, int col_pos)
+    {
+        static_assert((SrcRows <= Rows) && (SrcCols <= Cols), "MatFixed source bigger than the matrix");
+        if (((row_pos + SrcRows) > Rows) || ((col_pos + SrcCols) > Cols)) {
+            return;
+        }
+        for (int row = 0; row < SrcRows; row++) {
+            memcpy(&this->data[(row + row_pos) * Cols + col_pos], &src.data[row * SrcCols], SrcCols * sizeof(float));
+        }
+    }
+
+    /**
+     * Return norm of the vector.
+     * If it's matrix, calculate matrix norm
+     *
+     * @return
+     *      - matrix norm
+     */
+    float norm(void) const
+    {
+        float sqr_norm = 0;
+        for (int i = 0; i < length; i++) {
+            sqr_norm += this->data[i] * this->data[i];
+        }
+        return sqrtf(sqr_norm);
+    }
+
+    /**
+     * Normalizes the vector, i.e. divides it by its own norm.
+     * If it's matrix, calculate matrix norm
+     */
+    void normalize(void)
+    {
+        *this *= 1 / norm();
+    }
+
+    /**
+     * The method fill 0 to the matrix structure.
+     */
+    void clear(void)
+    {
+        memset(this->data, 0, sizeof(this->data));
+    }
+};
+
+/**
+ * + operator, sum of two matrices
+ * @param[in] A: Input matrix A
+ * @param[in] B: Input matrix B
+ *
+ * @return
+ *     - result matrix A+B
+*/
+template <int Rows, int Cols>
+MatFixed<Rows, Cols> operator+(const MatFixed<Rows, Cols> &A, const MatFixed<Rows, Cols> &B)
+{
+    MatFixed<Rows, Cols> temp(A);
+    return (temp += B);
+}
+
+/**
+ * + operator, sum of matrix with constant
+ * @param[in] A: Input matrix A
+ * @param[in] C: Input constant
+ *
+ * @return
+ *     - result matrix A+C
+*/
+template <int Rows, int Cols>
+MatFixed<Rows, Cols> operator+(const MatFixed<Rows, Cols> &A, float C)
+{
+    MatFixed<Rows, Cols> temp(A);
+    return (temp += C);
+}
+
+/**
+ * - operator, subtraction of two matrices
+ * @param[in] A: Input matrix A
+ * @param[in] B: Input matrix B
+ *
+ * @return
+ *     - result matrix A-B
+*/
+template <int Rows, int Cols>
+MatFixed<Rows, Cols> operator-(const MatFixed<Rows, Cols> &A, const MatFixed<Rows, Cols> &B)
+{
+    MatFixed<Rows, Cols> temp(A);
+    return (temp -= B);
+}
+
+/**
+ * - operator, subtraction of constant from matrix
+ * @param[in] A: Input matrix A
+ * @param[in] C: Input constant
+ *
+ * @return
+ *     - result matrix A-C
+*/
+template <int Rows, int Cols>
+MatFixed<Rows, Cols> operator-(const MatFixed<Rows, Cols> &A, float C)
+{
+    MatFixed<Rows, Cols> temp(A);
+    return (temp -= C);
+}
+
+/**
+ * * operator, multiplication of two matrices.
+ * Only compiles when the columns of A match the rows of B.
+ * @param[in] A: Input matrix A [rows]x[inner]
+ * @param[in] B: Input matrix B [inner]x[cols]
+ *
+ * @return
+ *     - result matrix A*B [rows]x[cols]
+*/
+template <int Rows, int Inner, int Cols>
+MatFixed<Rows, Cols> operator*(const MatFixed<Rows, Inner> &A, const MatFixed<Inner, Cols> &B)
+{
+    MatFixed<Rows, Cols> temp;
+    dspm_mult_f32(A.data, B.data, temp.data, Rows, Inner, Cols);
+    return temp;
+}
+
+/**
+ * * operator, multiplication of matrix with constant
+ * @param[in] A: Input matrix A
+ * @param[in] C: floating point value
+ *
+ * @return
+ *     - result matrix A*C
+*/
+template <int Rows, int Cols>
+MatFixed<Rows, Cols> operator*(const MatFixed<Rows, Cols> &A, float C)
+{
+    MatFixed<Rows, Cols> temp(A);
+    return (temp *= C);
+}
+
+/**
+ * * operator, multiplication of matrix with constant
+ * @param[in] C: floating point value
+ * @param[in] A: Input matrix A
+ *
+ * @return
+ *     - result matrix C*A
+*/
+template <int Rows, int Cols>
+MatFixed<Rows, Cols> operator*(float C, const MatFixed<Rows, Cols> &A)
+{
+    return (A * C);
+}
+
+/**
+ * / operator, divide of matrix by constant
+ * @param[in] A: Input matrix A
+ * @param[in] C: floating point value
+ *
+ * @return
+ *     - result matrix A/C
+*/
+template <int Rows, int Cols>
+MatFixed<Rows, Cols> operator/(const MatFixed<Rows, Cols> &A, float C)
+{
+    MatFixed<Rows, Cols> temp(A);
+    return (temp /= C);
+}
+
+/**
+ * / operator, divide matrix A by matrix B
+ * @param[in] A: Input matrix A
+ * @param[in] B: Input matrix B
+ *
+ * @return
+ *     - result matrix C, where C[i,j] = A[i,j]/B[i,j]
+*/
+template <int Rows, int Cols>
+MatFixed<Rows, Cols> operator/(const MatFixed<Rows, Cols> &A, const MatFixed<Rows, Cols> &B)
+{
+    MatFixed<Rows, Cols> temp(A);
+    return (temp /= B);
+}
+
+/**
+ * == operator, compare two matrices
+ * @param[in] A: Input matrix A
+ * @param[in] B: Input matrix B
+ *
+ * @return
+ *      - true if matrices are the same
+ *      - false if matrices are different
+*/
+template <int Rows, int Cols>
+bool operator==(const MatFixed<Rows, Cols> &A, const MatFixed<Rows, Cols> &B)
+{
+    for (int i = 0; i < Rows * Cols; i++) {
+        if (A.data[i] != B.data[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Print matrix to the standard iostream.
+ * @param[in] os: output stream
+ * @param[in] m: matrix to print
+ *
+ * @return
+ *      - output stream
+ */
+template <int Rows, int Cols>
+std::ostream &operator<<(std::ostream &os, const MatFixed<Rows, Cols> &m)
+{
+    for (int i = 0; i < Rows; ++i) {
+        os << m(i, 0);
+        for (int j = 1; j < Cols; ++j) {
+            os << " " << m(i, j);
+        }
+        os << std::endl;
+    }
+    return os;
+}
+
+}
+#endif //_dspm_mat_fixed_h_
@@ -15,6 +15,7 @@
 #include <stdexcept>
 #include <string.h>
 #include "mat.h"
+#include "mat_decomp.h"
 #include "esp_log.h"
 
 #include "dsps_math.h"
@@ -22,6 +23,7 @@
 #include <math.h>
 #include <cmath>
 #include <inttypes.h>
+#include <utility>
 
 
 
@@ -133,6 +135,32 @@ Mat::Mat(const Mat &m)
     }
 }
 
+Mat::Mat(Mat &&m)
+{
+    this->rows = m.rows;
+    this->cols = m.cols;
+    this->padding = m.padding;
+    this->stride = m.stride;
+    this->data = m.data;
+    this->length = m.length;
+    this->sub_matrix = m.sub_matrix;
+    this->ext_buff = m.ext_buff;
+
+    if (m.ext_buff) {
+        // the buffer is not owned by m: same as the copy constructor
+        if (!m.sub_matrix) {
+            allocate();
+            memcpy(this->data, m.data, this->length * sizeof(float));
+        }
+    } else {
+        m.data = NULL;
+        m.rows = 0;
+        m.cols = 0;
+        m.stride = 0;
+        m.length = 0;
+    }
+}
+
 Mat Mat::getROI(int startRow, int startCol, int roiRows, int roiCols, int stride)
 {
     Mat result(this->data, roiRows, roiCols, 0);
@@ -257,6 +285,33 @@ Mat &Mat::operator=(const Mat &m)
     return *this;
 }
 
+Mat &Mat::operator=(Mat &&m)
+{
+    if (this == &m) {
+        return *this;
+    }
+    // sub-matrices and external buffers keep their data, so it's copied
+    if (this->ext_buff || m.ext_buff) {
+        return (*this = static_cast<const Mat &>(m));
+    }
+
+    delete[] this->data;
+    this->rows = m.rows;
+    this->cols = m.cols;
+    this->padding = m.padding;
+    this->stride = m.stride;
+    this->data = m.data;
+    this->length = m.length;
+    this->sub_matrix = false;
+
+    m.data = NULL;
+    m.rows = 0;
+    m.cols = 0;
+    m.stride = 0;
+    m.length = 0;
+    return *this;
+}
+
 Mat &Mat::operator+=(const Mat &m)
 {
     if ((this->rows != m.rows) || (this->cols != m.cols)) {
@@ -361,8 +416,33 @@ Mat &Mat::operator/=(float num)
 
 Mat Mat::operator^(int num)
 {
-    Mat temp(*this);
-    return expHelper(temp, num);
+    if (this->rows != this->cols) {
+        ESP_LOGW("Mat", "operator ^ Error: matrix %dx%d is not square", this->rows, this->cols);
+        Mat err_ret;
+        return err_ret;
+    }
+    // Exponentiation by squaring: result holds base^(bits of num done so far)
+    Mat base(this->rows, this->cols);
+    if (num < 0) {
+        base = this->inverse();
+        num = -num;
+    } else {
+        base = *this;
+    }
+    Mat result = Mat::eye(this->rows);
+    Mat temp(this->rows, this->cols);
+    while (num > 0) {
+        if (num & 1) {
+            temp = result * base;
+            std::swap(result, temp);
+        }
+        num >>= 1;
+        if (num > 0) {
+            temp = base * base;
+            std::swap(base, temp);
+        }
+    }
+    return result;
 }
 
 void Mat::swapRows(int r1, int r2)
@@ -378,17 +458,6 @@ void Mat::swapRows(int r1, int r2)
     }
 }
 
-Mat Mat::t()
-{
-    Mat ret(this->cols, this->rows);
-    for (int i = 0; i < this->rows; ++i) {
-        for (int j = 0; j < this->cols; ++j) {
-            ret(j, i) = this->data[i * this->stride + j];
-        }
-    }
-    return ret;
-}
-
 Mat Mat::eye(int size)
 {
     Mat temp(size, size);
@@ -465,48 +534,13 @@ float Mat::norm(void)
 
 Mat Mat::solve(Mat A, Mat b)
 {
-    // Gaussian elimination
-    for (int i = 0; i < A.rows; ++i) {
-        if (A(i, i) == 0) {
-            // pivot 0 - error
-            ESP_LOGW("Mat", "Error: the coefficient matrix has 0 as a pivot. Please fix the input and try again.");
-            Mat err_result(0, 0);
-            return err_result;
-        }
-        float a_ii = 1 / A(i, i);
-        for (int j = i + 1; j < A.rows; ++j) {
-            float a_ji = A(j, i) * a_ii;
-            for (int k = i + 1; k < A.cols; ++k) {
-                A(j, k) -= A(i, k) * a_ji;
-                if ((A(j, k) < abs_tol) && (A(j, k) > -1 * abs_tol)) {
-                    A(j, k) = 0;
-                }
-            }
-            b(j, 0) -= b(i, 0) * a_ji;
-            if (A(j, 0) < abs_tol && A(j, 0) > -1 * abs_tol) {
-                A(j, 0) = 0;
-            }
-            A(j, i) = 0;
-        }
-    }
-
-    // Back substitution
-    Mat x(b.rows, 1);
-    x((x.rows - 1), 0) = b((x.rows - 1), 0) / A((x.rows - 1), (x.rows - 1));
-    if (x((x.rows - 1), 0) < abs_tol && x((x.rows - 1), 0) > -1 * abs_tol) {
-        x((x.rows - 1), 0) = 0;
-    }
-    for (int i = x.rows - 2; i >= 0; --i) {
-        float sum = 0;
-        for (int j = i + 1; j < x.rows; ++j) {
-            sum += A(i, j) * x(j, 0);
-        }
-        x(i, 0) = (b(i, 0) - sum) / A(i, i);
-        if (x(i, 0) < abs_tol && x(i, 0) > -1 * abs_tol) {
-            x(i, 0) = 0;
-        }
+    MatLU lu(A);
+    if (!lu.valid) {
+        ESP_LOGW("Mat", "Error: the coefficient matrix is singular. Please fix the input and try again.");
+        Mat err_result(0, 0);
+        return err_result;
     }
-    return x;
+    return lu.solve(b);
 }
 
 Mat Mat::bandSolve(Mat A, Mat b, int k)
@@ -717,104 +751,72 @@ Mat Mat::pinv()
     return AInverse;
 }
 
-Mat Mat::cofactor(int row, int col, int n)
+// Closed form of the small matrices: fewer operations than LU, and exact for integer
+// matrices (the cofactors are products of the elements)
+static float det2(const Mat &m)
 {
-    int i = 0, j = 0;
-    Mat result(n, n);
-    // Looping for each element of the matrix
-    for (int r = 0; r < n; r++) {
-        for (int c = 0; c < n; c++) {
-            //  Copying into temporary matrix only those element
-            //  which are not in given row and column
-            if (r != row && c != col) {
-                result(i, j++) = (*this)(r, c);
-
-                // Row is filled, so increase row index and
-                // reset col index
-                if (j == this->rows - 1) {
-                    j = 0;
-                    i++;
-                }
-            }
-        }
-    }
-    return result;
+    return m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
 }
 
-float Mat::det(int n)
+static float det3(const Mat &m)
 {
-    float D = 0; // Initialize result
-
-    //  Base case : if matrix contains single element
-    if (n == 1) {
-        return (*this)(0, 0);
-    }
-
-    Mat temp(this->rows, this->rows); // To store cofactors
-
-    int sign = 1;  // To store sign multiplier
-
-    // Iterate for each element of first row
-    for (int f = 0; f < n; f++) {
-        // Getting Cofactor of A[0][f]
-        Mat temp = this->cofactor(0, f, n);
-        D += (*this)(0, f) * temp.det(n - 1) * sign;
-
-        // terms are to be added with alternate sign
-        sign = -sign;
-    }
-
-    return D;
+    return m(0, 0) * (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1))
+           - m(0, 1) * (m(1, 0) * m(2, 2) - m(1, 2) * m(2, 0))
+           + m(0, 2) * (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0));
 }
 
-Mat Mat::adjoint()
+float Mat::det(int n)
 {
-    Mat adj(this->rows, this->cols);
-    if (this->rows == 1) {
-        adj(0, 0) = 1;
-        return adj;
+    if ((n == 2) && (this->rows >= 2) && (this->cols >= 2)) {
+        return det2(*this);
     }
-
-    // temp is used to store cofactors of A(,)
-    int sign = 1;
-    Mat temp(this->rows, this->cols);
-
-    for (int i = 0; i < this->rows; i++) {
-        for (int j = 0; j < this->cols; j++) {
-            // Get cofactor of A(i,j)
-            temp = this->cofactor( i, j, this->rows);
-
-            // sign of adj(j,i) positive if sum of row
-            // and column indexes is even.
-            sign = ((i + j) % 2 == 0) ? 1 : -1;
-
-            // Interchanging rows and columns to get the
-            // transpose of the cofactor matrix
-            adj(j, i) = (sign) * (temp.det(this->rows - 1));
-        }
+    if ((n == 3) && (this->rows >= 3) && (this->cols >= 3)) {
+        return det3(*this);
+    }
+    if ((n == this->rows) && (n == this->cols)) {
+        MatLU lu(*this);
+        return lu.det();
     }
-    return adj;
+    // determinant of the n x n top left block
+    MatLU lu(this->Get(0, n, 0, n));
+    return lu.det();
 }
 
 Mat Mat::inverse()
 {
+    if ((this->rows != this->cols) || (this->rows > 3)) {
+        MatLU lu(*this);
+        return lu.inverse();
+    }
     Mat result(this->rows, this->cols);
-    // Find determinant of matrix
-    float det = this->det(this->rows);
-    if (det == 0) {
-        //std::cout << "Singular matrix, can't find its inverse";
+    const Mat &m = *this;
+    float D = (this->rows == 1) ? m(0, 0) : (this->rows == 2) ? det2(m) : det3(m);
+    if (D == 0) {
+        result.clear();
         return result;
     }
-
-    // Find adjoint
-    Mat adj = this->adjoint();
-
-    // Find Inverse using formula "inverse(A) = adj(A)/det(A)"
-    for (int i = 0; i < this->rows; i++)
-        for (int j = 0; j < this->cols; j++) {
-            result(i, j) = adj(i, j) / float(det);
-        }
-
+    if (this->rows == 1) {
+        result(0, 0) = 1 / D;
+    } else if (this->rows == 2) {
+        result(0, 0) = m(1, 1);
+        result(0, 1) = -m(0, 1);
+        result(1, 0) = -m(1, 0);
+        result(1, 1) = m(0, 0);
+    } else {
+        // adjoint: transposed cofactors
+        result(0, 0) = m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1);
+        result(0, 1) = m(0, 2) * m(2, 1) - m(0, 1) * m(2, 2);
+        result(0, 2) = m(0, 1) * m(1, 2) - m(0, 2) * m(1, 1);
+        result(1, 0) = m(1, 2) * m(2, 0) - m(1, 0) * m(2, 2);
+        result(1, 1) = m(0, 0) * m(2, 2) - m(0, 2) * m(2, 0);
+        result(1, 2) = m(0, 2) * m(1, 0) - m(0, 0) * m(1, 2);
+        result(2, 0) = m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0);
+        result(2, 1) = m(0, 1) * m(2, 0) - m(0, 0) * m(2, 1);
+        result(2, 2) = m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+    }
+    if (this->rows > 1) {
+        result /= D;
+    }
     return result;
 }
 
@@ -826,49 +828,6 @@ void Mat::allocate()
     ESP_LOGD("Mat", "allocate(%i) = %p", this->length, this->data);
 }
 
-Mat Mat::expHelper(const Mat &m, int num)
-{
-    if (num == 0) {
-        return Mat::eye(m.rows);
-    } else if (num == 1) {
-        return m;
-    } else if (num % 2 == 0) {  // num is even
-        return expHelper(m * m, num / 2);
-    } else {                    // num is odd
-        return m * expHelper(m * m, (num - 1) / 2);
-    }
-}
-
-Mat operator+(const Mat &m1, const Mat &m2)
-{
-    if ((m1.rows != m2.rows) || (m1.cols != m2.cols)) {
-        ESP_LOGW("Mat", "operator + Error: matrices do not have equal dimensions");
-        Mat err_ret;
-        return err_ret;
-    }
-
-    if (m1.sub_matrix || m2.sub_matrix) {
-        Mat temp(m1.rows, m2.cols);
-        dspm_add_f32(m1.data, m2.data, temp.data, m1.rows, m1.cols, m1.padding, m2.padding, temp.padding, 1, 1, 1);
-        return temp;
-    } else {
-        Mat temp(m1);
-        return (temp += m2);
-    }
-}
-
-Mat operator+(const Mat &m, float C)
-{
-    if (m.sub_matrix) {
-        Mat temp(m.rows, m.cols);
-        dspm_addc_f32(m.data, temp.data, C, m.rows, m.cols, m.padding, temp.padding, 1, 1);
-        return temp;
-    } else {
-        Mat temp(m);
-        return (temp += C);
-    }
-}
-
 bool operator==(const Mat &m1, const Mat &m2)
 {
     if ((m1.cols != m2.cols) || (m1.rows != m2.rows)) {
@@ -887,101 +846,6 @@ bool operator==(const Mat &m1, const Mat &m2)
     return true;
 }
 
-Mat operator-(const Mat &m1, const Mat &m2)
-{
-    if ((m1.rows != m2.rows) || (m1.cols != m2.cols)) {
-        ESP_LOGW("Mat", "operator - Error: matrices do not have equal dimensions");
-        Mat err_ret;
-        return err_ret;
-    }
-
-    if (m1.sub_matrix || m2.sub_matrix) {
-        Mat temp(m1.rows, m1.cols);
-        dspm_sub_f32(m1.data, m2.data, temp.data, m1.rows, m1.cols, m1.padding, m2.padding, temp.padding, 1, 1, 1);
-        return temp;
-    } else {
-        Mat temp(m1);
-        return (temp -= m2);
-    }
-}
-
-Mat operator-(const Mat &m, float C)
-{
-    if (m.sub_matrix) {
-        Mat temp(m.rows, m.cols);
-        dspm_addc_f32(m.data, temp.data, -C, m.rows, m.cols, m.padding, temp.padding, 1, 1);
-        return temp;
-    } else {
-        Mat temp(m);
-        return (temp -= C);
-    }
-}
-
-Mat operator*(const Mat &m1, const Mat &m2)
-{
-    if (m1.cols != m2.rows) {
-        ESP_LOGW("Mat", "operator * Error: matrices do not have correct dimensions");
-        Mat err_ret;
-        return err_ret;
-    }
-    Mat temp(m1.rows, m2.cols);
-
-    if (m1.sub_matrix || m2.sub_matrix) {
-        dspm_mult_ex_f32(m1.data, m2.data, temp.data, m1.rows, m1.cols, m2.cols, m1.padding, m2.padding, temp.padding);
-    } else {
-        dspm_mult_f32(m1.data, m2.data, temp.data, m1.rows, m1.cols, m2.cols);
-    }
-
-    return temp;
-
-}
-
-Mat operator*(const Mat &m, float num)
-{
-    if (m.sub_matrix) {
-        Mat temp(m.rows, m.cols);
-        dspm_mulc_f32(m.data, temp.data, num, m.rows, m.cols, m.padding, temp.padding, 1, 1);
-        return temp;
-    } else {
-        Mat temp(m);
-        return (temp *= num);
-    }
-}
-
-Mat operator*(float num, const Mat &m)
-{
-    return (m * num);
-}
-
-Mat operator/(const Mat &m, float num)
-{
-    if (m.sub_matrix) {
-        Mat temp(m.rows, m.cols);
-        dspm_mulc_f32(m.data, temp.data, 1 / num, m.rows, m.cols, m.padding, temp.padding, 1, 1);
-        return temp;
-    } else {
-        Mat temp(m);
-        return (temp /= num);
-    }
-}
-
-Mat operator/(const Mat &A, const Mat &B)
-{
-    if ((A.rows != B.rows) || (A.cols != B.cols)) {
-        ESP_LOGW("Mat", "Operator + Error: matrices do not have equal dimensions");
-        Mat err_ret;
-        return err_ret;
-    }
-
-    Mat temp(A.rows, A.cols);
-    for (int row = 0; row < A.rows; row++) {
-        for (int col = 0; col < A.cols; col++) {
-            temp(row, col) = A(row, col) / B(row, col);
-        }
-    }
-    return temp;
-}
-
 ostream &operator<<(ostream &os, const Mat &m)
 {
     for (int i = 0; i < m.rows; ++i) {
@@ -0,0 +1,352 @@
+// Copyright 2018-2023 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "mat_decomp.h"
+#include "esp_log.h"
+
+#include "dsps_dotprod.h"
+
+namespace dspm {
+
+// Pivots below n * FLT_EPSILON times the largest element of the matrix are rounding noise:
+// the tolerance follows the scale of the matrix, so small matrices (e.g. covariances) are not
+// taken as singular
+static float pivot_tol(const Mat &A, bool diagonal)
+{
+    float max = 0;
+    for (int i = 0; i < A.rows; i++) {
+        if (diagonal) {
+            max = fmaxf(max, fabsf(A(i, i)));
+            continue;
+        }
+        for (int j = 0; j < A.cols; j++) {
+            max = fmaxf(max, fabsf(A(i, j)));
+        }
+    }
+    return A.rows * FLT_EPSILON * max;
+}
+
+MatLU::MatLU()
+{
+    this->pivot = NULL;
+    this->sign = 1;
+    this->valid = false;
+}
+
+MatLU::MatLU(const Mat &A)
+{
+    this->pivot = NULL;
+    this->sign = 1;
+    this->valid = false;
+    decompose(A);
+}
+
+MatLU::~MatLU()
+{
+    delete[] this->pivot;
+}
+
+bool MatLU::decompose(const Mat &A)
+{
+    this->valid = false;
+    if (A.rows != A.cols) {
+        ESP_LOGW("Mat", "LU Error: matrix %dx%d is not square", A.rows, A.cols);
+        return false;
+    }
+    const int n = A.rows;
+    if ((this->pivot == NULL) || (this->LU.rows != n)) {
+        delete[] this->pivot;
+        this->pivot = new int[n];
+    }
+    this->LU = A;
+    this->sign = 1;
+    const float tol = pivot_tol(A, false);
+    for (int i = 0; i < n; i++) {
+        this->pivot[i] = i;
+    }
+
+    float *lu = this->LU.data;
+    const int stride = this->LU.stride;
+    for (int k = 0; k < n; k++) {
+        // Partial pivoting: largest element of the column
+        int p = k;
+        float max = fabsf(lu[k * stride + k]);
+        for (int i = k + 1; i < n; i++) {
+            if (fabsf(lu[i * stride + k]) > max) {
+                max = fabsf(lu[i * stride + k]);
+                p = i;
+            }
+        }
+        if (max <= tol) {
+            return false;
+        }
+        if (p != k) {
+            this->LU.swapRows(p, k);
+            int temp = this->pivot[p];
+            this->pivot[p] = this->pivot[k];
+            this->pivot[k] = temp;
+            this->sign = -this->sign;
+        }
+
+        float inv_pivot = 1 / lu[k * stride + k];
+        const float *row_k = &lu[k * stride];
+        for (int i = k + 1; i < n; i++) {
+            float *row_i = &lu[i * stride];
+            float l = row_i[k] * inv_pivot;
+            row_i[k] = l;
+            for (int j = k + 1; j < n; j++) {
+                row_i[j] -= l * row_k[j];
+            }
+        }
+    }
+    this->valid = true;
+    return true;
+}
+
+float MatLU::det(void) const
+{
+    if (!this->valid) {
+        return 0;
+    }
+    float D = (float)this->sign;
+    for (int i = 0; i < this->LU.rows; i++) {
+        D *= this->LU(i, i);
+    }
+    return D;
+}
+
+void MatLU::substitute(Mat &x) const
+{
+    const int n = this->LU.rows;
+    const int m = x.cols;
+    // L*y = P*b, unit diagonal
+    for (int i = 1; i < n; i++) {
+        float *x_i = &x.data[i * x.stride];
+        for (int k = 0; k < i; k++) {
+            float l = this->LU(i, k);
+            const float *x_k = &x.data[k * x.stride];
+            for (int j = 0; j < m; j++) {
+                x_i[j] -= l * x_k[j];
+            }
+        }
+    }
+    // U*x = y
+    for (int i = n - 1; i >= 0; i--) {
+        float *x_i = &x.data[i * x.stride];
+        for (int k = i + 1; k < n; k++) {
+            float u = this->LU(i, k);
+            const float *x_k = &x.data[k * x.stride];
+            for (int j = 0; j < m; j++) {
+                x_i[j] -= u * x_k[j];
+            }
+        }
+        float inv_u = 1 / this->LU(i, i);
+        for (int j = 0; j < m; j++) {
+            x_i[j] *= inv_u;
+        }
+    }
+}
+
+bool MatLU::solve(const Mat &b, Mat &x) const
+{
+    if (!this->valid || (b.rows != this->LU.rows)) {
+        ESP_LOGW("Mat", "LU solve Error: no decomposition, or %d rows instead of %d", b.rows, this->LU.rows);
+        return false;
+    }
+    if ((x.rows != b.rows) || (x.cols != b.cols)) {
+        x = Mat(b.rows, b.cols);
+        if ((x.rows != b.rows) || (x.cols != b.cols)) {
+            return false;
+        }
+    }
+    for (int i = 0; i < b.rows; i++) {
+        memcpy(&x.data[i * x.stride], &b.data[this->pivot[i] * b.stride], b.cols * sizeof(float));
+    }
+    substitute(x);
+    return true;
+}
+
+Mat MatLU::solve(const Mat &b) const
+{
+    Mat x(b.rows, b.cols);
+    if (!solve(b, x)) {
+        Mat err_result(0, 0);
+        return err_result;
+    }
+    return x;
+}
+
+Mat MatLU::inverse(void) const
+{
+    const int n = this->LU.rows;
+    Mat result(n, n);
+    result.clear();
+    if (!this->valid) {
+        return result;
+    }
+    // Columns of the permuted identity
+    for (int i = 0; i < n; i++) {
+        result(i, this->pivot[i]) = 1;
+    }
+    substitute(result);
+    return result;
+}
+
+MatCholesky::MatCholesky()
+{
+    this->valid = false;
+}
+
+MatCholesky::MatCholesky(const Mat &A)
+{
+    this->valid = false;
+    decompose(A);
+}
+
+bool MatCholesky::decompose(const Mat &A)
+{
+    this->valid = false;
+    if (A.rows != A.cols) {
+        ESP_LOGW("Mat", "Cholesky Error: matrix %dx%d is not square", A.rows, A.cols);
+        return false;
+    }
+    const int n = A.rows;
+    if ((this->L.rows != n) || (this->L.cols != n)) {
+        this->L = Mat(n, n);
+    }
+    this->L.clear();
+    // The largest element of a positive definite matrix is on the diagonal
+    const float tol = pivot_tol(A, true);
+
+    float *l = this->L.data;
+    const int stride = this->L.stride;
+    for (int j = 0; j < n; j++) {
+        // Row j of L until the diagonal: dot products of the rows already computed
+        float sum = 0;
+        if (j > 0) {
+            dsps_dotprod_f32(&l[j * stride], &l[j * stride], &sum, j);
+        }
+        float d = A(j, j) - sum;
+        if (d <= tol) {
+            return false;
+        }
+        d = sqrtf(d);
+        l[j * stride + j] = d;
+        float inv_d = 1 / d;
+        for (int i = j + 1; i < n; i++) {
+            if (j > 0) {
+                dsps_dotprod_f32(&l[i * stride], &l[j * stride], &sum, j);
+            }
+            l[i * stride + j] = (A(i, j) - sum) * inv_d;
+        }
+    }
+    this->valid = true;
+    return true;
+}
+
+float MatCholesky::det(void) const
+{
+    if (!this->valid) {
+        return 0;
+    }
+    float D = 1;
+    for (int i = 0; i < this->L.rows; i++) {
+        D *= this->L(i, i);
+    }
+    return D * D;
+}
+
+void MatCholesky::substitute(Mat &x) const
+{
+    const int n = this->L.rows;
+    const int m = x.cols;
+    // L*y = b
+    for (int i = 0; i < n; i++) {
+        float *x_i = &x.data[i * x.stride];
+        for (int k = 0; k < i; k++) {
+            float l = this->L(i, k);
+            const float *x_k = &x.data[k * x.stride];
+            for (int j = 0; j < m; j++) {
+                x_i[j] -= l * x_k[j];
+            }
+        }
+        float inv_l = 1 / this->L(i, i);
+        for (int j = 0; j < m; j++) {
+            x_i[j] *= inv_l;
+        }
+    }
+    // L'*x = y
+    for (int i = n - 1; i >= 0; i--) {
+        float *x_i = &x.data[i * x.stride];
+        for (int k = i + 1; k < n; k++) {
+            float l = this->L(k, i);
+            const float *x_k = &x.data[k * x.stride];
+            for (int j = 0; j < m; j++) {
+                x_i[j] -= l * x_k[j];
+            }
+        }
+        float inv_l = 1 / this->L(i, i);
+        for (int j = 0; j < m; j++) {
+            x_i[j] *= inv_l;
+        }
+    }
+}
+
+bool MatCholesky::solve(const Mat &b, Mat &x) const
+{
+    if (!this->valid || (b.rows != this->L.rows)) {
+        ESP_LOGW("Mat", "Cholesky solve Error: no decomposition, or %d rows instead of %d", b.rows, this->L.rows);
+        return false;
+    }
+    if ((x.rows != b.rows) || (x.cols != b.cols)) {
+        x = Mat(b.rows, b.cols);
+        if ((x.rows != b.rows) || (x.cols != b.cols)) {
+            return false;
+        }
+    }
+    if (x.data != b.data) {
+        for (int i = 0; i < b.rows; i++) {
+            memcpy(&x.data[i * x.stride], &b.data[i * b.stride], b.cols * sizeof(float));
+        }
+    }
+    substitute(x);
+    return true;
+}
+
+Mat MatCholesky::solve(const Mat &b) const
+{
+    Mat x(b.rows, b.cols);
+    if (!solve(b, x)) {
+        Mat err_result(0, 0);
+        return err_result;
+    }
+    return x;
+}
+
+Mat MatCholesky::inverse(void) const
+{
+    const int n = this->L.rows;
+    Mat result = Mat::eye(n);
+    if (!this->valid) {
+        result.clear();
+        return result;
+    }
+    substitute(result);
+    return result;
+}
+
+}
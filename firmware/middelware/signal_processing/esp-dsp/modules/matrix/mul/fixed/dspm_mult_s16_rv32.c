@@ -0,0 +1,120 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include "dspm_mult.h"
+
+// The sums are 32 bit (one add per product instead of the 64 bit accumulator of
+// dspm_mult_s16_ansi()). They wrap modulo 2^32, but the 16 bit result only takes the bits
+// 15 - shift to 30 - shift of the sum, which are exact: bit exact with the _ansi kernel for
+// shift >= 0. The products are added as unsigned to keep the wrap defined.
+
+static inline int16_t dspm_mult_s16_result(uint32_t acc, int final_shift)
+{
+    if (final_shift > 0) {
+        return (int16_t)(acc << final_shift);
+    }
+    return (int16_t)((int32_t)acc >> (-final_shift));
+}
+
+// C[4][4] block at C = A[4][n] * B[n][4] of a matrix of k columns, the 16 sums in registers
+static inline void dspm_mult_4x4_block_s16(const int16_t *A, const int16_t *B, int16_t *C, int n, int k, uint32_t round, int final_shift)
+{
+    const int16_t *a0 = A;
+    const int16_t *a1 = A + n;
+    const int16_t *a2 = A + 2 * n;
+    const int16_t *a3 = A + 3 * n;
+    uint32_t c00 = round, c01 = round, c02 = round, c03 = round;
+    uint32_t c10 = round, c11 = round, c12 = round, c13 = round;
+    uint32_t c20 = round, c21 = round, c22 = round, c23 = round;
+    uint32_t c30 = round, c31 = round, c32 = round, c33 = round;
+    for (int s = 0 ; s < n ; s++) {
+        int32_t b0 = B[0];
+        int32_t b1 = B[1];
+        int32_t b2 = B[2];
+        int32_t b3 = B[3];
+        int32_t a = a0[s];
+        c00 += (uint32_t)(a * b0);
+        c01 += (uint32_t)(a * b1);
+        c02 += (uint32_t)(a * b2);
+        c03 += (uint32_t)(a * b3);
+        a = a1[s];
+        c10 += (uint32_t)(a * b0);
+        c11 += (uint32_t)(a * b1);
+        c12 += (uint32_t)(a * b2);
+        c13 += (uint32_t)(a * b3);
+        a = a2[s];
+        c20 += (uint32_t)(a * b0);
+        c21 += (uint32_t)(a * b1);
+        c22 += (uint32_t)(a * b2);
+        c23 += (uint32_t)(a * b3);
+        a = a3[s];
+        c30 += (uint32_t)(a * b0);
+        c31 += (uint32_t)(a * b1);
+        c32 += (uint32_t)(a * b2);
+        c33 += (uint32_t)(a * b3);
+        B += k;
+    }
+    C[0] = dspm_mult_s16_result(c00, final_shift);
+    C[1] = dspm_mult_s16_result(c01, final_shift);
+    C[2] = dspm_mult_s16_result(c02, final_shift);
+    C[3] = dspm_mult_s16_result(c03, final_shift);
+    C += k;
+    C[0] = dspm_mult_s16_result(c10, final_shift);
+    C[1] = dspm_mult_s16_result(c11, final_shift);
+    C[2] = dspm_mult_s16_result(c12, final_shift);
+    C[3] = dspm_mult_s16_result(c13, final_shift);
+    C += k;
+    C[0] = dspm_mult_s16_result(c20, final_shift);
+    C[1] = dspm_mult_s16_result(c21, final_shift);
+    C[2] = dspm_mult_s16_result(c22, final_shift);
+    C[3] = dspm_mult_s16_result(c23, final_shift);
+    C += k;
+    C[0] = dspm_mult_s16_result(c30, final_shift);
+    C[1] = dspm_mult_s16_result(c31, final_shift);
+    C[2] = dspm_mult_s16_result(c32, final_shift);
+    C[3] = dspm_mult_s16_result(c33, final_shift);
+}
+
+// Element by element product of a rows x cols edge block (less than 4 rows or columns)
+static void dspm_mult_edge_s16(const int16_t *A, const int16_t *B, int16_t *C, int rows, int cols, int n, int k, uint32_t round, int final_shift)
+{
+    for (int i = 0 ; i < rows ; i++) {
+        for (int j = 0 ; j < cols ; j++) {
+            uint32_t acc = round;
+            for (int s = 0 ; s < n ; s++) {
+                acc += (uint32_t)((int32_t)A[i * n + s] * (int32_t)B[s * k + j]);
+            }
+            C[i * k + j] = dspm_mult_s16_result(acc, final_shift);
+        }
+    }
+}
+
+// Matrinx A(m,n), m - amount or rows, n - amount of columns
+// C(m,k) = A(m,n)*B(n,k), in 4x4 register blocks
+esp_err_t dspm_mult_s16_rv32(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int shift)
+{
+    int final_shift = shift - 15;
+    uint32_t round = (uint32_t)(0x7fff >> shift);
+    int m4 = m & ~3;
+    int k4 = k & ~3;
+    for (int i = 0 ; i < m4 ; i += 4) {
+        for (int j = 0 ; j < k4 ; j += 4) {
+            dspm_mult_4x4_block_s16(&A[i * n], &B[j], &C[i * k + j], n, k, round, final_shift);
+        }
+        dspm_mult_edge_s16(&A[i * n], &B[k4], &C[i * k + k4], 4, k - k4, n, k, round, final_shift);
+    }
+    dspm_mult_edge_s16(&A[m4 * n], B, &C[m4 * k], m - m4, k, n, k, round, final_shift);
+    return ESP_OK;
+}
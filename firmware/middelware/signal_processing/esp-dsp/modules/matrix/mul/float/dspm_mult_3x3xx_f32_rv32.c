@@ -0,0 +1,48 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dspm_mult.h"
+
+// Fully unrolled 3x3 products: the 9 (or 3) sums in registers, each row of A and the
+// columns of B loaded once, sums in the order of dspm_mult_f32_ansi()
+
+esp_err_t dspm_mult_3x3x1_f32_rv32(const float *A, const float *B, float *C)
+{
+    float b0 = B[0];
+    float b1 = B[1];
+    float b2 = B[2];
+    for (int i = 0 ; i < 3 ; i++) {
+        C[i] = A[0] * b0 + A[1] * b1 + A[2] * b2;
+        A += 3;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dspm_mult_3x3x3_f32_rv32(const float *A, const float *B, float *C)
+{
+    float b00 = B[0], b01 = B[1], b02 = B[2];
+    float b10 = B[3], b11 = B[4], b12 = B[5];
+    float b20 = B[6], b21 = B[7], b22 = B[8];
+    for (int i = 0 ; i < 3 ; i++) {
+        float a0 = A[0];
+        float a1 = A[1];
+        float a2 = A[2];
+        C[0] = a0 * b00 + a1 * b10 + a2 * b20;
+        C[1] = a0 * b01 + a1 * b11 + a2 * b21;
+        C[2] = a0 * b02 + a1 * b12 + a2 * b22;
+        A += 3;
+        C += 3;
+    }
+    return ESP_OK;
+}
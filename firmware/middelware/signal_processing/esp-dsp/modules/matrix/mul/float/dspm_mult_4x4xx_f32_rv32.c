@@ -0,0 +1,48 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dspm_mult.h"
+
+// Fully unrolled 4x4 products: one row of A in registers against the columns of B, sums in
+// the order of dspm_mult_f32_ansi()
+
+esp_err_t dspm_mult_4x4x1_f32_rv32(const float *A, const float *B, float *C)
+{
+    float b0 = B[0];
+    float b1 = B[1];
+    float b2 = B[2];
+    float b3 = B[3];
+    for (int i = 0 ; i < 4 ; i++) {
+        C[i] = A[0] * b0 + A[1] * b1 + A[2] * b2 + A[3] * b3;
+        A += 4;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dspm_mult_4x4x4_f32_rv32(const float *A, const float *B, float *C)
+{
+    for (int i = 0 ; i < 4 ; i++) {
+        float a0 = A[0];
+        float a1 = A[1];
+        float a2 = A[2];
+        float a3 = A[3];
+        C[0] = a0 * B[0] + a1 * B[4] + a2 * B[8] + a3 * B[12];
+        C[1] = a0 * B[1] + a1 * B[5] + a2 * B[9] + a3 * B[13];
+        C[2] = a0 * B[2] + a1 * B[6] + a2 * B[10] + a3 * B[14];
+        C[3] = a0 * B[3] + a1 * B[7] + a2 * B[11] + a3 * B[15];
+        A += 4;
+        C += 4;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,130 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dspm_mult.h"
+
+// C[4][4] block at C = A[4][n] * B[n][4] of a matrix of k columns (A rows of n, B rows of k).
+// The 16 sums stay in registers: each A and B value is loaded once per block instead of once
+// per product, and every sum is done in the order of dspm_mult_f32_ansi() (same result).
+static inline void dspm_mult_4x4_block_f32(const float *A, const float *B, float *C, int n, int k)
+{
+    const float *a0 = A;
+    const float *a1 = A + n;
+    const float *a2 = A + 2 * n;
+    const float *a3 = A + 3 * n;
+    float b0 = B[0];
+    float b1 = B[1];
+    float b2 = B[2];
+    float b3 = B[3];
+    float c00 = a0[0] * b0, c01 = a0[0] * b1, c02 = a0[0] * b2, c03 = a0[0] * b3;
+    float c10 = a1[0] * b0, c11 = a1[0] * b1, c12 = a1[0] * b2, c13 = a1[0] * b3;
+    float c20 = a2[0] * b0, c21 = a2[0] * b1, c22 = a2[0] * b2, c23 = a2[0] * b3;
+    float c30 = a3[0] * b0, c31 = a3[0] * b1, c32 = a3[0] * b2, c33 = a3[0] * b3;
+    for (int s = 1 ; s < n ; s++) {
+        B += k;
+        b0 = B[0];
+        b1 = B[1];
+        b2 = B[2];
+        b3 = B[3];
+        float a = a0[s];
+        c00 += a * b0;
+        c01 += a * b1;
+        c02 += a * b2;
+        c03 += a * b3;
+        a = a1[s];
+        c10 += a * b0;
+        c11 += a * b1;
+        c12 += a * b2;
+        c13 += a * b3;
+        a = a2[s];
+        c20 += a * b0;
+        c21 += a * b1;
+        c22 += a * b2;
+        c23 += a * b3;
+        a = a3[s];
+        c30 += a * b0;
+        c31 += a * b1;
+        c32 += a * b2;
+        c33 += a * b3;
+    }
+    C[0] = c00;
+    C[1] = c01;
+    C[2] = c02;
+    C[3] = c03;
+    C += k;
+    C[0] = c10;
+    C[1] = c11;
+    C[2] = c12;
+    C[3] = c13;
+    C += k;
+    C[0] = c20;
+    C[1] = c21;
+    C[2] = c22;
+    C[3] = c23;
+    C += k;
+    C[0] = c30;
+    C[1] = c31;
+    C[2] = c32;
+    C[3] = c33;
+}
+
+// Element by element product of a rows x cols edge block (less than 4 rows or columns)
+static void dspm_mult_edge_f32(const float *A, const float *B, float *C, int rows, int cols, int n, int k)
+{
+    for (int i = 0 ; i < rows ; i++) {
+        for (int j = 0 ; j < cols ; j++) {
+            float acc = A[i * n] * B[j];
+            for (int s = 1 ; s < n ; s++) {
+                acc += A[i * n + s] * B[s * k + j];
+            }
+            C[i * k + j] = acc;
+        }
+    }
+}
+
+// Matrinx A(m,n), m - amount or rows, n - amount of columns
+// C(m,k) = A(m,n)*B(n,k)
+// 3x3 and 4x4 products go to their unrolled kernels, the rest is split in 4x4 register blocks
+esp_err_t dspm_mult_f32_rv32(const float *A, const float *B, float *C, int m, int n, int k)
+{
+    if ((m == 3) && (n == 3)) {
+        if (k == 3) {
+            return dspm_mult_3x3x3_f32_rv32(A, B, C);
+        }
+        if (k == 1) {
+            return dspm_mult_3x3x1_f32_rv32(A, B, C);
+        }
+    }
+    if ((m == 4) && (n == 4)) {
+        if (k == 4) {
+            return dspm_mult_4x4x4_f32_rv32(A, B, C);
+        }
+        if (k == 1) {
+            return dspm_mult_4x4x1_f32_rv32(A, B, C);
+        }
+    }
+    if (n <= 0) {
+        return ESP_OK;
+    }
+    int m4 = m & ~3;
+    int k4 = k & ~3;
+    for (int i = 0 ; i < m4 ; i += 4) {
+        for (int j = 0 ; j < k4 ; j += 4) {
+            dspm_mult_4x4_block_f32(&A[i * n], &B[j], &C[i * k + j], n, k);
+        }
+        dspm_mult_edge_f32(&A[i * n], &B[k4], &C[i * k + k4], 4, k - k4, n, k);
+    }
+    dspm_mult_edge_f32(&A[m4 * n], B, &C[m4 * k], m - m4, k, n, k);
+    return ESP_OK;
+}
@@ -30,6 +30,8 @@ extern "C"
  * Matrix multiplication for two floating point matrices: C[m][k] = A[m][n] * B[n][k]
  * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
  * The extension (_ae32) is optimized for ESP32 chip.
+ * The extension (_rv32) is plain C in 4x4 register blocks for RV32 (ESP32-C6), with the
+ * 3x3 and 4x4 products sent to dspm_mult_3x3xx_f32_rv32/dspm_mult_4x4xx_f32_rv32.
  *
  * @param[in] A  input matrix A[m][n]
  * @param[in] B  input matrix B[n][k]
@@ -42,6 +44,7 @@ extern "C"
  *      - One of the error codes from DSP library
  */
 esp_err_t dspm_mult_f32_ansi(const float *A, const float *B, float *C, int m, int n, int k);
+esp_err_t dspm_mult_f32_rv32(const float *A, const float *B, float *C, int m, int n, int k);
 esp_err_t dspm_mult_f32_ae32(const float *A, const float *B, float *C, int m, int n, int k);
 esp_err_t dspm_mult_f32_aes3(const float *A, const float *B, float *C, int m, int n, int k);
 /**@}*/
@@ -61,6 +64,7 @@ esp_err_t dspm_mult_f32_aes3(const float *A, const float *B, float *C, int m, in
  *      - One of the error codes from DSP library
  */
 esp_err_t dspm_mult_3x3x1_f32_ae32(const float *A, const float *B, float *C);
+esp_err_t dspm_mult_3x3x1_f32_rv32(const float *A, const float *B, float *C);
 
 /**
  * @brief   Matrix multiplication A[3x3]xB[3x3]
@@ -76,6 +80,7 @@ esp_err_t dspm_mult_3x3x1_f32_ae32(const float *A, const float *B, float *C);
  *      - One of the error codes from DSP library
  */
 esp_err_t dspm_mult_3x3x3_f32_ae32(const float *A, const float *B, float *C);
+esp_err_t dspm_mult_3x3x3_f32_rv32(const float *A, const float *B, float *C);
 
 /**
  * @brief   Matrix multiplication A[4x4]xB[4x1]
@@ -92,6 +97,7 @@ esp_err_t dspm_mult_3x3x3_f32_ae32(const float *A, const float *B, float *C);
  */
 
 esp_err_t dspm_mult_4x4x1_f32_ae32(const float *A, const float *B, float *C);
+esp_err_t dspm_mult_4x4x1_f32_rv32(const float *A, const float *B, float *C);
 
 /**
  * @brief   Matrix multiplication A[4x4]xB[4x4]
@@ -107,6 +113,30 @@ esp_err_t dspm_mult_4x4x1_f32_ae32(const float *A, const float *B, float *C);
  *      - One of the error codes from DSP library
  */
 esp_err_t dspm_mult_4x4x4_f32_ae32(const float *A, const float *B, float *C);
+esp_err_t dspm_mult_4x4x4_f32_rv32(const float *A, const float *B, float *C);
+
+/**@{*/
+/**
+ * @brief   Matrix multiplication by a transposed matrix
+ *
+ * Matrix multiplication for two floating point matrices: C[m][k] = A[m][n] * B[k][n]'
+ * Both operands are read along their rows, as for P*F' or H*P*H' products.
+ * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
+ * The extension (_rv32) is plain C in 4x4 register blocks for RV32 (ESP32-C6).
+ *
+ * @param[in] A  input matrix A[m][n]
+ * @param[in] B  input matrix B[k][n]
+ * @param C  result matrix C[m][k]
+ * @param[in] m  matrix dimension
+ * @param[in] n  matrix dimension
+ * @param[in] k  matrix dimension
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dspm_mult_bt_f32_ansi(const float *A, const float *B, float *C, int m, int n, int k);
+esp_err_t dspm_mult_bt_f32_rv32(const float *A, const float *B, float *C, int m, int n, int k);
+/**@}*/
 
 /**@{*/
 /**
@@ -115,6 +145,7 @@ esp_err_t dspm_mult_4x4x4_f32_ae32(const float *A, const float *B, float *C);
  * Matrix multiplication for two signed 16 bit fixed point matrices: C[m][k] = (A[m][n] * B[n][k]) >> (15- shift)
  * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
  * The extension (_ae32) is optimized for ESP32 chip.
+ * The extension (_rv32) accumulates in 32 bit, 4x4 register blocks (bit exact for shift >= 0).
  *
  * @param[in] A  input matrix A[m][n]
  * @param[in] B  input matrix B[n][k]
@@ -128,6 +159,7 @@ esp_err_t dspm_mult_4x4x4_f32_ae32(const float *A, const float *B, float *C);
  *      - One of the error codes from DSP library
  */
 esp_err_t dspm_mult_s16_ansi(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int shift);
+esp_err_t dspm_mult_s16_rv32(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int shift);
 esp_err_t dspm_mult_s16_ae32(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int shift);
 esp_err_t dspm_mult_s16_aes3(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int shift);
 /**@}*/
@@ -218,5 +250,28 @@ esp_err_t dspm_mult_ex_f32_aes3(const float *A, const float *B, float *C, int m,
 #define dspm_mult_ex_f32 dspm_mult_ex_f32_ansi
 #endif // CONFIG_DSP_OPTIMIZED
 
+#define dspm_mult_bt_f32 dspm_mult_bt_f32_ansi
+
+// The _rv32 kernels are plain C, selected independently of CONFIG_DSP_OPTIMIZED (Xtensa only).
+// dspm_mult_f32_rv32 itself sends the 3x3 and 4x4 products to the unrolled kernels.
+#if (dspm_mult_s16_rv32_enabled == 1)
+#undef dspm_mult_s16
+#define dspm_mult_s16 dspm_mult_s16_rv32
+#endif
+#if (dspm_mult_f32_rv32_enabled == 1)
+#undef dspm_mult_f32
+#define dspm_mult_f32 dspm_mult_f32_rv32
+#undef dspm_mult_bt_f32
+#define dspm_mult_bt_f32 dspm_mult_bt_f32_rv32
+#undef dspm_mult_3x3x1_f32
+#define dspm_mult_3x3x1_f32 dspm_mult_3x3x1_f32_rv32
+#undef dspm_mult_3x3x3_f32
+#define dspm_mult_3x3x3_f32 dspm_mult_3x3x3_f32_rv32
+#undef dspm_mult_4x4x1_f32
+#define dspm_mult_4x4x1_f32 dspm_mult_4x4x1_f32_rv32
+#undef dspm_mult_4x4x4_f32
+#define dspm_mult_4x4x4_f32 dspm_mult_4x4x4_f32_rv32
+#endif
+
 
 #endif // _dspm_mult_H_
@@ -30,4 +30,11 @@
 #define dspm_mult_s16_aes3_enabled 1
 #endif
 
+// RV32IMAC (ESP32-C6): C kernels tuned for the core, selected by default unless
+// CONFIG_DSP_ANSI forces the reference implementations
+#if defined(__riscv) && (__riscv_xlen == 32) && !CONFIG_DSP_ANSI
+#define dspm_mult_s16_rv32_enabled 1
+#define dspm_mult_f32_rv32_enabled 1
+#endif // __riscv
+
 #endif // _dspm_mult_platform_H_
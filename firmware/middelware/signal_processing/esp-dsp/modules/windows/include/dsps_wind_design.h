@@ -0,0 +1,124 @@
+// Copyright 2018-2023 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dsps_wind_design_H_
+#define _dsps_wind_design_H_
+
+#include "dsp_constexpr.h"
+
+/**
+* @brief Compile time window tables (C++14, header only).
+*
+*   The windows of dsps_wind_*_f32() (symmetric, len - 1 in the denominator, same
+*   coefficients) as constant expressions, so a table of a known length can be a constexpr
+*   object in flash instead of a RAM buffer filled at run time. Example:
+*       static constexpr auto hann = dsps_design::wind_hann<256>();
+*       ... signal[i] * hann.values[i] ...
+*/
+namespace dsps_design {
+
+/**
+ * Window table of Len values
+ */
+template <int Len>
+struct window {
+    static const int LEN = Len;     /*!< Number of values*/
+    float values[Len];              /*!< Window values*/
+};
+
+namespace detail {
+
+// a0 - a1 * cos(x) + a2 * cos(2x) - a3 * cos(3x) + a4 * cos(4x), x = 2 * pi * i / (len - 1)
+template <int Len>
+constexpr window<Len> cosine_sum(double a0, double a1, double a2, double a3, double a4)
+{
+    static_assert(Len > 1, "Window length must be at least 2");
+    window<Len> table{};
+    for (int i = 0; i < Len; i++) {
+        double x = 2 * dsp_constexpr::pi * i / (Len - 1);
+        // Terms of 0 weight are skipped, the compile time evaluation is the costly part
+        double value = a0 - a1 * dsp_constexpr::cos(x);
+        if (a2 != 0) {
+            value += a2 * dsp_constexpr::cos(2 * x);
+        }
+        if (a3 != 0) {
+            value -= a3 * dsp_constexpr::cos(3 * x);
+        }
+        if (a4 != 0) {
+            value += a4 * dsp_constexpr::cos(4 * x);
+        }
+        table.values[i] = (float)value;
+    }
+    return table;
+}
+
+} // namespace detail
+
+/**
+ * Hann window, as dsps_wind_hann_f32()
+ */
+template <int Len>
+constexpr window<Len> wind_hann()
+{
+    return detail::cosine_sum<Len>(0.5, 0.5, 0, 0, 0);
+}
+
+/**
+ * Blackman window, as dsps_wind_blackman_f32()
+ */
+template <int Len>
+constexpr window<Len> wind_blackman()
+{
+    return detail::cosine_sum<Len>(0.42, 0.5, 0.08, 0, 0);
+}
+
+/**
+ * Blackman-Harris window, as dsps_wind_blackman_harris_f32()
+ */
+template <int Len>
+constexpr window<Len> wind_blackman_harris()
+{
+    return detail::cosine_sum<Len>(0.35875, 0.48829, 0.14128, 0.01168, 0);
+}
+
+/**
+ * Blackman-Nuttall window, as dsps_wind_blackman_nuttall_f32()
+ */
+template <int Len>
+constexpr window<Len> wind_blackman_nuttall()
+{
+    return detail::cosine_sum<Len>(0.3635819, 0.4891775, 0.1365995, 0.0106411, 0);
+}
+
+/**
+ * Nuttall window, as dsps_wind_nuttall_f32()
+ */
+template <int Len>
+constexpr window<Len> wind_nuttall()
+{
+    return detail::cosine_sum<Len>(0.355768, 0.487396, 0.144232, 0.012604, 0);
+}
+
+/**
+ * Flat-Top window, as dsps_wind_flat_top_f32()
+ */
+template <int Len>
+constexpr window<Len> wind_flat_top()
+{
+    return detail::cosine_sum<Len>(0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368);
+}
+
+} // namespace dsps_design
+
+#endif // _dsps_wind_design_H_
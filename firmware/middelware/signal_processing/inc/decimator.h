@@ -0,0 +1,141 @@
+#ifndef DECIMATOR_H_
+#define DECIMATOR_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Decimator Decimator
+ */
+
+/** \brief Fixed point decimation of oversampled ADC streams
+ *
+ * A decimator_t is a chain of anti-aliasing FIR stages, each one filtering and decimating
+ * the output of the previous one (e.g. 80 kHz -> 3 halfband stages -> 10 kHz -> decimation
+ * by 10 -> 1 kHz). Averaging many oversampled ADC readings per output sample rises the SNR
+ * well above single-shot sampling, with the extra resolution kept in the Q15 output.
+ *
+ * Stages are computed in Q15 only at the output rate (polyphase decimation):
+ *  - DecimatorAddStage(): Blackman windowed sinc FIR run with esp-dsp dsps_fird_s16.
+ *  - DecimatorAddHalfband(): decimation by 2 with a halfband FIR. Every other coefficient is
+ *    zero and the rest are symmetric, so each output only takes (n_taps + 1) / 4 products.
+ *
+ * Frames are processed in place, so ADC buffers can be decimated without extra copies.
+ * Filters have unity DC gain but the windowed sinc ripple can overshoot a few percent,
+ * so leave one bit of headroom in the input (e.g. 12 bit ADC readings shifted by 3).
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsps_fir.h"
+/*==================[macros]=================================================*/
+#define DECIMATOR_MAX_STAGES    4
+/*==================[typedef]================================================*/
+/**
+ * @brief Decimation stage
+ */
+typedef struct {
+    uint8_t decimation;         /*!< Decimation factor */
+    bool halfband;              /*!< Halfband fast path */
+    uint16_t n_taps;            /*!< FIR length */
+    int16_t * coeffs;           /*!< Q15 coefficients (halfband: non zero side taps only) */
+    int16_t * delay;            /*!< Delay line (halfband: 2 * n_taps mirrored values) */
+    uint16_t pos;               /*!< Position in the halfband delay line */
+    fir_s16_t fir;              /*!< dsps_fird_s16 filter */
+} decimator_stage_t;
+
+/**
+ * @brief Chain of decimation stages
+ */
+typedef struct {
+    uint8_t n_stages;                                   /*!< Stages in use */
+    uint16_t decimation;                                /*!< Total decimation factor */
+    decimator_stage_t stages[DECIMATOR_MAX_STAGES];     /*!< Stages, in processing order */
+} decimator_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize an empty decimation chain
+ *
+ * @param decimator         Decimator to initialize
+ */
+void DecimatorInit(decimator_t * decimator);
+
+/**
+ * @brief Release the memory of all the stages
+ *
+ * @param decimator         Decimator
+ */
+void DecimatorDestroy(decimator_t * decimator);
+
+/**
+ * @brief Append a windowed sinc decimation stage
+ *
+ * Cut-off frequency is 0.8 times the output Nyquist frequency.
+ *
+ * @param decimator         Decimator
+ * @param decimation        Decimation factor of the stage
+ * @param n_taps            FIR length (several times the decimation factor)
+ * @return true             Stage added
+ * @return false            No free stages, invalid parameters or not enough memory
+ */
+bool DecimatorAddStage(decimator_t * decimator, uint8_t decimation, uint16_t n_taps);
+
+/**
+ * @brief Append a decimation stage with given coefficients
+ *
+ * @param decimator         Decimator
+ * @param decimation        Decimation factor of the stage
+ * @param coeffs            Q15 FIR coefficients
+ * @param n_taps            FIR length
+ * @return true             Stage added
+ * @return false            No free stages, invalid parameters or not enough memory
+ */
+bool DecimatorAddStageCoefficients(decimator_t * decimator, uint8_t decimation, const int16_t * coeffs, uint16_t n_taps);
+
+/**
+ * @brief Append a halfband decimation by 2 stage
+ *
+ * @param decimator         Decimator
+ * @param n_taps            FIR length (4 * k - 1: 7, 11, 15, 19, ...)
+ * @return true             Stage added
+ * @return false            No free stages, invalid length or not enough memory
+ */
+bool DecimatorAddHalfband(decimator_t * decimator, uint16_t n_taps);
+
+/**
+ * @brief Clear the delay lines of every stage
+ *
+ * @param decimator         Decimator
+ */
+void DecimatorReset(decimator_t * decimator);
+
+/**
+ * @brief Filter and decimate a frame in place
+ *
+ * @note  Lenght of the frame must be a multiple of the total decimation factor. Low rate
+ * samples are written at the beginning of the frame.
+ *
+ * @param decimator         Decimator
+ * @param signal            Q15 high rate frame, overwritten with the low rate samples
+ * @param signal_lenght     Number of high rate samples
+ * @return uint16_t         Number of low rate samples (0 if the lenght is not valid)
+ */
+uint16_t DecimatorProcess(decimator_t * decimator, int16_t * signal, uint16_t signal_lenght);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* DECIMATOR_H_ */
+
+/*==================[end of file]============================================*/
\ No newline at end of file
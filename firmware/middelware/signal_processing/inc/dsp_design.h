@@ -0,0 +1,95 @@
+#ifndef DSP_DESIGN_H_
+#define DSP_DESIGN_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup DSP_Design Compile time filter and window design
+ */
+
+/** \brief Window tables and biquad cascades generated at compile time, in flash
+ *
+ * C interface of the constexpr esp-dsp design headers (dsps_wind_design.h and
+ * dsps_biquad_design.h, C++14):
+ *
+ *  - DSPDesignWindow() gives the Hann, Blackman, Nuttall and Flat-Top tables of the power of
+ *    two lengths from DSP_DESIGN_WINDOW_MIN_LENGHT to DSP_DESIGN_WINDOW_MAX_LENGHT, the same
+ *    values as FFTWindowGenerate(). FFT plans point to them instead of allocating and
+ *    generating their window, other windows and lengths are still generated at run time.
+ *  - DSP_DESIGN_SOS() defines, in a C++ source file, a Butterworth, Chebyshev or notch
+ *    cascade evaluated by the compiler and a C function returning it. C code declares it with
+ *    DSP_DESIGN_SOS_DECLARE() and loads it with LowPassInitCoefficients(),
+ *    HiPassInitCoefficients() or IIRFilterAddCoefficients(), without designing at start up:
+ *
+ *        // filters.cpp
+ *        #include "dsp_design.h"
+ *        DSP_DESIGN_SOS(ecg_lpf, dsps_design::butterworth_lpf<4>(40.0 / 250.0))
+ *
+ *        // main.c
+ *        DSP_DESIGN_SOS_DECLARE(ecg_lpf);
+ *        LowPassInitCoefficients(ecg_lpf(), ORDER_4);
+ *
+ * Each table costs 4 bytes of flash per value: 8064 bytes per window with the default
+ * lengths (32 to 1024).
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include "fft.h"
+/*==================[macros]=================================================*/
+/** Shortest window with a flash table */
+#define DSP_DESIGN_WINDOW_MIN_LENGHT    32
+/** Longest window with a flash table (power of two up to MAX_SIGNAL_LENGHT) */
+#ifndef DSP_DESIGN_WINDOW_MAX_LENGHT
+#define DSP_DESIGN_WINDOW_MAX_LENGHT    1024
+#endif
+
+/** C declaration of a cascade defined with DSP_DESIGN_SOS() */
+#define DSP_DESIGN_SOS_DECLARE(name)    const float * name(void)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*==================[typedef]================================================*/
+
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Window table generated at compile time
+ *
+ * @param window            Window type
+ * @param signal_lenght     Lenght of the window
+ * @return const float*     Table of signal_lenght values in flash, NULL if there is no table
+ *                          for this window and length
+ */
+const float * DSPDesignWindow(fft_window_t window, uint16_t signal_lenght);
+
+#ifdef __cplusplus
+}
+
+#include "dsps_biquad_design.h"
+/**
+ * Constant cascade computed by the compiler from a dsps_design expression (e.g.
+ * dsps_design::chebyshev1_lpf<4>(0.1, 1.0)) and C function name() returning its
+ * coefficients (b0, b1, b2, a1, a2 of each section)
+ */
+#define DSP_DESIGN_SOS(name, design) \
+    static constexpr auto name##_sos = design; \
+    extern "C" const float * name(void){ return name##_sos.coeffs; }
+#endif
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* DSP_DESIGN_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,153 @@
+#ifndef DSP_PROFILE_H_
+#define DSP_PROFILE_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup DSP_Profile DSP profiling
+ */
+
+/** \brief Cycle count instrumentation of the signal processing middleware
+ *
+ * When built with DSP_PROFILE_ENABLE = 1 (e.g. idf_build_set_property(COMPILE_DEFINITIONS
+ * "DSP_PROFILE_ENABLE=1" APPEND) in the project CMakeLists.txt), every call to the
+ * instrumented functions of fft.c and iir_filter.c, and to the esp-dsp kernels they use,
+ * records its CPU cycles and the bytes of signal it processed. Cycles come from the CPU
+ * cycle counter (dsp_get_cpu_cycle_count()), which on the host test build is the time stamp
+ * counter, or nanoseconds of the monotonic clock when there is no TSC.
+ *
+ * Totals of a function include the functions it calls (FFTPlanSpectrum() includes
+ * dsps_fft2r_fc32(), etc.). Calls longer than 2^32 cycles are not measured correctly.
+ *
+ * With DSP_PROFILE_ENABLE = 0 (default) the instrumentation macros expand to nothing and
+ * the functions below are empty inline functions, so there is no code nor data left.
+ *
+ * @note  Counters are not protected against concurrent use, as the DSP scratch memory.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+/*==================[macros]=================================================*/
+#ifndef DSP_PROFILE_ENABLE
+#define DSP_PROFILE_ENABLE      0
+#endif
+
+#if DSP_PROFILE_ENABLE
+#include "dsp_common.h"
+/** Starts measuring the function id, in the scope where DSP_PROFILE_END() is used */
+#define DSP_PROFILE_BEGIN(id)               uint32_t dsp_profile_start_##id = dsp_get_cpu_cycle_count()
+/** Records a call to the function id that processed bytes bytes */
+#define DSP_PROFILE_END(id, bytes)          DSPProfileRecord(id, dsp_get_cpu_cycle_count() - dsp_profile_start_##id, bytes)
+/** Measures a single call (statement) as the function id */
+#define DSP_PROFILE_CALL(id, bytes, call)   do { DSP_PROFILE_BEGIN(id); call; DSP_PROFILE_END(id, bytes); } while (0)
+#else
+// Byte counts are still referenced (and discarded) so no variable is left unused
+#define DSP_PROFILE_BEGIN(id)
+#define DSP_PROFILE_END(id, bytes)          ((void)(bytes))
+#define DSP_PROFILE_CALL(id, bytes, call)   do { (void)(bytes); call; } while (0)
+#endif
+/*==================[typedef]================================================*/
+/**
+ * @brief Instrumented functions
+ */
+typedef enum {
+    DSP_PROFILE_FFT_PLAN_SPECTRUM = 0,  /*!< FFTPlanSpectrum() (FFTMagnitude(), FFTSpectrum(), FFTPlanMagnitude()) */
+    DSP_PROFILE_FFT_PLAN_POWER,         /*!< FFTPlanPower() */
+    DSP_PROFILE_FFT_WINDOW_GENERATE,    /*!< FFTWindowGenerate() */
+    DSP_PROFILE_FFT_REAL_SPLIT,         /*!< Split step of the real input plans */
+    DSP_PROFILE_IIR_FILTER_APPLY,       /*!< IIRFilterApply() (LowPassFilter(), HiPassFilter()) */
+    DSP_PROFILE_IIR_FILTER_DESIGN,      /*!< IIRFilterAddSection() (and IIRFilterAddButterworth()) */
+    DSP_PROFILE_DSPS_FFT2R_FC32,        /*!< dsps_fft2r_fc32() */
+    DSP_PROFILE_DSPS_BIT_REV_FC32,      /*!< dsps_bit_rev_fc32() and dsps_bit_rev_lookup_fc32() */
+    DSP_PROFILE_DSPS_CPLX2REC_FC32,     /*!< dsps_cplx2reC_fc32() */
+    DSP_PROFILE_DSPS_SQRT_F32,          /*!< dsps_sqrt_f32_ansi() */
+    DSP_PROFILE_DSPS_WIND_F32,          /*!< dsps_wind_xxx_f32() */
+    DSP_PROFILE_DSPS_BIQUAD_CASCADE_F32,/*!< dsps_biquad_cascade_f32() */
+    DSP_PROFILE_DSPS_BIQUAD_GEN_F32,    /*!< dsps_biquad_gen_xxx_f32() */
+    DSP_PROFILE_COUNT                   /*!< Number of instrumented functions */
+} dsp_profile_id_t;
+
+/**
+ * @brief Counters of an instrumented function
+ */
+typedef struct {
+    uint32_t calls;             /*!< Number of calls */
+    uint64_t total_cycles;      /*!< Cycles of all the calls */
+    uint32_t min_cycles;        /*!< Shortest call (0: no calls) */
+    uint32_t max_cycles;        /*!< Longest call */
+    uint64_t bytes;             /*!< Bytes of signal processed by all the calls */
+} dsp_profile_stats_t;
+
+/**
+ * @brief Output of DSPProfileDump(), called once per line (e.g. a wrapper of
+ * UartSendString(UART_PC, line))
+ */
+typedef void (*dsp_profile_print_t)(const char * line);
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+#if DSP_PROFILE_ENABLE
+/**
+ * @brief Add a call to the counters of a function (used by DSP_PROFILE_END())
+ *
+ * @param id                Instrumented function
+ * @param cycles            Cycles of the call
+ * @param bytes             Bytes of signal processed by the call
+ */
+void DSPProfileRecord(dsp_profile_id_t id, uint32_t cycles, size_t bytes);
+
+/**
+ * @brief Counters of a function
+ *
+ * @param id                Instrumented function
+ * @param stats             Structure to store the counters
+ * @return true             Counters stored
+ * @return false            Invalid function, or profiling disabled
+ */
+bool DSPProfileGet(dsp_profile_id_t id, dsp_profile_stats_t * stats);
+
+/**
+ * @brief Name of an instrumented function
+ *
+ * @param id                Instrumented function
+ * @return const char*      Name (NULL: invalid function)
+ */
+const char * DSPProfileName(dsp_profile_id_t id);
+
+/**
+ * @brief Restart every counter
+ */
+void DSPProfileClear(void);
+
+/**
+ * @brief Print the counters of every function called so far, one line per function:
+ * name, calls, total, min, average and max cycles, bytes and cycles per byte
+ *
+ * @param print             Output function, e.g. to the UART
+ */
+void DSPProfileDump(dsp_profile_print_t print);
+#else
+static inline void DSPProfileRecord(dsp_profile_id_t id, uint32_t cycles, size_t bytes){}
+static inline bool DSPProfileGet(dsp_profile_id_t id, dsp_profile_stats_t * stats){ return false; }
+static inline const char * DSPProfileName(dsp_profile_id_t id){ return NULL; }
+static inline void DSPProfileClear(void){}
+static inline void DSPProfileDump(dsp_profile_print_t print){}
+#endif
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* DSP_PROFILE_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,126 @@
+#ifndef DSP_SCRATCH_H_
+#define DSP_SCRATCH_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup DSP_Scratch DSP scratch memory
+ */
+
+/** \brief Scratch memory shared by the signal processing middleware
+ *
+ * Work buffers that are only needed while a function runs (fast convolution blocks,
+ * decimator design temporaries) are taken from a single region with a bump allocator
+ * instead of being reserved statically by each module, so they share the memory of the
+ * largest one in use at a time.
+ *
+ * FFT plans, including the one of FFTMagnitude(), deliberately keep their own window and
+ * work buffers: the region has no lock and FFTs are called from several tasks. They are
+ * not part of the high water mark either, which only covers the users of this region.
+ *
+ * Middleware functions release what they take before returning (DSPScratchMark() /
+ * DSPScratchRelease()). Applications can also take buffers for the current frame and
+ * call DSPScratchReset() between frames. The region is allocated on first use with
+ * DSP_SCRATCH_SIZE bytes, or set with DSPScratchInit() (heap or static buffer of any size).
+ * The high water mark reported by DSPScratchGetStats() is the size the region could be
+ * shrunk to for the same workload.
+ *
+ * @note  The region is not protected against concurrent use: FastConvProcess() and the
+ * Decimator design functions must run from a single task (as the static buffers they replace).
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "fft.h"
+/*==================[macros]=================================================*/
+/** Size of the region allocated on first use: the largest FastConvProcess() block (2 * MAX_SIGNAL_LENGHT
+ * floats) plus the alignment padding. Decimator design temporaries (about 10 bytes per tap) are
+ * smaller for any practical FIR length. */
+#ifndef DSP_SCRATCH_SIZE
+#define DSP_SCRATCH_SIZE        (2 * MAX_SIGNAL_LENGHT * sizeof(float) + DSP_SCRATCH_ALIGN)
+#endif
+/** Alignment of every scratch buffer (required by the esp-dsp SIMD kernels) */
+#define DSP_SCRATCH_ALIGN       16
+/*==================[typedef]================================================*/
+/**
+ * @brief Scratch memory usage
+ */
+typedef struct {
+    size_t size;                /*!< Size of the region (0: not allocated yet) */
+    size_t used;                /*!< Bytes currently taken */
+    size_t high_water;          /*!< Max bytes taken at the same time */
+    uint32_t failures;          /*!< Allocations that didn't fit in the region */
+} dsp_scratch_stats_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Set the scratch region
+ *
+ * @param buffer            Region to use (NULL: allocate size bytes from the heap)
+ * @param size              Size of the region in bytes
+ * @return true             Region set
+ * @return false            Scratch memory in use, or not enough memory
+ */
+bool DSPScratchInit(void * buffer, size_t size);
+
+/**
+ * @brief Take a buffer from the scratch region
+ *
+ * @note  Not thread safe: callers from different tasks (e.g. FastConvProcess() and a
+ * Decimator design running concurrently) corrupt each other's DSPScratchMark() /
+ * DSPScratchRelease() pairs.
+ *
+ * @param size              Size of the buffer in bytes
+ * @return void*            Buffer aligned to DSP_SCRATCH_ALIGN bytes (NULL: it doesn't fit)
+ */
+void * DSPScratchAlloc(size_t size);
+
+/**
+ * @brief Current position of the bump allocator
+ *
+ * @return size_t           Mark to give back to DSPScratchRelease()
+ */
+size_t DSPScratchMark(void);
+
+/**
+ * @brief Release every buffer taken after a mark
+ *
+ * @param mark              Value returned by DSPScratchMark()
+ */
+void DSPScratchRelease(size_t mark);
+
+/**
+ * @brief Release every scratch buffer (e.g. between frames)
+ */
+void DSPScratchReset(void);
+
+/**
+ * @brief Scratch memory usage
+ *
+ * @param stats             Structure to store the usage
+ */
+void DSPScratchGetStats(dsp_scratch_stats_t * stats);
+
+/**
+ * @brief Restart the high water mark and the failures count
+ */
+void DSPScratchClearStats(void);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* DSP_SCRATCH_H_ */
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,150 @@
+#ifndef FAST_CONV_H_
+#define FAST_CONV_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Fast_Conv Fast convolution
+ */
+
+/** \brief FFT based convolution and correlation with long kernels
+ *
+ * dsps_conv_f32(), dsps_corr_f32() and dsps_fir_f32() cost one multiplication per kernel
+ * tap and output sample. For long kernels (FIR filters of hundreds of taps, matched filters
+ * of pulse/echo measurements) fast_conv_t runs the convolution with overlap-save: blocks of
+ * B = L - M + 1 samples (plus the last M - 1 samples of history) are transformed with an L
+ * points FFT, multiplied by the kernel spectrum and transformed back. Two consecutive blocks
+ * are packed as real and imaginary parts of a single complex FFT, since the kernel is real.
+ *
+ * The FFT length L is chosen at creation (about 4 * M, the cheapest per sample), and kernels
+ * shorter than FAST_CONV_MIN_TAPS run as a direct form FIR (dsps_fir_f32()), which is
+ * faster for them. FastConvolution() and FastCorrelation() make the same choice for whole
+ * signals, with the same output as dsps_conv_f32() and dsps_corr_f32().
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsps_fir.h"
+/*==================[macros]=================================================*/
+/** Shortest kernel run with FFTs (shorter kernels are faster with the direct form) */
+#ifndef FAST_CONV_MIN_TAPS
+#define FAST_CONV_MIN_TAPS      24
+#endif
+/*==================[typedef]================================================*/
+/**
+ * @brief Streaming convolution with a fixed kernel
+ */
+typedef struct {
+    uint16_t n_taps;            /*!< Kernel length M */
+    uint16_t fft_lenght;        /*!< FFT length L (0: direct form) */
+    uint16_t block;             /*!< New samples of each FFT block (L - M + 1) */
+    float * kernel_fft;         /*!< Kernel spectrum divided by L (L complex values) */
+    float * history;            /*!< Last M - 1 input samples */
+    uint16_t * bitrev_table;    /*!< Bit reverse lookup table (NULL: computed bit reverse) */
+    uint16_t bitrev_size;       /*!< Number of swaps in bitrev_table */
+    fir_f32_t fir;              /*!< Direct form filter (short kernels) */
+    float * coeffs;             /*!< Direct form coefficients (time reversed kernel) */
+    float * delay;              /*!< Direct form delay line */
+} fast_conv_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Create a streaming convolution: y[n] = sum(kernel[m] * x[n - m])
+ *
+ * @param conv              Convolution to initialize
+ * @param kernel            Kernel (FIR filter coefficients) (of lenght = n_taps)
+ * @param n_taps            Kernel length (up to MAX_SIGNAL_LENGHT / 2)
+ * @return true             Convolution created
+ * @return false            Invalid length or not enough memory
+ */
+bool FastConvCreate(fast_conv_t * conv, const float * kernel, uint16_t n_taps);
+
+/**
+ * @brief Create a streaming correlation with a pattern: y[n] = sum(pattern[m] * x[n - M + 1 + m])
+ *
+ * y[n] is the correlation of the pattern with the last M samples, so a matched filter
+ * peaks when the end of the pattern arrives.
+ *
+ * @param conv              Correlation to initialize
+ * @param pattern           Pattern (of lenght = n_taps)
+ * @param n_taps            Pattern length M (up to MAX_SIGNAL_LENGHT / 2)
+ * @return true             Correlation created
+ * @return false            Invalid length or not enough memory
+ */
+bool FastConvCreateCorrelation(fast_conv_t * conv, const float * pattern, uint16_t n_taps);
+
+/**
+ * @brief Release the memory of a streaming convolution
+ *
+ * @param conv              Convolution created with FastConvCreate() or FastConvCreateCorrelation()
+ */
+void FastConvDestroy(fast_conv_t * conv);
+
+/**
+ * @brief Clear the input history
+ *
+ * @param conv              Convolution
+ */
+void FastConvReset(fast_conv_t * conv);
+
+/**
+ * @brief Filter a block of samples (of any lenght)
+ *
+ * Outputs are not delayed (one output per input), blocks shorter than conv->block only
+ * waste part of the FFT. Input and output can be the same array. The complex work buffer
+ * (L complex values) is taken from the DSP scratch memory (dsp_scratch.h) during the call.
+ *
+ * @param conv              Convolution
+ * @param input             Input samples
+ * @param output            Output samples
+ * @param signal_lenght     Number of samples
+ * @return true             Samples filtered
+ * @return false            Not enough scratch memory (output is not modified)
+ */
+bool FastConvProcess(fast_conv_t * conv, const float * input, float * output, uint16_t signal_lenght);
+
+/**
+ * @brief Convolution of two signals, same output as dsps_conv_f32()
+ *
+ * @param signal            Signal (of lenght = siglen)
+ * @param siglen            Signal length
+ * @param kernel            Kernel (of lenght = kernlen)
+ * @param kernlen           Kernel length
+ * @param convout           Array to store the convolution (of lenght = siglen + kernlen - 1)
+ * @return true             Convolution calculated
+ * @return false            Invalid lengths or not enough memory
+ */
+bool FastConvolution(const float * signal, uint16_t siglen, const float * kernel, uint16_t kernlen, float * convout);
+
+/**
+ * @brief Correlation of a signal with a pattern, same output as dsps_corr_f32()
+ *
+ * dest[n] = sum(signal[n + m] * pattern[m]), for n = 0 .. siglen - patlen
+ *
+ * @param signal            Signal (of lenght = siglen)
+ * @param siglen            Signal length
+ * @param pattern           Pattern (of lenght = patlen, not longer than the signal)
+ * @param patlen            Pattern length
+ * @param dest              Array to store the correlation (of lenght = siglen - patlen + 1)
+ * @return true             Correlation calculated
+ * @return false            Invalid lengths or not enough memory
+ */
+bool FastCorrelation(const float * signal, uint16_t siglen, const float * pattern, uint16_t patlen, float * dest);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* FAST_CONV_H_ */
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -8,6 +8,14 @@
  */
 
 /** \brief Functionalities to calculate FFT
+ * 
+ * FFTMagnitude() keeps working over the module's internal plan, which only keeps the window
+ * and work buffer of the last length used (allocated when the length changes). Tasks that need their own transform (or several lengths
+ * at once) should create an fft_plan_t with FFTPlanCreate(), which caches the window table
+ * and work buffer for that length. Windows with a compile time table (DSPDesignWindow())
+ * are read from flash and take no RAM.
+ * FFTPlanCreateReal() plans exploit that the signal is real: an N/2 points complex FFT
+ * followed by a split step, with half of the work and half of the work buffer.
  * 
  * @author Peñalva Albano
  *
@@ -16,6 +24,13 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 15/03/2024 | Document creation		                         						|
+ * | 16/10/2026 | FFT plans with cached window tables and work buffers					|
+ * | 16/10/2026 | Real input FFT plans, used by FFTMagnitude()							|
+ * | 16/10/2026 | FFTPlanPower() over circular buffers									|
+ * | 16/10/2026 | Power, fast magnitude and dB outputs (FFTSpectrum())					|
+ * | 16/10/2026 | Window and work buffer of FFTMagnitude() sized to the length in use	|
+ * | 16/10/2026 | FFTMagnitude() and FFTSpectrum() report invalid lengths				|
+ * | 16/10/2026 | Window tables generated at compile time (dsp_design.h)				|
  * 
  **/
 
@@ -25,7 +40,44 @@
 /*==================[macros]=================================================*/
 #define MAX_SIGNAL_LENGHT   2048
 /*==================[typedef]================================================*/
+/**
+ * @brief Window applied to the signal before the FFT
+ */
+typedef enum fft_window {
+    FFT_WINDOW_RECT = 0,            /*!< No window (rectangular) */
+    FFT_WINDOW_HANN,                /*!< Hann window */
+    FFT_WINDOW_BLACKMAN,            /*!< Blackman window */
+    FFT_WINDOW_BLACKMAN_HARRIS,     /*!< Blackman-Harris window */
+    FFT_WINDOW_BLACKMAN_NUTTALL,    /*!< Blackman-Nuttall window */
+    FFT_WINDOW_NUTTALL,             /*!< Nuttall window */
+    FFT_WINDOW_FLAT_TOP             /*!< Flat-Top window */
+} fft_window_t;
 
+/**
+ * @brief Output of FFTSpectrum() and FFTPlanSpectrum(), all of them on the FFTMagnitude() scale
+ */
+typedef enum fft_output {
+    FFT_OUTPUT_MAGNITUDE = 0,       /*!< Magnitude (same as FFTMagnitude()) */
+    FFT_OUTPUT_POWER,               /*!< Squared magnitude, without square roots */
+    FFT_OUTPUT_MAGNITUDE_FAST,      /*!< Magnitude with the esp-dsp square root approximation (dsps_sqrt_f32_ansi()) */
+    FFT_OUTPUT_DB                   /*!< 20 * log10(magnitude), with a fast log2 approximation (error < 0.003 dB) */
+} fft_output_t;
+
+/**
+ * @brief FFT plan: everything that only depends on (length, window) and can be reused between calls
+ */
+typedef struct {
+    uint16_t signal_lenght;         /*!< Length of the transformed signal (power of two) */
+    fft_window_t window_type;       /*!< Window applied to the signal */
+    const float * window;           /*!< Window table (signal_lenght values) */
+    float * window_buffer;          /*!< Window generated at run time (NULL: flash table of DSPDesignWindow()) */
+    float * buffer;                 /*!< Complex work buffer (2 * signal_lenght values, signal_lenght for real input) */
+    uint16_t * bitrev_table;        /*!< Bit reverse lookup table (NULL: computed bit reverse) */
+    uint16_t bitrev_size;           /*!< Number of swaps in bitrev_table */
+    bool real_input;                /*!< N/2 points complex FFT plus split step */
+    float * split_table;            /*!< Split step twiddles (N/4 + 1 complex values, real input only) */
+    bool allocated;                 /*!< Window and buffer were allocated by FFTPlanCreate() */
+} fft_plan_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -45,8 +97,26 @@ bool FFTInit(void);
  * @param signal            Array with signal values (of lenght = signal_lenght)
  * @param fft               Array to store FFT magnitude values (of lenght = signal_lenght / 2)
  * @param signal_lenght     Lenght of signal arrays
+ * @return true             FFT calculated
+ * @return false            Invalid length or not enough memory for the window and work buffer
+ *                          (fft is filled with zeros)
  */
-void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght);
+bool FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght);
+
+/**
+ * @brief Calculates the spectrum of a given signal in the selected output format
+ *
+ * Same as FFTMagnitude(), each output is computed in place in the fft array. Power and
+ * dB outputs skip the square root of every bin, which FFTMagnitude() pays for.
+ *
+ * @param signal            Array with signal values (of lenght = signal_lenght)
+ * @param fft               Array to store the spectrum (of lenght = signal_lenght / 2)
+ * @param signal_lenght     Lenght of signal arrays
+ * @param output            Output format
+ * @return true             Spectrum calculated
+ * @return false            Invalid length or not enough memory (fft is filled with zeros)
+ */
+bool FFTSpectrum(float * signal, float * fft, uint16_t signal_lenght, fft_output_t output);
 
 /**
  * @brief Return the FFT frequency axis vector
@@ -57,6 +127,89 @@ void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght);
  */
 void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f);
 
+/**
+ * @brief Generate a window table
+ *
+ * @param window            Array to store window values (of lenght = signal_lenght)
+ * @param signal_lenght     Lenght of the window
+ * @param window_type       Window to generate
+ */
+void FFTWindowGenerate(float * window, uint16_t signal_lenght, fft_window_t window_type);
+
+/**
+ * @brief Create an FFT plan for a given length and window
+ *
+ * Allocates the window table and the complex work buffer of the plan and generates the
+ * window once. Plans of different lengths can coexist and be used from different tasks.
+ *
+ * @note  Lenght must be a power of two (with maximun value = MAX_SIGNAL_LENGHT)
+ *
+ * @param plan              Plan to initialize
+ * @param signal_lenght     Lenght of the signals transformed with this plan
+ * @param window            Window applied to the signal
+ * @return true             Plan created
+ * @return false            Invalid length or not enough memory
+ */
+bool FFTPlanCreate(fft_plan_t * plan, uint16_t signal_lenght, fft_window_t window);
+
+/**
+ * @brief Create an FFT plan for real input signals
+ *
+ * The signal is packed as an N/2 points complex sequence (even samples as real part, odd
+ * samples as imaginary part) and the spectrum is recovered with a split step. Output is
+ * the same as FFTPlanCreate() plans with half of the work buffer and about half of the cost.
+ *
+ * @note  Lenght must be a power of two (from 4 to MAX_SIGNAL_LENGHT)
+ *
+ * @param plan              Plan to initialize
+ * @param signal_lenght     Lenght of the signals transformed with this plan
+ * @param window            Window applied to the signal
+ * @return true             Plan created
+ * @return false            Invalid length or not enough memory
+ */
+bool FFTPlanCreateReal(fft_plan_t * plan, uint16_t signal_lenght, fft_window_t window);
+
+/**
+ * @brief Release the memory of an FFT plan
+ *
+ * @param plan              Plan created with FFTPlanCreate()
+ */
+void FFTPlanDestroy(fft_plan_t * plan);
+
+/**
+ * @brief Calculates the FFT magnitude of a signal using a plan
+ *
+ * Same output as FFTMagnitude(), without regenerating the window or clearing buffers.
+ *
+ * @param plan              Plan created with FFTPlanCreate()
+ * @param signal            Array with signal values (of lenght = plan->signal_lenght)
+ * @param fft               Array to store FFT magnitude values (of lenght = plan->signal_lenght / 2)
+ */
+void FFTPlanMagnitude(fft_plan_t * plan, const float * signal, float * fft);
+
+/**
+ * @brief Calculates the spectrum of a signal using a plan, in the selected output format
+ *
+ * @param plan              Plan created with FFTPlanCreate() or FFTPlanCreateReal()
+ * @param signal            Array with signal values (of lenght = plan->signal_lenght)
+ * @param fft               Array to store the spectrum (of lenght = plan->signal_lenght / 2)
+ * @param output            Output format
+ */
+void FFTPlanSpectrum(fft_plan_t * plan, const float * signal, float * fft, fft_output_t output);
+
+/**
+ * @brief Calculates the FFT power spectrum of a frame stored in a circular buffer
+ *
+ * The frame is windowed straight from the circular buffer into the plan's work buffer,
+ * starting at its oldest sample, so streaming callers don't need to copy it first.
+ *
+ * @param plan              Plan created with FFTPlanCreate() or FFTPlanCreateReal()
+ * @param signal            Circular buffer with the frame (of lenght = plan->signal_lenght)
+ * @param start             Position of the oldest sample in signal (0 for a plain array)
+ * @param power             Array to store |X[k]|^2 (of lenght = plan->signal_lenght / 2)
+ */
+void FFTPlanPower(fft_plan_t * plan, const float * signal, uint16_t start, float * power);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
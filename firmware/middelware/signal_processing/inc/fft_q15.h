@@ -0,0 +1,97 @@
+#ifndef FFT_Q15_H_
+#define FFT_Q15_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup FFT_Q15 Fixed point FFT
+ */
+
+/** \brief Fixed point (Q15) spectrum of raw ADC frames
+ *
+ * Integer only alternative to FFTMagnitude() for cores without FPU (ESP32-C6). The frame
+ * mean is removed, the signal is windowed with a Q15 table and transformed with a block
+ * floating point radix 2 FFT (real input, N/2 complex points plus split step). Magnitudes
+ * are returned as 16 bit mantissas sharing one exponent:
+ *
+ *      FFTMagnitude() value of bin k ~= fft[k] * 2^exponent
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "fft.h"
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Integer magnitude approximation
+ */
+typedef enum fft_q15_magnitude {
+    FFT_Q15_MAG_ALPHA_MAX_BETA_MIN = 0,     /*!< 0.961 * max + 0.398 * min (max. error 4%) */
+    FFT_Q15_MAG_ISQRT                       /*!< Integer square root (truncation error only) */
+} fft_q15_magnitude_t;
+
+/**
+ * @brief Fixed point FFT plan
+ */
+typedef struct {
+    uint16_t signal_lenght;             /*!< Length of the transformed signal (power of two) */
+    fft_window_t window_type;           /*!< Window applied to the signal */
+    fft_q15_magnitude_t magnitude;      /*!< Magnitude approximation */
+    int16_t * window;                   /*!< Q15 window table (signal_lenght values) */
+    int16_t * buffer;                   /*!< Work buffer (signal_lenght / 2 complex values) */
+    int16_t * split_table;              /*!< Q15 split step twiddles (signal_lenght / 4 + 1 complex values) */
+} fft_q15_plan_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Create a fixed point FFT plan
+ *
+ * @note  Lenght must be a power of two (from 4 to MAX_SIGNAL_LENGHT)
+ *
+ * @param plan              Plan to initialize
+ * @param signal_lenght     Lenght of the frames transformed with this plan
+ * @param window            Window applied to the signal
+ * @param magnitude         Magnitude approximation
+ * @return true             Plan created
+ * @return false            Invalid length or not enough memory
+ */
+bool FFTQ15PlanCreate(fft_q15_plan_t * plan, uint16_t signal_lenght, fft_window_t window, fft_q15_magnitude_t magnitude);
+
+/**
+ * @brief Release the memory of a fixed point FFT plan
+ *
+ * @param plan              Plan created with FFTQ15PlanCreate()
+ */
+void FFTQ15PlanDestroy(fft_q15_plan_t * plan);
+
+/**
+ * @brief Calculates the magnitude spectrum of a raw ADC frame
+ *
+ * @note  The frame mean is removed before the transform, so bin 0 only holds the
+ * residual DC of the windowed signal.
+ *
+ * @param plan              Plan created with FFTQ15PlanCreate()
+ * @param signal            ADC samples (of lenght = plan->signal_lenght, up to 15 bits)
+ * @param fft               Array to store magnitude mantissas (of lenght = plan->signal_lenght / 2)
+ * @return int8_t           Block exponent shared by all the fft values
+ */
+int8_t FFTQ15Magnitude(fft_q15_plan_t * plan, const uint16_t * signal, uint16_t * fft);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* FFT_Q15_H_ */
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,165 @@
+#ifndef GOERTZEL_H_
+#define GOERTZEL_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Goertzel Goertzel filter bank
+ */
+
+/** \brief Power of a few frequencies over streaming samples
+ *
+ * A Goertzel filter bank tracks a handful of target frequencies (tones, power line
+ * harmonics) without computing a whole FFT. Samples are fed one by one or in blocks of
+ * any size, and every block_lenght samples the power of each bin is updated:
+ *
+ *      power[k] = |X(f_k)|^2 * (2 / block_lenght)^2
+ *
+ * that is, the squared amplitude of a sinusoid at f_k (rectangular window). Each bin costs
+ * one multiplication per sample, so for a few bins it is cheaper than FFTMagnitude().
+ * goertzel_q15_t runs the same filters in fixed point (Q15 samples, Q29 coefficients,
+ * 32 bit states), with the power returned in the same units (full scale = 1).
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Goertzel filter bank (float)
+ */
+typedef struct {
+    uint8_t n_bins;             /*!< Number of tracked frequencies */
+    uint16_t block_lenght;      /*!< Samples of each detection block */
+    uint16_t count;             /*!< Samples of the current block already processed */
+    float * coeffs;             /*!< 2 * cos(w) of each bin */
+    float * state;              /*!< s[n-1], s[n-2] of each bin */
+    float * power;              /*!< Power of each bin in the last completed block */
+} goertzel_t;
+
+/**
+ * @brief Goertzel filter bank (fixed point)
+ */
+typedef struct {
+    uint8_t n_bins;             /*!< Number of tracked frequencies */
+    uint16_t block_lenght;      /*!< Samples of each detection block */
+    uint16_t count;             /*!< Samples of the current block already processed */
+    uint8_t input_shift;        /*!< Right shift of the samples that keeps the states in 32 bits */
+    int32_t * coeffs;           /*!< 2 * cos(w) of each bin (Q29) */
+    int32_t * state;            /*!< s[n-1], s[n-2] of each bin */
+    float * power;              /*!< Power of each bin in the last completed block */
+} goertzel_q15_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Create a Goertzel filter bank
+ *
+ * @param bank              Filter bank to initialize
+ * @param sample_frec       Signal's sample frequency
+ * @param frecs             Frequencies to track (of lenght = n_bins, between 0 and sample_frec / 2)
+ * @param n_bins            Number of frequencies
+ * @param block_lenght      Samples of each detection block (frequency resolution = sample_frec / block_lenght)
+ * @return true             Filter bank created
+ * @return false            Invalid parameters or not enough memory
+ */
+bool GoertzelCreate(goertzel_t * bank, float sample_frec, const float * frecs, uint8_t n_bins, uint16_t block_lenght);
+
+/**
+ * @brief Release the memory of a Goertzel filter bank
+ *
+ * @param bank              Filter bank created with GoertzelCreate()
+ */
+void GoertzelDestroy(goertzel_t * bank);
+
+/**
+ * @brief Restart the current block and clear the powers
+ *
+ * @param bank              Filter bank
+ */
+void GoertzelReset(goertzel_t * bank);
+
+/**
+ * @brief Process one sample
+ *
+ * @param bank              Filter bank
+ * @param sample            New sample
+ * @return true             A block was completed and the powers were updated
+ * @return false            Block not completed yet
+ */
+bool GoertzelUpdate(goertzel_t * bank, float sample);
+
+/**
+ * @brief Process a block of samples (of any lenght)
+ *
+ * @param bank              Filter bank
+ * @param signal            Samples
+ * @param signal_lenght     Number of samples
+ * @return uint16_t         Number of detection blocks completed (powers hold the last one)
+ */
+uint16_t GoertzelProcess(goertzel_t * bank, const float * signal, uint16_t signal_lenght);
+
+/**
+ * @brief Create a fixed point Goertzel filter bank
+ *
+ * @param bank              Filter bank to initialize
+ * @param sample_frec       Signal's sample frequency
+ * @param frecs             Frequencies to track (of lenght = n_bins, between 0 and sample_frec / 2)
+ * @param n_bins            Number of frequencies
+ * @param block_lenght      Samples of each detection block (frequency resolution = sample_frec / block_lenght)
+ * @return true             Filter bank created
+ * @return false            Invalid parameters or not enough memory
+ */
+bool GoertzelQ15Create(goertzel_q15_t * bank, float sample_frec, const float * frecs, uint8_t n_bins, uint16_t block_lenght);
+
+/**
+ * @brief Release the memory of a fixed point Goertzel filter bank
+ *
+ * @param bank              Filter bank created with GoertzelQ15Create()
+ */
+void GoertzelQ15Destroy(goertzel_q15_t * bank);
+
+/**
+ * @brief Restart the current block and clear the powers
+ *
+ * @param bank              Filter bank
+ */
+void GoertzelQ15Reset(goertzel_q15_t * bank);
+
+/**
+ * @brief Process one Q15 sample
+ *
+ * @param bank              Filter bank
+ * @param sample            New sample
+ * @return true             A block was completed and the powers were updated
+ * @return false            Block not completed yet
+ */
+bool GoertzelQ15Update(goertzel_q15_t * bank, int16_t sample);
+
+/**
+ * @brief Process a block of Q15 samples (of any lenght)
+ *
+ * @param bank              Filter bank
+ * @param signal            Samples
+ * @param signal_lenght     Number of samples
+ * @return uint16_t         Number of detection blocks completed (powers hold the last one)
+ */
+uint16_t GoertzelQ15Process(goertzel_q15_t * bank, const int16_t * signal, uint16_t signal_lenght);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* GOERTZEL_H_ */
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -8,6 +8,14 @@
  */
 
 /** \brief Functionalities to design and use filters
+ * 
+ * Each iir_filter_t owns its own cascade of biquad sections (coefficients and delay
+ * lines), so several channels can be filtered independently. Sections of any kind
+ * (low pass, high pass, band pass, notch) can be mixed, and the whole cascade is run
+ * in a single pass over the signal. LowPassInit()/HiPassInit() and their filter
+ * functions are kept for single channel applications, over two internal filters.
+ * LowPassInitCoefficients()/HiPassInitCoefficients() load a cascade designed at compile
+ * time (DSP_DESIGN_SOS() of dsp_design.h) instead of designing it at start up.
  * 
  * @author Peñalva Albano
  *
@@ -16,11 +24,15 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 15/03/2024 | Document creation		                         						|
+ * | 16/10/2026 | Multi-instance biquad cascades (iir_filter_t)							|
+ * | 16/10/2026 | Fused cascade kernel (dsps_biquad_cascade_f32)							|
+ * | 16/10/2026 | Compile time designs (LowPassInitCoefficients(), dsp_design.h)		|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
+#include <stdbool.h>
 /*==================[macros]=================================================*/
 
 /*==================[typedef]================================================*/
@@ -30,6 +42,23 @@ typedef enum filter_order {
     ORDER_6 = 6,        /*!< 6th order filter */
     ORDER_8 = 8         /*!< 8th order filter */
 } filter_order_t;
+
+typedef enum filter_type {
+    FILTER_LOW_PASS,    /*!< Low pass section (cut-off frequency) */
+    FILTER_HIGH_PASS,   /*!< High pass section (cut-off frequency) */
+    FILTER_BAND_PASS,   /*!< Band pass section with 0 dB gain (center frequency) */
+    FILTER_NOTCH        /*!< Notch section (notch frequency) */
+} filter_type_t;
+
+/**
+ * @brief IIR filter: cascade of 2nd order sections (direct form II)
+ */
+typedef struct {
+    uint8_t n_sections;     /*!< Sections in use */
+    uint8_t max_sections;   /*!< Allocated sections */
+    float * coeffs;         /*!< b0, b1, b2, a1, a2 of each section */
+    float * delay;          /*!< w0, w1 of each section */
+} iir_filter_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -51,6 +80,22 @@ void LowPassInit(float sample_frec, float cut_frec, filter_order_t order);
  */
 void HiPassInit(float sample_frec, float cut_frec, filter_order_t order);
 
+/**
+ * @brief Initialize the low pass filter with precomputed coefficients
+ * 
+ * @param coeffs        b0, b1, b2, a1, a2 of order / 2 sections (e.g. DSP_DESIGN_SOS())
+ * @param order         Filter's order (2, 4, 6 or 8)
+ */
+void LowPassInitCoefficients(const float * coeffs, filter_order_t order);
+
+/**
+ * @brief Initialize the hi pass filter with precomputed coefficients
+ * 
+ * @param coeffs        b0, b1, b2, a1, a2 of order / 2 sections (e.g. DSP_DESIGN_SOS())
+ * @param order         Filter's order (2, 4, 6 or 8)
+ */
+void HiPassInitCoefficients(const float * coeffs, filter_order_t order);
+
 /**
  * @brief Apply a low pass filter to a signal array
  * 
@@ -69,6 +114,78 @@ void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_l
  */
 void HiPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght);
 
+/**
+ * @brief Create an empty filter
+ * 
+ * @param filter        Filter to initialize
+ * @param max_sections  Maximum number of 2nd order sections of the filter
+ * @return true         Filter created
+ * @return false        Not enough memory
+ */
+bool IIRFilterCreate(iir_filter_t * filter, uint8_t max_sections);
+
+/**
+ * @brief Release the memory of a filter
+ * 
+ * @param filter        Filter created with IIRFilterCreate()
+ */
+void IIRFilterDestroy(iir_filter_t * filter);
+
+/**
+ * @brief Append a 2nd order section to the filter cascade
+ * 
+ * @param filter        Filter
+ * @param type          Section type
+ * @param sample_frec   Signal's sample frequency
+ * @param frec          Cut-off, center or notch frequency
+ * @param q_factor      Section's Q factor
+ * @return true         Section added
+ * @return false        No free sections left
+ */
+bool IIRFilterAddSection(iir_filter_t * filter, filter_type_t type, float sample_frec, float frec, float q_factor);
+
+/**
+ * @brief Append a Butterworth low pass or high pass filter to the filter cascade
+ * 
+ * @param filter        Filter
+ * @param type          FILTER_LOW_PASS or FILTER_HIGH_PASS
+ * @param sample_frec   Signal's sample frequency
+ * @param cut_frec      Filter's cut-off frequency
+ * @param order         Filter's order (any even order, order / 2 sections are added)
+ * @return true         Sections added
+ * @return false        Invalid order or not enough free sections
+ */
+bool IIRFilterAddButterworth(iir_filter_t * filter, filter_type_t type, float sample_frec, float cut_frec, uint8_t order);
+
+/**
+ * @brief Append a section with given coefficients to the filter cascade
+ * 
+ * @param filter        Filter
+ * @param coeffs        b0, b1, b2, a1, a2 (a0 = 1)
+ * @return true         Section added
+ * @return false        No free sections left
+ */
+bool IIRFilterAddCoefficients(iir_filter_t * filter, const float * coeffs);
+
+/**
+ * @brief Clear the delay lines of every section
+ * 
+ * @param filter        Filter
+ */
+void IIRFilterReset(iir_filter_t * filter);
+
+/**
+ * @brief Apply the filter cascade to a signal array
+ * 
+ * @note  Input and output may be the same array
+ * 
+ * @param filter            Filter
+ * @param input_signal      Input signal array
+ * @param output_signal     Filtered signal array
+ * @param signal_lenght     Number of samples of both signals
+ */
+void IIRFilterApply(iir_filter_t * filter, const float * input_signal, float * output_signal, uint16_t signal_lenght);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
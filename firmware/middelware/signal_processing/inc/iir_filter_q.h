@@ -0,0 +1,142 @@
+#ifndef IIR_FILTER_Q_H_
+#define IIR_FILTER_Q_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup IIR_Filter_Q Fixed point IIR filter
+ */
+
+/** \brief Fixed point biquad cascades for raw ADC streams
+ *
+ * Integer only alternative to iir_filter_t for cores without FPU (ESP32-C6). Filters are
+ * designed in float as usual (IIRFilterAddSection(), IIRFilterAddButterworth(), which use
+ * the esp-dsp dsps_biquad_gen_*_f32 designs) and quantized once with IIRFilterQQuantize().
+ * Sections are direct form I with saturated outputs:
+ *
+ *  - IIR_FILTER_Q15: Q15 data, Q14 coefficients and 32 bit accumulation (2 guard bits, the
+ *    gain of every section must be below 4). Optional first order noise shaping feeds the
+ *    rounding error of each section back into its next sample, which moves the rounding
+ *    noise away from DC (recommended for low cut-off frequencies).
+ *  - IIR_FILTER_Q31: Q31 data, Q30 coefficients and 64 bit accumulation (dsps_biquad_cascade_s32).
+ *    Its rounding noise is far below any ADC resolution, so noise shaping is not applied.
+ *
+ * Q14 coefficients lose precision for cut-off frequencies well below fs / 50, use Q31
+ * filters in that case.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "iir_filter.h"
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Data format of a fixed point filter
+ */
+typedef enum iir_filter_q_format {
+    IIR_FILTER_Q15 = 0,     /*!< Q15 data, Q14 coefficients, 32 bit accumulator */
+    IIR_FILTER_Q31          /*!< Q31 data, Q30 coefficients, 64 bit accumulator */
+} iir_filter_q_format_t;
+
+/**
+ * @brief Fixed point IIR filter: cascade of 2nd order sections (direct form I)
+ */
+typedef struct {
+    uint8_t n_sections;             /*!< Sections in use */
+    uint8_t max_sections;           /*!< Allocated sections */
+    iir_filter_q_format_t format;   /*!< Data and coefficients format */
+    bool noise_shaping;             /*!< Rounding error feedback (Q15 only) */
+    int32_t * coeffs;               /*!< b0, b1, b2, a1, a2 of each section (Q14 or Q30) */
+    int32_t * delay;                /*!< x[n-1], x[n-2] of the input and y[n-1], y[n-2] of each section */
+    int32_t * error;                /*!< Rounding error of each section (noise shaping) */
+} iir_filter_q_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Create an empty fixed point filter
+ *
+ * @param filter            Filter to initialize
+ * @param max_sections      Maximum number of 2nd order sections of the filter
+ * @param format            Data and coefficients format
+ * @param noise_shaping     Feed the rounding error back (IIR_FILTER_Q15 only)
+ * @return true             Filter created
+ * @return false            Not enough memory
+ */
+bool IIRFilterQCreate(iir_filter_q_t * filter, uint8_t max_sections, iir_filter_q_format_t format, bool noise_shaping);
+
+/**
+ * @brief Release the memory of a fixed point filter
+ *
+ * @param filter            Filter created with IIRFilterQCreate()
+ */
+void IIRFilterQDestroy(iir_filter_q_t * filter);
+
+/**
+ * @brief Quantize and append a section with given float coefficients
+ *
+ * @param filter            Filter
+ * @param coeffs            b0, b1, b2, a1, a2 (a0 = 1), as generated by dsps_biquad_gen_*_f32
+ * @return true             Section added
+ * @return false            No free sections left or coefficients out of the -2..2 range
+ */
+bool IIRFilterQAddCoefficients(iir_filter_q_t * filter, const float * coeffs);
+
+/**
+ * @brief Quantize and append all the sections of a float filter
+ *
+ * @param filter            Filter
+ * @param design            Float filter designed with IIRFilterAddSection()/IIRFilterAddButterworth()
+ * @return true             Sections added
+ * @return false            Not enough free sections or coefficients out of range
+ */
+bool IIRFilterQQuantize(iir_filter_q_t * filter, const iir_filter_t * design);
+
+/**
+ * @brief Clear the delay lines (and rounding errors) of every section
+ *
+ * @param filter            Filter
+ */
+void IIRFilterQReset(iir_filter_q_t * filter);
+
+/**
+ * @brief Apply an IIR_FILTER_Q15 filter to a signal array
+ *
+ * @note  Input and output may be the same array
+ *
+ * @param filter            Filter
+ * @param input_signal      Input signal array (Q15)
+ * @param output_signal     Filtered signal array (Q15)
+ * @param signal_lenght     Number of samples of both signals
+ */
+void IIRFilterQ15Apply(iir_filter_q_t * filter, const int16_t * input_signal, int16_t * output_signal, uint16_t signal_lenght);
+
+/**
+ * @brief Apply an IIR_FILTER_Q31 filter to a signal array
+ *
+ * @note  Input and output may be the same array
+ *
+ * @param filter            Filter
+ * @param input_signal      Input signal array (Q31)
+ * @param output_signal     Filtered signal array (Q31)
+ * @param signal_lenght     Number of samples of both signals
+ */
+void IIRFilterQ31Apply(iir_filter_q_t * filter, const int32_t * input_signal, int32_t * output_signal, uint16_t signal_lenght);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* IIR_FILTER_Q_H_ */
+
+/*==================[end of file]============================================*/
\ No newline at end of file
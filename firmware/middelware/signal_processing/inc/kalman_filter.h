@@ -0,0 +1,173 @@
+#ifndef KALMAN_FILTER_H_
+#define KALMAN_FILTER_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Kalman_Filter Linear Kalman filter
+ */
+
+/** \brief Kalman smoothing of scalar sensor readings (HC-SR04 distance, HX711 weight)
+ *
+ * C interface of the esp-dsp kf_linear templates: a linear Kalman filter of 1 to 3 states
+ * whose first state is measured, with fixed size matrices and a scalar update (no matrix
+ * inversion, closed form for 1 and 2 states):
+ *
+ *  - KALMAN_RANDOM_WALK: slowly varying value (weight), process_noise in units^2/s
+ *  - KALMAN_CONSTANT_VELOCITY: value and rate (distance and speed), process_noise is the
+ *    acceleration spectral density in units^2/s^3
+ *  - KALMAN_CONSTANT_ACCELERATION: value, rate and acceleration, process_noise is the jerk
+ *    spectral density in units^2/s^5
+ *
+ * measurement_noise is the variance of the readings (units^2). kalman_filter_q_t runs the
+ * same model in fixed point on integer readings for cores without FPU (ESP32-C6): the gain
+ * is the steady state gain of the float filter (computed once in KalmanFilterQCreate()) and
+ * an update is a few 32 bit additions and one product per state.
+ *
+ * Example: distance = KalmanFilterQUpdate(&kf, HcSr04ReadDistanceInCentimeters());
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*==================[typedef]================================================*/
+/**
+ * @brief Kalman filter model, the value is the number of states
+ */
+typedef enum kalman_model {
+    KALMAN_RANDOM_WALK = 1,             /*!< x = [value] */
+    KALMAN_CONSTANT_VELOCITY,           /*!< x = [value, rate] */
+    KALMAN_CONSTANT_ACCELERATION        /*!< x = [value, rate, acceleration] */
+} kalman_model_t;
+
+/**
+ * @brief Linear Kalman filter (float)
+ */
+typedef struct {
+    kalman_model_t model;       /*!< Model (number of states) */
+    void * filter;              /*!< kf_linear<N> object */
+} kalman_filter_t;
+
+/**
+ * @brief Linear Kalman filter (fixed point, steady state gain)
+ */
+typedef struct {
+    kalman_model_t model;       /*!< Model (number of states) */
+    void * filter;              /*!< kf_linear_fixed<N> object */
+} kalman_filter_q_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Create a Kalman filter, states at 0
+ *
+ * @param kf                Filter to initialize
+ * @param model             Model of the measured value
+ * @param sample_period     Time between readings (s)
+ * @param process_noise     Spectral density of the noise of the last state derivative
+ * @param measurement_noise Variance of the readings
+ * @return true             Filter created
+ * @return false            Invalid parameters or not enough memory
+ */
+bool KalmanFilterCreate(kalman_filter_t * kf, kalman_model_t model, float sample_period, float process_noise, float measurement_noise);
+
+/**
+ * @brief Release the memory of a Kalman filter
+ *
+ * @param kf                Filter created with KalmanFilterCreate()
+ */
+void KalmanFilterDestroy(kalman_filter_t * kf);
+
+/**
+ * @brief Set the value (rates at 0) with a large uncertainty, the next readings set the states
+ *
+ * @param kf                Filter
+ * @param value             Initial value
+ */
+void KalmanFilterReset(kalman_filter_t * kf, float value);
+
+/**
+ * @brief Filter a reading (prediction and correction)
+ *
+ * @param kf                Filter
+ * @param reading           Measured value
+ * @return float            Filtered value
+ */
+float KalmanFilterUpdate(kalman_filter_t * kf, float reading);
+
+/**
+ * @brief States of the filter
+ *
+ * @param kf                Filter
+ * @param state             Value, rate and acceleration (as many as states of the model)
+ */
+void KalmanFilterGetState(const kalman_filter_t * kf, float * state);
+
+/**
+ * @brief Create a fixed point Kalman filter, states at 0
+ *
+ * @param kf                Filter to initialize
+ * @param model             Model of the measured value
+ * @param sample_period     Time between readings (s)
+ * @param process_noise     Spectral density of the noise of the last state derivative
+ * @param measurement_noise Variance of the readings
+ * @param frac_bits         Fractional bits of the states (0 to 16), |reading| * 2^frac_bits below 2^31
+ * @return true             Filter created
+ * @return false            Invalid parameters, gain out of range or not enough memory
+ */
+bool KalmanFilterQCreate(kalman_filter_q_t * kf, kalman_model_t model, float sample_period, float process_noise, float measurement_noise, uint8_t frac_bits);
+
+/**
+ * @brief Release the memory of a fixed point Kalman filter
+ *
+ * @param kf                Filter created with KalmanFilterQCreate()
+ */
+void KalmanFilterQDestroy(kalman_filter_q_t * kf);
+
+/**
+ * @brief Set the value (rates at 0)
+ *
+ * @param kf                Filter
+ * @param value             Initial value
+ */
+void KalmanFilterQReset(kalman_filter_q_t * kf, int32_t value);
+
+/**
+ * @brief Filter a reading (prediction and correction with the steady state gain)
+ *
+ * @param kf                Filter
+ * @param reading           Measured value
+ * @return int32_t          Filtered value, rounded to reading units
+ */
+int32_t KalmanFilterQUpdate(kalman_filter_q_t * kf, int32_t reading);
+
+/**
+ * @brief States of the filter in float (units per second)
+ *
+ * @param kf                Filter
+ * @param state             Value, rate and acceleration (as many as states of the model)
+ */
+void KalmanFilterQGetState(const kalman_filter_q_t * kf, float * state);
+
+#ifdef __cplusplus
+}
+#endif
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* KALMAN_FILTER_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,124 @@
+#ifndef MULTICHANNEL_FILTER_H_
+#define MULTICHANNEL_FILTER_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Multichannel_Filter Multichannel filter
+ */
+
+/** \brief Filtering of interleaved multichannel frames
+ *
+ * An mc_filter_t filters all the channels of an ADC scan in a single call, in place over
+ * the interleaved frames (CH0, CH1, ... CHn, CH0, CH1, ...), without de-interleaving copies.
+ * Each channel keeps its own delay lines. Coefficients are either shared by all the
+ * channels or set per channel. Two kinds of filters are available:
+ *
+ *  - IIR: cascade of biquad sections, usually copied from an iir_filter_t design.
+ *  - FIR: direct form FIR with any number of taps.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Multichannel filter kind
+ */
+typedef enum mc_filter_kind {
+    MC_FILTER_IIR = 0,      /*!< Cascade of 2nd order sections (direct form II) */
+    MC_FILTER_FIR           /*!< FIR filter */
+} mc_filter_kind_t;
+
+/**
+ * @brief Multichannel filter
+ */
+typedef struct {
+    mc_filter_kind_t kind;      /*!< Filter kind */
+    uint8_t n_channels;         /*!< Channels of each interleaved frame */
+    bool shared_coeffs;         /*!< All the channels use the same coefficients */
+    uint16_t n_coeffs;          /*!< Coefficients of each channel (5 * sections or taps) */
+    uint16_t n_delay;           /*!< Delay line length of each channel (2 * sections or taps) */
+    uint16_t pos;               /*!< Position in the FIR delay lines (common to all channels) */
+    float * coeffs;             /*!< Coefficients (1 or n_channels sets) */
+    float * delay;              /*!< Delay lines (n_channels sets) */
+} mc_filter_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Create a multichannel IIR filter
+ *
+ * @param filter            Filter to initialize
+ * @param n_channels        Channels of each interleaved frame
+ * @param n_sections        2nd order sections of each channel
+ * @param shared_coeffs     All the channels use the same coefficients
+ * @return true             Filter created
+ * @return false            Not enough memory
+ */
+bool MCFilterCreateIIR(mc_filter_t * filter, uint8_t n_channels, uint8_t n_sections, bool shared_coeffs);
+
+/**
+ * @brief Create a multichannel FIR filter
+ *
+ * @param filter            Filter to initialize
+ * @param n_channels        Channels of each interleaved frame
+ * @param n_taps            Taps of each channel
+ * @param shared_coeffs     All the channels use the same coefficients
+ * @return true             Filter created
+ * @return false            Not enough memory
+ */
+bool MCFilterCreateFIR(mc_filter_t * filter, uint8_t n_channels, uint16_t n_taps, bool shared_coeffs);
+
+/**
+ * @brief Release the memory of a multichannel filter
+ *
+ * @param filter            Filter created with MCFilterCreateIIR() or MCFilterCreateFIR()
+ */
+void MCFilterDestroy(mc_filter_t * filter);
+
+/**
+ * @brief Set the coefficients of a channel
+ *
+ * @param filter            Filter
+ * @param channel           Channel (ignored if coefficients are shared)
+ * @param coeffs            IIR: b0, b1, b2, a1, a2 of each section (e.g. iir_filter_t coeffs).
+ *                          FIR: taps.
+ * @return true             Coefficients set
+ * @return false            Invalid channel
+ */
+bool MCFilterSetCoefficients(mc_filter_t * filter, uint8_t channel, const float * coeffs);
+
+/**
+ * @brief Clear the delay lines of every channel
+ *
+ * @param filter            Filter
+ */
+void MCFilterReset(mc_filter_t * filter);
+
+/**
+ * @brief Filter interleaved frames in place
+ *
+ * @param filter            Filter
+ * @param frames            Interleaved samples (of lenght = n_frames * n_channels)
+ * @param n_frames          Number of frames
+ */
+void MCFilterApply(mc_filter_t * filter, float * frames, uint16_t n_frames);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* MULTICHANNEL_FILTER_H_ */
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,192 @@
+#ifndef ORIENTATION_FILTER_H_
+#define ORIENTATION_FILTER_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Orientation_Filter Orientation filter
+ */
+
+/** \brief Quaternion complementary filters for accelerometer + gyroscope IMUs (MPU6050)
+ *
+ * Attitude estimation at the IMU rate for a fraction of the cost of the 13 states EKF
+ * (ekf_imu13states). The gyroscope rates are integrated into the attitude quaternion and
+ * the accelerometer (gravity direction) corrects the drift of roll and pitch:
+ *
+ *  - ORIENTATION_MADGWICK: gradient descent step towards the measured gravity, gain beta
+ *    (rad/s, ~ sqrt(3/4) * gyroscope noise, 0.1 is a usual value).
+ *  - ORIENTATION_MAHONY: PI feedback of the angle between the measured and the estimated
+ *    gravity, gains kp (1/s) and ki (1/s^2). The integral term removes the gyroscope bias.
+ *
+ * Without magnetometer the yaw is gyroscope integration only. Vectors are normalized with a
+ * fast inverse square root (no sqrt nor divisions per sample). orientation_filter_q_t runs
+ * the same filters in fixed point on the raw readings (Q30 quaternion, 64 bit products)
+ * for cores without FPU (ESP32-C6).
+ *
+ * OrientationFilterProcessMotion6() and OrientationFilterQProcessMotion6() process whole
+ * bursts of samples read from the MPU6050 FIFO with MPU6050_getMotion6FIFO(): ax, ay, az,
+ * gx, gy, gz (raw, 16 bit) per sample. The accelerometer scale is irrelevant (the vector is
+ * normalized), the gyroscope scale is given at initialization (ORIENTATION_MPU6050_GYRO_*).
+ *
+ * Quaternion q = w, x, y, z rotates the sensor frame to the earth frame (z up): the gravity
+ * seen by the sensor is (2(xz - wy), 2(wx + yz), w^2 - x^2 - y^2 + z^2), same convention
+ * as ekf_imu13states.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+/** Gyroscope scales of the MPU6050 full scale ranges, rad/s per LSB */
+#define ORIENTATION_MPU6050_GYRO_250DPS     (3.14159265f / 180.0f / 131.0f)
+#define ORIENTATION_MPU6050_GYRO_500DPS     (3.14159265f / 180.0f / 65.5f)
+#define ORIENTATION_MPU6050_GYRO_1000DPS    (3.14159265f / 180.0f / 32.8f)
+#define ORIENTATION_MPU6050_GYRO_2000DPS    (3.14159265f / 180.0f / 16.4f)
+
+/** Values of each sample of a MPU6050 burst: ax, ay, az, gx, gy, gz */
+#define ORIENTATION_MOTION6_VALUES          6
+/*==================[typedef]================================================*/
+/**
+ * @brief Orientation filter algorithm
+ */
+typedef enum orientation_algorithm {
+    ORIENTATION_MADGWICK = 0,   /*!< Gradient descent, gain beta */
+    ORIENTATION_MAHONY          /*!< PI feedback, gains kp and ki */
+} orientation_algorithm_t;
+
+/**
+ * @brief Orientation filter (float)
+ */
+typedef struct {
+    orientation_algorithm_t algorithm;  /*!< Filter algorithm */
+    float q[4];                 /*!< Attitude quaternion w, x, y, z */
+    float sample_period;        /*!< Time between samples (s) */
+    float gain;                 /*!< beta (Madgwick) or kp (Mahony) */
+    float ki;                   /*!< Integral gain (Mahony) */
+    float integral[3];          /*!< Integral feedback (Mahony), rad/s */
+    float gyro_scale;           /*!< Raw gyroscope to rad/s (OrientationFilterProcessMotion6()) */
+} orientation_filter_t;
+
+/**
+ * @brief Orientation filter (fixed point)
+ */
+typedef struct {
+    orientation_algorithm_t algorithm;  /*!< Filter algorithm */
+    int32_t q[4];               /*!< Attitude quaternion w, x, y, z (Q30) */
+    int32_t gyro_k;             /*!< Raw gyroscope to half rotation angle per sample, 0.5 * gyro_scale / sample_frec (Q46) */
+    int32_t gain_k;             /*!< beta / sample_frec (Madgwick) or 0.5 * kp / sample_frec (Mahony) (Q30) */
+    int32_t ki_k;               /*!< 0.5 * ki / sample_frec^2 (Mahony) (Q46) */
+    int64_t integral[3];        /*!< Integral feedback (Mahony), half rotation angle per sample (Q46) */
+} orientation_filter_q_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize an orientation filter, attitude at rest (q = 1, 0, 0, 0)
+ *
+ * @param filter            Filter to initialize
+ * @param algorithm         ORIENTATION_MADGWICK or ORIENTATION_MAHONY
+ * @param sample_frec       IMU sample frequency
+ * @param gain              beta (Madgwick) or kp (Mahony)
+ * @param ki                Integral gain (Mahony, 0 disables the bias compensation)
+ * @param gyro_scale        Raw gyroscope to rad/s (ORIENTATION_MPU6050_GYRO_*), only for OrientationFilterProcessMotion6()
+ * @return true             Filter initialized
+ * @return false            Invalid parameters
+ */
+bool OrientationFilterInit(orientation_filter_t * filter, orientation_algorithm_t algorithm, float sample_frec, float gain, float ki, float gyro_scale);
+
+/**
+ * @brief Attitude at rest (q = 1, 0, 0, 0) and integral feedback cleared
+ *
+ * @param filter            Filter
+ */
+void OrientationFilterReset(orientation_filter_t * filter);
+
+/**
+ * @brief Update the attitude with a sample
+ *
+ * @param filter            Filter
+ * @param gyro              Angular rates x, y, z (rad/s)
+ * @param accel             Acceleration x, y, z (any unit, all 0 skips the correction)
+ */
+void OrientationFilterUpdate(orientation_filter_t * filter, const float * gyro, const float * accel);
+
+/**
+ * @brief Update the attitude with a burst of raw MPU6050 samples
+ *
+ * @param filter            Filter
+ * @param samples           ax, ay, az, gx, gy, gz of each sample (MPU6050_getMotion6FIFO())
+ * @param n_samples         Number of samples
+ */
+void OrientationFilterProcessMotion6(orientation_filter_t * filter, const int16_t * samples, uint16_t n_samples);
+
+/**
+ * @brief Euler angles of the attitude
+ *
+ * @param filter            Filter
+ * @param euler             Roll, pitch and yaw (rad)
+ */
+void OrientationFilterGetEuler(const orientation_filter_t * filter, float * euler);
+
+/**
+ * @brief Initialize a fixed point orientation filter, attitude at rest (q = 1, 0, 0, 0)
+ *
+ * @param filter            Filter to initialize
+ * @param algorithm         ORIENTATION_MADGWICK or ORIENTATION_MAHONY
+ * @param sample_frec       IMU sample frequency
+ * @param gain              beta (Madgwick) or kp (Mahony)
+ * @param ki                Integral gain (Mahony, 0 disables the bias compensation)
+ * @param gyro_scale        Raw gyroscope to rad/s (ORIENTATION_MPU6050_GYRO_*)
+ * @return true             Filter initialized
+ * @return false            Invalid parameters or constants out of the fixed point range
+ */
+bool OrientationFilterQInit(orientation_filter_q_t * filter, orientation_algorithm_t algorithm, float sample_frec, float gain, float ki, float gyro_scale);
+
+/**
+ * @brief Attitude at rest (q = 1, 0, 0, 0) and integral feedback cleared
+ *
+ * @param filter            Filter
+ */
+void OrientationFilterQReset(orientation_filter_q_t * filter);
+
+/**
+ * @brief Update the attitude with a raw sample
+ *
+ * @param filter            Filter
+ * @param gyro              Raw angular rates x, y, z
+ * @param accel             Raw acceleration x, y, z (all 0 skips the correction)
+ */
+void OrientationFilterQUpdate(orientation_filter_q_t * filter, const int16_t * gyro, const int16_t * accel);
+
+/**
+ * @brief Update the attitude with a burst of raw MPU6050 samples
+ *
+ * @param filter            Filter
+ * @param samples           ax, ay, az, gx, gy, gz of each sample (MPU6050_getMotion6FIFO())
+ * @param n_samples         Number of samples
+ */
+void OrientationFilterQProcessMotion6(orientation_filter_q_t * filter, const int16_t * samples, uint16_t n_samples);
+
+/**
+ * @brief Attitude quaternion in float
+ *
+ * @param filter            Filter
+ * @param q                 w, x, y, z
+ */
+void OrientationFilterQGetQuaternion(const orientation_filter_q_t * filter, float * q);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* ORIENTATION_FILTER_H_ */
+
+/*==================[end of file]============================================*/
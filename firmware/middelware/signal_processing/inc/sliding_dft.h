@@ -0,0 +1,113 @@
+#ifndef SLIDING_DFT_H_
+#define SLIDING_DFT_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Sliding_DFT Sliding DFT
+ */
+
+/** \brief Spectrum of the last N samples, updated sample by sample
+ *
+ * The sliding DFT keeps the DFT bins of a window of the last N samples and updates them
+ * with every new sample at a fixed cost per bin, so a live spectrum can be refreshed at
+ * sample rate instead of recomputing FFTMagnitude() for each block:
+ *
+ *      X_k[n] = r * e^(j*2*pi*k/N) * (X_k[n-1] + x[n] - r^N * x[n-N])
+ *
+ * The damping factor r (slightly below 1) makes the recursion stable: rounding errors
+ * decay instead of accumulating forever, at the cost of weighting the window samples by
+ * r^m (with r = 0.9999 and N = 256, older samples are attenuated 2.5%).
+ * SDFTMagnitude() returns the amplitude of each bin (rectangular window).
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define SDFT_DEFAULT_DAMPING    0.9999f
+/*==================[typedef]================================================*/
+/**
+ * @brief Sliding DFT
+ */
+typedef struct {
+    uint16_t signal_lenght;     /*!< Window length N */
+    uint8_t n_bins;             /*!< Number of tracked bins */
+    float damping;              /*!< Damping factor r */
+    float damping_n;            /*!< r^N */
+    uint16_t pos;               /*!< Position of the oldest sample in the buffer */
+    float * buffer;             /*!< Last N samples */
+    uint16_t * bins;            /*!< Tracked bins (0 to N / 2) */
+    float * twiddle;            /*!< r * e^(j*2*pi*k/N) of each bin (re, im) */
+    float * spectrum;           /*!< X_k of each bin (re, im) */
+} sdft_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Create a sliding DFT
+ *
+ * @param sdft              Sliding DFT to initialize
+ * @param signal_lenght     Window length N (frequency resolution = sample frequency / N)
+ * @param bins              Bins to track (of lenght = n_bins, from 0 to N / 2)
+ * @param n_bins            Number of bins
+ * @param damping           Damping factor (e.g. SDFT_DEFAULT_DAMPING, 1 for no damping)
+ * @return true             Sliding DFT created
+ * @return false            Invalid parameters or not enough memory
+ */
+bool SDFTCreate(sdft_t * sdft, uint16_t signal_lenght, const uint16_t * bins, uint8_t n_bins, float damping);
+
+/**
+ * @brief Release the memory of a sliding DFT
+ *
+ * @param sdft              Sliding DFT created with SDFTCreate()
+ */
+void SDFTDestroy(sdft_t * sdft);
+
+/**
+ * @brief Clear the window and the spectrum
+ *
+ * @param sdft              Sliding DFT
+ */
+void SDFTReset(sdft_t * sdft);
+
+/**
+ * @brief Slide the window one sample
+ *
+ * @param sdft              Sliding DFT
+ * @param sample            New sample
+ */
+void SDFTUpdate(sdft_t * sdft, float sample);
+
+/**
+ * @brief Slide the window over a block of samples
+ *
+ * @param sdft              Sliding DFT
+ * @param signal            New samples
+ * @param signal_lenght     Number of samples
+ */
+void SDFTProcess(sdft_t * sdft, const float * signal, uint16_t signal_lenght);
+
+/**
+ * @brief Snapshot of the amplitude of every tracked bin
+ *
+ * @param sdft              Sliding DFT
+ * @param magnitude         Array to store the amplitudes (of lenght = n_bins)
+ */
+void SDFTMagnitude(const sdft_t * sdft, float * magnitude);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* SLIDING_DFT_H_ */
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,158 @@
+#ifndef SPECTROGRAM_H_
+#define SPECTROGRAM_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Spectrogram Streaming spectral analysis
+ */
+
+/** \brief Welch power spectral density and STFT spectrogram over streaming samples
+ *
+ * Samples are written in blocks of any size (for example, each ADC read) into a ring
+ * buffer of one frame. Every hop = N / overlap samples a new frame is windowed straight
+ * from the ring buffer into the FFT work buffer (no intermediate frame copy), and its
+ * power spectral density becomes a new spectrogram row:
+ *
+ *      row[k] = c_k * |X[k]|^2 / (sample_frec * sum(w[n]^2)),  c_0 = 1, c_k = 2
+ *
+ * in signal units^2 / Hz (one-sided). Rows are averaged until SpectrogramPSDReset(), so
+ * SpectrogramPSD() returns the Welch estimate of the PSD. Window tables are generated once
+ * (with the esp-dsp windows module) and cached in the internal real FFT plan.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "fft.h"
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Overlap between consecutive frames
+ */
+typedef enum spectrogram_overlap {
+    SPECTROGRAM_OVERLAP_0 = 1,      /*!< No overlap (hop = N) */
+    SPECTROGRAM_OVERLAP_50 = 2,     /*!< 50% overlap (hop = N / 2) */
+    SPECTROGRAM_OVERLAP_75 = 4      /*!< 75% overlap (hop = N / 4) */
+} spectrogram_overlap_t;
+
+/**
+ * @brief Function called with each new spectrogram row
+ *
+ * @param row               PSD of the last frame (of lenght = N / 2)
+ * @param n_bins            Number of bins of the row (N / 2)
+ * @param param             Parameter given to SpectrogramCreate()
+ */
+typedef void (*spectrogram_row_cb_t)(const float * row, uint16_t n_bins, void * param);
+
+/**
+ * @brief Streaming spectral analysis stage
+ */
+typedef struct {
+    uint16_t signal_lenght;         /*!< Frame length N */
+    uint16_t hop;                   /*!< Samples between consecutive frames */
+    float sample_frec;              /*!< Signal's sample frequency */
+    fft_plan_t plan;                /*!< Real FFT plan with the cached window table */
+    float * ring;                   /*!< Ring buffer with the last N samples */
+    uint16_t pos;                   /*!< Position of the oldest sample in the ring buffer */
+    uint16_t count;                 /*!< Samples written since the last frame */
+    uint16_t filled;                /*!< Samples in the ring buffer (up to N) */
+    float * row;                    /*!< PSD of the last frame (spectrogram row) */
+    float * psd_sum;                /*!< Sum of the rows since SpectrogramPSDReset() */
+    uint32_t n_frames;              /*!< Number of rows in psd_sum */
+    float density;                  /*!< 2 / (sample_frec * sum(w[n]^2)) */
+    spectrogram_row_cb_t row_cb;    /*!< Function called with each new row (NULL: none) */
+    void * param;                   /*!< Parameter of row_cb */
+} spectrogram_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Create a streaming spectral analysis stage
+ *
+ * @note  Lenght must be a power of two (from 16 to MAX_SIGNAL_LENGHT)
+ *
+ * @param spec              Stage to initialize
+ * @param sample_frec       Signal's sample frequency
+ * @param signal_lenght     Frame length N (frequency resolution = sample_frec / N)
+ * @param overlap           Overlap between consecutive frames
+ * @param window            Window applied to each frame
+ * @param row_cb            Function called with each new row (NULL: rows are only kept in spec->row)
+ * @param param             Parameter of row_cb
+ * @return true             Stage created
+ * @return false            Invalid parameters or not enough memory
+ */
+bool SpectrogramCreate(spectrogram_t * spec, float sample_frec, uint16_t signal_lenght, spectrogram_overlap_t overlap,
+    fft_window_t window, spectrogram_row_cb_t row_cb, void * param);
+
+/**
+ * @brief Release the memory of a streaming spectral analysis stage
+ *
+ * @param spec              Stage created with SpectrogramCreate()
+ */
+void SpectrogramDestroy(spectrogram_t * spec);
+
+/**
+ * @brief Clear the ring buffer, the last row and the PSD average
+ *
+ * @param spec              Stage
+ */
+void SpectrogramReset(spectrogram_t * spec);
+
+/**
+ * @brief Write samples (of any lenght) into the stage
+ *
+ * @param spec              Stage
+ * @param signal            Samples
+ * @param signal_lenght     Number of samples
+ * @return uint16_t         Number of spectrogram rows completed (spec->row holds the last one)
+ */
+uint16_t SpectrogramWrite(spectrogram_t * spec, const float * signal, uint16_t signal_lenght);
+
+/**
+ * @brief Write ADC readings (of any lenght) into the stage
+ *
+ * Readings are converted to (values[i] - offset) * gain while they are stored in the
+ * ring buffer, so no float copy of the ADC buffer is needed.
+ *
+ * @param spec              Stage
+ * @param values            ADC readings (e.g. from AnalogInputReadContinuous())
+ * @param signal_lenght     Number of readings
+ * @param offset            Reading that corresponds to 0
+ * @param gain              Signal units per ADC unit
+ * @return uint16_t         Number of spectrogram rows completed (spec->row holds the last one)
+ */
+uint16_t SpectrogramWriteADC(spectrogram_t * spec, const uint16_t * values, uint16_t signal_lenght, uint16_t offset, float gain);
+
+/**
+ * @brief Welch estimate of the power spectral density
+ *
+ * @param spec              Stage
+ * @param psd               Array to store the average of the rows (of lenght = N / 2), in units^2 / Hz
+ * @return uint32_t         Number of averaged rows (0: psd is not modified)
+ */
+uint32_t SpectrogramPSD(const spectrogram_t * spec, float * psd);
+
+/**
+ * @brief Restart the PSD average
+ *
+ * @param spec              Stage
+ */
+void SpectrogramPSDReset(spectrogram_t * spec);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* SPECTROGRAM_H_ */
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,238 @@
+/**
+ * @file decimator.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "decimator.h"
+#include "dsp_scratch.h"
+#include "esp_dsp.h"
+/*==================[macros and definitions]=================================*/
+#define Q15_ONE             32768
+/* Cut-off frequency of the windowed sinc stages, relative to the output Nyquist frequency */
+#define STAGE_CUTOFF        0.8f
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static decimator_stage_t * DecimatorNewStage(decimator_t * decimator, uint8_t decimation, uint16_t n_taps, uint16_t n_coeffs, uint16_t n_delay);
+static bool DecimatorDesign(float * h, uint16_t n_taps, float cutoff);
+static int16_t DecimatorSat16(int32_t x);
+static uint16_t DecimatorHalfband(decimator_stage_t * stage, int16_t * signal, uint16_t signal_lenght);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static decimator_stage_t * DecimatorNewStage(decimator_t * decimator, uint8_t decimation, uint16_t n_taps, uint16_t n_coeffs, uint16_t n_delay){
+    if((decimator->n_stages >= DECIMATOR_MAX_STAGES) || (decimation < 2) || (n_taps < 2)){
+        return NULL;
+    }
+    decimator_stage_t * stage = &decimator->stages[decimator->n_stages];
+    memset(stage, 0, sizeof(decimator_stage_t));
+    stage->coeffs = malloc(n_coeffs * sizeof(int16_t));
+    stage->delay = calloc(n_delay, sizeof(int16_t));
+    if((stage->coeffs == NULL) || (stage->delay == NULL)){
+        free(stage->coeffs);
+        free(stage->delay);
+        return NULL;
+    }
+    stage->decimation = decimation;
+    stage->n_taps = n_taps;
+    return stage;
+}
+
+static bool DecimatorDesign(float * h, uint16_t n_taps, float cutoff){
+    // Blackman windowed sinc with unity DC gain. The window is 2 samples longer so the
+    // first and last taps are not wasted on zeros.
+    size_t mark = DSPScratchMark();
+    float * window = DSPScratchAlloc((n_taps + 2) * sizeof(float));
+    if(window == NULL){
+        return false;
+    }
+    dsps_wind_blackman_f32(window, n_taps + 2);
+    float center = (n_taps - 1) / 2.0f;
+    float sum = 0;
+    for(uint16_t n=0; n<n_taps; n++){
+        float t = n - center;
+        float sinc = (t == 0) ? 2 * cutoff : sinf(2 * M_PI * cutoff * t) / (M_PI * t);
+        h[n] = sinc * window[n + 1];
+        sum += h[n];
+    }
+    for(uint16_t n=0; n<n_taps; n++){
+        h[n] /= sum;
+    }
+    DSPScratchRelease(mark);
+    return true;
+}
+
+static int16_t DecimatorSat16(int32_t x){
+    if(x > INT16_MAX){
+        return INT16_MAX;
+    }
+    if(x < INT16_MIN){
+        return INT16_MIN;
+    }
+    return x;
+}
+
+static uint16_t DecimatorHalfband(decimator_stage_t * stage, int16_t * signal, uint16_t signal_lenght){
+    uint16_t n_taps = stage->n_taps;
+    uint16_t n_side = (n_taps + 1) / 4;
+    uint16_t center = (n_taps - 1) / 2;
+    const int16_t * coeffs = stage->coeffs;
+    int16_t * delay = stage->delay;
+    uint16_t pos = stage->pos;
+    uint16_t result = 0;
+    for(uint16_t i=0; i<signal_lenght; i+=2){
+        // Every sample is stored twice, so the last n_taps samples are always contiguous
+        for(uint8_t k=0; k<2; k++){
+            delay[pos] = signal[i + k];
+            delay[pos + n_taps] = signal[i + k];
+            pos++;
+            if(pos >= n_taps){
+                pos = 0;
+            }
+        }
+        const int16_t * w = &delay[pos];
+        // Center tap is 0.5, the others are symmetric and only every other one is not zero
+        int32_t acc = ((int32_t)w[center] << 14) + (1 << 14);
+        for(uint16_t j=0; j<n_side; j++){
+            acc += coeffs[j] * ((int32_t)w[2 * j] + w[n_taps - 1 - 2 * j]);
+        }
+        signal[result++] = DecimatorSat16(acc >> 15);
+    }
+    stage->pos = pos;
+    return result;
+}
+
+/*==================[external functions definition]==========================*/
+void DecimatorInit(decimator_t * decimator){
+    memset(decimator, 0, sizeof(decimator_t));
+    decimator->decimation = 1;
+}
+
+void DecimatorDestroy(decimator_t * decimator){
+    for(uint8_t s=0; s<decimator->n_stages; s++){
+        decimator_stage_t * stage = &decimator->stages[s];
+        if(!stage->halfband){
+            dsps_fird_s16_aexx_free(&stage->fir);
+        }
+        free(stage->coeffs);
+        free(stage->delay);
+    }
+    DecimatorInit(decimator);
+}
+
+bool DecimatorAddStage(decimator_t * decimator, uint8_t decimation, uint16_t n_taps){
+    // Design temporaries are scratch memory
+    size_t mark = DSPScratchMark();
+    float * h = DSPScratchAlloc(n_taps * sizeof(float));
+    int16_t * coeffs = DSPScratchAlloc(n_taps * sizeof(int16_t));
+    bool ok = (h != NULL) && (coeffs != NULL) && (decimation >= 2);
+    ok = ok && DecimatorDesign(h, n_taps, STAGE_CUTOFF * 0.5f / decimation);
+    if(ok){
+        // Rounding error of the quantization is moved to the center tap to keep unity DC gain
+        int32_t sum = 0;
+        for(uint16_t n=0; n<n_taps; n++){
+            coeffs[n] = lroundf(h[n] * Q15_ONE);
+            sum += coeffs[n];
+        }
+        coeffs[n_taps / 2] += Q15_ONE - sum;
+        ok = DecimatorAddStageCoefficients(decimator, decimation, coeffs, n_taps);
+    }
+    DSPScratchRelease(mark);
+    return ok;
+}
+
+bool DecimatorAddStageCoefficients(decimator_t * decimator, uint8_t decimation, const int16_t * coeffs, uint16_t n_taps){
+    decimator_stage_t * stage = DecimatorNewStage(decimator, decimation, n_taps, n_taps, n_taps);
+    if(stage == NULL){
+        return false;
+    }
+    memcpy(stage->coeffs, coeffs, n_taps * sizeof(int16_t));
+    if(dsps_fird_init_s16(&stage->fir, stage->coeffs, stage->delay, n_taps, decimation, 0, 0) != ESP_OK){
+        dsps_fird_s16_aexx_free(&stage->fir);
+        free(stage->coeffs);
+        free(stage->delay);
+        return false;
+    }
+    decimator->decimation *= decimation;
+    decimator->n_stages++;
+    return true;
+}
+
+bool DecimatorAddHalfband(decimator_t * decimator, uint16_t n_taps){
+    if((n_taps < 7) || ((n_taps + 1) % 4)){
+        return false;
+    }
+    uint16_t n_side = (n_taps + 1) / 4;
+    decimator_stage_t * stage = DecimatorNewStage(decimator, 2, n_taps, n_side, 2 * n_taps);
+    size_t mark = DSPScratchMark();
+    float * h = DSPScratchAlloc(n_taps * sizeof(float));
+    // Cut-off at a quarter of the input rate: h[center] = 0.5 and h[center +- 2k] = 0
+    if((stage == NULL) || (h == NULL) || !DecimatorDesign(h, n_taps, 0.25f)){
+        if(stage != NULL){
+            free(stage->coeffs);
+            free(stage->delay);
+        }
+        DSPScratchRelease(mark);
+        return false;
+    }
+    stage->halfband = true;
+    float scale = 0;
+    for(uint16_t j=0; j<n_side; j++){
+        scale += 2 * h[2 * j];
+    }
+    // Side taps are scaled to add exactly 0.5, rounding error goes to the taps next to the center
+    int32_t sum = 0;
+    for(uint16_t j=0; j<n_side; j++){
+        stage->coeffs[j] = lroundf(h[2 * j] / scale * (Q15_ONE / 2));
+        sum += 2 * stage->coeffs[j];
+    }
+    stage->coeffs[n_side - 1] += (Q15_ONE / 2 - sum) / 2;
+    DSPScratchRelease(mark);
+    decimator->decimation *= 2;
+    decimator->n_stages++;
+    return true;
+}
+
+void DecimatorReset(decimator_t * decimator){
+    for(uint8_t s=0; s<decimator->n_stages; s++){
+        decimator_stage_t * stage = &decimator->stages[s];
+        if(stage->halfband){
+            memset(stage->delay, 0, 2 * stage->n_taps * sizeof(int16_t));
+            stage->pos = 0;
+        } else {
+            memset(stage->fir.delay, 0, stage->fir.coeffs_len * sizeof(int16_t));
+            stage->fir.pos = 0;
+            stage->fir.d_pos = 0;
+        }
+    }
+}
+
+uint16_t DecimatorProcess(decimator_t * decimator, int16_t * signal, uint16_t signal_lenght){
+    if((decimator->n_stages == 0) || (signal_lenght % decimator->decimation)){
+        return 0;
+    }
+    // Each stage reads its input ahead of the samples it writes, so the whole chain runs in place
+    for(uint8_t s=0; s<decimator->n_stages; s++){
+        decimator_stage_t * stage = &decimator->stages[s];
+        if(stage->halfband){
+            signal_lenght = DecimatorHalfband(stage, signal, signal_lenght);
+        } else {
+            signal_lenght = dsps_fird_s16(&stage->fir, signal, signal, signal_lenght / stage->decimation);
+        }
+    }
+    return signal_lenght;
+}
+
+/*==================[end of file]============================================*/
\ No newline at end of file
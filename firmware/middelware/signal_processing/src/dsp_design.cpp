@@ -0,0 +1,90 @@
+/**
+ * @file dsp_design.cpp
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stddef.h>
+#include "dsp_design.h"
+#include "dsps_wind_design.h"
+/*==================[macros and definitions]=================================*/
+#if (DSP_DESIGN_WINDOW_MAX_LENGHT > MAX_SIGNAL_LENGHT)
+#error "DSP_DESIGN_WINDOW_MAX_LENGHT above MAX_SIGNAL_LENGHT"
+#endif
+/*==================[internal data declaration]==============================*/
+// Tables of one length, evaluated by the compiler (constexpr) and placed in flash
+template <int Len>
+struct WindowTables {
+    static constexpr dsps_design::window<Len> hann = dsps_design::wind_hann<Len>();
+    static constexpr dsps_design::window<Len> blackman = dsps_design::wind_blackman<Len>();
+    static constexpr dsps_design::window<Len> nuttall = dsps_design::wind_nuttall<Len>();
+    static constexpr dsps_design::window<Len> flat_top = dsps_design::wind_flat_top<Len>();
+};
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+template <int Len> constexpr dsps_design::window<Len> WindowTables<Len>::hann;
+template <int Len> constexpr dsps_design::window<Len> WindowTables<Len>::blackman;
+template <int Len> constexpr dsps_design::window<Len> WindowTables<Len>::nuttall;
+template <int Len> constexpr dsps_design::window<Len> WindowTables<Len>::flat_top;
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+template <int Len>
+static const float * DSPDesignWindowTable(fft_window_t window){
+    switch(window){
+        case FFT_WINDOW_HANN:
+            return WindowTables<Len>::hann.values;
+        case FFT_WINDOW_BLACKMAN:
+            return WindowTables<Len>::blackman.values;
+        case FFT_WINDOW_NUTTALL:
+            return WindowTables<Len>::nuttall.values;
+        case FFT_WINDOW_FLAT_TOP:
+            return WindowTables<Len>::flat_top.values;
+        default:
+            return NULL;
+    }
+}
+
+/*==================[external functions definition]==========================*/
+const float * DSPDesignWindow(fft_window_t window, uint16_t signal_lenght){
+    if((signal_lenght < DSP_DESIGN_WINDOW_MIN_LENGHT) || (signal_lenght > DSP_DESIGN_WINDOW_MAX_LENGHT)){
+        return NULL;
+    }
+    switch(signal_lenght){
+        case 32:
+            return DSPDesignWindowTable<32>(window);
+        case 64:
+            return DSPDesignWindowTable<64>(window);
+#if (DSP_DESIGN_WINDOW_MAX_LENGHT >= 128)
+        case 128:
+            return DSPDesignWindowTable<128>(window);
+#endif
+#if (DSP_DESIGN_WINDOW_MAX_LENGHT >= 256)
+        case 256:
+            return DSPDesignWindowTable<256>(window);
+#endif
+#if (DSP_DESIGN_WINDOW_MAX_LENGHT >= 512)
+        case 512:
+            return DSPDesignWindowTable<512>(window);
+#endif
+#if (DSP_DESIGN_WINDOW_MAX_LENGHT >= 1024)
+        case 1024:
+            return DSPDesignWindowTable<1024>(window);
+#endif
+#if (DSP_DESIGN_WINDOW_MAX_LENGHT >= 2048)
+        case 2048:
+            return DSPDesignWindowTable<2048>(window);
+#endif
+        default:
+            return NULL;
+    }
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,94 @@
+/**
+ * @file dsp_profile.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "dsp_profile.h"
+#if DSP_PROFILE_ENABLE
+/*==================[macros and definitions]=================================*/
+#define LINE_SIZE       128
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static const char * const profile_names[DSP_PROFILE_COUNT] = {
+    [DSP_PROFILE_FFT_PLAN_SPECTRUM] = "FFTPlanSpectrum",
+    [DSP_PROFILE_FFT_PLAN_POWER] = "FFTPlanPower",
+    [DSP_PROFILE_FFT_WINDOW_GENERATE] = "FFTWindowGenerate",
+    [DSP_PROFILE_FFT_REAL_SPLIT] = "FFTRealSplit",
+    [DSP_PROFILE_IIR_FILTER_APPLY] = "IIRFilterApply",
+    [DSP_PROFILE_IIR_FILTER_DESIGN] = "IIRFilterAddSection",
+    [DSP_PROFILE_DSPS_FFT2R_FC32] = "dsps_fft2r_fc32",
+    [DSP_PROFILE_DSPS_BIT_REV_FC32] = "dsps_bit_rev_fc32",
+    [DSP_PROFILE_DSPS_CPLX2REC_FC32] = "dsps_cplx2reC_fc32",
+    [DSP_PROFILE_DSPS_SQRT_F32] = "dsps_sqrt_f32",
+    [DSP_PROFILE_DSPS_WIND_F32] = "dsps_wind_f32",
+    [DSP_PROFILE_DSPS_BIQUAD_CASCADE_F32] = "dsps_biquad_cascade_f32",
+    [DSP_PROFILE_DSPS_BIQUAD_GEN_F32] = "dsps_biquad_gen_f32"
+};
+static dsp_profile_stats_t profile_stats[DSP_PROFILE_COUNT];
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+void DSPProfileRecord(dsp_profile_id_t id, uint32_t cycles, size_t bytes){
+    dsp_profile_stats_t * stats = &profile_stats[id];
+    stats->calls++;
+    stats->total_cycles += cycles;
+    stats->bytes += bytes;
+    if((stats->calls == 1) || (cycles < stats->min_cycles)){
+        stats->min_cycles = cycles;
+    }
+    if(cycles > stats->max_cycles){
+        stats->max_cycles = cycles;
+    }
+}
+
+bool DSPProfileGet(dsp_profile_id_t id, dsp_profile_stats_t * stats){
+    if(id >= DSP_PROFILE_COUNT){
+        return false;
+    }
+    *stats = profile_stats[id];
+    return true;
+}
+
+const char * DSPProfileName(dsp_profile_id_t id){
+    return (id < DSP_PROFILE_COUNT) ? profile_names[id] : NULL;
+}
+
+void DSPProfileClear(void){
+    memset(profile_stats, 0, sizeof(profile_stats));
+}
+
+void DSPProfileDump(dsp_profile_print_t print){
+    char line[LINE_SIZE];
+    snprintf(line, LINE_SIZE, "%-24s %8s %12s %10s %10s %10s %10s %8s\r\n",
+             "function", "calls", "total", "min", "avg", "max", "bytes", "cyc/B");
+    print(line);
+    for(uint8_t i=0; i<DSP_PROFILE_COUNT; i++){
+        const dsp_profile_stats_t * stats = &profile_stats[i];
+        if(stats->calls == 0){
+            continue;
+        }
+        float per_byte = (stats->bytes != 0) ? ((float)stats->total_cycles / stats->bytes) : 0;
+        snprintf(line, LINE_SIZE, "%-24s %8" PRIu32 " %12" PRIu64 " %10" PRIu32 " %10" PRIu64 " %10" PRIu32 " %10" PRIu64 " %8.2f\r\n",
+                 profile_names[i], stats->calls, stats->total_cycles, stats->min_cycles,
+                 stats->total_cycles / stats->calls, stats->max_cycles, stats->bytes, per_byte);
+        print(line);
+    }
+}
+
+#endif
+/*==================[end of file]============================================*/
@@ -0,0 +1,95 @@
+/**
+ * @file dsp_scratch.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include "dsp_scratch.h"
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static uint8_t * scratch = NULL;
+static bool scratch_allocated = false;
+static dsp_scratch_stats_t scratch_stats = {
+    .size = 0,
+    .used = 0,
+    .high_water = 0,
+    .failures = 0
+};
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+bool DSPScratchInit(void * buffer, size_t size){
+    // Region can't be replaced under buffers in use
+    if(scratch_stats.used != 0){
+        return false;
+    }
+    if(scratch_allocated){
+        free(scratch);
+    }
+    scratch_allocated = (buffer == NULL);
+    if(buffer == NULL){
+        buffer = malloc(size);
+    }
+    scratch = buffer;
+    scratch_stats.size = (buffer == NULL) ? 0 : size;
+    return buffer != NULL;
+}
+
+void * DSPScratchAlloc(size_t size){
+    if((scratch == NULL) && !DSPScratchInit(NULL, DSP_SCRATCH_SIZE)){
+        scratch_stats.failures++;
+        return NULL;
+    }
+    // Alignment is relative to the address, the region itself may not be aligned
+    uintptr_t base = (uintptr_t)scratch;
+    size_t start = ((base + scratch_stats.used + DSP_SCRATCH_ALIGN - 1) & ~(uintptr_t)(DSP_SCRATCH_ALIGN - 1)) - base;
+    if((start > scratch_stats.size) || (size > scratch_stats.size - start)){
+        scratch_stats.failures++;
+        return NULL;
+    }
+    scratch_stats.used = start + size;
+    if(scratch_stats.used > scratch_stats.high_water){
+        scratch_stats.high_water = scratch_stats.used;
+    }
+    return &scratch[start];
+}
+
+size_t DSPScratchMark(void){
+    return scratch_stats.used;
+}
+
+void DSPScratchRelease(size_t mark){
+    if(mark < scratch_stats.used){
+        scratch_stats.used = mark;
+    }
+}
+
+void DSPScratchReset(void){
+    scratch_stats.used = 0;
+}
+
+void DSPScratchGetStats(dsp_scratch_stats_t * stats){
+    *stats = scratch_stats;
+}
+
+void DSPScratchClearStats(void){
+    scratch_stats.high_water = scratch_stats.used;
+    scratch_stats.failures = 0;
+}
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,258 @@
+/**
+ * @file fast_conv.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fast_conv.h"
+#include "fft.h"
+#include "dsp_scratch.h"
+#include "esp_dsp.h"
+/*==================[macros and definitions]=================================*/
+/* Smallest FFT with an esp-dsp bit reverse table */
+#define MIN_FFT_LENGHT      16
+/* FFT length relative to the kernel length */
+#define FFT_TAPS_RATIO      4
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static uint16_t FastConvFFTLenght(uint16_t n_taps);
+static bool FastConvInit(fast_conv_t * conv, const float * kernel, uint16_t n_taps, bool correlation, bool direct);
+static void FastConvFFT(const fast_conv_t * conv, float * z);
+static void FastConvBlocks(fast_conv_t * conv, float * z, const float * input, float * output, uint16_t n1, uint16_t n2);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static uint16_t FastConvFFTLenght(uint16_t n_taps){
+    // Blocks of L - M + 1 samples cost O(L * log2(L)), which favors long FFTs, but past
+    // L = 4 * M the work buffers stop fitting in cache and the cost per sample grows again
+    uint32_t fft_lenght = MIN_FFT_LENGHT;
+    while((fft_lenght < FFT_TAPS_RATIO * n_taps) && (fft_lenght < MAX_SIGNAL_LENGHT)){
+        fft_lenght *= 2;
+    }
+    return fft_lenght;
+}
+
+static bool FastConvInit(fast_conv_t * conv, const float * kernel, uint16_t n_taps, bool correlation, bool direct){
+    memset(conv, 0, sizeof(fast_conv_t));
+    if((n_taps == 0) || (n_taps > MAX_SIGNAL_LENGHT / 2)){
+        return false;
+    }
+    conv->n_taps = n_taps;
+    if(direct){
+        // dsps_fir_f32() multiplies coeffs[0] by the oldest sample: the kernel goes reversed
+        conv->coeffs = malloc(n_taps * sizeof(float));
+        // dsps_fir_init_f32() clears 4 more values than the delay line length
+        conv->delay = calloc(n_taps + 4, sizeof(float));
+        if((conv->coeffs == NULL) || (conv->delay == NULL)){
+            FastConvDestroy(conv);
+            return false;
+        }
+        for(uint16_t m=0; m<n_taps; m++){
+            conv->coeffs[m] = correlation ? kernel[m] : kernel[n_taps - 1 - m];
+        }
+        dsps_fir_init_f32(&conv->fir, conv->coeffs, conv->delay, n_taps);
+        return true;
+    }
+    // Twiddle factors table is shared with the FFT module
+    if(!FFTInit()){
+        return false;
+    }
+    uint16_t fft_lenght = FastConvFFTLenght(n_taps);
+    conv->kernel_fft = malloc(2 * fft_lenght * sizeof(float));
+    conv->history = calloc(n_taps, sizeof(float));
+    if((conv->kernel_fft == NULL) || (conv->history == NULL)){
+        FastConvDestroy(conv);
+        return false;
+    }
+    conv->fft_lenght = fft_lenght;
+    conv->block = fft_lenght - n_taps + 1;
+    int pow = dsp_power_of_two(fft_lenght);
+    if(pow < 13){
+        conv->bitrev_table = dsps_fft2r_rev_tables_fc32[pow - 4];
+        conv->bitrev_size = dsps_fft2r_rev_tables_fc32_size[pow - 4];
+    }
+    // Kernel spectrum, with the 1/L of the inverse FFT
+    float * h = conv->kernel_fft;
+    memset(h, 0, 2 * fft_lenght * sizeof(float));
+    for(uint16_t m=0; m<n_taps; m++){
+        h[2*m] = (correlation ? kernel[n_taps - 1 - m] : kernel[m]) / fft_lenght;
+    }
+    FastConvFFT(conv, h);
+    return true;
+}
+
+static void FastConvFFT(const fast_conv_t * conv, float * z){
+    dsps_fft2r_fc32(z, conv->fft_lenght);
+    if(conv->bitrev_table != NULL){
+        dsps_bit_rev_lookup_fc32(z, conv->bitrev_size, conv->bitrev_table);
+    } else {
+        dsps_bit_rev_fc32(z, conv->fft_lenght);
+    }
+}
+
+static void FastConvBlocks(fast_conv_t * conv, float * z, const float * input, float * output, uint16_t n1, uint16_t n2){
+    uint16_t fft_lenght = conv->fft_lenght;
+    uint16_t n_history = conv->n_taps - 1;
+    const float * h = conv->kernel_fft;
+    // First block (history and n1 samples) as real part, second block (the last M - 1
+    // samples of the first one and n2 samples) as imaginary part, zero padded
+    uint16_t len1 = n_history + n1;
+    uint16_t len2 = (n2 > 0) ? n_history + n2 : 0;
+    for(uint16_t i=0; i<n_history; i++){
+        z[2*i] = conv->history[i];
+    }
+    for(uint16_t i=n_history; i<len1; i++){
+        z[2*i] = input[i - n_history];
+    }
+    for(uint16_t i=len1; i<fft_lenght; i++){
+        z[2*i] = 0;
+    }
+    for(uint16_t i=0; i<len2; i++){
+        z[2*i+1] = input[n1 - n_history + i];
+    }
+    for(uint16_t i=len2; i<fft_lenght; i++){
+        z[2*i+1] = 0;
+    }
+    FastConvFFT(conv, z);
+    // Z * H, conjugated so that the forward FFT gives back the conjugate of the inverse FFT
+    for(uint16_t k=0; k<fft_lenght; k++){
+        float zr = z[2*k];
+        float zi = z[2*k+1];
+        z[2*k] = zr * h[2*k] - zi * h[2*k+1];
+        z[2*k+1] = -(zr * h[2*k+1] + zi * h[2*k]);
+    }
+    FastConvFFT(conv, z);
+    // History is updated before writing the outputs, which may overwrite the input
+    uint16_t n = n1 + n2;
+    if(n >= n_history){
+        memcpy(conv->history, &input[n - n_history], n_history * sizeof(float));
+    } else {
+        memmove(conv->history, &conv->history[n], (n_history - n) * sizeof(float));
+        memcpy(&conv->history[n_history - n], input, n * sizeof(float));
+    }
+    // First M - 1 outputs of each block are wrapped around, the rest is the linear convolution
+    for(uint16_t i=0; i<n1; i++){
+        output[i] = z[2*(n_history + i)];
+    }
+    for(uint16_t i=0; i<n2; i++){
+        output[n1 + i] = -z[2*(n_history + i) + 1];
+    }
+}
+
+/*==================[external functions definition]==========================*/
+bool FastConvCreate(fast_conv_t * conv, const float * kernel, uint16_t n_taps){
+    return FastConvInit(conv, kernel, n_taps, false, n_taps < FAST_CONV_MIN_TAPS);
+}
+
+bool FastConvCreateCorrelation(fast_conv_t * conv, const float * pattern, uint16_t n_taps){
+    return FastConvInit(conv, pattern, n_taps, true, n_taps < FAST_CONV_MIN_TAPS);
+}
+
+void FastConvDestroy(fast_conv_t * conv){
+    free(conv->kernel_fft);
+    free(conv->history);
+    free(conv->coeffs);
+    free(conv->delay);
+    conv->kernel_fft = NULL;
+    conv->history = NULL;
+    conv->coeffs = NULL;
+    conv->delay = NULL;
+    conv->fft_lenght = 0;
+    conv->n_taps = 0;
+}
+
+void FastConvReset(fast_conv_t * conv){
+    if(conv->fft_lenght == 0){
+        memset(conv->delay, 0, conv->n_taps * sizeof(float));
+        conv->fir.pos = 0;
+    } else {
+        memset(conv->history, 0, conv->n_taps * sizeof(float));
+    }
+}
+
+bool FastConvProcess(fast_conv_t * conv, const float * input, float * output, uint16_t signal_lenght){
+    if(conv->fft_lenght == 0){
+        dsps_fir_f32(&conv->fir, input, output, signal_lenght);
+        return true;
+    }
+    // Complex work buffer is only needed during the call
+    size_t mark = DSPScratchMark();
+    float * z = DSPScratchAlloc(2 * conv->fft_lenght * sizeof(float));
+    if(z == NULL){
+        return false;
+    }
+    while(signal_lenght > 0){
+        // Blocks go in pairs, a single (or shorter) block only at the end
+        uint16_t n1 = (signal_lenght < conv->block) ? signal_lenght : conv->block;
+        uint16_t n2 = signal_lenght - n1;
+        if(n2 > conv->block){
+            n2 = conv->block;
+        }
+        FastConvBlocks(conv, z, input, output, n1, n2);
+        input += n1 + n2;
+        output += n1 + n2;
+        signal_lenght -= n1 + n2;
+    }
+    DSPScratchRelease(mark);
+    return true;
+}
+
+bool FastConvolution(const float * signal, uint16_t siglen, const float * kernel, uint16_t kernlen, float * convout){
+    if((siglen == 0) || (kernlen == 0) || ((uint32_t)siglen + kernlen - 1 > UINT16_MAX)){
+        return false;
+    }
+    // The shorter signal is the kernel
+    if(siglen < kernlen){
+        const float * tmp = signal;
+        signal = kernel;
+        kernel = tmp;
+        uint16_t tmp_len = siglen;
+        siglen = kernlen;
+        kernlen = tmp_len;
+    }
+    if(kernlen < FAST_CONV_MIN_TAPS){
+        return dsps_conv_f32(signal, siglen, kernel, kernlen, convout) == ESP_OK;
+    }
+    fast_conv_t conv;
+    if(!FastConvInit(&conv, kernel, kernlen, false, false)){
+        return false;
+    }
+    // The tail is the response to M - 1 zeros, filtered in place
+    bool ok = FastConvProcess(&conv, signal, convout, siglen);
+    memset(&convout[siglen], 0, (kernlen - 1) * sizeof(float));
+    ok = ok && FastConvProcess(&conv, &convout[siglen], &convout[siglen], kernlen - 1);
+    FastConvDestroy(&conv);
+    return ok;
+}
+
+bool FastCorrelation(const float * signal, uint16_t siglen, const float * pattern, uint16_t patlen, float * dest){
+    if((patlen == 0) || (siglen < patlen)){
+        return false;
+    }
+    if(patlen < FAST_CONV_MIN_TAPS){
+        return dsps_corr_f32(signal, siglen, pattern, patlen, dest) == ESP_OK;
+    }
+    fast_conv_t conv;
+    if(!FastConvInit(&conv, pattern, patlen, true, false)){
+        return false;
+    }
+    // First M - 1 samples only fill the history, the first output is the correlation at lag 0
+    memcpy(conv.history, signal, (patlen - 1) * sizeof(float));
+    bool ok = FastConvProcess(&conv, &signal[patlen - 1], dest, siglen - patlen + 1);
+    FastConvDestroy(&conv);
+    return ok;
+}
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -11,22 +11,251 @@
 
 /*==================[inclusions]=============================================*/
 #include <string.h>
+#include <stdlib.h>
 #include <math.h>
 #include "fft.h"
+#include "dsp_design.h"
+#include "dsp_profile.h"
 #include "esp_dsp.h"
 #include "esp_log.h"
 /*==================[macros and definitions]=================================*/
 #define TAG "FFT Module"
+/* 10 * log10(2) */
+#define DB_PER_OCTAVE   3.01029996f
+/* log2(1 + f) ~ f * (C1 + f * (C2 + f * C3)), 0 <= f < 1 */
+#define LOG2_C1         1.4228654f
+#define LOG2_C2         -0.5820856f
+#define LOG2_C3         0.1592202f
 /*==================[internal data declaration]==============================*/
-static float fft_complex[2 * MAX_SIGNAL_LENGHT];
-static float wind[MAX_SIGNAL_LENGHT];
-/*==================[internal functions declaration]=========================*/
 
+/*==================[internal functions declaration]=========================*/
+static void FFTPlanSetLenght(fft_plan_t * plan, uint16_t signal_lenght);
+static bool FFTPlanAllocate(fft_plan_t * plan, uint16_t signal_lenght, fft_window_t window, bool real_input);
+static bool FFTDefaultPlanSetLenght(uint16_t signal_lenght);
+static void FFTPlanLoad(fft_plan_t * plan, const float * signal, uint16_t start);
+static void FFTPlanTransform(fft_plan_t * plan);
+static void FFTRealSplit(fft_plan_t * plan);
+static void FFTPlanScaledPower(fft_plan_t * plan, float * fft);
+static float FFTFastLog2(float x);
 /*==================[internal data definition]===============================*/
+static fft_plan_t default_plan = {
+    .signal_lenght = 0,
+    .window_type = FFT_WINDOW_HANN,
+    .window = NULL,
+    .window_buffer = NULL,
+    .buffer = NULL,
+    .bitrev_table = NULL,
+    .bitrev_size = 0,
+    .real_input = true,
+    .split_table = NULL,
+    .allocated = false
+};
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static void FFTPlanSetLenght(fft_plan_t * plan, uint16_t signal_lenght){
+    // Real input plans run a complex FFT of half the signal length
+    uint16_t fft_lenght = plan->real_input ? (signal_lenght / 2) : signal_lenght;
+    plan->signal_lenght = signal_lenght;
+    if(plan->window_buffer != NULL){
+        FFTWindowGenerate(plan->window_buffer, signal_lenght, plan->window_type);
+        plan->window = plan->window_buffer;
+    } else {
+        plan->window = DSPDesignWindow(plan->window_type, signal_lenght);
+    }
+    // esp-dsp ships bit reverse lookup tables from 16 to 4096 points
+    int pow = dsp_power_of_two(fft_lenght);
+    if((pow > 3) && (pow < 13)){
+        plan->bitrev_table = dsps_fft2r_rev_tables_fc32[pow - 4];
+        plan->bitrev_size = dsps_fft2r_rev_tables_fc32_size[pow - 4];
+    } else {
+        plan->bitrev_table = NULL;
+        plan->bitrev_size = 0;
+    }
+    // Split step twiddles W^k = cos(2*pi*k/N) - j*sin(2*pi*k/N), for k = 0 .. N/4
+    if(plan->real_input){
+        float e = 2 * M_PI / signal_lenght;
+        for(uint16_t k=0; k<=(signal_lenght / 4); k++){
+            plan->split_table[2*k] = cosf(k * e);
+            plan->split_table[2*k+1] = sinf(k * e);
+        }
+    }
+}
+
+static bool FFTPlanAllocate(fft_plan_t * plan, uint16_t signal_lenght, fft_window_t window, bool real_input){
+    if(!dsp_is_power_of_two(signal_lenght) || (signal_lenght < 4) || (signal_lenght > MAX_SIGNAL_LENGHT)){
+        return false;
+    }
+    // Twiddle factors table is shared by all plans
+    if(!FFTInit()){
+        return false;
+    }
+    // Windows with a flash table need no buffer
+    bool window_table = (DSPDesignWindow(window, signal_lenght) != NULL);
+    plan->window_buffer = window_table ? NULL : malloc(signal_lenght * sizeof(float));
+    if(real_input){
+        // N/2 complex points plus N/4 + 1 split twiddles
+        plan->buffer = malloc(signal_lenght * sizeof(float));
+        plan->split_table = malloc((signal_lenght / 2 + 2) * sizeof(float));
+    } else {
+        plan->buffer = malloc(2 * signal_lenght * sizeof(float));
+        plan->split_table = NULL;
+    }
+    if((!window_table && (plan->window_buffer == NULL)) || (plan->buffer == NULL) || (real_input && (plan->split_table == NULL))){
+        free(plan->window_buffer);
+        free(plan->buffer);
+        free(plan->split_table);
+        plan->window_buffer = NULL;
+        plan->buffer = NULL;
+        plan->split_table = NULL;
+        return false;
+    }
+    plan->allocated = true;
+    plan->real_input = real_input;
+    plan->window_type = window;
+    FFTPlanSetLenght(plan, signal_lenght);
+    return true;
+}
+
+static bool FFTDefaultPlanSetLenght(uint16_t signal_lenght){
+    // Same limits as FFTPlanAllocate(): the twiddle table covers MAX_SIGNAL_LENGHT points
+    if(!dsp_is_power_of_two(signal_lenght) || (signal_lenght < 4) || (signal_lenght > MAX_SIGNAL_LENGHT)){
+        return false;
+    }
+    if(!FFTInit()){
+        return false;
+    }
+    // Window, work buffer and split twiddles are kept between calls, sized to the length in use
+    free(default_plan.window_buffer);
+    free(default_plan.buffer);
+    free(default_plan.split_table);
+    bool window_table = (DSPDesignWindow(default_plan.window_type, signal_lenght) != NULL);
+    default_plan.window_buffer = window_table ? NULL : malloc(signal_lenght * sizeof(float));
+    default_plan.buffer = malloc(signal_lenght * sizeof(float));
+    default_plan.split_table = malloc((signal_lenght / 2 + 2) * sizeof(float));
+    if((!window_table && (default_plan.window_buffer == NULL)) || (default_plan.buffer == NULL) || (default_plan.split_table == NULL)){
+        free(default_plan.window_buffer);
+        free(default_plan.buffer);
+        free(default_plan.split_table);
+        default_plan.window = NULL;
+        default_plan.window_buffer = NULL;
+        default_plan.buffer = NULL;
+        default_plan.split_table = NULL;
+        default_plan.signal_lenght = 0;
+        return false;
+    }
+    FFTPlanSetLenght(&default_plan, signal_lenght);
+    return true;
+}
+
+static void FFTPlanLoad(fft_plan_t * plan, const float * signal, uint16_t start){
+    uint16_t signal_lenght = plan->signal_lenght;
+    // Frames that wrap around a circular buffer are windowed in two segments, straight
+    // into the work buffer
+    uint16_t first = signal_lenght - start;
+    const float * w = plan->window;
+    float * buffer = plan->buffer;
+    if(plan->real_input){
+        // Windowed signal packed as z[n] = x[2n] + j*x[2n+1]
+        for(uint16_t i=0; i<first; i++){
+            buffer[i] = signal[start + i] * w[i];
+        }
+        for(uint16_t i=first; i<signal_lenght; i++){
+            buffer[i] = signal[i - first] * w[i];
+        }
+    } else {
+        // Windowed signal as real part, every imaginary part is overwritten here so the
+        // buffer doesn't need to be cleared
+        for(uint16_t i=0; i<first; i++){
+            buffer[2*i] = signal[start + i] * w[i];
+            buffer[2*i+1] = 0;
+        }
+        for(uint16_t i=first; i<signal_lenght; i++){
+            buffer[2*i] = signal[i - first] * w[i];
+            buffer[2*i+1] = 0;
+        }
+    }
+}
+
+static void FFTPlanTransform(fft_plan_t * plan){
+    // Real input plans run a complex FFT of half the signal length
+    uint16_t fft_lenght = plan->real_input ? (plan->signal_lenght / 2) : plan->signal_lenght;
+    float * fft_buffer = plan->buffer;
+    size_t fft_bytes = 2 * fft_lenght * sizeof(float);
+    // Calculate FFT
+    DSP_PROFILE_CALL(DSP_PROFILE_DSPS_FFT2R_FC32, fft_bytes, dsps_fft2r_fc32(fft_buffer, fft_lenght));
+    // Bit reverse
+    if(plan->bitrev_table != NULL){
+        DSP_PROFILE_CALL(DSP_PROFILE_DSPS_BIT_REV_FC32, fft_bytes,
+                         dsps_bit_rev_lookup_fc32(fft_buffer, plan->bitrev_size, plan->bitrev_table));
+    } else {
+        DSP_PROFILE_CALL(DSP_PROFILE_DSPS_BIT_REV_FC32, fft_bytes, dsps_bit_rev_fc32(fft_buffer, fft_lenght));
+    }
+    if(plan->real_input){
+        DSP_PROFILE_CALL(DSP_PROFILE_FFT_REAL_SPLIT, fft_bytes, FFTRealSplit(plan));
+    } else {
+        // Convert one complex vector to two complex vectors
+        DSP_PROFILE_CALL(DSP_PROFILE_DSPS_CPLX2REC_FC32, fft_bytes, dsps_cplx2reC_fc32(fft_buffer, fft_lenght));
+    }
+}
+
+static void FFTRealSplit(fft_plan_t * plan){
+    uint16_t half = plan->signal_lenght / 2;
+    float * z = plan->buffer;
+    const float * w = plan->split_table;
+    // DC and Nyquist bins are real, Nyquist is stored as the imaginary part of bin 0
+    float dc = z[0] + z[1];
+    z[1] = z[0] - z[1];
+    z[0] = dc;
+    // Split step, with A = Z[k] and B = Z[N/2-k]:
+    // Fe = (A + conj(B)) / 2, Fo = -j * (A - conj(B)) / 2
+    // X[k] = Fe + W^k * Fo, X[N/2-k] = conj(Fe - W^k * Fo)
+    // Each pair of bins only reads its own pair, so the spectrum replaces Z in place
+    for(uint16_t k=1; k<=(half / 2); k++){
+        float ar = z[2*k];
+        float ai = z[2*k+1];
+        float br = z[2*(half-k)];
+        float bi = z[2*(half-k)+1];
+        float fe_re = 0.5f * (ar + br);
+        float fe_im = 0.5f * (ai - bi);
+        float fo_re = 0.5f * (ai + bi);
+        float fo_im = 0.5f * (br - ar);
+        float t_re = w[2*k] * fo_re + w[2*k+1] * fo_im;
+        float t_im = w[2*k] * fo_im - w[2*k+1] * fo_re;
+        z[2*k] = fe_re + t_re;
+        z[2*k+1] = fe_im + t_im;
+        z[2*(half-k)] = fe_re - t_re;
+        z[2*(half-k)+1] = t_im - fe_im;
+    }
+}
+
+static void FFTPlanScaledPower(fft_plan_t * plan, float * fft){
+    uint16_t half = plan->signal_lenght / 2;
+    const float * x = plan->buffer;
+    // Square of FFTMagnitude() values: 4 * |X[k]| / (N/2), and half of it for DC. The
+    // complex path already holds 2 * X[k] (but for DC) after dsps_cplx2reC_fc32().
+    float scale = plan->real_input ? (8.0f / plan->signal_lenght) : (4.0f / plan->signal_lenght);
+    float dc_scale = plan->real_input ? (scale / 4) : (scale / 2);
+    float scale2 = scale * scale;
+    fft[0] = dc_scale * dc_scale * (x[0] * x[0] + (plan->real_input ? 0 : x[1] * x[1]));
+    for(uint16_t k=1; k<half; k++){
+        fft[k] = scale2 * (x[2*k] * x[2*k] + x[2*k+1] * x[2*k+1]);
+    }
+}
+
+static float FFTFastLog2(float x){
+    // x = 2^e * (1 + f): log2(x) = e + log2(1 + f), with a cubic for log2(1 + f) that is
+    // exact at f = 0 and f = 1 (so it is continuous) and has a max error of 8.8e-4
+    union {
+        float f;
+        uint32_t i;
+    } u = {x};
+    float e = (float)((int32_t)(u.i >> 23) - 127);
+    u.i = (u.i & 0x007FFFFF) | 0x3F800000;
+    float f = u.f - 1.0f;
+    return e + f * (LOG2_C1 + f * (LOG2_C2 + f * LOG2_C3));
+}
 
 /*==================[external functions definition]==========================*/
 bool FFTInit(void){
@@ -37,26 +266,19 @@ bool FFTInit(void){
     return true;
 }
 
-void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght){
-    // Generate Hann window
-    dsps_wind_hann_f32(wind, signal_lenght);
-    // Clear fft array
-    memset(fft_complex, 0, 2 * MAX_SIGNAL_LENGHT * sizeof(float));
-    // Multiply input array with window and store as real part
-    dsps_mul_f32(signal, wind, fft_complex, signal_lenght, 1, 1, 2);    
-    // Calculate FFT  
-    dsps_fft2r_fc32(fft_complex, signal_lenght);
-    // Bit reverse
-    dsps_bit_rev_fc32(fft_complex, signal_lenght);
-    // Convert one complex vector to two complex vectors
-    dsps_cplx2reC_fc32(fft_complex, signal_lenght);
-    // Calculate FFT magnitude 
-    for (int j = 0; j < signal_lenght; j++){
-            fft_complex[j] = 2*(sqrt(fft_complex[j*2+0]*fft_complex[j*2+0] + fft_complex[j*2+1]*fft_complex[j*2+1])) / (signal_lenght/2);
+bool FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght){
+    return FFTSpectrum(signal, fft, signal_lenght, FFT_OUTPUT_MAGNITUDE);
+}
+
+bool FFTSpectrum(float * signal, float * fft, uint16_t signal_lenght, fft_output_t output){
+    // Window is only regenerated when the signal length changes (0: no plan yet)
+    if(((default_plan.signal_lenght == 0) || (default_plan.signal_lenght != signal_lenght)) && !FFTDefaultPlanSetLenght(signal_lenght)){
+        // No stale values from a previous call are left in the output
+        memset(fft, 0, (signal_lenght / 2) * sizeof(float));
+        return false;
     }
-    fft_complex[0] = fft_complex[0] / 2;
-    // Copy result in fft array
-    memcpy(fft, fft_complex, (signal_lenght / 2) * sizeof(float));
+    FFTPlanSpectrum(&default_plan, signal, fft, output);
+    return true;
 }
 
 void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f){
@@ -66,4 +288,110 @@ void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f){
     }
 }
 
+void FFTWindowGenerate(float * window, uint16_t signal_lenght, fft_window_t window_type){
+    size_t bytes = signal_lenght * sizeof(float);
+    DSP_PROFILE_BEGIN(DSP_PROFILE_FFT_WINDOW_GENERATE);
+    switch(window_type){
+        case FFT_WINDOW_RECT:
+            for(uint16_t i=0; i<signal_lenght; i++){
+                window[i] = 1.0f;
+            }
+        break;
+        case FFT_WINDOW_HANN:
+            DSP_PROFILE_CALL(DSP_PROFILE_DSPS_WIND_F32, bytes, dsps_wind_hann_f32(window, signal_lenght));
+        break;
+        case FFT_WINDOW_BLACKMAN:
+            DSP_PROFILE_CALL(DSP_PROFILE_DSPS_WIND_F32, bytes, dsps_wind_blackman_f32(window, signal_lenght));
+        break;
+        case FFT_WINDOW_BLACKMAN_HARRIS:
+            DSP_PROFILE_CALL(DSP_PROFILE_DSPS_WIND_F32, bytes, dsps_wind_blackman_harris_f32(window, signal_lenght));
+        break;
+        case FFT_WINDOW_BLACKMAN_NUTTALL:
+            DSP_PROFILE_CALL(DSP_PROFILE_DSPS_WIND_F32, bytes, dsps_wind_blackman_nuttall_f32(window, signal_lenght));
+        break;
+        case FFT_WINDOW_NUTTALL:
+            DSP_PROFILE_CALL(DSP_PROFILE_DSPS_WIND_F32, bytes, dsps_wind_nuttall_f32(window, signal_lenght));
+        break;
+        case FFT_WINDOW_FLAT_TOP:
+            DSP_PROFILE_CALL(DSP_PROFILE_DSPS_WIND_F32, bytes, dsps_wind_flat_top_f32(window, signal_lenght));
+        break;
+    }
+    DSP_PROFILE_END(DSP_PROFILE_FFT_WINDOW_GENERATE, bytes);
+}
+
+bool FFTPlanCreate(fft_plan_t * plan, uint16_t signal_lenght, fft_window_t window){
+    return FFTPlanAllocate(plan, signal_lenght, window, false);
+}
+
+bool FFTPlanCreateReal(fft_plan_t * plan, uint16_t signal_lenght, fft_window_t window){
+    return FFTPlanAllocate(plan, signal_lenght, window, true);
+}
+
+void FFTPlanDestroy(fft_plan_t * plan){
+    if(plan->allocated){
+        free(plan->window_buffer);
+        free(plan->buffer);
+        free(plan->split_table);
+    }
+    plan->window = NULL;
+    plan->window_buffer = NULL;
+    plan->buffer = NULL;
+    plan->split_table = NULL;
+    plan->signal_lenght = 0;
+    plan->allocated = false;
+}
+
+void FFTPlanMagnitude(fft_plan_t * plan, const float * signal, float * fft){
+    FFTPlanSpectrum(plan, signal, fft, FFT_OUTPUT_MAGNITUDE);
+}
+
+void FFTPlanSpectrum(fft_plan_t * plan, const float * signal, float * fft, fft_output_t output){
+    DSP_PROFILE_BEGIN(DSP_PROFILE_FFT_PLAN_SPECTRUM);
+    uint16_t half = plan->signal_lenght / 2;
+    FFTPlanLoad(plan, signal, 0);
+    FFTPlanTransform(plan);
+    FFTPlanScaledPower(plan, fft);
+    // Every output is derived in place from the squared magnitude
+    switch(output){
+        case FFT_OUTPUT_MAGNITUDE:
+            for(uint16_t k=0; k<half; k++){
+                fft[k] = sqrtf(fft[k]);
+            }
+        break;
+        case FFT_OUTPUT_POWER:
+        break;
+        case FFT_OUTPUT_MAGNITUDE_FAST:
+            DSP_PROFILE_CALL(DSP_PROFILE_DSPS_SQRT_F32, half * sizeof(float), dsps_sqrt_f32_ansi(fft, fft, half));
+        break;
+        case FFT_OUTPUT_DB:
+            // 20 * log10(|X|) = 10 * log10(2) * log2(|X|^2)
+            for(uint16_t k=0; k<half; k++){
+                fft[k] = DB_PER_OCTAVE * FFTFastLog2(fft[k]);
+            }
+        break;
+    }
+    DSP_PROFILE_END(DSP_PROFILE_FFT_PLAN_SPECTRUM, plan->signal_lenght * sizeof(float));
+}
+
+void FFTPlanPower(fft_plan_t * plan, const float * signal, uint16_t start, float * power){
+    DSP_PROFILE_BEGIN(DSP_PROFILE_FFT_PLAN_POWER);
+    uint16_t half = plan->signal_lenght / 2;
+    const float * x = plan->buffer;
+    FFTPlanLoad(plan, signal, start);
+    FFTPlanTransform(plan);
+    if(plan->real_input){
+        power[0] = x[0] * x[0];
+        for(uint16_t k=1; k<half; k++){
+            power[k] = x[2*k] * x[2*k] + x[2*k+1] * x[2*k+1];
+        }
+    } else {
+        // The complex path doubles every bin but DC
+        power[0] = x[0] * x[0] + x[1] * x[1];
+        for(uint16_t k=1; k<half; k++){
+            power[k] = 0.25f * (x[2*k] * x[2*k] + x[2*k+1] * x[2*k+1]);
+        }
+    }
+    DSP_PROFILE_END(DSP_PROFILE_FFT_PLAN_POWER, plan->signal_lenght * sizeof(float));
+}
+
 /*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,225 @@
+/**
+ * @file fft_q15.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <math.h>
+#include "fft_q15.h"
+#include "esp_dsp.h"
+/*==================[macros and definitions]=================================*/
+/* A radix 2 butterfly can grow a component by up to 1 + sqrt(2), so stage inputs
+ * are kept below 32767 / 2.4142 to make overflow impossible */
+#define BFP_STAGE_MAX       13500
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static int8_t FFTQ15BlockShift(int16_t * data, uint16_t n, int32_t max);
+static int8_t FFTQ15Radix2(int16_t * data, uint16_t n);
+static uint16_t FFTQ15Sqrt(uint32_t x);
+static uint16_t FFTQ15Abs(int32_t re, int32_t im, fft_q15_magnitude_t magnitude);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static int8_t FFTQ15BlockShift(int16_t * data, uint16_t n, int32_t max){
+    int8_t shift = 0;
+    while((max >> shift) > BFP_STAGE_MAX){
+        shift++;
+    }
+    if(shift > 0){
+        int32_t round = 1 << (shift - 1);
+        for(uint16_t i=0; i<n; i++){
+            data[i] = (data[i] + round) >> shift;
+        }
+    }
+    return shift;
+}
+
+static int8_t FFTQ15Radix2(int16_t * data, uint16_t n){
+    // Same butterflies and twiddle table as dsps_fft2r_sc16_ansi, but the block is
+    // only scaled before the stages that could overflow. Input is already below
+    // BFP_STAGE_MAX, the peak of every stage output is tracked while it is written.
+    const int16_t * w = dsps_fft_w_table_sc16;
+    int8_t exponent = 0;
+    int32_t max = 0;
+    int ie = 1;
+    for(int n2 = n / 2; n2 > 0; n2 >>= 1){
+        exponent += FFTQ15BlockShift(data, 2 * n, max);
+        max = 0;
+        int ia = 0;
+        for(int j = 0; j < ie; j++){
+            int32_t c = w[2 * j];
+            int32_t s = w[2 * j + 1];
+            for(int i = 0; i < n2; i++){
+                int m = ia + n2;
+                int32_t re_temp = c * data[2 * m] + s * data[2 * m + 1];
+                int32_t im_temp = c * data[2 * m + 1] - s * data[2 * m];
+                int32_t a_re = (int32_t)data[2 * ia] << 15;
+                int32_t a_im = (int32_t)data[2 * ia + 1] << 15;
+                int32_t m_re = (a_re - re_temp + 0x4000) >> 15;
+                int32_t m_im = (a_im - im_temp + 0x4000) >> 15;
+                int32_t p_re = (a_re + re_temp + 0x4000) >> 15;
+                int32_t p_im = (a_im + im_temp + 0x4000) >> 15;
+                data[2 * m] = m_re;
+                data[2 * m + 1] = m_im;
+                data[2 * ia] = p_re;
+                data[2 * ia + 1] = p_im;
+                // OR of the magnitudes is a cheap bound of the peak (below twice its value)
+                max |= (m_re ^ (m_re >> 31)) | (m_im ^ (m_im >> 31)) | (p_re ^ (p_re >> 31)) | (p_im ^ (p_im >> 31));
+                ia++;
+            }
+            ia += n2;
+        }
+        ie <<= 1;
+    }
+    return exponent;
+}
+
+static uint16_t FFTQ15Sqrt(uint32_t x){
+    uint32_t res = 0;
+    uint32_t bit = 1UL << 30;
+    while(bit > x){
+        bit >>= 2;
+    }
+    while(bit != 0){
+        if(x >= res + bit){
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+static uint16_t FFTQ15Abs(int32_t re, int32_t im, fft_q15_magnitude_t magnitude){
+    // Components are below 2^18, the result is returned divided by 4 to fit 16 bits
+    uint32_t a = re < 0 ? -re : re;
+    uint32_t b = im < 0 ? -im : im;
+    if(magnitude == FFT_Q15_MAG_ISQRT){
+        a >>= 2;
+        b >>= 2;
+        return FFTQ15Sqrt(a * a + b * b);
+    }
+    // alpha = 123/128, beta = 51/128
+    if(a > b){
+        return (a * 123 + b * 51) >> 9;
+    }
+    return (b * 123 + a * 51) >> 9;
+}
+
+/*==================[external functions definition]==========================*/
+bool FFTQ15PlanCreate(fft_q15_plan_t * plan, uint16_t signal_lenght, fft_window_t window, fft_q15_magnitude_t magnitude){
+    if(!dsp_is_power_of_two(signal_lenght) || (signal_lenght < 4) || (signal_lenght > MAX_SIGNAL_LENGHT)){
+        return false;
+    }
+    // Q15 twiddle factors table is shared by all plans
+    if(dsps_fft2r_init_sc16(NULL, CONFIG_DSP_MAX_FFT_SIZE) != ESP_OK){
+        return false;
+    }
+    float * window_f32 = malloc(signal_lenght * sizeof(float));
+    plan->window = malloc(signal_lenght * sizeof(int16_t));
+    plan->buffer = malloc(signal_lenght * sizeof(int16_t));
+    plan->split_table = malloc((signal_lenght / 2 + 2) * sizeof(int16_t));
+    if((window_f32 == NULL) || (plan->window == NULL) || (plan->buffer == NULL) || (plan->split_table == NULL)){
+        free(window_f32);
+        plan->signal_lenght = 0;
+        FFTQ15PlanDestroy(plan);
+        return false;
+    }
+    plan->signal_lenght = signal_lenght;
+    plan->window_type = window;
+    plan->magnitude = magnitude;
+    // Window is generated once in float and quantized to Q15
+    FFTWindowGenerate(window_f32, signal_lenght, window);
+    for(uint16_t i=0; i<signal_lenght; i++){
+        plan->window[i] = (int16_t)lroundf(window_f32[i] * INT16_MAX);
+    }
+    free(window_f32);
+    float e = 2 * M_PI / signal_lenght;
+    for(uint16_t k=0; k<=(signal_lenght / 4); k++){
+        plan->split_table[2*k] = (int16_t)lroundf(cosf(k * e) * INT16_MAX);
+        plan->split_table[2*k+1] = (int16_t)lroundf(sinf(k * e) * INT16_MAX);
+    }
+    return true;
+}
+
+void FFTQ15PlanDestroy(fft_q15_plan_t * plan){
+    free(plan->window);
+    free(plan->buffer);
+    free(plan->split_table);
+    plan->window = NULL;
+    plan->buffer = NULL;
+    plan->split_table = NULL;
+    plan->signal_lenght = 0;
+}
+
+int8_t FFTQ15Magnitude(fft_q15_plan_t * plan, const uint16_t * signal, uint16_t * fft){
+    uint16_t signal_lenght = plan->signal_lenght;
+    uint16_t half = signal_lenght / 2;
+    int16_t * z = plan->buffer;
+    const int16_t * w = plan->split_table;
+    // Frame mean and peak deviation
+    uint32_t sum = 0;
+    for(uint16_t i=0; i<signal_lenght; i++){
+        sum += signal[i];
+    }
+    int32_t mean = (sum + half) / signal_lenght;
+    int32_t max = 0;
+    for(uint16_t i=0; i<signal_lenght; i++){
+        int32_t v = (int32_t)signal[i] - mean;
+        v = v < 0 ? -v : v;
+        if(v > max){
+            max = v;
+        }
+    }
+    // Normalize so the first stage starts with all the available headroom
+    int8_t norm = 0;
+    if(max > 0){
+        while((max << (norm + 1)) <= BFP_STAGE_MAX){
+            norm++;
+        }
+        while((max >> -norm) > BFP_STAGE_MAX){
+            norm--;
+        }
+    }
+    // Windowed signal packed as z[n] = x[2n] + j*x[2n+1]
+    for(uint16_t i=0; i<signal_lenght; i++){
+        int32_t v = (int32_t)signal[i] - mean;
+        v = norm >= 0 ? (v << norm) : (v >> -norm);
+        z[i] = (v * plan->window[i] + 0x4000) >> 15;
+    }
+    // N/2 points complex FFT
+    int8_t exponent = FFTQ15Radix2(z, half);
+    dsps_bit_rev_sc16_ansi(z, half);
+    // Split step (see FFTPlanCreateReal), computing 2 * X[k]
+    fft[0] = (uint16_t)(abs((int32_t)z[0] + z[1]) >> 3);
+    for(uint16_t k=1; k<=(half / 2); k++){
+        int32_t ar = z[2*k];
+        int32_t ai = z[2*k+1];
+        int32_t br = z[2*(half-k)];
+        int32_t bi = z[2*(half-k)+1];
+        int32_t fe_re = ar + br;
+        int32_t fe_im = ai - bi;
+        int32_t fo_re = ai + bi;
+        int32_t fo_im = br - ar;
+        int32_t t_re = ((w[2*k] * fo_re) >> 15) + ((w[2*k+1] * fo_im) >> 15);
+        int32_t t_im = ((w[2*k] * fo_im) >> 15) - ((w[2*k+1] * fo_re) >> 15);
+        fft[k] = FFTQ15Abs(fe_re + t_re, fe_im + t_im, plan->magnitude);
+        fft[half-k] = FFTQ15Abs(fe_re - t_re, fe_im - t_im, plan->magnitude);
+    }
+    // FFTMagnitude() scale is 4 * |2X| / N and fft holds |2X| / 4
+    return exponent - norm + 4 - dsp_power_of_two(signal_lenght);
+}
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,236 @@
+/**
+ * @file goertzel.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "goertzel.h"
+/*==================[macros and definitions]=================================*/
+#define N_STATE         2
+/* 2 * cos(w) in Q29: 2.0 fits exactly, products with the states fit in 64 bits */
+#define COEFF_SHIFT     29
+/* Fixed point states are kept below 2^30 */
+#define STATE_BITS      30
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static void GoertzelBlockEnd(goertzel_t * bank);
+static void GoertzelQ15BlockEnd(goertzel_q15_t * bank);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static void GoertzelBlockEnd(goertzel_t * bank){
+    // |X|^2 = s1^2 + s2^2 - 2cos(w) * s1 * s2, normalized to the squared amplitude of a tone
+    float scale = 2.0f / bank->block_lenght;
+    scale *= scale;
+    for(uint8_t k=0; k<bank->n_bins; k++){
+        float s1 = bank->state[N_STATE * k];
+        float s2 = bank->state[N_STATE * k + 1];
+        bank->power[k] = (s1 * s1 + s2 * s2 - bank->coeffs[k] * s1 * s2) * scale;
+    }
+    memset(bank->state, 0, bank->n_bins * N_STATE * sizeof(float));
+    bank->count = 0;
+}
+
+static void GoertzelQ15BlockEnd(goertzel_q15_t * bank){
+    // Same as GoertzelBlockEnd(), undoing the input shift and the Q15 format
+    float scale = ldexpf(2.0f / bank->block_lenght, bank->input_shift - 15);
+    scale *= scale;
+    for(uint8_t k=0; k<bank->n_bins; k++){
+        float s1 = bank->state[N_STATE * k];
+        float s2 = bank->state[N_STATE * k + 1];
+        float c = ldexpf(bank->coeffs[k], -COEFF_SHIFT);
+        bank->power[k] = (s1 * s1 + s2 * s2 - c * s1 * s2) * scale;
+    }
+    memset(bank->state, 0, bank->n_bins * N_STATE * sizeof(int32_t));
+    bank->count = 0;
+}
+
+/*==================[external functions definition]==========================*/
+bool GoertzelCreate(goertzel_t * bank, float sample_frec, const float * frecs, uint8_t n_bins, uint16_t block_lenght){
+    memset(bank, 0, sizeof(goertzel_t));
+    if((n_bins == 0) || (block_lenght < 2)){
+        return false;
+    }
+    bank->coeffs = malloc(n_bins * sizeof(float));
+    bank->state = calloc(n_bins * N_STATE, sizeof(float));
+    bank->power = calloc(n_bins, sizeof(float));
+    if((bank->coeffs == NULL) || (bank->state == NULL) || (bank->power == NULL)){
+        GoertzelDestroy(bank);
+        return false;
+    }
+    bank->n_bins = n_bins;
+    bank->block_lenght = block_lenght;
+    for(uint8_t k=0; k<n_bins; k++){
+        bank->coeffs[k] = 2 * cosf(2 * M_PI * frecs[k] / sample_frec);
+    }
+    return true;
+}
+
+void GoertzelDestroy(goertzel_t * bank){
+    free(bank->coeffs);
+    free(bank->state);
+    free(bank->power);
+    bank->coeffs = NULL;
+    bank->state = NULL;
+    bank->power = NULL;
+    bank->n_bins = 0;
+}
+
+void GoertzelReset(goertzel_t * bank){
+    memset(bank->state, 0, bank->n_bins * N_STATE * sizeof(float));
+    memset(bank->power, 0, bank->n_bins * sizeof(float));
+    bank->count = 0;
+}
+
+bool GoertzelUpdate(goertzel_t * bank, float sample){
+    float * s = bank->state;
+    for(uint8_t k=0; k<bank->n_bins; k++){
+        float s0 = sample + bank->coeffs[k] * s[0] - s[1];
+        s[1] = s[0];
+        s[0] = s0;
+        s += N_STATE;
+    }
+    if(++bank->count >= bank->block_lenght){
+        GoertzelBlockEnd(bank);
+        return true;
+    }
+    return false;
+}
+
+uint16_t GoertzelProcess(goertzel_t * bank, const float * signal, uint16_t signal_lenght){
+    uint16_t blocks = 0;
+    while(signal_lenght > 0){
+        uint16_t chunk = bank->block_lenght - bank->count;
+        if(chunk > signal_lenght){
+            chunk = signal_lenght;
+        }
+        // One bin at a time, so its states and coefficient stay in registers
+        for(uint8_t k=0; k<bank->n_bins; k++){
+            float c = bank->coeffs[k];
+            float s1 = bank->state[N_STATE * k];
+            float s2 = bank->state[N_STATE * k + 1];
+            for(uint16_t i=0; i<chunk; i++){
+                float s0 = signal[i] + c * s1 - s2;
+                s2 = s1;
+                s1 = s0;
+            }
+            bank->state[N_STATE * k] = s1;
+            bank->state[N_STATE * k + 1] = s2;
+        }
+        bank->count += chunk;
+        signal += chunk;
+        signal_lenght -= chunk;
+        if(bank->count >= bank->block_lenght){
+            GoertzelBlockEnd(bank);
+            blocks++;
+        }
+    }
+    return blocks;
+}
+
+bool GoertzelQ15Create(goertzel_q15_t * bank, float sample_frec, const float * frecs, uint8_t n_bins, uint16_t block_lenght){
+    memset(bank, 0, sizeof(goertzel_q15_t));
+    if((n_bins == 0) || (block_lenght < 2)){
+        return false;
+    }
+    bank->coeffs = malloc(n_bins * sizeof(int32_t));
+    bank->state = calloc(n_bins * N_STATE, sizeof(int32_t));
+    bank->power = calloc(n_bins, sizeof(float));
+    if((bank->coeffs == NULL) || (bank->state == NULL) || (bank->power == NULL)){
+        GoertzelQ15Destroy(bank);
+        return false;
+    }
+    bank->n_bins = n_bins;
+    bank->block_lenght = block_lenght;
+    // States grow up to N * |x| / |sin(w)| (N^2 * |x| / 2 at DC): the input is shifted so
+    // that the bin closest to DC or Nyquist stays below 2^STATE_BITS
+    float gain = 0;
+    for(uint8_t k=0; k<n_bins; k++){
+        double w = 2 * M_PI * frecs[k] / sample_frec;
+        float s = (float)fabs(sin(w));
+        float bin_gain = (s * block_lenght > 1) ? block_lenght / s : (float)block_lenght * block_lenght;
+        gain = fmaxf(gain, bin_gain);
+        bank->coeffs[k] = (int32_t)llround(ldexp(2 * cos(w), COEFF_SHIFT));
+    }
+    int bits = (int)ceilf(log2f(gain)) + 15;
+    bank->input_shift = bits > STATE_BITS ? bits - STATE_BITS : 0;
+    return true;
+}
+
+void GoertzelQ15Destroy(goertzel_q15_t * bank){
+    free(bank->coeffs);
+    free(bank->state);
+    free(bank->power);
+    bank->coeffs = NULL;
+    bank->state = NULL;
+    bank->power = NULL;
+    bank->n_bins = 0;
+}
+
+void GoertzelQ15Reset(goertzel_q15_t * bank){
+    memset(bank->state, 0, bank->n_bins * N_STATE * sizeof(int32_t));
+    memset(bank->power, 0, bank->n_bins * sizeof(float));
+    bank->count = 0;
+}
+
+bool GoertzelQ15Update(goertzel_q15_t * bank, int16_t sample){
+    int32_t x = sample >> bank->input_shift;
+    int32_t * s = bank->state;
+    for(uint8_t k=0; k<bank->n_bins; k++){
+        // 2 * cos(w) * s[n-1] may exceed 32 bits, the sum doesn't
+        int32_t s0 = (int32_t)((((int64_t)bank->coeffs[k] * s[0]) >> COEFF_SHIFT) + x - s[1]);
+        s[1] = s[0];
+        s[0] = s0;
+        s += N_STATE;
+    }
+    if(++bank->count >= bank->block_lenght){
+        GoertzelQ15BlockEnd(bank);
+        return true;
+    }
+    return false;
+}
+
+uint16_t GoertzelQ15Process(goertzel_q15_t * bank, const int16_t * signal, uint16_t signal_lenght){
+    uint16_t blocks = 0;
+    uint8_t shift = bank->input_shift;
+    while(signal_lenght > 0){
+        uint16_t chunk = bank->block_lenght - bank->count;
+        if(chunk > signal_lenght){
+            chunk = signal_lenght;
+        }
+        for(uint8_t k=0; k<bank->n_bins; k++){
+            int32_t c = bank->coeffs[k];
+            int32_t s1 = bank->state[N_STATE * k];
+            int32_t s2 = bank->state[N_STATE * k + 1];
+            for(uint16_t i=0; i<chunk; i++){
+                int32_t s0 = (int32_t)((((int64_t)c * s1) >> COEFF_SHIFT) + (signal[i] >> shift) - s2);
+                s2 = s1;
+                s1 = s0;
+            }
+            bank->state[N_STATE * k] = s1;
+            bank->state[N_STATE * k + 1] = s2;
+        }
+        bank->count += chunk;
+        signal += chunk;
+        signal_lenght -= chunk;
+        if(bank->count >= bank->block_lenght){
+            GoertzelQ15BlockEnd(bank);
+            blocks++;
+        }
+    }
+    return blocks;
+}
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -10,47 +10,36 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
 #include "iir_filter.h"
+#include "dsp_profile.h"
 #include "esp_dsp.h"
 /*==================[macros and definitions]=================================*/
 #define N_SOS       5
 #define N_DELAY     2
-// 2nd order Butterworth 
-#define ORDER2_Q    (1 / 1.414)
-// 4th order Butterworth 
-#define ORDER4_Q1   (1 / 0.765)
-#define ORDER4_Q2   (1 / 1.848)
-// 6th order Butterworth 
-#define ORDER6_Q1   (1 / 0.518)
-#define ORDER6_Q2   (1 / 1.414)
-#define ORDER6_Q3   (1 / 1.932)
-// 8th order Butterworth 
-#define ORDER8_Q1   (1 / 0.390)
-#define ORDER8_Q2   (1 / 1.111)
-#define ORDER8_Q3   (1 / 1.663)
-#define ORDER8_Q4   (1 / 1.962)
+#define MAX_LEGACY_SECTIONS     (ORDER_8 / 2)
 /*==================[internal data declaration]==============================*/
-static uint8_t lp_order, hp_order;
-float hp2_delay[N_DELAY] = {0, 0};  // delay
-float hp4_delay[N_DELAY] = {0, 0};  // delay
-float hp6_delay[N_DELAY] = {0, 0};  // delay
-float hp8_delay[N_DELAY] = {0, 0};  // delay
-float lp2_delay[N_DELAY] = {0, 0};  // delay
-float lp4_delay[N_DELAY] = {0, 0};  // delay
-float lp6_delay[N_DELAY] = {0, 0};  // delay
-float lp8_delay[N_DELAY] = {0, 0};  // delay
-float lp2_sos_coeff[N_SOS]; 
-float lp4_sos_coeff[N_SOS]; 
-float lp6_sos_coeff[N_SOS]; 
-float lp8_sos_coeff[N_SOS]; 
-float hp2_sos_coeff[N_SOS]; 
-float hp4_sos_coeff[N_SOS]; 
-float hp6_sos_coeff[N_SOS]; 
-float hp8_sos_coeff[N_SOS]; 
+static float lp_sos_coeff[MAX_LEGACY_SECTIONS * N_SOS];
+static float lp_delay[MAX_LEGACY_SECTIONS * N_DELAY];
+static float hp_sos_coeff[MAX_LEGACY_SECTIONS * N_SOS];
+static float hp_delay[MAX_LEGACY_SECTIONS * N_DELAY];
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
-
+static iir_filter_t lp_filter = {
+    .n_sections = 0,
+    .max_sections = MAX_LEGACY_SECTIONS,
+    .coeffs = lp_sos_coeff,
+    .delay = lp_delay
+};
+static iir_filter_t hp_filter = {
+    .n_sections = 0,
+    .max_sections = MAX_LEGACY_SECTIONS,
+    .coeffs = hp_sos_coeff,
+    .delay = hp_delay
+};
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
@@ -58,99 +47,135 @@ float hp8_sos_coeff[N_SOS];
 /*==================[external functions definition]==========================*/
 
 void LowPassInit(float sample_frec, float cut_frec, filter_order_t order){
-    float f = cut_frec / sample_frec;
-    lp_order = order;
-    switch(lp_order){
-        case ORDER_2:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER2_Q);
-        break;
-        case ORDER_4:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER4_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER4_Q2);
-        break;
-        case ORDER_6:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER6_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER6_Q2);
-            dsps_biquad_gen_lpf_f32(lp6_sos_coeff, f, ORDER6_Q3);
-        break;
-        case ORDER_8:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER8_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER8_Q2);
-            dsps_biquad_gen_lpf_f32(lp6_sos_coeff, f, ORDER8_Q3);
-            dsps_biquad_gen_lpf_f32(lp8_sos_coeff, f, ORDER8_Q4);
-        break;
-    }
+    lp_filter.n_sections = 0;
+    IIRFilterAddButterworth(&lp_filter, FILTER_LOW_PASS, sample_frec, cut_frec, order);
+    IIRFilterReset(&lp_filter);
 }
 
 void HiPassInit(float sample_frec, float cut_frec, filter_order_t order){
-    float f = cut_frec / sample_frec;
-    hp_order = order;
-    switch(hp_order){
-        case ORDER_2:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER2_Q);
-        break;
-        case ORDER_4:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER4_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER4_Q2);
-        break;
-        case ORDER_6:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER6_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER6_Q2);
-            dsps_biquad_gen_hpf_f32(hp6_sos_coeff, f, ORDER6_Q3);
-        break;
-        case ORDER_8:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER8_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER8_Q2);
-            dsps_biquad_gen_hpf_f32(hp6_sos_coeff, f, ORDER8_Q3);
-            dsps_biquad_gen_hpf_f32(hp8_sos_coeff, f, ORDER8_Q4);
-        break;
+    hp_filter.n_sections = 0;
+    IIRFilterAddButterworth(&hp_filter, FILTER_HIGH_PASS, sample_frec, cut_frec, order);
+    IIRFilterReset(&hp_filter);
+}
+
+void LowPassInitCoefficients(const float * coeffs, filter_order_t order){
+    lp_filter.n_sections = 0;
+    for(uint8_t i=0; i<(order / 2); i++){
+        IIRFilterAddCoefficients(&lp_filter, &coeffs[i * N_SOS]);
     }
+    IIRFilterReset(&lp_filter);
 }
 
-void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght){
-    switch(lp_order){
-        case ORDER_2:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-        break;
-        case ORDER_4:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp4_sos_coeff, lp4_delay);
-        break;
-        case ORDER_6:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp4_sos_coeff, lp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp6_sos_coeff, lp6_delay);
-        break;
-        case ORDER_8:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp4_sos_coeff, lp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp6_sos_coeff, lp6_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp8_sos_coeff, lp8_delay);
-        break;
+void HiPassInitCoefficients(const float * coeffs, filter_order_t order){
+    hp_filter.n_sections = 0;
+    for(uint8_t i=0; i<(order / 2); i++){
+        IIRFilterAddCoefficients(&hp_filter, &coeffs[i * N_SOS]);
     }
+    IIRFilterReset(&hp_filter);
+}
+
+void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght){
+    IIRFilterApply(&lp_filter, input_signal, output_signal, signal_lenght);
 }
 
 void HiPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght){
-    switch(hp_order){
-        case ORDER_2:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-        break;
-        case ORDER_4:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp4_sos_coeff, hp4_delay);
-        break;
-        case ORDER_6:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp4_sos_coeff, hp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp6_sos_coeff, hp6_delay);
-        break;
-        case ORDER_8:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp4_sos_coeff, hp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp6_sos_coeff, hp6_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp8_sos_coeff, hp8_delay);
-        break;
+    IIRFilterApply(&hp_filter, input_signal, output_signal, signal_lenght);
+}
+
+bool IIRFilterCreate(iir_filter_t * filter, uint8_t max_sections){
+    filter->n_sections = 0;
+    filter->max_sections = max_sections;
+    filter->coeffs = malloc(max_sections * N_SOS * sizeof(float));
+    filter->delay = calloc(max_sections * N_DELAY, sizeof(float));
+    if((filter->coeffs == NULL) || (filter->delay == NULL)){
+        IIRFilterDestroy(filter);
+        return false;
+    }
+    return true;
+}
+
+void IIRFilterDestroy(iir_filter_t * filter){
+    free(filter->coeffs);
+    free(filter->delay);
+    filter->coeffs = NULL;
+    filter->delay = NULL;
+    filter->n_sections = 0;
+    filter->max_sections = 0;
+}
+
+bool IIRFilterAddSection(iir_filter_t * filter, filter_type_t type, float sample_frec, float frec, float q_factor){
+    if(filter->n_sections >= filter->max_sections){
+        return false;
+    }
+    float * coeffs = &filter->coeffs[filter->n_sections * N_SOS];
+    float f = frec / sample_frec;
+    size_t bytes = N_SOS * sizeof(float);
+    DSP_PROFILE_BEGIN(DSP_PROFILE_IIR_FILTER_DESIGN);
+    switch(type){
+        case FILTER_LOW_PASS:
+            DSP_PROFILE_CALL(DSP_PROFILE_DSPS_BIQUAD_GEN_F32, bytes, dsps_biquad_gen_lpf_f32(coeffs, f, q_factor));
+        break;
+        case FILTER_HIGH_PASS:
+            DSP_PROFILE_CALL(DSP_PROFILE_DSPS_BIQUAD_GEN_F32, bytes, dsps_biquad_gen_hpf_f32(coeffs, f, q_factor));
+        break;
+        case FILTER_BAND_PASS:
+            DSP_PROFILE_CALL(DSP_PROFILE_DSPS_BIQUAD_GEN_F32, bytes, dsps_biquad_gen_bpf0db_f32(coeffs, f, q_factor));
+        break;
+        case FILTER_NOTCH:
+            // -inf dB stopband gain places the zeros right on the unit circle
+            DSP_PROFILE_CALL(DSP_PROFILE_DSPS_BIQUAD_GEN_F32, bytes, dsps_biquad_gen_notch_f32(coeffs, f, -INFINITY, q_factor));
+        break;
+        default:
+            return false;
+    }
+    memset(&filter->delay[filter->n_sections * N_DELAY], 0, N_DELAY * sizeof(float));
+    filter->n_sections++;
+    DSP_PROFILE_END(DSP_PROFILE_IIR_FILTER_DESIGN, bytes);
+    return true;
+}
+
+bool IIRFilterAddButterworth(iir_filter_t * filter, filter_type_t type, float sample_frec, float cut_frec, uint8_t order){
+    if((order == 0) || (order % 2) || ((type != FILTER_LOW_PASS) && (type != FILTER_HIGH_PASS))){
+        return false;
+    }
+    if((filter->n_sections + order / 2) > filter->max_sections){
+        return false;
+    }
+    // Butterworth poles in pairs: Q = 1 / (2 * cos(theta)), theta = (2k - 1) * pi / (2 * order),
+    // highest Q section first
+    for(uint8_t k=order/2; k>0; k--){
+        float q_factor = 1 / (2 * cosf((2 * k - 1) * M_PI / (2 * order)));
+        IIRFilterAddSection(filter, type, sample_frec, cut_frec, q_factor);
+    }
+    return true;
+}
+
+bool IIRFilterAddCoefficients(iir_filter_t * filter, const float * coeffs){
+    if(filter->n_sections >= filter->max_sections){
+        return false;
+    }
+    memcpy(&filter->coeffs[filter->n_sections * N_SOS], coeffs, N_SOS * sizeof(float));
+    memset(&filter->delay[filter->n_sections * N_DELAY], 0, N_DELAY * sizeof(float));
+    filter->n_sections++;
+    return true;
+}
+
+void IIRFilterReset(iir_filter_t * filter){
+    memset(filter->delay, 0, filter->max_sections * N_DELAY * sizeof(float));
+}
+
+void IIRFilterApply(iir_filter_t * filter, const float * input_signal, float * output_signal, uint16_t signal_lenght){
+    size_t bytes = signal_lenght * sizeof(float);
+    DSP_PROFILE_BEGIN(DSP_PROFILE_IIR_FILTER_APPLY);
+    if(filter->n_sections == 0){
+        memmove(output_signal, input_signal, bytes);
+    } else {
+        // Every sample goes through all the sections before reading the next one, so
+        // the signal is streamed through memory only once whatever the filter order
+        DSP_PROFILE_CALL(DSP_PROFILE_DSPS_BIQUAD_CASCADE_F32, bytes,
+                         dsps_biquad_cascade_f32(input_signal, output_signal, signal_lenght, filter->n_sections, filter->coeffs, filter->delay));
     }
+    DSP_PROFILE_END(DSP_PROFILE_IIR_FILTER_APPLY, bytes);
 }
 
 /*==================[end of file]============================================*/
\ No newline at end of file
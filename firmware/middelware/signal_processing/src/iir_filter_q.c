@@ -0,0 +1,148 @@
+/**
+ * @file iir_filter_q.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "iir_filter_q.h"
+#include "esp_dsp.h"
+/*==================[macros and definitions]=================================*/
+#define N_SOS       5
+#define N_DELAY     2
+#define Q15_COEFF_SHIFT     14
+#define Q31_COEFF_SHIFT     30
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static int16_t IIRFilterQSat16(int32_t x);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static int16_t IIRFilterQSat16(int32_t x){
+    if(x > INT16_MAX){
+        return INT16_MAX;
+    }
+    if(x < INT16_MIN){
+        return INT16_MIN;
+    }
+    return x;
+}
+
+/*==================[external functions definition]==========================*/
+bool IIRFilterQCreate(iir_filter_q_t * filter, uint8_t max_sections, iir_filter_q_format_t format, bool noise_shaping){
+    filter->n_sections = 0;
+    filter->max_sections = max_sections;
+    filter->format = format;
+    filter->noise_shaping = noise_shaping && (format == IIR_FILTER_Q15);
+    filter->coeffs = malloc(max_sections * N_SOS * sizeof(int32_t));
+    filter->delay = calloc((max_sections + 1) * N_DELAY, sizeof(int32_t));
+    filter->error = calloc(max_sections, sizeof(int32_t));
+    if((filter->coeffs == NULL) || (filter->delay == NULL) || (filter->error == NULL)){
+        IIRFilterQDestroy(filter);
+        return false;
+    }
+    return true;
+}
+
+void IIRFilterQDestroy(iir_filter_q_t * filter){
+    free(filter->coeffs);
+    free(filter->delay);
+    free(filter->error);
+    filter->coeffs = NULL;
+    filter->delay = NULL;
+    filter->error = NULL;
+    filter->n_sections = 0;
+    filter->max_sections = 0;
+}
+
+bool IIRFilterQAddCoefficients(iir_filter_q_t * filter, const float * coeffs){
+    if(filter->n_sections >= filter->max_sections){
+        return false;
+    }
+    int32_t * coeffs_q = &filter->coeffs[filter->n_sections * N_SOS];
+    int64_t q_max = (filter->format == IIR_FILTER_Q15) ? INT16_MAX : INT32_MAX;
+    int shift = (filter->format == IIR_FILTER_Q15) ? Q15_COEFF_SHIFT : Q31_COEFF_SHIFT;
+    for(uint8_t j=0; j<N_SOS; j++){
+        int64_t q = llround(ldexp(coeffs[j], shift));
+        if((q > q_max) || (q < -q_max - 1)){
+            return false;
+        }
+        coeffs_q[j] = q;
+    }
+    filter->error[filter->n_sections] = 0;
+    filter->n_sections++;
+    return true;
+}
+
+bool IIRFilterQQuantize(iir_filter_q_t * filter, const iir_filter_t * design){
+    if((filter->n_sections + design->n_sections) > filter->max_sections){
+        return false;
+    }
+    uint8_t n_sections = filter->n_sections;
+    for(uint8_t k=0; k<design->n_sections; k++){
+        if(!IIRFilterQAddCoefficients(filter, &design->coeffs[k * N_SOS])){
+            filter->n_sections = n_sections;
+            return false;
+        }
+    }
+    return true;
+}
+
+void IIRFilterQReset(iir_filter_q_t * filter){
+    memset(filter->delay, 0, (filter->max_sections + 1) * N_DELAY * sizeof(int32_t));
+    memset(filter->error, 0, filter->max_sections * sizeof(int32_t));
+}
+
+void IIRFilterQ15Apply(iir_filter_q_t * filter, const int16_t * input_signal, int16_t * output_signal, uint16_t signal_lenght){
+    uint8_t n_sections = filter->n_sections;
+    int32_t * h = filter->delay;
+    int32_t * e = filter->error;
+    for(uint16_t i=0; i<signal_lenght; i++){
+        int32_t x = input_signal[i];
+        const int32_t * c = filter->coeffs;
+        for(uint8_t k=0; k<n_sections; k++){
+            // Q15 * Q14 products accumulated modulo 2^32: partial sums may wrap, the
+            // final Q29 sum fits as long as the section gain is below 4
+            uint32_t acc = (uint32_t)(c[0] * x) + (uint32_t)(c[1] * h[2*k]) + (uint32_t)(c[2] * h[2*k+1])
+                         - (uint32_t)(c[3] * h[2*k+2]) - (uint32_t)(c[4] * h[2*k+3]);
+            int32_t sum = (int32_t)acc;
+            int32_t y;
+            if(filter->noise_shaping){
+                // The bits dropped by the truncation are added to the next sample
+                sum += e[k];
+                y = sum >> Q15_COEFF_SHIFT;
+                e[k] = sum - (y << Q15_COEFF_SHIFT);
+            } else {
+                y = (sum + (1 << (Q15_COEFF_SHIFT - 1))) >> Q15_COEFF_SHIFT;
+            }
+            h[2*k+1] = h[2*k];
+            h[2*k] = x;
+            x = IIRFilterQSat16(y);
+            c += N_SOS;
+        }
+        h[2*n_sections+1] = h[2*n_sections];
+        h[2*n_sections] = x;
+        output_signal[i] = x;
+    }
+}
+
+void IIRFilterQ31Apply(iir_filter_q_t * filter, const int32_t * input_signal, int32_t * output_signal, uint16_t signal_lenght){
+    if(filter->n_sections == 0){
+        memmove(output_signal, input_signal, signal_lenght * sizeof(int32_t));
+        return;
+    }
+    dsps_biquad_cascade_s32(input_signal, output_signal, signal_lenght, filter->n_sections, filter->coeffs, filter->delay);
+}
+
+/*==================[end of file]============================================*/
\ No newline at end of file
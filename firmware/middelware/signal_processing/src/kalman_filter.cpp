@@ -0,0 +1,207 @@
+/**
+ * @file kalman_filter.cpp
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <new>
+#include "kalman_filter.h"
+#include "kf_linear.h"
+/*==================[macros and definitions]=================================*/
+#define MAX_FRAC_BITS   16
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+// The model selects the template (number of states) once, in every call of the C interface
+template <int N>
+static void * KalmanFilterNew(float sample_period, float process_noise, float measurement_noise){
+    kf_linear<N> * filter = new (std::nothrow) kf_linear<N>();
+    if(filter != NULL){
+        filter->Init(sample_period, process_noise, measurement_noise);
+    }
+    return filter;
+}
+
+template <int N>
+static void * KalmanFilterQNew(float sample_period, float process_noise, float measurement_noise, uint8_t frac_bits){
+    kf_linear<N> design;
+    design.Init(sample_period, process_noise, measurement_noise);
+    kf_linear_fixed<N> * filter = new (std::nothrow) kf_linear_fixed<N>();
+    if((filter != NULL) && !filter->Init(design, frac_bits)){
+        delete filter;
+        filter = NULL;
+    }
+    return filter;
+}
+
+template <int N>
+static void KalmanFilterGetStateN(const kf_linear<N> * filter, float * state){
+    for(uint8_t i=0; i<N; i++){
+        state[i] = filter->x[i];
+    }
+}
+
+/*==================[external functions definition]==========================*/
+bool KalmanFilterCreate(kalman_filter_t * kf, kalman_model_t model, float sample_period, float process_noise, float measurement_noise){
+    kf->model = model;
+    kf->filter = NULL;
+    if((sample_period <= 0) || (process_noise < 0) || (measurement_noise <= 0)){
+        return false;
+    }
+    switch(model){
+        case KALMAN_RANDOM_WALK:
+            kf->filter = KalmanFilterNew<1>(sample_period, process_noise, measurement_noise);
+            break;
+        case KALMAN_CONSTANT_VELOCITY:
+            kf->filter = KalmanFilterNew<2>(sample_period, process_noise, measurement_noise);
+            break;
+        case KALMAN_CONSTANT_ACCELERATION:
+            kf->filter = KalmanFilterNew<3>(sample_period, process_noise, measurement_noise);
+            break;
+    }
+    return kf->filter != NULL;
+}
+
+void KalmanFilterDestroy(kalman_filter_t * kf){
+    switch(kf->model){
+        case KALMAN_RANDOM_WALK:
+            delete static_cast<kf_linear<1> *>(kf->filter);
+            break;
+        case KALMAN_CONSTANT_VELOCITY:
+            delete static_cast<kf_linear<2> *>(kf->filter);
+            break;
+        case KALMAN_CONSTANT_ACCELERATION:
+            delete static_cast<kf_linear<3> *>(kf->filter);
+            break;
+    }
+    kf->filter = NULL;
+}
+
+void KalmanFilterReset(kalman_filter_t * kf, float value){
+    switch(kf->model){
+        case KALMAN_RANDOM_WALK:
+            static_cast<kf_linear<1> *>(kf->filter)->Reset(value);
+            break;
+        case KALMAN_CONSTANT_VELOCITY:
+            static_cast<kf_linear<2> *>(kf->filter)->Reset(value);
+            break;
+        case KALMAN_CONSTANT_ACCELERATION:
+            static_cast<kf_linear<3> *>(kf->filter)->Reset(value);
+            break;
+    }
+}
+
+float KalmanFilterUpdate(kalman_filter_t * kf, float reading){
+    switch(kf->model){
+        case KALMAN_RANDOM_WALK:
+            return static_cast<kf_linear<1> *>(kf->filter)->Filter(reading);
+        case KALMAN_CONSTANT_VELOCITY:
+            return static_cast<kf_linear<2> *>(kf->filter)->Filter(reading);
+        case KALMAN_CONSTANT_ACCELERATION:
+            return static_cast<kf_linear<3> *>(kf->filter)->Filter(reading);
+    }
+    return reading;
+}
+
+void KalmanFilterGetState(const kalman_filter_t * kf, float * state){
+    switch(kf->model){
+        case KALMAN_RANDOM_WALK:
+            KalmanFilterGetStateN(static_cast<const kf_linear<1> *>(kf->filter), state);
+            break;
+        case KALMAN_CONSTANT_VELOCITY:
+            KalmanFilterGetStateN(static_cast<const kf_linear<2> *>(kf->filter), state);
+            break;
+        case KALMAN_CONSTANT_ACCELERATION:
+            KalmanFilterGetStateN(static_cast<const kf_linear<3> *>(kf->filter), state);
+            break;
+    }
+}
+
+bool KalmanFilterQCreate(kalman_filter_q_t * kf, kalman_model_t model, float sample_period, float process_noise, float measurement_noise, uint8_t frac_bits){
+    kf->model = model;
+    kf->filter = NULL;
+    if((sample_period <= 0) || (process_noise <= 0) || (measurement_noise <= 0) || (frac_bits > MAX_FRAC_BITS)){
+        return false;
+    }
+    switch(model){
+        case KALMAN_RANDOM_WALK:
+            kf->filter = KalmanFilterQNew<1>(sample_period, process_noise, measurement_noise, frac_bits);
+            break;
+        case KALMAN_CONSTANT_VELOCITY:
+            kf->filter = KalmanFilterQNew<2>(sample_period, process_noise, measurement_noise, frac_bits);
+            break;
+        case KALMAN_CONSTANT_ACCELERATION:
+            kf->filter = KalmanFilterQNew<3>(sample_period, process_noise, measurement_noise, frac_bits);
+            break;
+    }
+    return kf->filter != NULL;
+}
+
+void KalmanFilterQDestroy(kalman_filter_q_t * kf){
+    switch(kf->model){
+        case KALMAN_RANDOM_WALK:
+            delete static_cast<kf_linear_fixed<1> *>(kf->filter);
+            break;
+        case KALMAN_CONSTANT_VELOCITY:
+            delete static_cast<kf_linear_fixed<2> *>(kf->filter);
+            break;
+        case KALMAN_CONSTANT_ACCELERATION:
+            delete static_cast<kf_linear_fixed<3> *>(kf->filter);
+            break;
+    }
+    kf->filter = NULL;
+}
+
+void KalmanFilterQReset(kalman_filter_q_t * kf, int32_t value){
+    switch(kf->model){
+        case KALMAN_RANDOM_WALK:
+            static_cast<kf_linear_fixed<1> *>(kf->filter)->Reset(value);
+            break;
+        case KALMAN_CONSTANT_VELOCITY:
+            static_cast<kf_linear_fixed<2> *>(kf->filter)->Reset(value);
+            break;
+        case KALMAN_CONSTANT_ACCELERATION:
+            static_cast<kf_linear_fixed<3> *>(kf->filter)->Reset(value);
+            break;
+    }
+}
+
+int32_t KalmanFilterQUpdate(kalman_filter_q_t * kf, int32_t reading){
+    switch(kf->model){
+        case KALMAN_RANDOM_WALK:
+            return static_cast<kf_linear_fixed<1> *>(kf->filter)->Filter(reading);
+        case KALMAN_CONSTANT_VELOCITY:
+            return static_cast<kf_linear_fixed<2> *>(kf->filter)->Filter(reading);
+        case KALMAN_CONSTANT_ACCELERATION:
+            return static_cast<kf_linear_fixed<3> *>(kf->filter)->Filter(reading);
+    }
+    return reading;
+}
+
+void KalmanFilterQGetState(const kalman_filter_q_t * kf, float * state){
+    switch(kf->model){
+        case KALMAN_RANDOM_WALK:
+            static_cast<const kf_linear_fixed<1> *>(kf->filter)->GetState(state);
+            break;
+        case KALMAN_CONSTANT_VELOCITY:
+            static_cast<const kf_linear_fixed<2> *>(kf->filter)->GetState(state);
+            break;
+        case KALMAN_CONSTANT_ACCELERATION:
+            static_cast<const kf_linear_fixed<3> *>(kf->filter)->GetState(state);
+            break;
+    }
+}
+
+/*==================[end of file]============================================*/
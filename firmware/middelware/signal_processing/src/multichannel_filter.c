@@ -0,0 +1,145 @@
+/**
+ * @file multichannel_filter.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include "multichannel_filter.h"
+/*==================[macros and definitions]=================================*/
+#define N_SOS       5
+#define N_DELAY     2
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static bool MCFilterCreate(mc_filter_t * filter, mc_filter_kind_t kind, uint8_t n_channels, uint16_t n_coeffs, uint16_t n_delay, bool shared_coeffs);
+static void MCFilterApplyIIR(mc_filter_t * filter, uint8_t channel, float * frames, uint16_t n_frames);
+static void MCFilterApplyFIR(mc_filter_t * filter, uint8_t channel, float * frames, uint16_t n_frames);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static bool MCFilterCreate(mc_filter_t * filter, mc_filter_kind_t kind, uint8_t n_channels, uint16_t n_coeffs, uint16_t n_delay, bool shared_coeffs){
+    filter->kind = kind;
+    filter->n_channels = n_channels;
+    filter->shared_coeffs = shared_coeffs;
+    filter->n_coeffs = n_coeffs;
+    filter->n_delay = n_delay;
+    filter->pos = 0;
+    filter->coeffs = calloc((shared_coeffs ? 1 : n_channels) * n_coeffs, sizeof(float));
+    filter->delay = calloc(n_channels * n_delay, sizeof(float));
+    if((n_channels == 0) || (filter->coeffs == NULL) || (filter->delay == NULL)){
+        MCFilterDestroy(filter);
+        return false;
+    }
+    return true;
+}
+
+static void MCFilterApplyIIR(mc_filter_t * filter, uint8_t channel, float * frames, uint16_t n_frames){
+    // One channel at a time: its delay lines stay hot while the frames are walked with a stride
+    const float * coeffs = filter->shared_coeffs ? filter->coeffs : &filter->coeffs[channel * filter->n_coeffs];
+    float * delay = &filter->delay[channel * filter->n_delay];
+    uint8_t n_sections = filter->n_coeffs / N_SOS;
+    uint8_t n_channels = filter->n_channels;
+    float * sample = &frames[channel];
+    for(uint16_t i=0; i<n_frames; i++){
+        float x = *sample;
+        const float * c = coeffs;
+        float * w = delay;
+        for(uint8_t j=0; j<n_sections; j++){
+            float d0 = x - c[3] * w[0] - c[4] * w[1];
+            x = c[0] * d0 + c[1] * w[0] + c[2] * w[1];
+            w[1] = w[0];
+            w[0] = d0;
+            c += N_SOS;
+            w += N_DELAY;
+        }
+        *sample = x;
+        sample += n_channels;
+    }
+}
+
+static void MCFilterApplyFIR(mc_filter_t * filter, uint8_t channel, float * frames, uint16_t n_frames){
+    // Same circular delay line as dsps_fir_f32_ansi, every channel starts from the common position
+    const float * coeffs = filter->shared_coeffs ? filter->coeffs : &filter->coeffs[channel * filter->n_coeffs];
+    float * delay = &filter->delay[channel * filter->n_delay];
+    uint16_t n_taps = filter->n_delay;
+    uint16_t pos = filter->pos;
+    uint8_t n_channels = filter->n_channels;
+    float * sample = &frames[channel];
+    for(uint16_t i=0; i<n_frames; i++){
+        float acc = 0;
+        const float * c = coeffs;
+        delay[pos] = *sample;
+        pos++;
+        if(pos >= n_taps){
+            pos = 0;
+        }
+        for(uint16_t n=pos; n<n_taps; n++){
+            acc += *c++ * delay[n];
+        }
+        for(uint16_t n=0; n<pos; n++){
+            acc += *c++ * delay[n];
+        }
+        *sample = acc;
+        sample += n_channels;
+    }
+}
+
+/*==================[external functions definition]==========================*/
+bool MCFilterCreateIIR(mc_filter_t * filter, uint8_t n_channels, uint8_t n_sections, bool shared_coeffs){
+    return MCFilterCreate(filter, MC_FILTER_IIR, n_channels, n_sections * N_SOS, n_sections * N_DELAY, shared_coeffs);
+}
+
+bool MCFilterCreateFIR(mc_filter_t * filter, uint8_t n_channels, uint16_t n_taps, bool shared_coeffs){
+    return MCFilterCreate(filter, MC_FILTER_FIR, n_channels, n_taps, n_taps, shared_coeffs);
+}
+
+void MCFilterDestroy(mc_filter_t * filter){
+    free(filter->coeffs);
+    free(filter->delay);
+    filter->coeffs = NULL;
+    filter->delay = NULL;
+    filter->n_channels = 0;
+}
+
+bool MCFilterSetCoefficients(mc_filter_t * filter, uint8_t channel, const float * coeffs){
+    if(filter->shared_coeffs){
+        channel = 0;
+    } else if(channel >= filter->n_channels){
+        return false;
+    }
+    memcpy(&filter->coeffs[channel * filter->n_coeffs], coeffs, filter->n_coeffs * sizeof(float));
+    return true;
+}
+
+void MCFilterReset(mc_filter_t * filter){
+    memset(filter->delay, 0, filter->n_channels * filter->n_delay * sizeof(float));
+    filter->pos = 0;
+}
+
+void MCFilterApply(mc_filter_t * filter, float * frames, uint16_t n_frames){
+    if((filter->n_coeffs == 0) || (n_frames == 0)){
+        return;
+    }
+    for(uint8_t ch=0; ch<filter->n_channels; ch++){
+        if(filter->kind == MC_FILTER_IIR){
+            MCFilterApplyIIR(filter, ch, frames, n_frames);
+        } else {
+            MCFilterApplyFIR(filter, ch, frames, n_frames);
+        }
+    }
+    if(filter->kind == MC_FILTER_FIR){
+        filter->pos = (filter->pos + n_frames) % filter->n_delay;
+    }
+}
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,401 @@
+/**
+ * @file orientation_filter.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <math.h>
+#include "orientation_filter.h"
+/*==================[macros and definitions]=================================*/
+#define Q30_SHIFT       30
+#define Q46_SHIFT       46
+#define Q30_ONE         (1 << Q30_SHIFT)
+/** Product of two Q30 values */
+#define Q30_MUL(a, b)   ((int32_t)(((int64_t)(a) * (b)) >> Q30_SHIFT))
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static float OrientationInvSqrt(float x);
+static void OrientationMadgwickStep(orientation_filter_t * filter, float gx, float gy, float gz, float ax, float ay, float az);
+static void OrientationMahonyStep(orientation_filter_t * filter, float gx, float gy, float gz, float ax, float ay, float az);
+static void OrientationNormalizeQ30(int32_t * v, uint8_t n);
+static void OrientationMadgwickStepQ(orientation_filter_q_t * filter, const int16_t * gyro, const int16_t * accel);
+static void OrientationMahonyStepQ(orientation_filter_q_t * filter, const int16_t * gyro, const int16_t * accel);
+static bool OrientationToFixed(float value, int shift, int32_t * fixed);
+/*==================[internal data definition]===============================*/
+/** 1/sqrt(x) at the middle of the 12 bins of width 0.25 between x = 1 and 4 (Q30) */
+static const int32_t inv_sqrt_q30[12] = {
+    1012333500, 915690104, 842312387, 784150157, 736580814, 696735698,
+    662727842, 633258380, 607400100, 584471019, 563956835, 545461392
+};
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static float OrientationInvSqrt(float x){
+    // Initial guess from the exponent bits and two Newton iterations (relative error ~5e-6)
+    uint32_t i;
+    float y;
+    memcpy(&i, &x, sizeof(i));
+    i = 0x5F3759DF - (i >> 1);
+    memcpy(&y, &i, sizeof(y));
+    y = y * (1.5f - 0.5f * x * y * y);
+    y = y * (1.5f - 0.5f * x * y * y);
+    return y;
+}
+
+static void OrientationMadgwickStep(orientation_filter_t * filter, float gx, float gy, float gz, float ax, float ay, float az){
+    float q0 = filter->q[0];
+    float q1 = filter->q[1];
+    float q2 = filter->q[2];
+    float q3 = filter->q[3];
+
+    // Rate of change of the quaternion from the gyroscope
+    float dq0 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+    float dq1 = 0.5f * (q0 * gx + q2 * gz - q3 * gy);
+    float dq2 = 0.5f * (q0 * gy - q1 * gz + q3 * gx);
+    float dq3 = 0.5f * (q0 * gz + q1 * gy - q2 * gx);
+
+    float a_norm = ax * ax + ay * ay + az * az;
+    if(a_norm > 0){
+        float inv_norm = OrientationInvSqrt(a_norm);
+        ax *= inv_norm;
+        ay *= inv_norm;
+        az *= inv_norm;
+        // Gradient of the error between the estimated and the measured gravity
+        float q0q0 = q0 * q0;
+        float q1q1 = q1 * q1;
+        float q2q2 = q2 * q2;
+        float q3q3 = q3 * q3;
+        float s0 = 4.0f * q0 * q2q2 + 2.0f * q2 * ax + 4.0f * q0 * q1q1 - 2.0f * q1 * ay;
+        float s1 = 4.0f * q1 * q3q3 - 2.0f * q3 * ax + 4.0f * q0q0 * q1 - 2.0f * q0 * ay - 4.0f * q1
+                   + 8.0f * q1 * q1q1 + 8.0f * q1 * q2q2 + 4.0f * q1 * az;
+        float s2 = 4.0f * q0q0 * q2 + 2.0f * q0 * ax + 4.0f * q2 * q3q3 - 2.0f * q3 * ay - 4.0f * q2
+                   + 8.0f * q2 * q1q1 + 8.0f * q2 * q2q2 + 4.0f * q2 * az;
+        float s3 = 4.0f * q1q1 * q3 - 2.0f * q1 * ax + 4.0f * q2q2 * q3 - 2.0f * q2 * ay;
+        float s_norm = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+        if(s_norm > 0){
+            float beta = filter->gain * OrientationInvSqrt(s_norm);
+            dq0 -= beta * s0;
+            dq1 -= beta * s1;
+            dq2 -= beta * s2;
+            dq3 -= beta * s3;
+        }
+    }
+
+    float dt = filter->sample_period;
+    q0 += dq0 * dt;
+    q1 += dq1 * dt;
+    q2 += dq2 * dt;
+    q3 += dq3 * dt;
+    float inv_norm = OrientationInvSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+    filter->q[0] = q0 * inv_norm;
+    filter->q[1] = q1 * inv_norm;
+    filter->q[2] = q2 * inv_norm;
+    filter->q[3] = q3 * inv_norm;
+}
+
+static void OrientationMahonyStep(orientation_filter_t * filter, float gx, float gy, float gz, float ax, float ay, float az){
+    float q0 = filter->q[0];
+    float q1 = filter->q[1];
+    float q2 = filter->q[2];
+    float q3 = filter->q[3];
+
+    float a_norm = ax * ax + ay * ay + az * az;
+    if(a_norm > 0){
+        float inv_norm = OrientationInvSqrt(a_norm);
+        ax *= inv_norm;
+        ay *= inv_norm;
+        az *= inv_norm;
+        // Estimated gravity and its error against the measured one (cross product)
+        float vx = 2.0f * (q1 * q3 - q0 * q2);
+        float vy = 2.0f * (q0 * q1 + q2 * q3);
+        float vz = q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3;
+        float ex = ay * vz - az * vy;
+        float ey = az * vx - ax * vz;
+        float ez = ax * vy - ay * vx;
+        if(filter->ki > 0){
+            float ki_dt = filter->ki * filter->sample_period;
+            filter->integral[0] += ki_dt * ex;
+            filter->integral[1] += ki_dt * ey;
+            filter->integral[2] += ki_dt * ez;
+            gx += filter->integral[0];
+            gy += filter->integral[1];
+            gz += filter->integral[2];
+        }
+        gx += filter->gain * ex;
+        gy += filter->gain * ey;
+        gz += filter->gain * ez;
+    }
+
+    float half_dt = 0.5f * filter->sample_period;
+    gx *= half_dt;
+    gy *= half_dt;
+    gz *= half_dt;
+    float w0 = q0;
+    float w1 = q1;
+    float w2 = q2;
+    q0 += -w1 * gx - w2 * gy - q3 * gz;
+    q1 += w0 * gx + w2 * gz - q3 * gy;
+    q2 += w0 * gy - w1 * gz + q3 * gx;
+    q3 += w0 * gz + w1 * gy - w2 * gx;
+    float inv_norm = OrientationInvSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+    filter->q[0] = q0 * inv_norm;
+    filter->q[1] = q1 * inv_norm;
+    filter->q[2] = q2 * inv_norm;
+    filter->q[3] = q3 * inv_norm;
+}
+
+static void OrientationNormalizeQ30(int32_t * v, uint8_t n){
+    // v / |v| in Q30, whatever the format of v (sum of squares below 2^63)
+    uint64_t n2 = 0;
+    for(uint8_t i=0; i<n; i++){
+        n2 += (uint64_t)((int64_t)v[i] * v[i]);
+    }
+    if(n2 == 0){
+        return;
+    }
+    // Even shift of n2 to x in [1, 4) (Q60), so that 1/sqrt(n2) = 2^(e/2) / 2^30 / sqrt(x)
+    int top_bit = 63 - __builtin_clzll(n2);
+    int e = 60 - top_bit;
+    if(e & 1){
+        e++;
+    }
+    uint64_t x60 = (e >= 0) ? (n2 << e) : (n2 >> -e);
+    int64_t x = (int64_t)(x60 >> Q30_SHIFT);
+    // Table guess and two Newton iterations, y = 1/sqrt(x) in Q30 (relative error ~5e-5)
+    int64_t y = inv_sqrt_q30[(x >> 28) - 4];
+    for(uint8_t i=0; i<2; i++){
+        int64_t xyy = (((x * y) >> Q30_SHIFT) * y) >> Q30_SHIFT;
+        y = (y * (3 * (int64_t)Q30_ONE - xyy)) >> (Q30_SHIFT + 1);
+    }
+    int shift = Q30_SHIFT - e / 2;
+    for(uint8_t i=0; i<n; i++){
+        int64_t p = (int64_t)v[i] * y;
+        v[i] = (int32_t)((shift >= 0) ? (p >> shift) : (p << -shift));
+    }
+}
+
+static void OrientationMadgwickStepQ(orientation_filter_q_t * filter, const int16_t * gyro, const int16_t * accel){
+    int32_t q0 = filter->q[0];
+    int32_t q1 = filter->q[1];
+    int32_t q2 = filter->q[2];
+    int32_t q3 = filter->q[3];
+
+    // Half rotation angle of the sample (Q30)
+    int32_t hx = (int32_t)(((int64_t)gyro[0] * filter->gyro_k) >> (Q46_SHIFT - Q30_SHIFT));
+    int32_t hy = (int32_t)(((int64_t)gyro[1] * filter->gyro_k) >> (Q46_SHIFT - Q30_SHIFT));
+    int32_t hz = (int32_t)(((int64_t)gyro[2] * filter->gyro_k) >> (Q46_SHIFT - Q30_SHIFT));
+    int32_t dq0 = (int32_t)((-(int64_t)q1 * hx - (int64_t)q2 * hy - (int64_t)q3 * hz) >> Q30_SHIFT);
+    int32_t dq1 = (int32_t)(((int64_t)q0 * hx + (int64_t)q2 * hz - (int64_t)q3 * hy) >> Q30_SHIFT);
+    int32_t dq2 = (int32_t)(((int64_t)q0 * hy - (int64_t)q1 * hz + (int64_t)q3 * hx) >> Q30_SHIFT);
+    int32_t dq3 = (int32_t)(((int64_t)q0 * hz + (int64_t)q1 * hy - (int64_t)q2 * hx) >> Q30_SHIFT);
+
+    if((accel[0] != 0) || (accel[1] != 0) || (accel[2] != 0)){
+        int32_t a[3] = {accel[0], accel[1], accel[2]};
+        OrientationNormalizeQ30(a, 3);
+        int32_t ax = a[0];
+        int32_t ay = a[1];
+        int32_t az = a[2];
+        // Gradient of the Madgwick step in Q30, up to 16 in magnitude: 64 bit sums
+        int32_t q0q0 = Q30_MUL(q0, q0);
+        int32_t q1q1 = Q30_MUL(q1, q1);
+        int32_t q2q2 = Q30_MUL(q2, q2);
+        int32_t q3q3 = Q30_MUL(q3, q3);
+        int64_t s0 = 4 * (int64_t)Q30_MUL(q0, q2q2) + 2 * (int64_t)Q30_MUL(q2, ax) + 4 * (int64_t)Q30_MUL(q0, q1q1)
+                     - 2 * (int64_t)Q30_MUL(q1, ay);
+        int64_t s1 = 4 * (int64_t)Q30_MUL(q1, q3q3) - 2 * (int64_t)Q30_MUL(q3, ax) + 4 * (int64_t)Q30_MUL(q0q0, q1)
+                     - 2 * (int64_t)Q30_MUL(q0, ay) - 4 * (int64_t)q1 + 8 * (int64_t)Q30_MUL(q1, q1q1)
+                     + 8 * (int64_t)Q30_MUL(q1, q2q2) + 4 * (int64_t)Q30_MUL(q1, az);
+        int64_t s2 = 4 * (int64_t)Q30_MUL(q0q0, q2) + 2 * (int64_t)Q30_MUL(q0, ax) + 4 * (int64_t)Q30_MUL(q2, q3q3)
+                     - 2 * (int64_t)Q30_MUL(q3, ay) - 4 * (int64_t)q2 + 8 * (int64_t)Q30_MUL(q2, q1q1)
+                     + 8 * (int64_t)Q30_MUL(q2, q2q2) + 4 * (int64_t)Q30_MUL(q2, az);
+        int64_t s3 = 4 * (int64_t)Q30_MUL(q1q1, q3) - 2 * (int64_t)Q30_MUL(q1, ax) + 4 * (int64_t)Q30_MUL(q2q2, q3)
+                     - 2 * (int64_t)Q30_MUL(q2, ay);
+        // Q26 fits in 32 bits, normalization gives back Q30
+        int32_t s[4] = {(int32_t)(s0 >> 4), (int32_t)(s1 >> 4), (int32_t)(s2 >> 4), (int32_t)(s3 >> 4)};
+        if((s[0] != 0) || (s[1] != 0) || (s[2] != 0) || (s[3] != 0)){
+            OrientationNormalizeQ30(s, 4);
+            dq0 -= Q30_MUL(filter->gain_k, s[0]);
+            dq1 -= Q30_MUL(filter->gain_k, s[1]);
+            dq2 -= Q30_MUL(filter->gain_k, s[2]);
+            dq3 -= Q30_MUL(filter->gain_k, s[3]);
+        }
+    }
+
+    filter->q[0] = q0 + dq0;
+    filter->q[1] = q1 + dq1;
+    filter->q[2] = q2 + dq2;
+    filter->q[3] = q3 + dq3;
+    OrientationNormalizeQ30(filter->q, 4);
+}
+
+static void OrientationMahonyStepQ(orientation_filter_q_t * filter, const int16_t * gyro, const int16_t * accel){
+    int32_t q0 = filter->q[0];
+    int32_t q1 = filter->q[1];
+    int32_t q2 = filter->q[2];
+    int32_t q3 = filter->q[3];
+
+    // Half rotation angle of the sample (Q30)
+    int32_t h[3];
+    for(uint8_t i=0; i<3; i++){
+        h[i] = (int32_t)(((int64_t)gyro[i] * filter->gyro_k) >> (Q46_SHIFT - Q30_SHIFT));
+    }
+
+    if((accel[0] != 0) || (accel[1] != 0) || (accel[2] != 0)){
+        int32_t a[3] = {accel[0], accel[1], accel[2]};
+        OrientationNormalizeQ30(a, 3);
+        // Estimated gravity and its error against the measured one (cross product), Q30
+        int32_t vx = (int32_t)(((int64_t)q1 * q3 - (int64_t)q0 * q2) >> (Q30_SHIFT - 1));
+        int32_t vy = (int32_t)(((int64_t)q0 * q1 + (int64_t)q2 * q3) >> (Q30_SHIFT - 1));
+        int32_t vz = (int32_t)(((int64_t)q0 * q0 - (int64_t)q1 * q1 - (int64_t)q2 * q2 + (int64_t)q3 * q3) >> Q30_SHIFT);
+        int32_t e[3];
+        e[0] = (int32_t)(((int64_t)a[1] * vz - (int64_t)a[2] * vy) >> Q30_SHIFT);
+        e[1] = (int32_t)(((int64_t)a[2] * vx - (int64_t)a[0] * vz) >> Q30_SHIFT);
+        e[2] = (int32_t)(((int64_t)a[0] * vy - (int64_t)a[1] * vx) >> Q30_SHIFT);
+        for(uint8_t i=0; i<3; i++){
+            filter->integral[i] += ((int64_t)e[i] * filter->ki_k) >> Q30_SHIFT;
+            h[i] += Q30_MUL(e[i], filter->gain_k) + (int32_t)(filter->integral[i] >> (Q46_SHIFT - Q30_SHIFT));
+        }
+    }
+
+    filter->q[0] = q0 + (int32_t)((-(int64_t)q1 * h[0] - (int64_t)q2 * h[1] - (int64_t)q3 * h[2]) >> Q30_SHIFT);
+    filter->q[1] = q1 + (int32_t)(((int64_t)q0 * h[0] + (int64_t)q2 * h[2] - (int64_t)q3 * h[1]) >> Q30_SHIFT);
+    filter->q[2] = q2 + (int32_t)(((int64_t)q0 * h[1] - (int64_t)q1 * h[2] + (int64_t)q3 * h[0]) >> Q30_SHIFT);
+    filter->q[3] = q3 + (int32_t)(((int64_t)q0 * h[2] + (int64_t)q1 * h[1] - (int64_t)q2 * h[0]) >> Q30_SHIFT);
+    OrientationNormalizeQ30(filter->q, 4);
+}
+
+static bool OrientationToFixed(float value, int shift, int32_t * fixed){
+    int64_t q = llround(ldexp(value, shift));
+    if((q > INT32_MAX) || (q < 0)){
+        return false;
+    }
+    *fixed = (int32_t)q;
+    return true;
+}
+
+/*==================[external functions definition]==========================*/
+bool OrientationFilterInit(orientation_filter_t * filter, orientation_algorithm_t algorithm, float sample_frec, float gain, float ki, float gyro_scale){
+    if((sample_frec <= 0) || (gain < 0) || (ki < 0)){
+        return false;
+    }
+    filter->algorithm = algorithm;
+    filter->sample_period = 1.0f / sample_frec;
+    filter->gain = gain;
+    filter->ki = ki;
+    filter->gyro_scale = gyro_scale;
+    OrientationFilterReset(filter);
+    return true;
+}
+
+void OrientationFilterReset(orientation_filter_t * filter){
+    filter->q[0] = 1;
+    filter->q[1] = 0;
+    filter->q[2] = 0;
+    filter->q[3] = 0;
+    memset(filter->integral, 0, sizeof(filter->integral));
+}
+
+void OrientationFilterUpdate(orientation_filter_t * filter, const float * gyro, const float * accel){
+    if(filter->algorithm == ORIENTATION_MADGWICK){
+        OrientationMadgwickStep(filter, gyro[0], gyro[1], gyro[2], accel[0], accel[1], accel[2]);
+    } else {
+        OrientationMahonyStep(filter, gyro[0], gyro[1], gyro[2], accel[0], accel[1], accel[2]);
+    }
+}
+
+void OrientationFilterProcessMotion6(orientation_filter_t * filter, const int16_t * samples, uint16_t n_samples){
+    // Algorithm selected once per burst
+    float scale = filter->gyro_scale;
+    if(filter->algorithm == ORIENTATION_MADGWICK){
+        for(uint16_t i=0; i<n_samples; i++){
+            OrientationMadgwickStep(filter, scale * samples[3], scale * samples[4], scale * samples[5],
+                                    samples[0], samples[1], samples[2]);
+            samples += ORIENTATION_MOTION6_VALUES;
+        }
+    } else {
+        for(uint16_t i=0; i<n_samples; i++){
+            OrientationMahonyStep(filter, scale * samples[3], scale * samples[4], scale * samples[5],
+                                  samples[0], samples[1], samples[2]);
+            samples += ORIENTATION_MOTION6_VALUES;
+        }
+    }
+}
+
+void OrientationFilterGetEuler(const orientation_filter_t * filter, float * euler){
+    float q0 = filter->q[0];
+    float q1 = filter->q[1];
+    float q2 = filter->q[2];
+    float q3 = filter->q[3];
+    float sin_pitch = 2.0f * (q0 * q2 - q3 * q1);
+    if(sin_pitch > 1.0f){
+        sin_pitch = 1.0f;
+    }
+    if(sin_pitch < -1.0f){
+        sin_pitch = -1.0f;
+    }
+    euler[0] = atan2f(2.0f * (q0 * q1 + q2 * q3), 1.0f - 2.0f * (q1 * q1 + q2 * q2));
+    euler[1] = asinf(sin_pitch);
+    euler[2] = atan2f(2.0f * (q0 * q3 + q1 * q2), 1.0f - 2.0f * (q2 * q2 + q3 * q3));
+}
+
+bool OrientationFilterQInit(orientation_filter_q_t * filter, orientation_algorithm_t algorithm, float sample_frec, float gain, float ki, float gyro_scale){
+    if((sample_frec <= 0) || (gain < 0) || (ki < 0) || (gyro_scale <= 0)){
+        return false;
+    }
+    float dt = 1.0f / sample_frec;
+    float gain_k = (algorithm == ORIENTATION_MADGWICK) ? gain * dt : 0.5f * gain * dt;
+    filter->algorithm = algorithm;
+    if(!OrientationToFixed(0.5f * gyro_scale * dt, Q46_SHIFT, &filter->gyro_k) ||
+       !OrientationToFixed(gain_k, Q30_SHIFT, &filter->gain_k) ||
+       !OrientationToFixed(0.5f * ki * dt * dt, Q46_SHIFT, &filter->ki_k)){
+        return false;
+    }
+    OrientationFilterQReset(filter);
+    return true;
+}
+
+void OrientationFilterQReset(orientation_filter_q_t * filter){
+    filter->q[0] = Q30_ONE;
+    filter->q[1] = 0;
+    filter->q[2] = 0;
+    filter->q[3] = 0;
+    memset(filter->integral, 0, sizeof(filter->integral));
+}
+
+void OrientationFilterQUpdate(orientation_filter_q_t * filter, const int16_t * gyro, const int16_t * accel){
+    if(filter->algorithm == ORIENTATION_MADGWICK){
+        OrientationMadgwickStepQ(filter, gyro, accel);
+    } else {
+        OrientationMahonyStepQ(filter, gyro, accel);
+    }
+}
+
+void OrientationFilterQProcessMotion6(orientation_filter_q_t * filter, const int16_t * samples, uint16_t n_samples){
+    if(filter->algorithm == ORIENTATION_MADGWICK){
+        for(uint16_t i=0; i<n_samples; i++){
+            OrientationMadgwickStepQ(filter, &samples[3], &samples[0]);
+            samples += ORIENTATION_MOTION6_VALUES;
+        }
+    } else {
+        for(uint16_t i=0; i<n_samples; i++){
+            OrientationMahonyStepQ(filter, &samples[3], &samples[0]);
+            samples += ORIENTATION_MOTION6_VALUES;
+        }
+    }
+}
+
+void OrientationFilterQGetQuaternion(const orientation_filter_q_t * filter, float * q){
+    for(uint8_t i=0; i<4; i++){
+        q[i] = ldexpf((float)filter->q[i], -Q30_SHIFT);
+    }
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,142 @@
+/**
+ * @file sliding_dft.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "sliding_dft.h"
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+bool SDFTCreate(sdft_t * sdft, uint16_t signal_lenght, const uint16_t * bins, uint8_t n_bins, float damping){
+    memset(sdft, 0, sizeof(sdft_t));
+    if((signal_lenght < 2) || (n_bins == 0) || (damping <= 0) || (damping > 1)){
+        return false;
+    }
+    for(uint8_t k=0; k<n_bins; k++){
+        if(bins[k] > signal_lenght / 2){
+            return false;
+        }
+    }
+    sdft->buffer = calloc(signal_lenght, sizeof(float));
+    sdft->bins = malloc(n_bins * sizeof(uint16_t));
+    sdft->twiddle = malloc(2 * n_bins * sizeof(float));
+    sdft->spectrum = calloc(2 * n_bins, sizeof(float));
+    if((sdft->buffer == NULL) || (sdft->bins == NULL) || (sdft->twiddle == NULL) || (sdft->spectrum == NULL)){
+        SDFTDestroy(sdft);
+        return false;
+    }
+    sdft->signal_lenght = signal_lenght;
+    sdft->n_bins = n_bins;
+    sdft->damping = damping;
+    sdft->damping_n = powf(damping, signal_lenght);
+    memcpy(sdft->bins, bins, n_bins * sizeof(uint16_t));
+    for(uint8_t k=0; k<n_bins; k++){
+        float w = 2 * M_PI * bins[k] / signal_lenght;
+        sdft->twiddle[2*k] = damping * cosf(w);
+        sdft->twiddle[2*k+1] = damping * sinf(w);
+    }
+    return true;
+}
+
+void SDFTDestroy(sdft_t * sdft){
+    free(sdft->buffer);
+    free(sdft->bins);
+    free(sdft->twiddle);
+    free(sdft->spectrum);
+    sdft->buffer = NULL;
+    sdft->bins = NULL;
+    sdft->twiddle = NULL;
+    sdft->spectrum = NULL;
+    sdft->n_bins = 0;
+}
+
+void SDFTReset(sdft_t * sdft){
+    memset(sdft->buffer, 0, sdft->signal_lenght * sizeof(float));
+    memset(sdft->spectrum, 0, 2 * sdft->n_bins * sizeof(float));
+    sdft->pos = 0;
+}
+
+void SDFTUpdate(sdft_t * sdft, float sample){
+    // The comb (x[n] - r^N * x[n-N]) is shared by all the bins
+    float delta = sample - sdft->damping_n * sdft->buffer[sdft->pos];
+    sdft->buffer[sdft->pos] = sample;
+    if(++sdft->pos >= sdft->signal_lenght){
+        sdft->pos = 0;
+    }
+    float * x = sdft->spectrum;
+    const float * w = sdft->twiddle;
+    for(uint8_t k=0; k<sdft->n_bins; k++){
+        float re = x[0] + delta;
+        float im = x[1];
+        x[0] = w[0] * re - w[1] * im;
+        x[1] = w[0] * im + w[1] * re;
+        x += 2;
+        w += 2;
+    }
+}
+
+void SDFTProcess(sdft_t * sdft, const float * signal, uint16_t signal_lenght){
+    float r_n = sdft->damping_n;
+    while(signal_lenght > 0){
+        // Chunks that do not wrap around the buffer, so x[n-N] is buffer[pos + i]
+        uint16_t chunk = sdft->signal_lenght - sdft->pos;
+        if(chunk > signal_lenght){
+            chunk = signal_lenght;
+        }
+        float * old = &sdft->buffer[sdft->pos];
+        // Bins are independent, updating all of them for each sample keeps the
+        // pipeline busy instead of waiting on the recursion of a single bin
+        for(uint16_t i=0; i<chunk; i++){
+            float delta = signal[i] - r_n * old[i];
+            old[i] = signal[i];
+            float * x = sdft->spectrum;
+            const float * w = sdft->twiddle;
+            for(uint8_t k=0; k<sdft->n_bins; k++){
+                float re = x[0] + delta;
+                float im = x[1];
+                x[0] = w[0] * re - w[1] * im;
+                x[1] = w[0] * im + w[1] * re;
+                x += 2;
+                w += 2;
+            }
+        }
+        sdft->pos += chunk;
+        if(sdft->pos >= sdft->signal_lenght){
+            sdft->pos = 0;
+        }
+        signal += chunk;
+        signal_lenght -= chunk;
+    }
+}
+
+void SDFTMagnitude(const sdft_t * sdft, float * magnitude){
+    for(uint8_t k=0; k<sdft->n_bins; k++){
+        float re = sdft->spectrum[2*k];
+        float im = sdft->spectrum[2*k+1];
+        // DC and Nyquist bins are not mirrored
+        bool edge = (sdft->bins[k] == 0) || (2 * sdft->bins[k] == sdft->signal_lenght);
+        magnitude[k] = sqrtf(re * re + im * im) * (edge ? 1.0f : 2.0f) / sdft->signal_lenght;
+    }
+}
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,181 @@
+/**
+ * @file spectrogram.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include "spectrogram.h"
+/*==================[macros and definitions]=================================*/
+/* Smallest frame with an esp-dsp bit reverse table for its N/2 points FFT */
+#define MIN_SIGNAL_LENGHT   16
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static uint16_t SpectrogramChunk(const spectrogram_t * spec, uint16_t signal_lenght);
+static bool SpectrogramAdvance(spectrogram_t * spec, uint16_t chunk);
+static void SpectrogramFrame(spectrogram_t * spec);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static uint16_t SpectrogramChunk(const spectrogram_t * spec, uint16_t signal_lenght){
+    // Up to the next frame and without wrapping around the ring buffer
+    uint16_t chunk = spec->hop - spec->count;
+    if(chunk > spec->signal_lenght - spec->pos){
+        chunk = spec->signal_lenght - spec->pos;
+    }
+    if(chunk > signal_lenght){
+        chunk = signal_lenght;
+    }
+    return chunk;
+}
+
+static bool SpectrogramAdvance(spectrogram_t * spec, uint16_t chunk){
+    spec->pos += chunk;
+    if(spec->pos >= spec->signal_lenght){
+        spec->pos = 0;
+    }
+    spec->count += chunk;
+    if(spec->count < spec->hop){
+        return false;
+    }
+    spec->count = 0;
+    // First frame waits until the ring buffer is full
+    if(spec->filled < spec->signal_lenght){
+        spec->filled += spec->hop;
+        if(spec->filled < spec->signal_lenght){
+            return false;
+        }
+    }
+    SpectrogramFrame(spec);
+    return true;
+}
+
+static void SpectrogramFrame(spectrogram_t * spec){
+    uint16_t n_bins = spec->signal_lenght / 2;
+    float * row = spec->row;
+    // After a write the oldest sample is the next one to be overwritten
+    FFTPlanPower(&spec->plan, spec->ring, spec->pos, row);
+    row[0] *= 0.5f * spec->density;
+    for(uint16_t k=1; k<n_bins; k++){
+        row[k] *= spec->density;
+    }
+    for(uint16_t k=0; k<n_bins; k++){
+        spec->psd_sum[k] += row[k];
+    }
+    spec->n_frames++;
+    if(spec->row_cb != NULL){
+        spec->row_cb(row, n_bins, spec->param);
+    }
+}
+
+/*==================[external functions definition]==========================*/
+bool SpectrogramCreate(spectrogram_t * spec, float sample_frec, uint16_t signal_lenght, spectrogram_overlap_t overlap,
+    fft_window_t window, spectrogram_row_cb_t row_cb, void * param){
+    memset(spec, 0, sizeof(spectrogram_t));
+    if((signal_lenght < MIN_SIGNAL_LENGHT) || (sample_frec <= 0)){
+        return false;
+    }
+    if((overlap != SPECTROGRAM_OVERLAP_0) && (overlap != SPECTROGRAM_OVERLAP_50) && (overlap != SPECTROGRAM_OVERLAP_75)){
+        return false;
+    }
+    if(!FFTPlanCreateReal(&spec->plan, signal_lenght, window)){
+        return false;
+    }
+    spec->ring = calloc(signal_lenght, sizeof(float));
+    spec->row = calloc(signal_lenght / 2, sizeof(float));
+    spec->psd_sum = calloc(signal_lenght / 2, sizeof(float));
+    if((spec->ring == NULL) || (spec->row == NULL) || (spec->psd_sum == NULL)){
+        SpectrogramDestroy(spec);
+        return false;
+    }
+    spec->signal_lenght = signal_lenght;
+    spec->hop = signal_lenght / overlap;
+    spec->sample_frec = sample_frec;
+    spec->row_cb = row_cb;
+    spec->param = param;
+    float window_power = 0;
+    for(uint16_t i=0; i<signal_lenght; i++){
+        window_power += spec->plan.window[i] * spec->plan.window[i];
+    }
+    spec->density = 2.0f / (sample_frec * window_power);
+    return true;
+}
+
+void SpectrogramDestroy(spectrogram_t * spec){
+    FFTPlanDestroy(&spec->plan);
+    free(spec->ring);
+    free(spec->row);
+    free(spec->psd_sum);
+    spec->ring = NULL;
+    spec->row = NULL;
+    spec->psd_sum = NULL;
+    spec->signal_lenght = 0;
+}
+
+void SpectrogramReset(spectrogram_t * spec){
+    memset(spec->ring, 0, spec->signal_lenght * sizeof(float));
+    memset(spec->row, 0, spec->signal_lenght / 2 * sizeof(float));
+    spec->pos = 0;
+    spec->count = 0;
+    spec->filled = 0;
+    SpectrogramPSDReset(spec);
+}
+
+uint16_t SpectrogramWrite(spectrogram_t * spec, const float * signal, uint16_t signal_lenght){
+    uint16_t rows = 0;
+    while(signal_lenght > 0){
+        uint16_t chunk = SpectrogramChunk(spec, signal_lenght);
+        memcpy(&spec->ring[spec->pos], signal, chunk * sizeof(float));
+        signal += chunk;
+        signal_lenght -= chunk;
+        if(SpectrogramAdvance(spec, chunk)){
+            rows++;
+        }
+    }
+    return rows;
+}
+
+uint16_t SpectrogramWriteADC(spectrogram_t * spec, const uint16_t * values, uint16_t signal_lenght, uint16_t offset, float gain){
+    uint16_t rows = 0;
+    while(signal_lenght > 0){
+        uint16_t chunk = SpectrogramChunk(spec, signal_lenght);
+        float * ring = &spec->ring[spec->pos];
+        for(uint16_t i=0; i<chunk; i++){
+            ring[i] = ((int32_t)values[i] - offset) * gain;
+        }
+        values += chunk;
+        signal_lenght -= chunk;
+        if(SpectrogramAdvance(spec, chunk)){
+            rows++;
+        }
+    }
+    return rows;
+}
+
+uint32_t SpectrogramPSD(const spectrogram_t * spec, float * psd){
+    if(spec->n_frames == 0){
+        return 0;
+    }
+    float scale = 1.0f / spec->n_frames;
+    for(uint16_t k=0; k<(spec->signal_lenght / 2); k++){
+        psd[k] = spec->psd_sum[k] * scale;
+    }
+    return spec->n_frames;
+}
+
+void SpectrogramPSDReset(spectrogram_t * spec){
+    memset(spec->psd_sum, 0, spec->signal_lenght / 2 * sizeof(float));
+    spec->n_frames = 0;
+}
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+int test_fft(void);
+int test_fft_q15(void);
+int test_iir(void);
+int test_iir_q(void);
+int test_multichannel(void);
+int test_decimator(void);
+int test_goertzel(void);
+int test_sdft(void);
+int test_spectrogram(void);
+int test_fast_conv(void);
+int test_scratch(void);
+int test_rv32(void);
+int test_profile(void);
+int test_mat(void);
+int test_ekf(void);
+int test_kalman(void);
+int test_design(void);
+
+int main(void)
+{
+    int failed = 0;
+    printf("main starts!\n");
+    failed += test_fft();
+    failed += test_fft_q15();
+    failed += test_iir();
+    failed += test_iir_q();
+    failed += test_multichannel();
+    failed += test_decimator();
+    failed += test_goertzel();
+    failed += test_sdft();
+    failed += test_spectrogram();
+    failed += test_fast_conv();
+    failed += test_scratch();
+    failed += test_rv32();
+    failed += test_profile();
+    failed += test_mat();
+    failed += test_ekf();
+    failed += test_kalman();
+    failed += test_design();
+
+    if (failed) {
+        printf("Test failed: %i\n", failed);
+        return EXIT_FAILURE;
+    }
+    printf("Test done\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "dsp_common.h"
+#include "decimator.h"
+
+#define HIGH_RATE       80000
+#define LOW_RATE        1000
+#define FRAME_LENGHT    800
+#define N_FRAMES        200
+#define ADC_OFFSET      2048
+#define ADC_MAX         4095
+#define TONE_FREC       50
+#define HALFBAND_TAPS   19
+
+static int16_t frame[FRAME_LENGHT];
+static int16_t frame_ref[FRAME_LENGHT];
+static float low_rate[N_FRAMES * FRAME_LENGHT * LOW_RATE / HIGH_RATE];
+static float single_shot[N_FRAMES * FRAME_LENGHT * LOW_RATE / HIGH_RATE];
+
+static float noise(void)
+{
+    // Sum of uniform values, close enough to gaussian noise (1 LSB rms per unit)
+    float v = 0;
+    for (int k = 0 ; k < 12 ; k++) {
+        v += (float)rand() / RAND_MAX;
+    }
+    return v - 6;
+}
+
+// 12 bit ADC at 80 kHz: tone, out of band interference and noise. Q15 with one bit of headroom.
+static void generate_frame(int n0, int16_t *x)
+{
+    for (int i = 0 ; i < FRAME_LENGHT ; i++) {
+        int n = n0 + i;
+        float v = ADC_OFFSET + 1000 * sinf(2 * M_PI * TONE_FREC * n / HIGH_RATE)
+                  + 300 * sinf(2 * M_PI * 25000.0f * n / HIGH_RATE) + 3 * noise();
+        int32_t adc = v < 0 ? 0 : (v > ADC_MAX ? ADC_MAX : lroundf(v));
+        x[i] = (adc - ADC_OFFSET) << 3;
+    }
+}
+
+// SNR of a tone fitted over whole periods, skipping the filters transient
+static float tone_snr(const float *y, int len, int skip)
+{
+    int n = ((len - skip) / (LOW_RATE / TONE_FREC)) * (LOW_RATE / TONE_FREC);
+    y += len - n;
+    float a = 0, b = 0, c = 0;
+    for (int i = 0 ; i < n ; i++) {
+        a += y[i] * sinf(2 * M_PI * TONE_FREC * i / LOW_RATE);
+        b += y[i] * cosf(2 * M_PI * TONE_FREC * i / LOW_RATE);
+        c += y[i];
+    }
+    a *= 2.0f / n;
+    b *= 2.0f / n;
+    c /= n;
+    float noise_pow = 0;
+    for (int i = 0 ; i < n ; i++) {
+        float e = y[i] - c - a * sinf(2 * M_PI * TONE_FREC * i / LOW_RATE) - b * cosf(2 * M_PI * TONE_FREC * i / LOW_RATE);
+        noise_pow += e * e;
+    }
+    return 10 * log10f((a * a + b * b) / 2 / (noise_pow / n));
+}
+
+// Halfband fast path against the same filter run by dsps_fird_s16
+static int test_decimator_halfband(void)
+{
+    decimator_t halfband;
+    decimator_t generic;
+    int16_t coeffs[HALFBAND_TAPS] = {0};
+    DecimatorInit(&halfband);
+    DecimatorInit(&generic);
+    DecimatorAddHalfband(&halfband, HALFBAND_TAPS);
+    for (int j = 0 ; j < (HALFBAND_TAPS + 1) / 4 ; j++) {
+        coeffs[2 * j] = halfband.stages[0].coeffs[j];
+        coeffs[HALFBAND_TAPS - 1 - 2 * j] = halfband.stages[0].coeffs[j];
+    }
+    coeffs[(HALFBAND_TAPS - 1) / 2] = 16384;
+    DecimatorAddStageCoefficients(&generic, 2, coeffs, HALFBAND_TAPS);
+
+    int max_error = 0;
+    uint32_t cycles_halfband = 0;
+    uint32_t cycles_generic = 0;
+    for (int f = 0 ; f < 8 ; f++) {
+        generate_frame(f * FRAME_LENGHT, frame);
+        memcpy(frame_ref, frame, sizeof(frame));
+        uint32_t start = dsp_get_cpu_cycle_count();
+        int len = DecimatorProcess(&halfband, frame, FRAME_LENGHT);
+        uint32_t end = dsp_get_cpu_cycle_count();
+        cycles_halfband += end - start;
+        start = dsp_get_cpu_cycle_count();
+        int len_ref = DecimatorProcess(&generic, frame_ref, FRAME_LENGHT);
+        end = dsp_get_cpu_cycle_count();
+        cycles_generic += end - start;
+        if (len != FRAME_LENGHT / 2 || len_ref != FRAME_LENGHT / 2) {
+            printf("Error: decimated lenght %i/%i\n", len, len_ref);
+            return 1;
+        }
+        for (int i = 0 ; i < len ; i++) {
+            max_error = abs(frame[i] - frame_ref[i]) > max_error ? abs(frame[i] - frame_ref[i]) : max_error;
+        }
+    }
+    printf("Halfband %i taps | max error %i LSB | dsps_fird_s16: %u cycles | halfband: %u cycles\n",
+           HALFBAND_TAPS, max_error, (unsigned)cycles_generic, (unsigned)cycles_halfband);
+    DecimatorDestroy(&halfband);
+    DecimatorDestroy(&generic);
+    // dsps_fird_s16 rounds up almost a whole LSB, the halfband path rounds to nearest
+    if (max_error > 1) {
+        printf("Error: halfband path differs from dsps_fird_s16\n");
+        return 1;
+    }
+    return 0;
+}
+
+// 80 kHz -> 3 halfband stages -> 10 kHz -> FIR decimation by 10 -> 1 kHz, against one sample every 80
+static int test_decimator_snr(void)
+{
+    decimator_t decimator;
+    DecimatorInit(&decimator);
+    bool ok = DecimatorAddHalfband(&decimator, HALFBAND_TAPS) && DecimatorAddHalfband(&decimator, HALFBAND_TAPS)
+              && DecimatorAddHalfband(&decimator, HALFBAND_TAPS) && DecimatorAddStage(&decimator, 10, 101);
+    if (!ok || decimator.decimation != HIGH_RATE / LOW_RATE) {
+        printf("Error creating decimation chain\n");
+        return 1;
+    }
+    int n_low = 0;
+    uint32_t cycles = 0;
+    for (int f = 0 ; f < N_FRAMES ; f++) {
+        generate_frame(f * FRAME_LENGHT, frame);
+        for (int i = 0 ; i < FRAME_LENGHT ; i += HIGH_RATE / LOW_RATE) {
+            single_shot[n_low + i / (HIGH_RATE / LOW_RATE)] = frame[i];
+        }
+        uint32_t start = dsp_get_cpu_cycle_count();
+        int len = DecimatorProcess(&decimator, frame, FRAME_LENGHT);
+        uint32_t end = dsp_get_cpu_cycle_count();
+        cycles += end - start;
+        for (int i = 0 ; i < len ; i++) {
+            low_rate[n_low + i] = frame[i];
+        }
+        n_low += len;
+    }
+    float snr_single = tone_snr(single_shot, n_low, 0);
+    float snr_decimated = tone_snr(low_rate, n_low, 100);
+    printf("Decimation by %i | single shot SNR %.1f dB | decimated SNR %.1f dB | %.2f cycles/input sample\n",
+           decimator.decimation, snr_single, snr_decimated, (float)cycles / (N_FRAMES * FRAME_LENGHT));
+    DecimatorDestroy(&decimator);
+    if (n_low != N_FRAMES * FRAME_LENGHT * LOW_RATE / HIGH_RATE || snr_decimated < snr_single + 15) {
+        printf("Error: decimated SNR is not better than single shot sampling\n");
+        return 1;
+    }
+    return 0;
+}
+
+int test_decimator(void)
+{
+    int failed = 0;
+    failed += test_decimator_halfband();
+    failed += test_decimator_snr();
+    if (failed == 0) {
+        printf("Decimator test Pass!\n");
+    }
+    return failed;
+}
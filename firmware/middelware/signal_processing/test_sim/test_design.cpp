@@ -0,0 +1,160 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <complex>
+
+#include "dsps_wind_design.h"
+extern "C" {
+#include "fft.h"
+#include "iir_filter.h"
+}
+#include "dsp_design.h"
+
+#define SIGNAL_LENGHT       512
+
+// Evaluated by the compiler: a design that doesn't fit a constant expression fails to build
+static_assert(dsps_design::wind_hann<5>().values[2] == 1.0f, "Hann window peak");
+static_assert(dsps_design::wind_hann<5>().values[0] == 0.0f, "Hann window edge");
+
+DSP_DESIGN_SOS(test_lpf, dsps_design::butterworth_lpf<4>(50.0 / 1000.0))
+DSP_DESIGN_SOS(test_hpf, dsps_design::butterworth_hpf<8>(5.0 / 1000.0))
+DSP_DESIGN_SOS(test_cheby_lpf, dsps_design::chebyshev1_lpf<4>(0.1, 1.0))
+DSP_DESIGN_SOS(test_cheby_hpf, dsps_design::chebyshev1_hpf<6>(0.2, 0.5))
+DSP_DESIGN_SOS(test_notch, dsps_design::notch(0.05, 10))
+
+// |H(f)| of a cascade
+static float gain(const float *coeffs, int n_sections, float f)
+{
+    std::complex<float> z1 = std::polar(1.0f, -2 * (float)M_PI * f);
+    std::complex<float> z2 = z1 * z1;
+    std::complex<float> h = 1;
+    for (int s = 0 ; s < n_sections ; s++) {
+        const float *c = &coeffs[5 * s];
+        h *= (c[0] + c[1] * z1 + c[2] * z2) / (1.0f + c[3] * z1 + c[4] * z2);
+    }
+    return std::abs(h);
+}
+
+// Flash tables against the run time windows, and FFT plans pointing to them
+static int test_design_windows(void)
+{
+    int failed = 0;
+    const fft_window_t windows[] = {FFT_WINDOW_HANN, FFT_WINDOW_BLACKMAN, FFT_WINDOW_NUTTALL, FFT_WINDOW_FLAT_TOP};
+    static float window[DSP_DESIGN_WINDOW_MAX_LENGHT];
+    float max_error = 0;
+    for (int w = 0 ; w < 4 ; w++) {
+        for (int len = DSP_DESIGN_WINDOW_MIN_LENGHT ; len <= DSP_DESIGN_WINDOW_MAX_LENGHT ; len *= 2) {
+            const float *table = DSPDesignWindow(windows[w], len);
+            if (table == NULL) {
+                printf("Error: no window table %i, length %i\n", windows[w], len);
+                failed++;
+                continue;
+            }
+            FFTWindowGenerate(window, len, windows[w]);
+            for (int i = 0 ; i < len ; i++) {
+                max_error = fmaxf(max_error, fabsf(table[i] - window[i]));
+            }
+        }
+    }
+    printf("Window tables | max error against FFTWindowGenerate() %e\n", max_error);
+    if ((max_error > 1e-6f) || (DSPDesignWindow(FFT_WINDOW_BLACKMAN_HARRIS, 256) != NULL) ||
+            (DSPDesignWindow(FFT_WINDOW_HANN, 48) != NULL) || (DSPDesignWindow(FFT_WINDOW_HANN, 2 * DSP_DESIGN_WINDOW_MAX_LENGHT) != NULL)) {
+        printf("Error: window tables\n");
+        failed++;
+    }
+
+    fft_plan_t plan;
+    fft_plan_t plan_generated;
+    if (!FFTPlanCreateReal(&plan, SIGNAL_LENGHT, FFT_WINDOW_HANN) ||
+            !FFTPlanCreateReal(&plan_generated, SIGNAL_LENGHT, FFT_WINDOW_BLACKMAN_HARRIS)) {
+        printf("Error: FFTPlanCreateReal\n");
+        return failed + 1;
+    }
+    if ((plan.window != DSPDesignWindow(FFT_WINDOW_HANN, SIGNAL_LENGHT)) || (plan.window_buffer != NULL) ||
+            (plan_generated.window != plan_generated.window_buffer) || (plan_generated.window == NULL)) {
+        printf("Error: FFT plan windows\n");
+        failed++;
+    }
+    FFTPlanDestroy(&plan);
+    FFTPlanDestroy(&plan_generated);
+    return failed;
+}
+
+// Butterworth cascades against the run time design, Chebyshev and notch responses
+static int test_design_biquads(void)
+{
+    int failed = 0;
+    iir_filter_t lpf;
+    iir_filter_t hpf;
+    IIRFilterCreate(&lpf, 2);
+    IIRFilterCreate(&hpf, 4);
+    IIRFilterAddButterworth(&lpf, FILTER_LOW_PASS, 1000, 50, 4);
+    IIRFilterAddButterworth(&hpf, FILTER_HIGH_PASS, 1000, 5, 8);
+    float max_error = 0;
+    for (int i = 0 ; i < 2 * 5 ; i++) {
+        max_error = fmaxf(max_error, fabsf(test_lpf()[i] - lpf.coeffs[i]));
+    }
+    for (int i = 0 ; i < 4 * 5 ; i++) {
+        max_error = fmaxf(max_error, fabsf(test_hpf()[i] - hpf.coeffs[i]));
+    }
+
+    // Same output through the legacy interface
+    static float signal[SIGNAL_LENGHT];
+    static float out_design[SIGNAL_LENGHT];
+    static float out_runtime[SIGNAL_LENGHT];
+    for (int i = 0 ; i < SIGNAL_LENGHT ; i++) {
+        signal[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+    LowPassInitCoefficients(test_lpf(), ORDER_4);
+    LowPassFilter(signal, out_design, SIGNAL_LENGHT);
+    LowPassInit(1000, 50, ORDER_4);
+    LowPassFilter(signal, out_runtime, SIGNAL_LENGHT);
+    float max_output_error = 0;
+    for (int i = 0 ; i < SIGNAL_LENGHT ; i++) {
+        max_output_error = fmaxf(max_output_error, fabsf(out_design[i] - out_runtime[i]));
+    }
+    printf("Butterworth   | max coefficient error %e | max LowPassFilter() error %e\n", max_error, max_output_error);
+    if ((max_error > 1e-5f) || (max_output_error > 1e-5f)) {
+        printf("Error: Butterworth design\n");
+        failed++;
+    }
+    IIRFilterDestroy(&lpf);
+    IIRFilterDestroy(&hpf);
+
+    // Equiripple pass band between -ripple and 0 dB, -ripple at the band edge (and at DC or
+    // Nyquist, even orders)
+    const float ripple_lpf = powf(10, -1.0f / 20);
+    const float ripple_hpf = powf(10, -0.5f / 20);
+    float pass_min = 1;
+    float pass_max = 0;
+    for (float f = 0 ; f <= 0.1f ; f += 0.001f) {
+        float g = gain(test_cheby_lpf(), 2, f);
+        pass_min = fminf(pass_min, g / ripple_lpf);
+        pass_max = fmaxf(pass_max, g);
+    }
+    for (float f = 0.2f ; f <= 0.5f ; f += 0.001f) {
+        float g = gain(test_cheby_hpf(), 3, f);
+        pass_min = fminf(pass_min, g / ripple_hpf);
+        pass_max = fmaxf(pass_max, g);
+    }
+    float edge_error = fmaxf(fabsf(gain(test_cheby_lpf(), 2, 0.1f) - ripple_lpf), fabsf(gain(test_cheby_hpf(), 3, 0.2f) - ripple_hpf));
+    float notch = gain(test_notch(), 1, 0.05f);
+    printf("Chebyshev I   | pass band %f to %f (ripple units) | band edge error %e | notch %e\n", pass_min, pass_max, edge_error, notch);
+    if ((pass_min < 0.9999f) || (pass_max > 1.0001f) || (edge_error > 1e-4f) || (notch > 1e-4f) ||
+            (fabsf(gain(test_notch(), 1, 0) - 1) > 1e-4f)) {
+        printf("Error: Chebyshev / notch design\n");
+        failed++;
+    }
+    return failed;
+}
+
+extern "C" int test_design(void)
+{
+    int failed = 0;
+    failed += test_design_windows();
+    failed += test_design_biquads();
+    if (failed == 0) {
+        printf("Design test Pass!\n");
+    }
+    return failed;
+}
@@ -0,0 +1,244 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "dsp_common.h"
+#include "ekf_imu13states.h"
+#include "ekf_imu13states_fixed.h"
+extern "C" {
+#include "orientation_filter.h"
+}
+
+// Heap allocation counter of test_mat.cpp
+extern volatile uint32_t heap_allocations;
+
+#define EKF_STEPS           6144
+#define EKF_SAMPLE_FREC     100.0f
+#define EKF_SAMPLE_TIME     (1.0f / EKF_SAMPLE_FREC)
+#define ACCEL_LSB_PER_G     16384.0f
+#define FIFO_BURST          16
+
+// Recording of a MPU6050 (raw accel and gyro, ±2 g and ±250 dps) and a magnetometer on the
+// rotation of ekf_imu13states::TestFull(), with a constant gyroscope bias
+static int16_t motion6[EKF_STEPS * ORIENTATION_MOTION6_VALUES];
+static float magn[EKF_STEPS * 3];
+static float gravity[EKF_STEPS * 3];
+
+static void record_imu(const float *gyro_err)
+{
+    const float pi = 3.14159265f;
+    float accel0_data[] = {0, 0, 1};
+    float magn0_data[] = {1, 0, 0};
+    dspm::Mat accel0(accel0_data, 3, 1);
+    dspm::Mat magn0(magn0_data, 3, 1);
+    dspm::Mat Rm = dspm::Mat::eye(3);
+
+    for (int n = 0; n < EKF_STEPS; n++) {
+        float gyro_data[3] = {0, 0, 0};
+        if (n >= EKF_STEPS / 12) {
+            float w = cosf(-pi / 2 + pi * (n - EKF_STEPS / 12) / (EKF_STEPS / 30));
+            gyro_data[0] = 1 / pi * w;
+            gyro_data[1] = 2 / pi * w;
+            gyro_data[2] = 3 / pi * w;
+        }
+        float angle[3];
+        for (int i = 0; i < 3; i++) {
+            angle[i] = gyro_data[i] * EKF_SAMPLE_TIME;
+        }
+        Rm = Rm * ekf::eul2rotm(angle);
+        // Accel and magn rotate to the opposite direction
+        dspm::Mat accel_data = Rm.t() * accel0;
+        dspm::Mat magn_data = Rm.t() * magn0;
+        int16_t *sample = &motion6[n * ORIENTATION_MOTION6_VALUES];
+        for (int i = 0; i < 3; i++) {
+            sample[i] = (int16_t)lroundf(accel_data(i, 0) * ACCEL_LSB_PER_G);
+            sample[3 + i] = (int16_t)lroundf((gyro_data[i] + gyro_err[i]) / ORIENTATION_MPU6050_GYRO_250DPS);
+            magn[n * 3 + i] = magn_data(i, 0);
+            gravity[n * 3 + i] = accel_data(i, 0);
+        }
+    }
+}
+
+// Sample n of the recording in float: gyro in rad/s, normalized accel
+static void recorded_sample(int n, float *gyro, float *accel)
+{
+    const int16_t *sample = &motion6[n * ORIENTATION_MOTION6_VALUES];
+    float norm = 0;
+    for (int i = 0; i < 3; i++) {
+        gyro[i] = sample[3 + i] * ORIENTATION_MPU6050_GYRO_250DPS;
+        accel[i] = sample[i];
+        norm += accel[i] * accel[i];
+    }
+    norm = sqrtf(norm);
+    for (int i = 0; i < 3; i++) {
+        accel[i] /= norm;
+    }
+}
+
+// Gravity seen by the sensor at attitude q
+static void quat_gravity(const float *q, float *g)
+{
+    g[0] = 2 * (q[1] * q[3] - q[0] * q[2]);
+    g[1] = 2 * (q[0] * q[1] + q[2] * q[3]);
+    g[2] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+}
+
+// Angle between two gravity vectors, degrees
+static float tilt_error(const float *g, const float *g_ref)
+{
+    float dot = (g[0] * g_ref[0] + g[1] * g_ref[1] + g[2] * g_ref[2]) /
+                sqrtf((g[0] * g[0] + g[1] * g[1] + g[2] * g[2]) * (g_ref[0] * g_ref[0] + g_ref[1] * g_ref[1] + g_ref[2] * g_ref[2]));
+    return acosf(fminf(dot, 1.0f)) * 180.0f / 3.14159265f;
+}
+
+// ekf_imu13states_fixed on the recording: same states as the Mat based filter, gyro bias
+// error at least halved (the filter converges slowly with Q of Init()), no heap memory
+// and the cycles of a filter step
+static int test_ekf_imu13states_fixed(void)
+{
+    int failed = 0;
+    const float gyro_err[3] = {0.1, 0.2, 0.3};
+    float R[6];
+    for (int i = 0; i < 6; i++) {
+        R[i] = 0.01;
+    }
+    record_imu(gyro_err);
+
+    ekf_imu13states *ekf_ref = new ekf_imu13states();
+    ekf_ref->Init();
+    static ekf_imu13states_fixed ekf_fixed;
+    ekf_fixed.Init();
+
+    uint32_t cycles_ref = 0;
+    uint32_t cycles_fixed = 0;
+    uint32_t allocations = 0;
+    float diff = 0;
+    for (int n = 0; n < EKF_STEPS; n++) {
+        float input_u[3];
+        float accel_data[3];
+        recorded_sample(n, input_u, accel_data);
+
+        uint32_t cycles = dsp_get_cpu_cycle_count();
+        ekf_ref->Process(input_u, EKF_SAMPLE_TIME);
+        ekf_ref->UpdateRefMeasurement(accel_data, &magn[n * 3], R);
+        cycles_ref += dsp_get_cpu_cycle_count() - cycles;
+
+        uint32_t start = heap_allocations;
+        cycles = dsp_get_cpu_cycle_count();
+        ekf_fixed.Process(input_u, EKF_SAMPLE_TIME);
+        ekf_fixed.UpdateRefMeasurement(accel_data, &magn[n * 3], R);
+        cycles_fixed += dsp_get_cpu_cycle_count() - cycles;
+        allocations += heap_allocations - start;
+
+        for (int i = 0; i < ekf_imu13states_fixed::NUMX; i++) {
+            diff = fmaxf(diff, fabsf(ekf_fixed.X(i, 0) - ekf_ref->X(i, 0)));
+        }
+    }
+
+    float bias_err = 0;
+    for (int i = 0; i < 3; i++) {
+        bias_err = fmaxf(bias_err, fabsf(ekf_fixed.X(4 + i, 0) - gyro_err[i]) / gyro_err[i]);
+    }
+    printf("ekf_imu13states step (Process + UpdateRefMeasurement), %i steps\n", EKF_STEPS);
+    printf("  Mat:      %u cycles/step\n", (unsigned)(cycles_ref / EKF_STEPS));
+    printf("  MatFixed: %u cycles/step, %u allocations, states diff %f, gyro bias relative error %f\n",
+           (unsigned)(cycles_fixed / EKF_STEPS), (unsigned)allocations, diff, bias_err);
+    if ((allocations != 0) || (diff > 1e-3f) || (bias_err > 0.5f)) {
+        printf("Error: ekf_imu13states_fixed\n");
+        failed++;
+    }
+    delete ekf_ref;
+    return failed;
+}
+
+// Madgwick and Mahony filters, float and fixed point, fed with FIFO bursts of the
+// recording: tilt (gravity direction) against ekf_imu13states after 1 s of convergence
+static int test_orientation_filter(void)
+{
+    int failed = 0;
+    const float gyro_err[3] = {0.02, -0.01, 0.015};
+    const float max_tilt_error = 2.0f;
+    float R[6];
+    for (int i = 0; i < 6; i++) {
+        R[i] = 0.01;
+    }
+    record_imu(gyro_err);
+
+    ekf_imu13states *ekf_ref = new ekf_imu13states();
+    ekf_ref->Init();
+    orientation_filter_t filters[2];
+    orientation_filter_q_t filters_q[2];
+    OrientationFilterInit(&filters[0], ORIENTATION_MADGWICK, EKF_SAMPLE_FREC, 0.1f, 0, ORIENTATION_MPU6050_GYRO_250DPS);
+    OrientationFilterInit(&filters[1], ORIENTATION_MAHONY, EKF_SAMPLE_FREC, 1.0f, 0.1f, ORIENTATION_MPU6050_GYRO_250DPS);
+    if (!OrientationFilterQInit(&filters_q[0], ORIENTATION_MADGWICK, EKF_SAMPLE_FREC, 0.1f, 0, ORIENTATION_MPU6050_GYRO_250DPS) ||
+            !OrientationFilterQInit(&filters_q[1], ORIENTATION_MAHONY, EKF_SAMPLE_FREC, 1.0f, 0.1f, ORIENTATION_MPU6050_GYRO_250DPS)) {
+        printf("Error: OrientationFilterQInit\n");
+        delete ekf_ref;
+        return 1;
+    }
+
+    const char *names[4] = {"Madgwick float", "Mahony float", "Madgwick Q30", "Mahony Q30"};
+    float error_ekf[4] = {0, 0, 0, 0};
+    float error_true[5] = {0, 0, 0, 0, 0};
+    uint32_t cycles[4] = {0, 0, 0, 0};
+    for (int n = 0; n < EKF_STEPS; n += FIFO_BURST) {
+        for (int k = n; k < n + FIFO_BURST; k++) {
+            float input_u[3];
+            float accel_data[3];
+            recorded_sample(k, input_u, accel_data);
+            ekf_ref->Process(input_u, EKF_SAMPLE_TIME);
+            ekf_ref->UpdateRefMeasurement(accel_data, &magn[k * 3], R);
+        }
+        const int16_t *burst = &motion6[n * ORIENTATION_MOTION6_VALUES];
+        float q[4][4];
+        for (int f = 0; f < 2; f++) {
+            uint32_t start = dsp_get_cpu_cycle_count();
+            OrientationFilterProcessMotion6(&filters[f], burst, FIFO_BURST);
+            cycles[f] += dsp_get_cpu_cycle_count() - start;
+            for (int i = 0; i < 4; i++) {
+                q[f][i] = filters[f].q[i];
+            }
+            start = dsp_get_cpu_cycle_count();
+            OrientationFilterQProcessMotion6(&filters_q[f], burst, FIFO_BURST);
+            cycles[2 + f] += dsp_get_cpu_cycle_count() - start;
+            OrientationFilterQGetQuaternion(&filters_q[f], q[2 + f]);
+        }
+        if (n < EKF_SAMPLE_FREC) {
+            continue;
+        }
+        float g_ekf[3];
+        quat_gravity(ekf_ref->X.data, g_ekf);
+        const float *g_true = &gravity[(n + FIFO_BURST - 1) * 3];
+        error_true[4] = fmaxf(error_true[4], tilt_error(g_ekf, g_true));
+        for (int f = 0; f < 4; f++) {
+            float g[3];
+            quat_gravity(q[f], g);
+            error_ekf[f] = fmaxf(error_ekf[f], tilt_error(g, g_ekf));
+            error_true[f] = fmaxf(error_true[f], tilt_error(g, g_true));
+        }
+    }
+
+    printf("Orientation filters, %i samples in bursts of %i, max tilt error (deg)\n", EKF_STEPS, FIFO_BURST);
+    printf("  %-16s | vs EKF | vs true | cycles/sample\n", "filter");
+    printf("  %-16s |      - | %7.3f | -\n", "ekf_imu13states", error_true[4]);
+    for (int f = 0; f < 4; f++) {
+        printf("  %-16s | %6.3f | %7.3f | %u\n", names[f], error_ekf[f], error_true[f], (unsigned)(cycles[f] / EKF_STEPS));
+        if (error_ekf[f] > max_tilt_error) {
+            printf("Error: %s tilt error\n", names[f]);
+            failed++;
+        }
+    }
+    delete ekf_ref;
+    return failed;
+}
+
+extern "C" int test_ekf(void)
+{
+    int failed = 0;
+    failed += test_ekf_imu13states_fixed();
+    failed += test_orientation_filter();
+    if (failed == 0) {
+        printf("EKF test Pass!\n");
+    }
+    return failed;
+}
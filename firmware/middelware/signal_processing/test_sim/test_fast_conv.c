@@ -0,0 +1,193 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "dsp_common.h"
+#include "dsps_fir.h"
+#include "dsps_conv.h"
+#include "dsps_corr.h"
+#include "fast_conv.h"
+
+#define N_SAMPLES       4096
+#define MAX_TAPS        1024
+#define PULSE_LENGHT    256
+#define ECHO_DELAY      1234
+
+static float signal[N_SAMPLES];
+static float kernel[MAX_TAPS];
+static float coeffs[MAX_TAPS];
+static float delay[MAX_TAPS + 4];
+static float reference[N_SAMPLES + MAX_TAPS];
+static float output[N_SAMPLES + MAX_TAPS];
+
+static void generate(float *x, int len)
+{
+    for (int i = 0 ; i < len ; i++) {
+        x[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+}
+
+static float max_error(const float *x, const float *ref, int len)
+{
+    float peak = 0;
+    float error = 0;
+    for (int i = 0 ; i < len ; i++) {
+        peak = fmaxf(peak, fabsf(ref[i]));
+        error = fmaxf(error, fabsf(x[i] - ref[i]));
+    }
+    return error / peak;
+}
+
+// Streaming convolution in uneven blocks against dsps_fir_f32(), and the cost per sample of both
+static int test_fast_conv_stream(void)
+{
+    int failed = 0;
+    const int taps[] = {16, 32, 48, 64, 128, 255, 512, 1024};
+    const int chunks[] = {1, 100, 777, 1500};
+    generate(signal, N_SAMPLES);
+    printf("Taps |  FFT | max error (rel. to peak) | direct cycles/sample | fast cycles/sample\n");
+    for (int t = 0 ; t < sizeof(taps) / sizeof(taps[0]) ; t++) {
+        int n_taps = taps[t];
+        fir_f32_t fir;
+        fast_conv_t conv;
+        generate(kernel, n_taps);
+        for (int m = 0 ; m < n_taps ; m++) {
+            coeffs[m] = kernel[n_taps - 1 - m];
+        }
+        memset(delay, 0, sizeof(delay));
+        dsps_fir_init_f32(&fir, coeffs, delay, n_taps);
+        uint32_t start = dsp_get_cpu_cycle_count();
+        dsps_fir_f32(&fir, signal, reference, N_SAMPLES);
+        uint32_t cycles_direct = dsp_get_cpu_cycle_count() - start;
+
+        if (!FastConvCreate(&conv, kernel, n_taps)) {
+            printf("Error creating convolution of %i taps\n", n_taps);
+            return failed + 1;
+        }
+        int n = 0;
+        for (int c = 0 ; n < N_SAMPLES ; c++) {
+            int chunk = chunks[c % 4];
+            if (chunk > N_SAMPLES - n) {
+                chunk = N_SAMPLES - n;
+            }
+            FastConvProcess(&conv, &signal[n], &output[n], chunk);
+            n += chunk;
+        }
+        float error = max_error(output, reference, N_SAMPLES);
+        // Whole signal at once, in place
+        FastConvReset(&conv);
+        memcpy(output, signal, sizeof(signal));
+        start = dsp_get_cpu_cycle_count();
+        FastConvProcess(&conv, output, output, N_SAMPLES);
+        uint32_t cycles_fast = dsp_get_cpu_cycle_count() - start;
+        error = fmaxf(error, max_error(output, reference, N_SAMPLES));
+
+        printf("%4i | %4u | %24e | %20.1f | %18.1f\n", n_taps, conv.fft_lenght, error,
+               (float)cycles_direct / N_SAMPLES, (float)cycles_fast / N_SAMPLES);
+        if (error > 1e-5f) {
+            printf("Error: fast convolution differs from dsps_fir_f32()\n");
+            failed++;
+        }
+        FastConvDestroy(&conv);
+    }
+    return failed;
+}
+
+// Whole signals against dsps_conv_f32_ansi(), kernel longer than the signal included
+static int test_fast_convolution(void)
+{
+    int failed = 0;
+    const int lens[][2] = {{2000, 300}, {300, 2000}, {1000, 20}};
+    for (int t = 0 ; t < 3 ; t++) {
+        int siglen = lens[t][0];
+        int kernlen = lens[t][1];
+        float *x = malloc(siglen * sizeof(float));
+        float *h = malloc(kernlen * sizeof(float));
+        generate(x, siglen);
+        generate(h, kernlen);
+        dsps_conv_f32_ansi(x, siglen, h, kernlen, reference);
+        bool ok = FastConvolution(x, siglen, h, kernlen, output);
+        float error = max_error(output, reference, siglen + kernlen - 1);
+        printf("Convolution %4i x %4i | max error %e\n", siglen, kernlen, error);
+        if (!ok || (error > 1e-5f)) {
+            printf("Error: FastConvolution() differs from dsps_conv_f32()\n");
+            failed++;
+        }
+        free(x);
+        free(h);
+    }
+    return failed;
+}
+
+// Matched filter: time of flight of a chirp echo buried in noise
+static int test_fast_correlation(void)
+{
+    float pulse[PULSE_LENGHT];
+    for (int i = 0 ; i < PULSE_LENGHT ; i++) {
+        float t = (float)i / PULSE_LENGHT;
+        pulse[i] = sinf(2 * M_PI * (10 * t + 40 * t * t)) * sinf(M_PI * t);
+    }
+    generate(signal, N_SAMPLES);
+    for (int i = 0 ; i < PULSE_LENGHT ; i++) {
+        signal[ECHO_DELAY + i] += 0.3f * pulse[i];
+    }
+    int len = N_SAMPLES - PULSE_LENGHT + 1;
+    uint32_t start = dsp_get_cpu_cycle_count();
+    dsps_corr_f32_ansi(signal, N_SAMPLES, pulse, PULSE_LENGHT, reference);
+    uint32_t cycles_direct = dsp_get_cpu_cycle_count() - start;
+    start = dsp_get_cpu_cycle_count();
+    bool ok = FastCorrelation(signal, N_SAMPLES, pulse, PULSE_LENGHT, output);
+    uint32_t cycles_fast = dsp_get_cpu_cycle_count() - start;
+    float error = max_error(output, reference, len);
+    int peak = 0;
+    for (int n = 1 ; n < len ; n++) {
+        if (output[n] > output[peak]) {
+            peak = n;
+        }
+    }
+    printf("Correlation %i x %i | max error %e | echo at %i (expected %i) | direct %u cycles | fast %u cycles\n",
+           N_SAMPLES, PULSE_LENGHT, error, peak, ECHO_DELAY, (unsigned)cycles_direct, (unsigned)cycles_fast);
+    if (!ok || (error > 1e-5f) || (peak != ECHO_DELAY)) {
+        printf("Error: FastCorrelation() differs from dsps_corr_f32()\n");
+        return 1;
+    }
+    return 0;
+}
+
+// Streaming matched filters: y[n] is the correlation with the last M samples, both paths
+static int test_fast_conv_correlation(void)
+{
+    int failed = 0;
+    const int taps[] = {16, 200};
+    generate(signal, N_SAMPLES);
+    for (int t = 0 ; t < 2 ; t++) {
+        int n_taps = taps[t];
+        fast_conv_t conv;
+        generate(kernel, n_taps);
+        dsps_corr_f32_ansi(signal, N_SAMPLES, kernel, n_taps, reference);
+        FastConvCreateCorrelation(&conv, kernel, n_taps);
+        FastConvProcess(&conv, signal, output, N_SAMPLES);
+        float error = max_error(&output[n_taps - 1], reference, N_SAMPLES - n_taps + 1);
+        printf("Streaming correlation %3i taps | max error %e\n", n_taps, error);
+        if (error > 1e-5f) {
+            printf("Error: streaming correlation differs from dsps_corr_f32()\n");
+            failed++;
+        }
+        FastConvDestroy(&conv);
+    }
+    return failed;
+}
+
+int test_fast_conv(void)
+{
+    int failed = 0;
+    failed += test_fast_conv_stream();
+    failed += test_fast_convolution();
+    failed += test_fast_correlation();
+    failed += test_fast_conv_correlation();
+    if (failed == 0) {
+        printf("Fast convolution test Pass!\n");
+    }
+    return failed;
+}
@@ -0,0 +1,203 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "dsp_common.h"
+#include "esp_dsp.h"
+#include "fft.h"
+
+#define TEST_REPEAT     16
+
+static float signal[MAX_SIGNAL_LENGHT];
+static float fft_cplx[MAX_SIGNAL_LENGHT / 2];
+static float fft_real[MAX_SIGNAL_LENGHT / 2];
+
+static void generate_signal(float *x, int len)
+{
+    for (int i = 0 ; i < len ; i++) {
+        x[i] = 0.5f + sinf(2 * M_PI * 0.0625f * i) + 0.25f * cosf(2 * M_PI * 0.3f * i)
+               + 0.01f * ((float)rand() / RAND_MAX - 0.5f);
+    }
+}
+
+// Real input plans against the complex plans (same path as the original FFTMagnitude)
+static int test_fft_real(void)
+{
+    int failed = 0;
+    printf("  N  | max error (rel. to peak) | complex cycles | real cycles\n");
+    for (int len = 256 ; len <= MAX_SIGNAL_LENGHT ; len *= 2) {
+        fft_plan_t plan_cplx;
+        fft_plan_t plan_real;
+        if (!FFTPlanCreate(&plan_cplx, len, FFT_WINDOW_HANN) || !FFTPlanCreateReal(&plan_real, len, FFT_WINDOW_HANN)) {
+            printf("Error creating plans for N = %i\n", len);
+            return 1;
+        }
+        generate_signal(signal, len);
+
+        uint32_t cycles_cplx = UINT32_MAX;
+        uint32_t cycles_real = UINT32_MAX;
+        for (int r = 0 ; r < TEST_REPEAT ; r++) {
+            uint32_t start = dsp_get_cpu_cycle_count();
+            FFTPlanMagnitude(&plan_cplx, signal, fft_cplx);
+            uint32_t end = dsp_get_cpu_cycle_count();
+            if ((end - start) < cycles_cplx) {
+                cycles_cplx = end - start;
+            }
+            start = dsp_get_cpu_cycle_count();
+            FFTPlanMagnitude(&plan_real, signal, fft_real);
+            end = dsp_get_cpu_cycle_count();
+            if ((end - start) < cycles_real) {
+                cycles_real = end - start;
+            }
+        }
+
+        float peak = 0;
+        float error = 0;
+        for (int k = 0 ; k < len / 2 ; k++) {
+            peak = fmaxf(peak, fft_cplx[k]);
+            error = fmaxf(error, fabsf(fft_cplx[k] - fft_real[k]));
+        }
+        printf("%4i | %24e | %14u | %11u\n", len, error / peak, (unsigned)cycles_cplx, (unsigned)cycles_real);
+        if (error / peak > 1e-5f) {
+            printf("Error: real FFT differs from complex FFT for N = %i\n", len);
+            failed++;
+        }
+        FFTPlanDestroy(&plan_cplx);
+        FFTPlanDestroy(&plan_real);
+    }
+    return failed;
+}
+
+// Original FFTMagnitude(): Hann window generated on every call, complex FFT of the
+// zero-padded real signal, magnitude of each bin. Independent reference for the module.
+static void fft_magnitude_reference(const float *x, float *fft, int len)
+{
+    static float wind[MAX_SIGNAL_LENGHT];
+    static float fft_complex[2 * MAX_SIGNAL_LENGHT];
+    dsps_wind_hann_f32(wind, len);
+    memset(fft_complex, 0, 2 * MAX_SIGNAL_LENGHT * sizeof(float));
+    dsps_mul_f32(x, wind, fft_complex, len, 1, 1, 2);
+    dsps_fft2r_fc32(fft_complex, len);
+    dsps_bit_rev_fc32(fft_complex, len);
+    dsps_cplx2reC_fc32(fft_complex, len);
+    for (int j = 0 ; j < len ; j++) {
+        fft_complex[j] = 2 * (sqrt(fft_complex[j * 2 + 0] * fft_complex[j * 2 + 0] + fft_complex[j * 2 + 1] * fft_complex[j * 2 + 1])) / (len / 2);
+    }
+    fft_complex[0] = fft_complex[0] / 2;
+    memcpy(fft, fft_complex, (len / 2) * sizeof(float));
+}
+
+// FFTMagnitude() (real path, cached window) bin by bin against the original algorithm
+static int test_fft_magnitude(void)
+{
+    int failed = 0;
+    FFTInit();
+    for (int len = 32 ; len <= MAX_SIGNAL_LENGHT ; len *= 2) {
+        generate_signal(signal, len);
+        fft_magnitude_reference(signal, fft_cplx, len);
+        if (!FFTMagnitude(signal, fft_real, len)) {
+            printf("Error: FFTMagnitude N = %i rejected\n", len);
+            failed++;
+            continue;
+        }
+        for (int k = 0 ; k < len / 2 ; k++) {
+            if (fabsf(fft_cplx[k] - fft_real[k]) > 1e-4f) {
+                printf("Error: FFTMagnitude N = %i bin %i: %f != %f\n", len, k, fft_real[k], fft_cplx[k]);
+                failed++;
+                break;
+            }
+        }
+    }
+    // Invalid lengths are reported and leave a zero output, not a previous spectrum
+    static float fft_out[MAX_SIGNAL_LENGHT];
+    const uint16_t invalid[] = {0, 2, 100, 3000, 2 * MAX_SIGNAL_LENGHT};
+    for (int i = 0 ; i < (int)(sizeof(invalid) / sizeof(invalid[0])) ; i++) {
+        for (int k = 0 ; k < MAX_SIGNAL_LENGHT ; k++) {
+            fft_out[k] = 1;
+        }
+        bool ok = FFTMagnitude(signal, fft_out, invalid[i]);
+        for (int k = 0 ; k < invalid[i] / 2 ; k++) {
+            ok = ok || (fft_out[k] != 0);
+        }
+        if (ok) {
+            printf("Error: FFTMagnitude N = %i not rejected\n", invalid[i]);
+            failed++;
+        }
+    }
+    return failed;
+}
+
+// Output modes against the exact magnitude: cost and error bound of each one
+static int test_fft_outputs(void)
+{
+    int failed = 0;
+    int len = 1024;
+    const char *names[] = {"magnitude", "power", "fast magnitude", "dB"};
+    fft_plan_t plan;
+    FFTPlanCreateReal(&plan, len, FFT_WINDOW_HANN);
+    generate_signal(signal, len);
+    FFTPlanSpectrum(&plan, signal, fft_real, FFT_OUTPUT_MAGNITUDE);
+    float peak = 0;
+    for (int k = 0 ; k < len / 2 ; k++) {
+        peak = fmaxf(peak, fft_real[k]);
+    }
+    uint32_t cycles[FFT_OUTPUT_DB + 1];
+    float error[FFT_OUTPUT_DB + 1];
+    for (int mode = FFT_OUTPUT_MAGNITUDE ; mode <= FFT_OUTPUT_DB ; mode++) {
+        cycles[mode] = UINT32_MAX;
+        for (int r = 0 ; r < TEST_REPEAT ; r++) {
+            uint32_t start = dsp_get_cpu_cycle_count();
+            FFTPlanSpectrum(&plan, signal, fft_cplx, mode);
+            uint32_t end = dsp_get_cpu_cycle_count();
+            if ((end - start) < cycles[mode]) {
+                cycles[mode] = end - start;
+            }
+        }
+        // Relative error for power and magnitudes, absolute error in dB (bins above -120 dB of the peak)
+        error[mode] = 0;
+        for (int k = 0 ; k < len / 2 ; k++) {
+            double mag = fft_real[k];
+            if (mag < peak * 1e-6f) {
+                continue;
+            }
+            switch (mode) {
+            case FFT_OUTPUT_MAGNITUDE:
+            case FFT_OUTPUT_MAGNITUDE_FAST:
+                error[mode] = fmaxf(error[mode], fabs(fft_cplx[k] - mag) / mag);
+                break;
+            case FFT_OUTPUT_POWER:
+                error[mode] = fmaxf(error[mode], fabs(fft_cplx[k] - mag * mag) / (mag * mag));
+                break;
+            case FFT_OUTPUT_DB:
+                error[mode] = fmaxf(error[mode], fabs(fft_cplx[k] - 20 * log10(mag)));
+                break;
+            }
+        }
+    }
+    // Power is the common part of every output, the rest is the cost of the conversion
+    const float bound[] = {0, 1e-6f, 0.07f, 0.005f};
+    printf("Output (N = %i) | cycles | conversion cycles/bin | max error\n", len);
+    for (int mode = FFT_OUTPUT_MAGNITUDE ; mode <= FFT_OUTPUT_DB ; mode++) {
+        printf("%-14s | %6u | %21.2f | %e%s\n", names[mode], (unsigned)cycles[mode],
+               ((float)cycles[mode] - cycles[FFT_OUTPUT_POWER]) / (len / 2), error[mode], mode == FFT_OUTPUT_DB ? " dB" : "");
+        if (error[mode] > bound[mode]) {
+            printf("Error: %s output out of bounds\n", names[mode]);
+            failed++;
+        }
+    }
+    FFTPlanDestroy(&plan);
+    return failed;
+}
+
+int test_fft(void)
+{
+    int failed = 0;
+    failed += test_fft_real();
+    failed += test_fft_magnitude();
+    failed += test_fft_outputs();
+    if (failed == 0) {
+        printf("FFT test Pass!\n");
+    }
+    return failed;
+}
@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "dsp_common.h"
+#include "fft.h"
+#include "fft_q15.h"
+
+#define TEST_REPEAT     16
+#define ADC_OFFSET      2048
+#define ADC_MAX         4095
+
+static uint16_t adc[MAX_SIGNAL_LENGHT];
+static float signal[MAX_SIGNAL_LENGHT];
+static float fft_f32[MAX_SIGNAL_LENGHT / 2];
+static uint16_t fft_q15[MAX_SIGNAL_LENGHT / 2];
+
+// 12 bit ADC frame: offset, full scale tone, small tone and noise
+static void generate_adc(uint16_t *x, int len)
+{
+    for (int i = 0 ; i < len ; i++) {
+        float v = ADC_OFFSET + 1800 * sinf(2 * M_PI * 0.05f * i) + 60 * cosf(2 * M_PI * 0.21f * i)
+                  + 4 * ((float)rand() / RAND_MAX - 0.5f);
+        x[i] = v < 0 ? 0 : (v > ADC_MAX ? ADC_MAX : (uint16_t)lroundf(v));
+    }
+}
+
+static int test_fft_q15_mode(fft_q15_magnitude_t mode, const char *name, float max_error)
+{
+    int failed = 0;
+    printf("%s\n", name);
+    printf("  N  | max error (rel. to peak) | float cycles | q15 cycles\n");
+    for (int len = 256 ; len <= MAX_SIGNAL_LENGHT ; len *= 2) {
+        fft_plan_t plan_f32;
+        fft_q15_plan_t plan_q15;
+        if (!FFTPlanCreateReal(&plan_f32, len, FFT_WINDOW_HANN) || !FFTQ15PlanCreate(&plan_q15, len, FFT_WINDOW_HANN, mode)) {
+            printf("Error creating plans for N = %i\n", len);
+            return 1;
+        }
+        generate_adc(adc, len);
+
+        uint32_t cycles_f32 = UINT32_MAX;
+        uint32_t cycles_q15 = UINT32_MAX;
+        int8_t exponent = 0;
+        for (int r = 0 ; r < TEST_REPEAT ; r++) {
+            // Float path includes the conversion and mean removal the Q15 path does internally
+            uint32_t start = dsp_get_cpu_cycle_count();
+            float mean = 0;
+            for (int i = 0 ; i < len ; i++) {
+                mean += adc[i];
+            }
+            mean /= len;
+            for (int i = 0 ; i < len ; i++) {
+                signal[i] = adc[i] - mean;
+            }
+            FFTPlanMagnitude(&plan_f32, signal, fft_f32);
+            uint32_t end = dsp_get_cpu_cycle_count();
+            if ((end - start) < cycles_f32) {
+                cycles_f32 = end - start;
+            }
+            start = dsp_get_cpu_cycle_count();
+            exponent = FFTQ15Magnitude(&plan_q15, adc, fft_q15);
+            end = dsp_get_cpu_cycle_count();
+            if ((end - start) < cycles_q15) {
+                cycles_q15 = end - start;
+            }
+        }
+
+        float peak = 0;
+        float error = 0;
+        for (int k = 0 ; k < len / 2 ; k++) {
+            peak = fmaxf(peak, fft_f32[k]);
+            error = fmaxf(error, fabsf(fft_f32[k] - ldexpf(fft_q15[k], exponent)));
+        }
+        printf("%4i | %24e | %12u | %10u\n", len, error / peak, (unsigned)cycles_f32, (unsigned)cycles_q15);
+        if (error / peak > max_error) {
+            printf("Error: Q15 spectrum differs from float spectrum for N = %i\n", len);
+            failed++;
+        }
+        FFTPlanDestroy(&plan_f32);
+        FFTQ15PlanDestroy(&plan_q15);
+    }
+    return failed;
+}
+
+int test_fft_q15(void)
+{
+    int failed = 0;
+    failed += test_fft_q15_mode(FFT_Q15_MAG_ISQRT, "Q15 FFT, integer square root", 2e-3f);
+    failed += test_fft_q15_mode(FFT_Q15_MAG_ALPHA_MAX_BETA_MIN, "Q15 FFT, alpha max beta min", 4.5e-2f);
+    if (failed == 0) {
+        printf("FFT Q15 test Pass!\n");
+    }
+    return failed;
+}
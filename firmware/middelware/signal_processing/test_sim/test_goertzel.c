@@ -0,0 +1,156 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "dsp_common.h"
+#include "fft.h"
+#include "goertzel.h"
+
+#define SAMPLE_FREC     1000.0f
+#define BLOCK_LENGHT    500
+#define N_BINS          3
+#define BENCH_BINS      8
+
+static float signal[MAX_SIGNAL_LENGHT];
+static int16_t signal_q15[MAX_SIGNAL_LENGHT];
+static float fft[MAX_SIGNAL_LENGHT / 2];
+
+static void generate_signal(int len)
+{
+    for (int i = 0 ; i < len ; i++) {
+        signal[i] = 0.5f * sinf(2 * M_PI * 50 / SAMPLE_FREC * i) + 0.2f * cosf(2 * M_PI * 150 / SAMPLE_FREC * i)
+                    + 0.1f + 0.01f * ((float)rand() / RAND_MAX - 0.5f);
+        signal_q15[i] = lroundf(signal[i] * 32767);
+    }
+}
+
+// Tone powers, sample by sample against block processing, and fixed point against float
+static int test_goertzel_power(void)
+{
+    const float frecs[N_BINS] = {50, 60, 150};
+    const float expected[N_BINS] = {0.25f, 0, 0.04f};
+    goertzel_t bank;
+    goertzel_t bank_sample;
+    goertzel_q15_t bank_q15;
+    GoertzelCreate(&bank, SAMPLE_FREC, frecs, N_BINS, BLOCK_LENGHT);
+    GoertzelCreate(&bank_sample, SAMPLE_FREC, frecs, N_BINS, BLOCK_LENGHT);
+    GoertzelQ15Create(&bank_q15, SAMPLE_FREC, frecs, N_BINS, BLOCK_LENGHT);
+    generate_signal(BLOCK_LENGHT);
+
+    // Block split in uneven chunks
+    int blocks = GoertzelProcess(&bank, signal, 123) + GoertzelProcess(&bank, &signal[123], BLOCK_LENGHT - 123);
+    int blocks_q15 = GoertzelQ15Process(&bank_q15, signal_q15, BLOCK_LENGHT);
+    int blocks_sample = 0;
+    for (int i = 0 ; i < BLOCK_LENGHT ; i++) {
+        blocks_sample += GoertzelUpdate(&bank_sample, signal[i]);
+    }
+    int failed = (blocks != 1) || (blocks_q15 != 1) || (blocks_sample != 1);
+    for (int k = 0 ; k < N_BINS ; k++) {
+        printf("Goertzel %5.1f Hz | power %f | sample by sample %f | Q15 %f | expected %f\n", frecs[k],
+               bank.power[k], bank_sample.power[k], bank_q15.power[k], expected[k]);
+        if ((fabsf(bank.power[k] - expected[k]) > 1e-3f) || (fabsf(bank_sample.power[k] - bank.power[k]) > 1e-5f)
+                || (fabsf(bank_q15.power[k] - bank.power[k]) > 1e-3f)) {
+            failed++;
+        }
+    }
+    GoertzelDestroy(&bank);
+    GoertzelDestroy(&bank_sample);
+    GoertzelQ15Destroy(&bank_q15);
+    if (failed) {
+        printf("Error: Goertzel powers out of range\n");
+    }
+    return failed;
+}
+
+// Power line bins at a high sample rate over a long block: the coefficients are close to 2
+// and the fixed point ones must resolve bins 1 Hz apart
+#define LINE_SAMPLE_FREC    8000.0f
+#define LINE_BLOCK_LENGHT   8000
+#define LINE_BINS           3
+
+static int test_goertzel_line(void)
+{
+    const float frecs[LINE_BINS] = {50, 51, 5};
+    const float expected[LINE_BINS] = {0.25f, 0, 0.01f};
+    goertzel_t bank;
+    goertzel_q15_t bank_q15;
+    GoertzelCreate(&bank, LINE_SAMPLE_FREC, frecs, LINE_BINS, LINE_BLOCK_LENGHT);
+    GoertzelQ15Create(&bank_q15, LINE_SAMPLE_FREC, frecs, LINE_BINS, LINE_BLOCK_LENGHT);
+    for (int i = 0 ; i < LINE_BLOCK_LENGHT ; i++) {
+        float x = 0.5f * sinf(2 * M_PI * 50 / LINE_SAMPLE_FREC * i) + 0.1f * cosf(2 * M_PI * 5 / LINE_SAMPLE_FREC * i);
+        GoertzelUpdate(&bank, x);
+        GoertzelQ15Update(&bank_q15, lroundf(x * 32767));
+    }
+    int failed = 0;
+    for (int k = 0 ; k < LINE_BINS ; k++) {
+        printf("Goertzel %5.1f Hz, N = %i | power %f | Q15 %f | expected %f\n", frecs[k], LINE_BLOCK_LENGHT,
+               bank.power[k], bank_q15.power[k], expected[k]);
+        if ((fabsf(bank.power[k] - expected[k]) > 1e-3f) || (fabsf(bank_q15.power[k] - expected[k]) > 1e-3f)) {
+            failed++;
+        }
+    }
+    GoertzelDestroy(&bank);
+    GoertzelQ15Destroy(&bank_q15);
+    if (failed) {
+        printf("Error: Goertzel power line bins out of range\n");
+    }
+    return failed;
+}
+
+// Cycles of each bin against the real input FFT: below the crossover Goertzel is cheaper
+static int test_goertzel_crossover(void)
+{
+    float frecs[BENCH_BINS];
+    for (int k = 0 ; k < BENCH_BINS ; k++) {
+        frecs[k] = 50 + 37 * k;
+    }
+    printf("  N  | FFT cycles | Goertzel cycles/bin | crossover bins | Q15 cycles/bin | Q15 crossover bins\n");
+    for (int len = 256 ; len <= MAX_SIGNAL_LENGHT ; len *= 2) {
+        fft_plan_t plan;
+        goertzel_t bank;
+        goertzel_q15_t bank_q15;
+        FFTPlanCreateReal(&plan, len, FFT_WINDOW_RECT);
+        GoertzelCreate(&bank, SAMPLE_FREC, frecs, BENCH_BINS, len);
+        GoertzelQ15Create(&bank_q15, SAMPLE_FREC, frecs, BENCH_BINS, len);
+        generate_signal(len);
+
+        uint32_t cycles_fft = UINT32_MAX;
+        uint32_t cycles_f32 = UINT32_MAX;
+        uint32_t cycles_q15 = UINT32_MAX;
+        for (int r = 0 ; r < 8 ; r++) {
+            uint32_t start = dsp_get_cpu_cycle_count();
+            FFTPlanMagnitude(&plan, signal, fft);
+            uint32_t end = dsp_get_cpu_cycle_count();
+            cycles_fft = (end - start) < cycles_fft ? (end - start) : cycles_fft;
+            start = dsp_get_cpu_cycle_count();
+            GoertzelProcess(&bank, signal, len);
+            end = dsp_get_cpu_cycle_count();
+            cycles_f32 = (end - start) < cycles_f32 ? (end - start) : cycles_f32;
+            start = dsp_get_cpu_cycle_count();
+            GoertzelQ15Process(&bank_q15, signal_q15, len);
+            end = dsp_get_cpu_cycle_count();
+            cycles_q15 = (end - start) < cycles_q15 ? (end - start) : cycles_q15;
+        }
+        float per_bin = (float)cycles_f32 / BENCH_BINS;
+        float per_bin_q15 = (float)cycles_q15 / BENCH_BINS;
+        printf("%4i | %10u | %19.0f | %14.1f | %14.0f | %18.1f\n", len, (unsigned)cycles_fft, per_bin,
+               cycles_fft / per_bin, per_bin_q15, cycles_fft / per_bin_q15);
+        FFTPlanDestroy(&plan);
+        GoertzelDestroy(&bank);
+        GoertzelQ15Destroy(&bank_q15);
+    }
+    return 0;
+}
+
+int test_goertzel(void)
+{
+    int failed = 0;
+    failed += test_goertzel_power();
+    failed += test_goertzel_line();
+    failed += test_goertzel_crossover();
+    if (failed == 0) {
+        printf("Goertzel test Pass!\n");
+    }
+    return failed;
+}
@@ -0,0 +1,165 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "dsp_common.h"
+#include "dsps_biquad.h"
+#include "iir_filter.h"
+
+#define TEST_REPEAT     16
+#define TEST_LENGHT     1024
+#define SAMPLE_FREC     1000.0f
+
+static float signal[TEST_LENGHT];
+static float out_chain[TEST_LENGHT];
+static float out_cascade[TEST_LENGHT];
+
+static void generate_signal(float *x, int len)
+{
+    for (int i = 0 ; i < len ; i++) {
+        x[i] = sinf(2 * M_PI * 20 / SAMPLE_FREC * i) + 0.5f * sinf(2 * M_PI * 300 / SAMPLE_FREC * i)
+               + 0.05f * ((float)rand() / RAND_MAX - 0.5f);
+    }
+}
+
+// Fused cascade against one dsps_biquad_f32 pass per section (previous LowPassFilter path)
+static int test_iir_cascade(filter_type_t type, const char *name)
+{
+    iir_filter_t chain;
+    iir_filter_t cascade;
+    IIRFilterCreate(&chain, ORDER_8 / 2);
+    IIRFilterCreate(&cascade, ORDER_8 / 2);
+    IIRFilterAddButterworth(&chain, type, SAMPLE_FREC, 50, ORDER_8);
+    IIRFilterAddButterworth(&cascade, type, SAMPLE_FREC, 50, ORDER_8);
+    generate_signal(signal, TEST_LENGHT);
+
+    uint32_t cycles_chain = UINT32_MAX;
+    uint32_t cycles_cascade = UINT32_MAX;
+    float error = 0;
+    for (int r = 0 ; r < TEST_REPEAT ; r++) {
+        uint32_t start = dsp_get_cpu_cycle_count();
+        dsps_biquad_f32(signal, out_chain, TEST_LENGHT, chain.coeffs, chain.delay);
+        for (int k = 1 ; k < chain.n_sections ; k++) {
+            dsps_biquad_f32(out_chain, out_chain, TEST_LENGHT, &chain.coeffs[5 * k], &chain.delay[2 * k]);
+        }
+        uint32_t end = dsp_get_cpu_cycle_count();
+        if ((end - start) < cycles_chain) {
+            cycles_chain = end - start;
+        }
+        start = dsp_get_cpu_cycle_count();
+        IIRFilterApply(&cascade, signal, out_cascade, TEST_LENGHT);
+        end = dsp_get_cpu_cycle_count();
+        if ((end - start) < cycles_cascade) {
+            cycles_cascade = end - start;
+        }
+        for (int i = 0 ; i < TEST_LENGHT ; i++) {
+            error = fmaxf(error, fabsf(out_chain[i] - out_cascade[i]));
+        }
+    }
+    printf("%s 8th order | max error %e | 4 x dsps_biquad_f32: %.2f cycles/sample | cascade: %.2f cycles/sample\n",
+           name, error, (float)cycles_chain / TEST_LENGHT, (float)cycles_cascade / TEST_LENGHT);
+    IIRFilterDestroy(&chain);
+    IIRFilterDestroy(&cascade);
+    if (error > 1e-5f) {
+        printf("Error: %s cascade differs from dsps_biquad_f32 chain\n", name);
+        return 1;
+    }
+    return 0;
+}
+
+// Q31 cascade with the same design quantized to Q30 coefficients
+static int test_iir_cascade_q31(void)
+{
+    static int32_t signal_q31[TEST_LENGHT];
+    static int32_t out_q31[TEST_LENGHT];
+    iir_filter_t filter;
+    int32_t coeffs_q30[5 * ORDER_8 / 2];
+    int32_t w_q31[2 * (ORDER_8 / 2 + 1)] = {0};
+    IIRFilterCreate(&filter, ORDER_8 / 2);
+    IIRFilterAddButterworth(&filter, FILTER_LOW_PASS, SAMPLE_FREC, 50, ORDER_8);
+    for (int k = 0 ; k < 5 * filter.n_sections ; k++) {
+        coeffs_q30[k] = lroundf(filter.coeffs[k] * (1 << 30));
+    }
+    generate_signal(signal, TEST_LENGHT);
+    for (int i = 0 ; i < TEST_LENGHT ; i++) {
+        signal_q31[i] = lroundf(signal[i] * 0.5f * INT32_MAX);
+    }
+
+    IIRFilterApply(&filter, signal, out_cascade, TEST_LENGHT);
+    uint32_t start = dsp_get_cpu_cycle_count();
+    dsps_biquad_cascade_s32(signal_q31, out_q31, TEST_LENGHT, filter.n_sections, coeffs_q30, w_q31);
+    uint32_t end = dsp_get_cpu_cycle_count();
+    float error = 0;
+    for (int i = 0 ; i < TEST_LENGHT ; i++) {
+        error = fmaxf(error, fabsf(out_q31[i] / (0.5f * INT32_MAX) - out_cascade[i]));
+    }
+    printf("Q31 8th order | max error %e | cascade: %.2f cycles/sample\n", error, (float)(end - start) / TEST_LENGHT);
+    IIRFilterDestroy(&filter);
+    if (error > 1e-4f) {
+        printf("Error: Q31 cascade differs from float cascade\n");
+        return 1;
+    }
+    return 0;
+}
+
+// Q31 cascade of more than BIQUAD_CASCADE_FUSED sections (two groups) against one section at a
+// time, each with its own delay line, over two blocks: same integer arithmetic, same output
+#define TEST_Q31_SECTIONS   6
+
+static int test_iir_cascade_q31_sections(void)
+{
+    static int32_t signal_q31[TEST_LENGHT];
+    static int32_t out_q31[TEST_LENGHT];
+    static int32_t out_ref[TEST_LENGHT];
+    iir_filter_t filter;
+    int32_t coeffs_q30[5 * TEST_Q31_SECTIONS];
+    int32_t w_q31[2 * (TEST_Q31_SECTIONS + 1)] = {0};
+    int32_t w_ref[TEST_Q31_SECTIONS][4] = {{0}};
+    // 8th order low pass followed by a 4th order high pass: 6 sections
+    IIRFilterCreate(&filter, TEST_Q31_SECTIONS);
+    IIRFilterAddButterworth(&filter, FILTER_LOW_PASS, SAMPLE_FREC, 50, ORDER_8);
+    IIRFilterAddButterworth(&filter, FILTER_HIGH_PASS, SAMPLE_FREC, 5, ORDER_4);
+    for (int k = 0 ; k < 5 * filter.n_sections ; k++) {
+        coeffs_q30[k] = lroundf(filter.coeffs[k] * (1 << 30));
+    }
+    generate_signal(signal, TEST_LENGHT);
+    for (int i = 0 ; i < TEST_LENGHT ; i++) {
+        signal_q31[i] = lroundf(signal[i] * 0.5f * INT32_MAX);
+    }
+
+    int64_t error = 0;
+    for (int b = 0 ; b < TEST_LENGHT ; b += TEST_LENGHT / 2) {
+        dsps_biquad_cascade_s32(&signal_q31[b], &out_q31[b], TEST_LENGHT / 2, TEST_Q31_SECTIONS, coeffs_q30, w_q31);
+        dsps_biquad_cascade_s32(&signal_q31[b], &out_ref[b], TEST_LENGHT / 2, 1, coeffs_q30, w_ref[0]);
+        for (int k = 1 ; k < TEST_Q31_SECTIONS ; k++) {
+            dsps_biquad_cascade_s32(&out_ref[b], &out_ref[b], TEST_LENGHT / 2, 1, &coeffs_q30[5 * k], w_ref[k]);
+        }
+    }
+    for (int i = 0 ; i < TEST_LENGHT ; i++) {
+        int64_t diff = (int64_t)out_q31[i] - out_ref[i];
+        if (llabs(diff) > error) {
+            error = llabs(diff);
+        }
+    }
+    printf("Q31 %i sections | max difference %lld LSB against one section at a time\n", TEST_Q31_SECTIONS, (long long)error);
+    IIRFilterDestroy(&filter);
+    if (error != 0) {
+        printf("Error: Q31 cascade of %i sections differs from one section at a time\n", TEST_Q31_SECTIONS);
+        return 1;
+    }
+    return 0;
+}
+
+int test_iir(void)
+{
+    int failed = 0;
+    failed += test_iir_cascade(FILTER_LOW_PASS, "LPF");
+    failed += test_iir_cascade(FILTER_HIGH_PASS, "HPF");
+    failed += test_iir_cascade_q31();
+    failed += test_iir_cascade_q31_sections();
+    if (failed == 0) {
+        printf("IIR test Pass!\n");
+    }
+    return failed;
+}
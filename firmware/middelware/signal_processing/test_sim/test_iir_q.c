@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "dsp_common.h"
+#include "iir_filter.h"
+#include "iir_filter_q.h"
+
+#define TEST_LENGHT     2048
+#define SAMPLE_FREC     1000.0f
+#define ADC_OFFSET      2048
+#define ADC_MAX         4095
+
+static float signal[TEST_LENGHT];
+static float out_f32[TEST_LENGHT];
+static int16_t signal_q15[TEST_LENGHT];
+static int16_t out_q15[TEST_LENGHT];
+static int32_t signal_q31[TEST_LENGHT];
+static int32_t out_q31[TEST_LENGHT];
+
+// 12 bit ADC stream (offset removed) in Q15 and the same values in float
+static void generate_adc(void)
+{
+    for (int i = 0 ; i < TEST_LENGHT ; i++) {
+        float v = ADC_OFFSET + 1200 * sinf(2 * M_PI * 10 / SAMPLE_FREC * i) + 500 * sinf(2 * M_PI * 50 / SAMPLE_FREC * i)
+                  + 200 * sinf(2 * M_PI * 180 / SAMPLE_FREC * i) + 4 * ((float)rand() / RAND_MAX - 0.5f);
+        int32_t adc = v < 0 ? 0 : (v > ADC_MAX ? ADC_MAX : lroundf(v));
+        signal_q15[i] = (adc - ADC_OFFSET) << 4;
+        signal_q31[i] = (int32_t)signal_q15[i] << 16;
+        signal[i] = signal_q15[i] / 32768.0f;
+    }
+}
+
+// Max error against the float filter, relative to full scale. Q31 filters are more
+// accurate than the float reference, their bound is the rounding noise of the reference.
+static int test_iir_q_design(iir_filter_t *design, iir_filter_q_format_t format, bool noise_shaping, const char *name, float max_error)
+{
+    iir_filter_q_t filter;
+    if (!IIRFilterQCreate(&filter, design->n_sections, format, noise_shaping) || !IIRFilterQQuantize(&filter, design)) {
+        printf("Error quantizing %s\n", name);
+        return 1;
+    }
+    IIRFilterReset(design);
+    IIRFilterApply(design, signal, out_f32, TEST_LENGHT);
+
+    float error = 0;
+    uint32_t start = dsp_get_cpu_cycle_count();
+    if (format == IIR_FILTER_Q15) {
+        IIRFilterQ15Apply(&filter, signal_q15, out_q15, TEST_LENGHT);
+    } else {
+        IIRFilterQ31Apply(&filter, signal_q31, out_q31, TEST_LENGHT);
+    }
+    uint32_t end = dsp_get_cpu_cycle_count();
+    for (int i = 0 ; i < TEST_LENGHT ; i++) {
+        float y = (format == IIR_FILTER_Q15) ? out_q15[i] / 32768.0f : out_q31[i] / 2147483648.0f;
+        error = fmaxf(error, fabsf(y - out_f32[i]));
+    }
+    printf("%-32s | max error %e | %.2f cycles/sample\n", name, error, (float)(end - start) / TEST_LENGHT);
+    IIRFilterQDestroy(&filter);
+    if (error > max_error) {
+        printf("Error: %s differs from float filter\n", name);
+        return 1;
+    }
+    return 0;
+}
+
+int test_iir_q(void)
+{
+    int failed = 0;
+    iir_filter_t design;
+    generate_adc();
+
+    IIRFilterCreate(&design, 4);
+    IIRFilterAddButterworth(&design, FILTER_LOW_PASS, SAMPLE_FREC, 30, ORDER_4);
+    failed += test_iir_q_design(&design, IIR_FILTER_Q15, false, "Q15 LPF 4th order 30 Hz", 2e-3f);
+    failed += test_iir_q_design(&design, IIR_FILTER_Q15, true, "Q15 LPF 4th order 30 Hz, shaped", 1e-3f);
+    failed += test_iir_q_design(&design, IIR_FILTER_Q31, false, "Q31 LPF 4th order 30 Hz", 5e-5f);
+    IIRFilterDestroy(&design);
+
+    IIRFilterCreate(&design, 4);
+    IIRFilterAddSection(&design, FILTER_NOTCH, SAMPLE_FREC, 50, 2);
+    IIRFilterAddButterworth(&design, FILTER_HIGH_PASS, SAMPLE_FREC, 20, ORDER_2);
+    failed += test_iir_q_design(&design, IIR_FILTER_Q15, true, "Q15 notch 50 Hz + HPF 20 Hz, shaped", 2e-3f);
+    failed += test_iir_q_design(&design, IIR_FILTER_Q31, false, "Q31 notch 50 Hz + HPF 20 Hz", 5e-5f);
+    IIRFilterDestroy(&design);
+
+    IIRFilterCreate(&design, 4);
+    IIRFilterAddButterworth(&design, FILTER_LOW_PASS, SAMPLE_FREC, 5, ORDER_8);
+    failed += test_iir_q_design(&design, IIR_FILTER_Q31, false, "Q31 LPF 8th order 5 Hz", 1e-4f);
+    IIRFilterDestroy(&design);
+
+    // More sections than one group of the Q31 cascade kernel
+    IIRFilterCreate(&design, 6);
+    IIRFilterAddSection(&design, FILTER_NOTCH, SAMPLE_FREC, 50, 2);
+    IIRFilterAddButterworth(&design, FILTER_LOW_PASS, SAMPLE_FREC, 100, ORDER_8);
+    failed += test_iir_q_design(&design, IIR_FILTER_Q31, false, "Q31 notch 50 Hz + LPF 8th order", 5e-5f);
+    IIRFilterAddButterworth(&design, FILTER_HIGH_PASS, SAMPLE_FREC, 20, ORDER_2);
+    failed += test_iir_q_design(&design, IIR_FILTER_Q31, false, "Q31 notch + LPF 8th + HPF 20 Hz", 5e-5f);
+    IIRFilterDestroy(&design);
+
+    if (failed == 0) {
+        printf("IIR fixed point test Pass!\n");
+    }
+    return failed;
+}
@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "dsp_common.h"
+#include "kalman_filter.h"
+
+#define TEST_LENGHT     1000
+
+// Normal noise of unit variance (sum of 12 uniforms)
+static float noise(void)
+{
+    float sum = 0;
+    for (int i = 0 ; i < 12 ; i++) {
+        sum += (float)rand() / RAND_MAX;
+    }
+    return sum - 6;
+}
+
+typedef struct {
+    const char *name;
+    kalman_model_t model;
+    float sample_period;
+    float process_noise;
+    float noise_std;
+    uint8_t frac_bits;
+    float value[3];         // Initial value, rate and acceleration of the true signal
+    float max_rms_ratio;    // Filtered error RMS / reading error RMS
+    float max_rate_error[3];    // Final rate and acceleration errors
+} kalman_case_t;
+
+// Float and fixed point filters on readings of a known trajectory (integer readings, as
+// HX711_read() and HcSr04ReadDistanceInCentimeters()): the error of the filtered value
+// against the trajectory must be well below the reading error, and the final states close
+// to the true ones
+static int test_kalman_case(const kalman_case_t *c)
+{
+    int n_states = c->model;
+    kalman_filter_t kf;
+    kalman_filter_q_t kf_q;
+    float var = c->noise_std * c->noise_std;
+    if (!KalmanFilterCreate(&kf, c->model, c->sample_period, c->process_noise, var) ||
+            !KalmanFilterQCreate(&kf_q, c->model, c->sample_period, c->process_noise, var, c->frac_bits)) {
+        printf("Error creating %s\n", c->name);
+        return 1;
+    }
+
+    float sq_reading = 0;
+    float sq_float = 0;
+    float sq_fixed = 0;
+    uint32_t cycles_float = 0;
+    uint32_t cycles_fixed = 0;
+    float truth[3] = {0, 0, 0};
+    for (int n = 0 ; n < TEST_LENGHT ; n++) {
+        float t = n * c->sample_period;
+        truth[0] = c->value[0] + c->value[1] * t + 0.5f * c->value[2] * t * t;
+        truth[1] = c->value[1] + c->value[2] * t;
+        truth[2] = c->value[2];
+        int32_t reading = lroundf(truth[0] + c->noise_std * noise());
+        if (n == 0) {
+            KalmanFilterReset(&kf, reading);
+            KalmanFilterQReset(&kf_q, reading);
+        }
+        uint32_t start = dsp_get_cpu_cycle_count();
+        float filtered = KalmanFilterUpdate(&kf, reading);
+        cycles_float += dsp_get_cpu_cycle_count() - start;
+        start = dsp_get_cpu_cycle_count();
+        int32_t filtered_q = KalmanFilterQUpdate(&kf_q, reading);
+        cycles_fixed += dsp_get_cpu_cycle_count() - start;
+        // Error after the convergence (first tenth of the readings)
+        if (n >= TEST_LENGHT / 10) {
+            sq_reading += (reading - truth[0]) * (reading - truth[0]);
+            sq_float += (filtered - truth[0]) * (filtered - truth[0]);
+            sq_fixed += (filtered_q - truth[0]) * (filtered_q - truth[0]);
+        }
+    }
+    float ratio = sqrtf(sq_float / sq_reading);
+    float ratio_q = sqrtf(sq_fixed / sq_reading);
+    float state[3];
+    float state_q[3];
+    KalmanFilterGetState(&kf, state);
+    KalmanFilterQGetState(&kf_q, state_q);
+
+    int failed = 0;
+    printf("%-30s | rms ratio %.3f, Q %.3f | %.1f cycles/update, Q %.1f\n", c->name, ratio, ratio_q,
+           (float)cycles_float / TEST_LENGHT, (float)cycles_fixed / TEST_LENGHT);
+    if ((ratio > c->max_rms_ratio) || (ratio_q > c->max_rms_ratio)) {
+        printf("Error: %s filtered error\n", c->name);
+        failed++;
+    }
+    for (int i = 1 ; i < n_states ; i++) {
+        printf("    state %i: true %f, float %f, Q %f\n", i, truth[i], state[i], state_q[i]);
+        if ((fabsf(state[i] - truth[i]) > c->max_rate_error[i]) || (fabsf(state_q[i] - truth[i]) > c->max_rate_error[i])) {
+            printf("Error: %s state %i\n", c->name, i);
+            failed++;
+        }
+    }
+    KalmanFilterDestroy(&kf);
+    KalmanFilterQDestroy(&kf_q);
+    return failed;
+}
+
+int test_kalman(void)
+{
+    const kalman_case_t cases[] = {
+        // HX711 at 10 Hz, constant load, 24 bit counts
+        {"HX711 weight, random walk", KALMAN_RANDOM_WALK, 0.1f, 100.0f, 200.0f, 6, {123456, 0, 0}, 0.3f, {0, 0, 0}},
+        // HC-SR04 at 20 Hz, target moving at 20 cm/s, readings in cm
+        {"HC-SR04 distance, const. vel.", KALMAN_CONSTANT_VELOCITY, 0.05f, 1.0f, 1.0f, 12, {50, 20, 0}, 0.5f, {0, 2, 0}},
+        // HC-SR04 at 20 Hz, accelerating target
+        {"HC-SR04 distance, const. acc.", KALMAN_CONSTANT_ACCELERATION, 0.05f, 1.0f, 1.0f, 12, {50, 5, 0.5f}, 0.6f, {0, 2, 1}},
+    };
+    int failed = 0;
+    for (unsigned i = 0 ; i < sizeof(cases) / sizeof(cases[0]) ; i++) {
+        failed += test_kalman_case(&cases[i]);
+    }
+    if (failed == 0) {
+        printf("Kalman test Pass!\n");
+    }
+    return failed;
+}
@@ -0,0 +1,583 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <new>
+
+#include "dsp_common.h"
+#include "mat.h"
+#include "mat_fixed.h"
+#include "mat_decomp.h"
+
+// Every heap allocation of the test program goes through these, so the allocations of an
+// operation are the difference of the counter around it (test_ekf.cpp uses it too)
+volatile uint32_t heap_allocations = 0;
+
+void *operator new(size_t size)
+{
+    heap_allocations++;
+    void *p = malloc(size ? size : 1);
+    if (p == NULL) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+    free(p);
+}
+
+#define N_STATES    13
+#define N_NOISE     18
+
+template <int Rows, int Cols>
+static void fill(dspm::MatFixed<Rows, Cols> &A, dspm::Mat &B)
+{
+    for (int i = 0 ; i < Rows ; i++) {
+        for (int j = 0 ; j < Cols ; j++) {
+            A(i, j) = (float)rand() / RAND_MAX - 0.5f;
+            B(i, j) = A(i, j);
+        }
+    }
+}
+
+static void fill(dspm::Mat &A)
+{
+    for (int i = 0 ; i < A.rows ; i++) {
+        for (int j = 0 ; j < A.cols ; j++) {
+            A(i, j) = (float)rand() / RAND_MAX - 0.5f;
+        }
+    }
+}
+
+static float max_diff(const dspm::Mat &A, const dspm::Mat &B)
+{
+    if ((A.rows != B.rows) || (A.cols != B.cols)) {
+        return INFINITY;
+    }
+    float diff = 0;
+    for (int i = 0 ; i < A.rows ; i++) {
+        for (int j = 0 ; j < A.cols ; j++) {
+            diff = fmaxf(diff, fabsf(A(i, j) - B(i, j)));
+        }
+    }
+    return diff;
+}
+
+template <int Rows, int Cols>
+static float max_diff(const dspm::MatFixed<Rows, Cols> &A, const dspm::Mat &B)
+{
+    if ((B.rows != Rows) || (B.cols != Cols)) {
+        return INFINITY;
+    }
+    float diff = 0;
+    for (int i = 0 ; i < Rows ; i++) {
+        for (int j = 0 ; j < Cols ; j++) {
+            diff = fmaxf(diff, fabsf(A(i, j) - B(i, j)));
+        }
+    }
+    return diff;
+}
+
+// Same operator set as Mat, same results (same kernels), no heap memory
+static int test_mat_fixed_operators(void)
+{
+    int failed = 0;
+    dspm::MatFixed<3, 4> A;
+    dspm::MatFixed<3, 4> B;
+    dspm::MatFixed<4, 2> C;
+    dspm::MatFixed<4, 4> S;
+    dspm::Mat A_ref(3, 4);
+    dspm::Mat B_ref(3, 4);
+    dspm::Mat C_ref(4, 2);
+    dspm::Mat S_ref(4, 4);
+    fill(A, A_ref);
+    fill(B, B_ref);
+    fill(C, C_ref);
+    fill(S, S_ref);
+
+    uint32_t start = heap_allocations;
+    dspm::MatFixed<3, 4> sum = A + B;
+    dspm::MatFixed<3, 4> diff = A - B * 2.0f;
+    dspm::MatFixed<3, 2> prod = A * C;
+    dspm::MatFixed<4, 3> trans = A.t();
+    dspm::MatFixed<4, 4> power = S ^ 5;
+    dspm::MatFixed<3, 4> scaled = 0.5f * (A / 4.0f + 1.0f) - 2.0f;
+    dspm::MatFixed<3, 4> ratio = A / B;
+    dspm::MatFixed<3, 4> chained(A);
+    chained += B;
+    chained -= 1.0f;
+    chained *= S;
+    dspm::MatFixed<2, 2> blk = S.block<2, 2>(1, 2);
+    dspm::MatFixed<4, 4> eye = dspm::MatFixed<4, 4>::eye();
+    eye.Copy(blk, 2, 0);
+    uint32_t allocations = heap_allocations - start;
+
+    float err = 0;
+    err = fmaxf(err, max_diff(sum, A_ref + B_ref));
+    err = fmaxf(err, max_diff(diff, A_ref - B_ref * 2.0f));
+    err = fmaxf(err, max_diff(prod, A_ref * C_ref));
+    err = fmaxf(err, max_diff(trans, A_ref.t()));
+    err = fmaxf(err, max_diff(power, S_ref ^ 5));
+    err = fmaxf(err, max_diff(scaled, 0.5f * (A_ref / 4.0f + 1.0f) - 2.0f));
+    err = fmaxf(err, max_diff(ratio, A_ref / B_ref));
+    dspm::Mat chained_ref(A_ref);
+    chained_ref += B_ref;
+    chained_ref -= 1.0f;
+    chained_ref *= S_ref;
+    err = fmaxf(err, max_diff(chained, chained_ref));
+    err = fmaxf(err, max_diff(blk, S_ref.block(1, 2, 2, 2)));
+    dspm::Mat eye_ref = dspm::Mat::eye(4);
+    eye_ref.Copy(S_ref.block(1, 2, 2, 2), 2, 0);
+    err = fmaxf(err, max_diff(eye, eye_ref));
+    if (err > 1e-5f) {
+        printf("Error: MatFixed results differ from Mat by %e\n", err);
+        failed++;
+    }
+    if (allocations != 0) {
+        printf("Error: MatFixed operators made %u heap allocations\n", (unsigned)allocations);
+        failed++;
+    }
+
+    // Mat interoperability: a Mat view shares the data, a Mat converts to MatFixed
+    start = heap_allocations;
+    dspm::Mat view = S.view();
+    view *= 2.0f;
+    allocations = heap_allocations - start;
+    dspm::MatFixed<4, 4> back(S_ref * 2.0f);
+    if ((allocations != 0) || !(back == S)) {
+        printf("Error: MatFixed view() / MatFixed(Mat)\n");
+        failed++;
+    }
+    return failed;
+}
+
+// EKF covariance prediction P = F * P * F' + Q of a 13 states filter
+static int test_mat_fixed_covariance(void)
+{
+    dspm::MatFixed<N_STATES, N_STATES> F;
+    dspm::MatFixed<N_STATES, N_STATES> P;
+    dspm::MatFixed<N_STATES, N_STATES> Q;
+    dspm::Mat F_ref(N_STATES, N_STATES);
+    dspm::Mat P_ref(N_STATES, N_STATES);
+    dspm::Mat Q_ref(N_STATES, N_STATES);
+    fill(F, F_ref);
+    fill(P, P_ref);
+    fill(Q, Q_ref);
+
+    uint32_t start = heap_allocations;
+    uint32_t cycles = dsp_get_cpu_cycle_count();
+    P_ref = F_ref * P_ref * F_ref.t() + Q_ref;
+    uint32_t cycles_ref = dsp_get_cpu_cycle_count() - cycles;
+    uint32_t allocations_ref = heap_allocations - start;
+
+    start = heap_allocations;
+    cycles = dsp_get_cpu_cycle_count();
+    P = F * P * F.t() + Q;
+    uint32_t cycles_fixed = dsp_get_cpu_cycle_count() - cycles;
+    uint32_t allocations = heap_allocations - start;
+
+    printf("P = F * P * F' + Q, %ix%i | Mat: %u allocations, %u cycles | MatFixed: %u allocations, %u cycles\n",
+           N_STATES, N_STATES, (unsigned)allocations_ref, (unsigned)cycles_ref, (unsigned)allocations, (unsigned)cycles_fixed);
+    if ((max_diff(P, P_ref) > 1e-5f) || (allocations != 0)) {
+        printf("Error: MatFixed covariance prediction\n");
+        return 1;
+    }
+    return 0;
+}
+
+// Product computed element by element, reference of the expressions
+static dspm::Mat mult(const dspm::Mat &A, const dspm::Mat &B)
+{
+    dspm::Mat C(A.rows, B.cols);
+    for (int i = 0 ; i < A.rows ; i++) {
+        for (int j = 0 ; j < B.cols ; j++) {
+            float sum = 0;
+            for (int k = 0 ; k < A.cols ; k++) {
+                sum += A(i, k) * B(k, j);
+            }
+            C(i, j) = sum;
+        }
+    }
+    return C;
+}
+
+static dspm::Mat trans(const dspm::Mat &A)
+{
+    dspm::Mat T(A.cols, A.rows);
+    for (int i = 0 ; i < A.rows ; i++) {
+        for (int j = 0 ; j < A.cols ; j++) {
+            T(j, i) = A(i, j);
+        }
+    }
+    return T;
+}
+
+// Expressions against operations done one at a time, moves and aliasing
+static int test_mat_expr_operators(void)
+{
+    int failed = 0;
+    dspm::Mat A(5, 4);
+    dspm::Mat B(5, 4);
+    dspm::Mat C(4, 6);
+    dspm::Mat D(6, 3);
+    fill(A);
+    fill(B);
+    fill(C);
+    fill(D);
+
+    float err = 0;
+    dspm::Mat sum = 2 * A - B / 4.0f + 1.0f;
+    dspm::Mat sum_ref(A);
+    sum_ref *= 2;
+    for (int i = 0 ; i < B.length ; i++) {
+        sum_ref.data[i] += 1.0f - B.data[i] / 4.0f;
+    }
+    err = fmaxf(err, max_diff(sum, sum_ref));
+    err = fmaxf(err, max_diff(A * C * D, mult(mult(A, C), D)));
+    err = fmaxf(err, max_diff((A + B) * (C * D), mult(mult(A, C), D) + mult(mult(B, C), D)));
+    err = fmaxf(err, max_diff(A.t() * B, mult(trans(A), B)));
+    err = fmaxf(err, max_diff(A * B.t(), mult(A, trans(B))));
+    err = fmaxf(err, max_diff((A * C).t(), trans(mult(A, C))));
+
+    // Operands and destinations with padding (sub-matrices)
+    dspm::Mat big(8, 8);
+    fill(big);
+    dspm::Mat roi = big.getROI(1, 2, 4, 4);
+    dspm::Mat roi_ref = big.Get(1, 4, 2, 4);
+    err = fmaxf(err, max_diff(A * roi - B, mult(A, roi_ref) - B));
+    err = fmaxf(err, max_diff(roi * roi.t(), mult(roi_ref, trans(roi_ref))));
+    roi = roi_ref * 3 + roi_ref.t();
+    err = fmaxf(err, max_diff(big.Get(1, 4, 2, 4), roi_ref * 3 + trans(roi_ref)));
+
+    // Destination read by the expression
+    dspm::Mat S(4, 4);
+    fill(S);
+    dspm::Mat S_ref(S);
+    S = S * 2 + S;
+    err = fmaxf(err, max_diff(S, S_ref * 3));
+    S_ref = S;
+    S = S * S * S.t();
+    err = fmaxf(err, max_diff(S, mult(mult(S_ref, S_ref), trans(S_ref))));
+    S_ref = S;
+    S += S.t() * 2;
+    err = fmaxf(err, max_diff(S, S_ref + trans(S_ref) * 2));
+    if (err > 1e-5f) {
+        printf("Error: matrix expressions differ from the reference by %e\n", err);
+        failed++;
+    }
+
+    // One allocation for the destination, none for an existing one or a move
+    uint32_t start = heap_allocations;
+    dspm::Mat E = A * C * D + A * C * D;
+    uint32_t allocations = heap_allocations - start;
+    start = heap_allocations;
+    E = (A + B) * C * D - E;
+    E -= A * C * D;
+    dspm::Mat moved(std::move(E));
+    E = std::move(moved);
+    allocations += heap_allocations - start;
+    if ((allocations != 1) || (E.rows != 5) || (E.cols != 3)) {
+        printf("Error: matrix expressions made %u heap allocations\n", (unsigned)allocations);
+        failed++;
+    }
+
+    // Dimensions mismatch: same error result as before
+    dspm::Mat wrong = A * B;
+    if ((wrong.rows != 1) || (wrong.cols != 1)) {
+        printf("Error: matrix expression with wrong dimensions\n");
+        failed++;
+    }
+    return failed;
+}
+
+// ekf::CovariancePrediction(): P = f * P * f' + dt^2 * G * Q * G', with f = F * dt + I
+static int test_mat_expr_covariance(void)
+{
+    const float dt = 0.01f;
+    dspm::Mat F(N_STATES, N_STATES);
+    dspm::Mat G(N_STATES, N_NOISE);
+    dspm::Mat Q(N_NOISE, N_NOISE);
+    dspm::Mat P(N_STATES, N_STATES);
+    fill(F);
+    fill(G);
+    fill(Q);
+    fill(P);
+    dspm::Mat P_ref(P);
+
+    // One result matrix per operator, as the operators did before the expressions
+    uint32_t start = heap_allocations;
+    uint32_t cycles = dsp_get_cpu_cycle_count();
+    {
+        dspm::Mat Fdt(F * dt);
+        dspm::Mat eye = dspm::Mat::eye(N_STATES);
+        dspm::Mat f(Fdt + eye);
+        dspm::Mat f_t(f.t());
+        dspm::Mat fP(f * P_ref);
+        dspm::Mat fPf(fP * f_t);
+        dspm::Mat GQ(G * Q);
+        dspm::Mat G_t(G.t());
+        dspm::Mat GQG(GQ * G_t);
+        dspm::Mat noise(GQG * (dt * dt));
+        dspm::Mat result(fPf + noise);
+        P_ref = result;
+    }
+    uint32_t cycles_ref = dsp_get_cpu_cycle_count() - cycles;
+    uint32_t allocations_ref = heap_allocations - start;
+
+    start = heap_allocations;
+    cycles = dsp_get_cpu_cycle_count();
+    {
+        dspm::Mat f = F * dt + dspm::Mat::eye(N_STATES);
+        P = f * P * f.t() + (dt * dt) * (G * Q * G.t());
+    }
+    uint32_t cycles_expr = dsp_get_cpu_cycle_count() - cycles;
+    uint32_t allocations = heap_allocations - start;
+
+    printf("EKF covariance prediction, %i states | operator by operator: %u allocations, %u cycles | expressions: %u allocations, %u cycles\n",
+           N_STATES, (unsigned)allocations_ref, (unsigned)cycles_ref, (unsigned)allocations, (unsigned)cycles_expr);
+    if ((max_diff(P, P_ref) > 1e-5f) || (allocations >= allocations_ref)) {
+        printf("Error: covariance prediction with expressions\n");
+        return 1;
+    }
+    return 0;
+}
+
+// Well conditioned matrix: random plus a dominant diagonal
+static void fill_regular(dspm::Mat &A)
+{
+    fill(A);
+    for (int i = 0 ; i < A.rows ; i++) {
+        A(i, i) += A.rows;
+    }
+}
+
+// Symmetric positive definite matrix: M * M' + I
+static void fill_spd(dspm::Mat &A)
+{
+    dspm::Mat M(A.rows, A.cols);
+    fill(M);
+    A = M * M.t() + dspm::Mat::eye(A.rows);
+}
+
+// Determinant by cofactor expansion of the first row (the former Mat::det()), reference
+static float det_cofactor(const float *A, int n)
+{
+    if (n == 1) {
+        return A[0];
+    }
+    float minor[(N_STATES - 1) * (N_STATES - 1)];
+    float D = 0;
+    float sign = 1;
+    for (int f = 0 ; f < n ; f++) {
+        int k = 0;
+        for (int r = 1 ; r < n ; r++) {
+            for (int c = 0 ; c < n ; c++) {
+                if (c != f) {
+                    minor[k++] = A[r * n + c];
+                }
+            }
+        }
+        D += sign * A[f] * det_cofactor(minor, n - 1);
+        sign = -sign;
+    }
+    return D;
+}
+
+// LU and Cholesky against references: residuals, inverse, determinant, several right-hand sides
+static int test_mat_decomp_accuracy(void)
+{
+    int failed = 0;
+    float err = 0;
+    for (int n = 1 ; n <= N_STATES ; n++) {
+        dspm::Mat A(n, n);
+        dspm::Mat b(n, 3);
+        fill_regular(A);
+        fill(b);
+
+        // One factorisation, solutions for each column alone and for all of them at once
+        dspm::MatLU lu(A);
+        dspm::Mat x = lu.solve(b);
+        err = fmaxf(err, max_diff(A * x, b));
+        for (int col = 0 ; col < b.cols ; col++) {
+            dspm::Mat x_col = lu.solve(b.Get(0, n, col, 1));
+            err = fmaxf(err, max_diff(x_col, x.Get(0, n, col, 1)));
+        }
+        err = fmaxf(err, max_diff(dspm::Mat::solve(A, b), x));
+        err = fmaxf(err, max_diff(A * A.inverse(), dspm::Mat::eye(n)));
+
+        // det(L * U) = prod(diag(U))
+        dspm::Mat L = dspm::Mat::eye(n);
+        dspm::Mat U(n, n);
+        fill(U);
+        float det = 1;
+        for (int i = 0 ; i < n ; i++) {
+            for (int j = 0 ; j < i ; j++) {
+                L(i, j) = U(i, j);
+                U(i, j) = 0;
+            }
+            U(i, i) += (U(i, i) > 0) ? 1 : -1;
+            det *= U(i, i);
+        }
+        dspm::Mat LU = L * U;
+        err = fmaxf(err, fabsf(LU.det(n) - det) / fabsf(det));
+
+        dspm::Mat S(n, n);
+        fill_spd(S);
+        dspm::MatCholesky chol(S);
+        dspm::MatLU S_lu(S);
+        if (!chol.valid) {
+            printf("Error: Cholesky decomposition of a %ix%i positive definite matrix\n", n, n);
+            failed++;
+            continue;
+        }
+        err = fmaxf(err, max_diff(chol.L * chol.L.t(), S));
+        err = fmaxf(err, max_diff(chol.solve(b), S_lu.solve(b)));
+        err = fmaxf(err, max_diff(S * chol.inverse(), dspm::Mat::eye(n)));
+        err = fmaxf(err, fabsf(chol.det() - S_lu.det()) / fabsf(S_lu.det()));
+    }
+
+    // Reference of the esp-dsp inverse test, exact integers
+    float data[] = {2, 5, 7, 6, 3, 4, 5, -2, -3};
+    float expected[] = {1, -1, 1, -38, 41, -34, 27, -29, 24};
+    dspm::Mat M(data, 3, 3);
+    err = fmaxf(err, max_diff(M.inverse(), dspm::Mat(expected, 3, 3)) / 41);
+    err = fmaxf(err, fabsf(M.det(3) - det_cofactor(data, 3)));
+
+    // Powers: squaring against repeated products, negative powers
+    dspm::Mat P(5, 5);
+    fill_regular(P);
+    P /= 5;
+    dspm::Mat P7 = dspm::Mat::eye(5);
+    for (int i = 0 ; i < 7 ; i++) {
+        P7 = P7 * P;
+    }
+    err = fmaxf(err, max_diff(P ^ 7, P7));
+    err = fmaxf(err, max_diff(P ^ 0, dspm::Mat::eye(5)));
+    err = fmaxf(err, max_diff((P ^ -2) * (P ^ 2), dspm::Mat::eye(5)));
+    if (err > 1e-4f) {
+        printf("Error: matrix decompositions differ from the references by %e\n", err);
+        failed++;
+    }
+
+    // Well conditioned matrices of small elements (covariances of small quantities) are not
+    // singular: same solutions as the unscaled ones, scaled back
+    float small_err = 0;
+    for (int n = 4 ; n <= N_STATES ; n++) {
+        dspm::Mat A(n, n);
+        dspm::Mat S(n, n);
+        dspm::Mat b(n, 1);
+        fill_regular(A);
+        fill_spd(S);
+        fill(b);
+        dspm::Mat A_small = A * 1e-12f;
+        dspm::Mat S_small = S * 1e-12f;
+        dspm::MatCholesky chol(S_small);
+        dspm::Mat x = dspm::Mat::solve(A_small, b);
+        if ((x.rows != n) || !chol.valid) {
+            printf("Error: %ix%i matrix of small elements taken as singular\n", n, n);
+            failed++;
+            continue;
+        }
+        small_err = fmaxf(small_err, max_diff(x * 1e-12f, dspm::Mat::solve(A, b)));
+        small_err = fmaxf(small_err, max_diff(A_small * A_small.inverse(), dspm::Mat::eye(n)));
+        small_err = fmaxf(small_err, max_diff(S_small * chol.inverse(), dspm::Mat::eye(n)));
+    }
+    if (small_err > 1e-4f) {
+        printf("Error: decompositions of small matrices differ from the references by %e\n", small_err);
+        failed++;
+    }
+
+    // Singular and not positive definite matrices
+    dspm::Mat singular = dspm::Mat::ones(4);
+    dspm::Mat b = dspm::Mat::ones(4, 1);
+    dspm::Mat indefinite = dspm::Mat::eye(4);
+    indefinite(2, 2) = -1;
+    dspm::MatCholesky not_spd(indefinite);
+    if ((singular.det(4) != 0) || (dspm::Mat::solve(singular, b).rows != 0) || not_spd.valid) {
+        printf("Error: singular matrix decompositions\n");
+        failed++;
+    }
+    return failed;
+}
+
+// Cycles of the determinant (cofactor expansion and LU), inverse and solve
+static int test_mat_decomp_speed(void)
+{
+    printf("  N | det cofactor | Mat::det | Mat::inverse | MatCholesky inverse | MatLU solve 3 rhs\n");
+    for (int n = 3 ; n <= N_STATES ; n += 2) {
+        dspm::Mat A(n, n);
+        dspm::Mat b(n, 3);
+        dspm::Mat x(n, 3);
+        fill_spd(A);
+        fill(b);
+
+        uint32_t cycles_cofactor = 0;
+        if (n <= 9) {
+            uint32_t cycles = dsp_get_cpu_cycle_count();
+            volatile float det = det_cofactor(A.data, n);
+            (void)det;
+            cycles_cofactor = dsp_get_cpu_cycle_count() - cycles;
+        }
+        uint32_t cycles = dsp_get_cpu_cycle_count();
+        volatile float det = A.det(n);
+        (void)det;
+        uint32_t cycles_det = dsp_get_cpu_cycle_count() - cycles;
+        cycles = dsp_get_cpu_cycle_count();
+        dspm::Mat inv = A.inverse();
+        uint32_t cycles_inv = dsp_get_cpu_cycle_count() - cycles;
+        cycles = dsp_get_cpu_cycle_count();
+        dspm::MatCholesky chol(A);
+        dspm::Mat inv_chol = chol.inverse();
+        uint32_t cycles_chol = dsp_get_cpu_cycle_count() - cycles;
+        dspm::MatLU lu(A);
+        cycles = dsp_get_cpu_cycle_count();
+        lu.solve(b, x);
+        uint32_t cycles_solve = dsp_get_cpu_cycle_count() - cycles;
+        if (n <= 9) {
+            printf(" %2i | %12u | %8u | %12u | %19u | %u\n", n, (unsigned)cycles_cofactor, (unsigned)cycles_det,
+                   (unsigned)cycles_inv, (unsigned)cycles_chol, (unsigned)cycles_solve);
+        } else {
+            printf(" %2i | %12s | %8u | %12u | %19u | %u\n", n, "-", (unsigned)cycles_det,
+                   (unsigned)cycles_inv, (unsigned)cycles_chol, (unsigned)cycles_solve);
+        }
+    }
+    return 0;
+}
+
+extern "C" int test_mat(void)
+{
+    int failed = 0;
+    failed += test_mat_fixed_operators();
+    failed += test_mat_fixed_covariance();
+    failed += test_mat_expr_operators();
+    failed += test_mat_expr_covariance();
+    failed += test_mat_decomp_accuracy();
+    failed += test_mat_decomp_speed();
+    if (failed == 0) {
+        printf("Mat test Pass!\n");
+    }
+    return failed;
+}
@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "dsp_common.h"
+#include "dsps_fir.h"
+#include "iir_filter.h"
+#include "multichannel_filter.h"
+
+#define N_CHANNELS      4
+#define N_FRAMES        256
+#define N_BLOCKS        3
+#define N_TAPS          31
+#define SAMPLE_FREC     1000.0f
+
+static float frames[N_FRAMES * N_CHANNELS];
+static float channel[N_CHANNELS][N_FRAMES];
+
+static void generate_frames(int block)
+{
+    for (int i = 0 ; i < N_FRAMES ; i++) {
+        int n = block * N_FRAMES + i;
+        for (int ch = 0 ; ch < N_CHANNELS ; ch++) {
+            frames[i * N_CHANNELS + ch] = sinf(2 * M_PI * (10 + 5 * ch) / SAMPLE_FREC * n)
+                                          + 0.3f * sinf(2 * M_PI * 200 / SAMPLE_FREC * n) + 0.1f * ch;
+        }
+    }
+}
+
+static float compare_frames(void)
+{
+    float error = 0;
+    for (int i = 0 ; i < N_FRAMES ; i++) {
+        for (int ch = 0 ; ch < N_CHANNELS ; ch++) {
+            error = fmaxf(error, fabsf(frames[i * N_CHANNELS + ch] - channel[ch][i]));
+        }
+    }
+    return error;
+}
+
+static void deinterleave(void)
+{
+    for (int i = 0 ; i < N_FRAMES ; i++) {
+        for (int ch = 0 ; ch < N_CHANNELS ; ch++) {
+            channel[ch][i] = frames[i * N_CHANNELS + ch];
+        }
+    }
+}
+
+// Shared and per channel IIR coefficients against one iir_filter_t per de-interleaved channel
+static int test_multichannel_iir(bool shared)
+{
+    iir_filter_t design[N_CHANNELS];
+    mc_filter_t filter;
+    MCFilterCreateIIR(&filter, N_CHANNELS, ORDER_8 / 2, shared);
+    for (int ch = 0 ; ch < N_CHANNELS ; ch++) {
+        IIRFilterCreate(&design[ch], ORDER_8 / 2);
+        IIRFilterAddButterworth(&design[ch], FILTER_LOW_PASS, SAMPLE_FREC, shared ? 50 : 40 + 10 * ch, ORDER_8);
+        MCFilterSetCoefficients(&filter, ch, design[ch].coeffs);
+    }
+
+    float error = 0;
+    uint32_t cycles_single = 0;
+    uint32_t cycles_multi = 0;
+    for (int b = 0 ; b < N_BLOCKS ; b++) {
+        generate_frames(b);
+        // Previous usage: de-interleave, filter each channel, interleave back
+        uint32_t start = dsp_get_cpu_cycle_count();
+        deinterleave();
+        for (int ch = 0 ; ch < N_CHANNELS ; ch++) {
+            IIRFilterApply(&design[ch], channel[ch], channel[ch], N_FRAMES);
+        }
+        for (int i = 0 ; i < N_FRAMES ; i++) {
+            for (int ch = 0 ; ch < N_CHANNELS ; ch++) {
+                frames[i * N_CHANNELS + ch] = channel[ch][i];
+            }
+        }
+        uint32_t end = dsp_get_cpu_cycle_count();
+        cycles_single += end - start;
+        generate_frames(b);
+        start = dsp_get_cpu_cycle_count();
+        MCFilterApply(&filter, frames, N_FRAMES);
+        end = dsp_get_cpu_cycle_count();
+        cycles_multi += end - start;
+        error = fmaxf(error, compare_frames());
+    }
+    printf("IIR %i channels, %s coefficients | max error %e | per channel: %u cycles | interleaved: %u cycles\n",
+           N_CHANNELS, shared ? "shared" : "per channel", error, (unsigned)cycles_single, (unsigned)cycles_multi);
+    for (int ch = 0 ; ch < N_CHANNELS ; ch++) {
+        IIRFilterDestroy(&design[ch]);
+    }
+    MCFilterDestroy(&filter);
+    if (error > 1e-5f) {
+        printf("Error: multichannel IIR differs from single channel filters\n");
+        return 1;
+    }
+    return 0;
+}
+
+// Shared FIR coefficients against dsps_fir_f32 per channel, over several blocks
+static int test_multichannel_fir(void)
+{
+    static float coeffs[N_TAPS];
+    static float delay[N_CHANNELS][N_TAPS + 4];
+    fir_f32_t fir[N_CHANNELS];
+    mc_filter_t filter;
+    for (int n = 0 ; n < N_TAPS ; n++) {
+        // Windowed sinc low pass, cut-off frequency 0.1
+        float t = n - (N_TAPS - 1) / 2.0f;
+        float sinc = (t == 0) ? 0.2f : sinf(2 * M_PI * 0.1f * t) / (M_PI * t);
+        coeffs[n] = sinc * (0.5f - 0.5f * cosf(2 * M_PI * n / (N_TAPS - 1)));
+    }
+    MCFilterCreateFIR(&filter, N_CHANNELS, N_TAPS, true);
+    MCFilterSetCoefficients(&filter, 0, coeffs);
+    for (int ch = 0 ; ch < N_CHANNELS ; ch++) {
+        dsps_fir_init_f32(&fir[ch], coeffs, delay[ch], N_TAPS);
+    }
+
+    float error = 0;
+    for (int b = 0 ; b < N_BLOCKS ; b++) {
+        generate_frames(b);
+        deinterleave();
+        for (int ch = 0 ; ch < N_CHANNELS ; ch++) {
+            dsps_fir_f32(&fir[ch], channel[ch], channel[ch], N_FRAMES);
+        }
+        MCFilterApply(&filter, frames, N_FRAMES);
+        error = fmaxf(error, compare_frames());
+    }
+    printf("FIR %i channels, %i taps | max error %e\n", N_CHANNELS, N_TAPS, error);
+    MCFilterDestroy(&filter);
+    if (error > 1e-5f) {
+        printf("Error: multichannel FIR differs from dsps_fir_f32\n");
+        return 1;
+    }
+    return 0;
+}
+
+int test_multichannel(void)
+{
+    int failed = 0;
+    failed += test_multichannel_iir(true);
+    failed += test_multichannel_iir(false);
+    failed += test_multichannel_fir();
+    if (failed == 0) {
+        printf("Multichannel filter test Pass!\n");
+    }
+    return failed;
+}
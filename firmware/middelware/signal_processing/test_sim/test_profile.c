@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "dsp_profile.h"
+#include "fft.h"
+#include "iir_filter.h"
+
+// Only built with the instrumentation, see CFLAGS in the Makefile
+#if DSP_PROFILE_ENABLE
+#define SIGNAL_LENGHT   256
+#define N_CALLS         3
+
+static float signal[SIGNAL_LENGHT];
+static float fft[SIGNAL_LENGHT / 2];
+static float filtered[SIGNAL_LENGHT];
+static int dump_lines;
+static int dump_fft_lines;
+
+static void dump_print(const char *line)
+{
+    dump_lines++;
+    if (strncmp(line, "FFTPlanSpectrum ", 16) == 0) {
+        dump_fft_lines++;
+    }
+}
+
+static int check_stats(dsp_profile_id_t id, uint32_t calls, uint64_t bytes)
+{
+    dsp_profile_stats_t stats;
+    if (!DSPProfileGet(id, &stats) || (stats.calls != calls) || (stats.bytes != bytes) ||
+            (stats.min_cycles > stats.max_cycles) || (stats.total_cycles < (uint64_t)stats.min_cycles * calls) ||
+            (stats.total_cycles > (uint64_t)stats.max_cycles * calls)) {
+        printf("Error: %s counters: %u calls, %llu bytes (expected %u calls, %llu bytes)\n", DSPProfileName(id),
+               (unsigned)stats.calls, (unsigned long long)stats.bytes, (unsigned)calls, (unsigned long long)bytes);
+        return 1;
+    }
+    return 0;
+}
+#endif
+
+int test_profile(void)
+{
+    int failed = 0;
+#if DSP_PROFILE_ENABLE
+    iir_filter_t filter;
+    for (int i = 0 ; i < SIGNAL_LENGHT ; i++) {
+        signal[i] = sinf(2 * M_PI * 10 * i / SIGNAL_LENGHT);
+    }
+    // First FFT call of a length generates its window, so it's left out
+    FFTMagnitude(signal, fft, SIGNAL_LENGHT);
+    IIRFilterCreate(&filter, 2);
+    DSPProfileClear();
+    for (int n = 0 ; n < N_CALLS ; n++) {
+        FFTMagnitude(signal, fft, SIGNAL_LENGHT);
+    }
+    IIRFilterAddButterworth(&filter, FILTER_LOW_PASS, 1000, 100, 4);
+    IIRFilterApply(&filter, signal, filtered, SIGNAL_LENGHT);
+    IIRFilterDestroy(&filter);
+
+    // Real input plan: N/2 complex points through the esp-dsp FFT and the split step
+    size_t signal_bytes = SIGNAL_LENGHT * sizeof(float);
+    failed += check_stats(DSP_PROFILE_FFT_PLAN_SPECTRUM, N_CALLS, N_CALLS * signal_bytes);
+    failed += check_stats(DSP_PROFILE_DSPS_FFT2R_FC32, N_CALLS, N_CALLS * signal_bytes);
+    failed += check_stats(DSP_PROFILE_DSPS_BIT_REV_FC32, N_CALLS, N_CALLS * signal_bytes);
+    failed += check_stats(DSP_PROFILE_FFT_REAL_SPLIT, N_CALLS, N_CALLS * signal_bytes);
+    failed += check_stats(DSP_PROFILE_DSPS_CPLX2REC_FC32, 0, 0);
+    failed += check_stats(DSP_PROFILE_FFT_WINDOW_GENERATE, 0, 0);
+    failed += check_stats(DSP_PROFILE_IIR_FILTER_DESIGN, 2, 2 * 5 * sizeof(float));
+    failed += check_stats(DSP_PROFILE_DSPS_BIQUAD_GEN_F32, 2, 2 * 5 * sizeof(float));
+    failed += check_stats(DSP_PROFILE_IIR_FILTER_APPLY, 1, signal_bytes);
+    failed += check_stats(DSP_PROFILE_DSPS_BIQUAD_CASCADE_F32, 1, signal_bytes);
+
+    // Nested calls are included in the totals of their callers
+    dsp_profile_stats_t outer;
+    dsp_profile_stats_t inner;
+    DSPProfileGet(DSP_PROFILE_FFT_PLAN_SPECTRUM, &outer);
+    DSPProfileGet(DSP_PROFILE_DSPS_FFT2R_FC32, &inner);
+    if (outer.total_cycles < inner.total_cycles) {
+        printf("Error: FFTPlanSpectrum() total below dsps_fft2r_fc32() total\n");
+        failed++;
+    }
+
+    // Header plus one line per function called
+    dump_lines = 0;
+    dump_fft_lines = 0;
+    DSPProfileDump(dump_print);
+    if ((dump_lines != 9) || (dump_fft_lines != 1)) {
+        printf("Error: DSPProfileDump() printed %i lines\n", dump_lines);
+        failed++;
+    }
+    DSPProfileClear();
+    dump_lines = 0;
+    DSPProfileDump(dump_print);
+    if (dump_lines != 1) {
+        printf("Error: DSPProfileClear() left %i functions\n", dump_lines - 1);
+        failed++;
+    }
+#endif
+    if (failed == 0) {
+        printf("DSP profile test Pass!\n");
+    }
+    return failed;
+}
@@ -0,0 +1,277 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "dsp_common.h"
+#include "dsps_dotprod.h"
+#include "dsps_fir.h"
+#include "dsps_biquad.h"
+#include "dsps_biquad_gen.h"
+#include "dsps_fft2r.h"
+#include "dsps_add.h"
+#include "dsps_mul.h"
+#include "dspm_mult.h"
+
+// The _rv32 kernels are plain C: on the host (or under qemu-riscv32) they must give the
+// same results as the _ansi ones, bit exact for the fixed point kernels
+#define MAX_LEN         1024
+#define N_TAPS          37
+#define MAX_DIM         9
+
+static int16_t xs[MAX_LEN + 2];
+static int16_t ys[MAX_LEN + 2];
+static int16_t out_ansi[MAX_LEN + 2];
+static int16_t out_rv32[MAX_LEN + 2];
+static float xf[MAX_LEN];
+static float yf[MAX_LEN];
+static float outf_ansi[MAX_LEN];
+static float outf_rv32[MAX_LEN];
+
+static void generate_s16(int16_t *x, int len, bool full_scale)
+{
+    for (int i = 0 ; i < len ; i++) {
+        x[i] = full_scale ? -32768 : (int16_t)(rand() % 65536 - 32768);
+    }
+}
+
+static void generate_f32(float *x, int len)
+{
+    for (int i = 0 ; i < len ; i++) {
+        x[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+}
+
+// Every length and relative alignment, full scale operands included (pairs of products of 2^31)
+static int test_rv32_dotprod(void)
+{
+    int failed = 0;
+    for (int full = 0 ; full < 2 ; full++) {
+        generate_s16(xs, MAX_LEN + 2, full);
+        generate_s16(ys, MAX_LEN + 2, full);
+        for (int len = 0 ; len < 40 ; len++) {
+            for (int a = 0 ; a < 2 ; a++) {
+                for (int b = 0 ; b < 2 ; b++) {
+                    for (int shift = 0 ; shift < 16 ; shift += 5) {
+                        dsps_dotprod_s16_ansi(&xs[a], &ys[b], &out_ansi[0], len, shift);
+                        dsps_dotprod_s16_rv32(&xs[a], &ys[b], &out_rv32[0], len, shift);
+                        if (out_ansi[0] != out_rv32[0]) {
+                            failed++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    generate_f32(xf, MAX_LEN);
+    generate_f32(yf, MAX_LEN);
+    for (int len = 0 ; len < 40 ; len++) {
+        dsps_dotprod_f32_ansi(xf, yf, &outf_ansi[0], len);
+        dsps_dotprod_f32_rv32(xf, yf, &outf_rv32[0], len);
+        if (outf_ansi[0] != outf_rv32[0]) {
+            failed++;
+        }
+    }
+    if (failed) {
+        printf("Error: dsps_dotprod_x_rv32() differs from dsps_dotprod_x_ansi() in %i cases\n", failed);
+    }
+    return failed;
+}
+
+// Decimating and plain (decim = 1) filters, block by block so the delay line wraps at every position
+static int test_rv32_fird(void)
+{
+    int failed = 0;
+    int16_t coeffs[N_TAPS];
+    int16_t delay_ansi[N_TAPS];
+    int16_t delay_rv32[N_TAPS];
+    for (int full = 0 ; full < 2 ; full++) {
+        generate_s16(coeffs, N_TAPS, full);
+        generate_s16(xs, MAX_LEN, full);
+        for (int decim = 1 ; decim <= 4 ; decim += 3) {
+            for (int shift = -2 ; shift <= 2 ; shift += 2) {
+                fir_s16_t fir_ansi;
+                fir_s16_t fir_rv32;
+                memset(delay_ansi, 0, sizeof(delay_ansi));
+                memset(delay_rv32, 0, sizeof(delay_rv32));
+                dsps_fird_init_s16(&fir_ansi, coeffs, delay_ansi, N_TAPS, decim, 0, shift);
+                dsps_fird_init_s16(&fir_rv32, coeffs, delay_rv32, N_TAPS, decim, 0, shift);
+                int n = 0;
+                for (int block = 1 ; n + block * decim <= MAX_LEN ; block++) {
+                    int r_ansi = dsps_fird_s16_ansi(&fir_ansi, &xs[n], out_ansi, block);
+                    int r_rv32 = dsps_fird_s16_rv32(&fir_rv32, &xs[n], out_rv32, block);
+                    if ((r_ansi != r_rv32) || memcmp(out_ansi, out_rv32, r_ansi * sizeof(int16_t)) ||
+                            (fir_ansi.pos != fir_rv32.pos)) {
+                        failed++;
+                    }
+                    n += block * decim;
+                }
+            }
+        }
+    }
+    if (failed) {
+        printf("Error: dsps_fird_s16_rv32() differs from dsps_fird_s16_ansi() in %i blocks\n", failed);
+    }
+    return failed;
+}
+
+static int test_rv32_biquad(void)
+{
+    float coef[5];
+    float w_ansi[2] = {0, 0};
+    float w_rv32[2] = {0, 0};
+    dsps_biquad_gen_lpf_f32(coef, 0.1f, 0.7071f);
+    generate_f32(xf, MAX_LEN);
+    int n = 0;
+    int failed = 0;
+    for (int block = 1 ; n + block <= MAX_LEN ; block++) {
+        dsps_biquad_f32_ansi(&xf[n], &outf_ansi[n], block, coef, w_ansi);
+        dsps_biquad_f32_rv32(&xf[n], &outf_rv32[n], block, coef, w_rv32);
+        n += block;
+    }
+    if (memcmp(outf_ansi, outf_rv32, n * sizeof(float)) || memcmp(w_ansi, w_rv32, sizeof(w_ansi))) {
+        printf("Error: dsps_biquad_f32_rv32() differs from dsps_biquad_f32_ansi()\n");
+        failed++;
+    }
+    return failed;
+}
+
+static int test_rv32_fft(void)
+{
+    int failed = 0;
+    dsps_fft2r_init_sc16(NULL, CONFIG_DSP_MAX_FFT_SIZE);
+    for (int N = 16 ; N <= MAX_LEN / 2 ; N *= 2) {
+        generate_s16(xs, 2 * N, false);
+        memcpy(ys, xs, 2 * N * sizeof(int16_t));
+        uint32_t start = dsp_get_cpu_cycle_count();
+        dsps_fft2r_sc16_ansi(xs, N);
+        uint32_t cycles_ansi = dsp_get_cpu_cycle_count() - start;
+        start = dsp_get_cpu_cycle_count();
+        dsps_fft2r_sc16_rv32(ys, N);
+        uint32_t cycles_rv32 = dsp_get_cpu_cycle_count() - start;
+        printf("FFT sc16 N = %4i | ansi %7u cycles | rv32 %7u cycles\n", N, (unsigned)cycles_ansi, (unsigned)cycles_rv32);
+        if (memcmp(xs, ys, 2 * N * sizeof(int16_t))) {
+            printf("Error: dsps_fft2r_sc16_rv32() differs from dsps_fft2r_sc16_ansi()\n");
+            failed++;
+        }
+    }
+    return failed;
+}
+
+// Packed path (contiguous, any common alignment), halfword path (mixed alignment) and strided path
+static int test_rv32_add_mul(void)
+{
+    int failed = 0;
+    generate_s16(xs, MAX_LEN + 2, false);
+    generate_s16(ys, MAX_LEN + 2, false);
+    for (int len = 0 ; len < 20 ; len++) {
+        for (int a = 0 ; a < 2 ; a++) {
+            for (int b = 0 ; b < 2 ; b++) {
+                for (int step = 1 ; step <= 2 ; step++) {
+                    int shift = len % 16;
+                    memset(out_ansi, 0, sizeof(out_ansi));
+                    memset(out_rv32, 0, sizeof(out_rv32));
+                    dsps_add_s16_ansi(&xs[a], &ys[b], &out_ansi[a], len, step, 1, step, 1);
+                    dsps_add_s16_rv32(&xs[a], &ys[b], &out_rv32[a], len, step, 1, step, 1);
+                    dsps_mul_s16_ansi(&xs[a], &ys[b], &out_ansi[MAX_LEN / 2], len, 1, step, 1, shift);
+                    dsps_mul_s16_rv32(&xs[a], &ys[b], &out_rv32[MAX_LEN / 2], len, 1, step, 1, shift);
+                    if (memcmp(out_ansi, out_rv32, sizeof(out_ansi))) {
+                        failed++;
+                    }
+                }
+            }
+        }
+    }
+    generate_f32(xf, MAX_LEN);
+    generate_f32(yf, MAX_LEN);
+    for (int len = 0 ; len < 20 ; len++) {
+        for (int step = 1 ; step <= 3 ; step++) {
+            memset(outf_ansi, 0, sizeof(outf_ansi));
+            memset(outf_rv32, 0, sizeof(outf_rv32));
+            dsps_add_f32_ansi(xf, yf, outf_ansi, len, step, 1, step);
+            dsps_add_f32_rv32(xf, yf, outf_rv32, len, step, 1, step);
+            dsps_mul_f32_ansi(xf, yf, &outf_ansi[MAX_LEN / 2], len, 1, step, 1);
+            dsps_mul_f32_rv32(xf, yf, &outf_rv32[MAX_LEN / 2], len, 1, step, 1);
+            if (memcmp(outf_ansi, outf_rv32, sizeof(outf_ansi))) {
+                failed++;
+            }
+        }
+    }
+    if (failed) {
+        printf("Error: dsps_add/mul_x_rv32() differ from the _ansi kernels in %i cases\n", failed);
+    }
+    return failed;
+}
+
+// Every shape up to 9x9x9, so each 4x4 block count and edge width is covered: the register
+// blocked kernels (and the 3x3/4x4 ones they dispatch to) against the _ansi ones, the
+// transposed B product against dspm_mult_f32_ansi() on the transposed matrix
+static int test_rv32_mult(void)
+{
+    int failed = 0;
+    float bt[MAX_DIM * MAX_DIM];
+    generate_f32(xf, MAX_DIM * MAX_DIM);
+    generate_f32(yf, MAX_DIM * MAX_DIM);
+    for (int m = 1 ; m <= MAX_DIM ; m++) {
+        for (int n = 1 ; n <= MAX_DIM ; n++) {
+            for (int k = 1 ; k <= MAX_DIM ; k++) {
+                memset(outf_ansi, 0, sizeof(outf_ansi));
+                memset(outf_rv32, 0, sizeof(outf_rv32));
+                dspm_mult_f32_ansi(xf, yf, outf_ansi, m, n, k);
+                dspm_mult_f32_rv32(xf, yf, outf_rv32, m, n, k);
+                if (memcmp(outf_ansi, outf_rv32, sizeof(outf_ansi))) {
+                    failed++;
+                }
+                for (int s = 0 ; s < n ; s++) {
+                    for (int j = 0 ; j < k ; j++) {
+                        bt[j * n + s] = yf[s * k + j];
+                    }
+                }
+                dspm_mult_bt_f32_ansi(xf, bt, &outf_ansi[MAX_LEN / 2], m, n, k);
+                dspm_mult_bt_f32_rv32(xf, bt, &outf_rv32[MAX_LEN / 2], m, n, k);
+                if (memcmp(outf_ansi, outf_rv32, sizeof(outf_ansi)) ||
+                        memcmp(outf_ansi, &outf_ansi[MAX_LEN / 2], m * k * sizeof(float))) {
+                    failed++;
+                }
+            }
+        }
+    }
+    for (int full = 0 ; full < 2 ; full++) {
+        generate_s16(xs, MAX_DIM * MAX_DIM, full);
+        generate_s16(ys, MAX_DIM * MAX_DIM, full);
+        for (int m = 1 ; m <= MAX_DIM ; m++) {
+            for (int n = 1 ; n <= MAX_DIM ; n++) {
+                for (int k = 1 ; k <= MAX_DIM ; k++) {
+                    int shift = (m + n + k) % 16;
+                    memset(out_ansi, 0, sizeof(out_ansi));
+                    memset(out_rv32, 0, sizeof(out_rv32));
+                    dspm_mult_s16_ansi(xs, ys, out_ansi, m, n, k, shift);
+                    dspm_mult_s16_rv32(xs, ys, out_rv32, m, n, k, shift);
+                    if (memcmp(out_ansi, out_rv32, sizeof(out_ansi))) {
+                        failed++;
+                    }
+                }
+            }
+        }
+    }
+    if (failed) {
+        printf("Error: dspm_mult_x_rv32() differ from the _ansi kernels in %i cases\n", failed);
+    }
+    return failed;
+}
+
+int test_rv32(void)
+{
+    int failed = 0;
+    failed += test_rv32_dotprod();
+    failed += test_rv32_fird();
+    failed += test_rv32_biquad();
+    failed += test_rv32_fft();
+    failed += test_rv32_add_mul();
+    failed += test_rv32_mult();
+    if (failed == 0) {
+        printf("RV32 kernels test Pass!\n");
+    }
+    return failed;
+}
@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "dsp_scratch.h"
+#include "fft.h"
+#include "fast_conv.h"
+
+#define REGION_SIZE     (16 * 1024)
+#define FFT_LENGHT      1024
+#define N_TAPS          100
+
+static uint8_t region[REGION_SIZE + 1];
+static float signal[FFT_LENGHT];
+static float fft[FFT_LENGHT / 2];
+
+// Bump allocator over a static region, deliberately misaligned
+static int test_scratch_alloc(void)
+{
+    int failed = 0;
+    dsp_scratch_stats_t stats;
+    if (!DSPScratchInit(&region[1], REGION_SIZE)) {
+        printf("Error: static region not accepted\n");
+        return 1;
+    }
+    DSPScratchClearStats();
+    size_t mark = DSPScratchMark();
+    uint8_t *a = DSPScratchAlloc(10);
+    uint8_t *b = DSPScratchAlloc(100);
+    if ((a == NULL) || (b == NULL) || ((uintptr_t)a % DSP_SCRATCH_ALIGN) || ((uintptr_t)b % DSP_SCRATCH_ALIGN) || (b < a + 10)) {
+        printf("Error: scratch buffers not aligned or overlapped\n");
+        failed++;
+    }
+    // Nested mark: the inner buffer goes back to the same address
+    size_t inner = DSPScratchMark();
+    void *c = DSPScratchAlloc(200);
+    DSPScratchRelease(inner);
+    void *d = DSPScratchAlloc(50);
+    if (c != d) {
+        printf("Error: released scratch memory not reused\n");
+        failed++;
+    }
+    // Region can't be replaced while in use
+    if (DSPScratchInit(NULL, REGION_SIZE)) {
+        printf("Error: scratch region replaced while in use\n");
+        failed++;
+    }
+    if (DSPScratchAlloc(REGION_SIZE) != NULL) {
+        printf("Error: allocation larger than the region\n");
+        failed++;
+    }
+    DSPScratchGetStats(&stats);
+    printf("Scratch region %u bytes | used %u | high water %u | failures %u\n", (unsigned)stats.size,
+           (unsigned)stats.used, (unsigned)stats.high_water, (unsigned)stats.failures);
+    if ((stats.failures != 1) || (stats.high_water < 310) || (stats.high_water > 310 + 3 * DSP_SCRATCH_ALIGN)) {
+        printf("Error: wrong scratch statistics\n");
+        failed++;
+    }
+    DSPScratchRelease(mark);
+    DSPScratchGetStats(&stats);
+    if (stats.used != 0) {
+        printf("Error: scratch memory not released\n");
+        failed++;
+    }
+    return failed;
+}
+
+// Middleware functions release what they take, the high water mark is their work buffer
+static int test_scratch_middleware(void)
+{
+    int failed = 0;
+    dsp_scratch_stats_t stats;
+    // Padding of the first buffer up to the alignment of the (misaligned) region
+    size_t offset = -(uintptr_t)&region[1] % DSP_SCRATCH_ALIGN;
+    for (int i = 0 ; i < FFT_LENGHT ; i++) {
+        signal[i] = sinf(2 * M_PI * 100 * i / FFT_LENGHT);
+    }
+    FFTInit();
+    // FFTMagnitude() keeps its own work buffer: it works with the whole region taken by
+    // someone else and doesn't touch it. Unit sine on bin 100, with the Hann window coherent gain.
+    size_t mark = DSPScratchMark();
+    void *taken = DSPScratchAlloc(REGION_SIZE - DSP_SCRATCH_ALIGN);
+    DSPScratchClearStats();
+    memset(fft, 0, sizeof(fft));
+    FFTMagnitude(signal, fft, FFT_LENGHT);
+    DSPScratchGetStats(&stats);
+    DSPScratchRelease(mark);
+    printf("FFTMagnitude() %i points, scratch region full | bin 100 = %f\n", FFT_LENGHT, fft[100]);
+    if ((taken == NULL) || (stats.high_water != stats.used) || (stats.failures != 0) || (fabsf(fft[100] - 2) > 0.05f)) {
+        printf("Error: FFTMagnitude() scratch memory usage\n");
+        failed++;
+    }
+
+    fast_conv_t conv;
+    float kernel[N_TAPS];
+    for (int m = 0 ; m < N_TAPS ; m++) {
+        kernel[m] = 1.0f / N_TAPS;
+    }
+    FastConvCreate(&conv, kernel, N_TAPS);
+    DSPScratchClearStats();
+    bool ok = FastConvProcess(&conv, signal, signal, FFT_LENGHT);
+    DSPScratchGetStats(&stats);
+    printf("FastConvProcess() %i taps | high water %u bytes\n", N_TAPS, (unsigned)stats.high_water);
+    if (!ok || (stats.used != 0) || (stats.high_water != offset + 2 * conv.fft_lenght * sizeof(float))) {
+        printf("Error: FastConvProcess() scratch memory usage\n");
+        failed++;
+    }
+    // Work buffer doesn't fit: nothing is filtered
+    DSPScratchInit(region, 256);
+    DSPScratchClearStats();
+    if (FastConvProcess(&conv, signal, signal, FFT_LENGHT)) {
+        printf("Error: FastConvProcess() without scratch memory\n");
+        failed++;
+    }
+    DSPScratchGetStats(&stats);
+    if (stats.failures != 1) {
+        printf("Error: scratch failure not counted\n");
+        failed++;
+    }
+    FastConvDestroy(&conv);
+    return failed;
+}
+
+int test_scratch(void)
+{
+    int failed = 0;
+    failed += test_scratch_alloc();
+    failed += test_scratch_middleware();
+    // Back to the default region for the rest of the tests
+    DSPScratchReset();
+    DSPScratchInit(NULL, DSP_SCRATCH_SIZE);
+    if (failed == 0) {
+        printf("Scratch memory test Pass!\n");
+    }
+    return failed;
+}
@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "dsp_common.h"
+#include "fft.h"
+#include "sliding_dft.h"
+
+#define SDFT_LENGHT     256
+#define N_BINS          4
+#define N_SAMPLES       20000
+#define BENCH_BINS      8
+
+static float signal[N_SAMPLES];
+static float fft[SDFT_LENGHT / 2];
+
+static void generate_signal(void)
+{
+    for (int i = 0 ; i < N_SAMPLES ; i++) {
+        signal[i] = 0.1f + 0.5f * sinf(2 * M_PI * 16 * i / SDFT_LENGHT) + 0.2f * cosf(2 * M_PI * 40.3f * i / SDFT_LENGHT)
+                    + 0.01f * ((float)rand() / RAND_MAX - 0.5f);
+    }
+}
+
+// Amplitude of bin k of the last SDFT_LENGHT samples ending at sample n, computed directly
+static float dft_amplitude(int n, int k)
+{
+    double re = 0, im = 0;
+    for (int m = 0 ; m < SDFT_LENGHT ; m++) {
+        double x = signal[n - SDFT_LENGHT + 1 + m];
+        re += x * cos(2 * M_PI * k * m / SDFT_LENGHT);
+        im -= x * sin(2 * M_PI * k * m / SDFT_LENGHT);
+    }
+    return sqrt(re * re + im * im) * (k == 0 ? 1 : 2) / SDFT_LENGHT;
+}
+
+// Sample by sample and block updates against the direct DFT, after a long run
+static int test_sdft_accuracy(void)
+{
+    const uint16_t bins[N_BINS] = {0, 16, 40, 100};
+    sdft_t sdft;
+    sdft_t sdft_block;
+    float magnitude[N_BINS];
+    float magnitude_block[N_BINS];
+    SDFTCreate(&sdft, SDFT_LENGHT, bins, N_BINS, 0.99999f);
+    SDFTCreate(&sdft_block, SDFT_LENGHT, bins, N_BINS, 0.99999f);
+    generate_signal();
+
+    float error = 0;
+    int n = 0;
+    while (n < N_SAMPLES) {
+        int chunk = (N_SAMPLES - n) < 333 ? (N_SAMPLES - n) : 333;
+        for (int i = 0 ; i < chunk ; i++) {
+            SDFTUpdate(&sdft, signal[n + i]);
+        }
+        SDFTProcess(&sdft_block, &signal[n], chunk);
+        n += chunk;
+        if (n >= SDFT_LENGHT) {
+            SDFTMagnitude(&sdft, magnitude);
+            SDFTMagnitude(&sdft_block, magnitude_block);
+            for (int k = 0 ; k < N_BINS ; k++) {
+                float ref = dft_amplitude(n - 1, bins[k]);
+                error = fmaxf(error, fmaxf(fabsf(magnitude[k] - ref), fabsf(magnitude_block[k] - ref)));
+            }
+        }
+    }
+    printf("Sliding DFT N = %i, %i bins | max error against DFT after %i samples %e\n", SDFT_LENGHT, N_BINS, N_SAMPLES, error);
+    SDFTDestroy(&sdft);
+    SDFTDestroy(&sdft_block);
+    if (error > 2e-3f) {
+        printf("Error: sliding DFT differs from DFT\n");
+        return 1;
+    }
+    return 0;
+}
+
+// Cost of refreshing the tracked bins on every sample against one FFT per block
+static int test_sdft_benchmark(void)
+{
+    uint16_t bins[BENCH_BINS];
+    for (int k = 0 ; k < BENCH_BINS ; k++) {
+        bins[k] = 4 + 8 * k;
+    }
+    sdft_t sdft;
+    fft_plan_t plan;
+    SDFTCreate(&sdft, SDFT_LENGHT, bins, BENCH_BINS, SDFT_DEFAULT_DAMPING);
+    FFTPlanCreateReal(&plan, SDFT_LENGHT, FFT_WINDOW_RECT);
+    uint32_t start = dsp_get_cpu_cycle_count();
+    for (int i = 0 ; i < SDFT_LENGHT ; i++) {
+        SDFTUpdate(&sdft, signal[i]);
+    }
+    uint32_t end = dsp_get_cpu_cycle_count();
+    uint32_t cycles_update = end - start;
+    start = dsp_get_cpu_cycle_count();
+    SDFTProcess(&sdft, signal, SDFT_LENGHT);
+    end = dsp_get_cpu_cycle_count();
+    uint32_t cycles_process = end - start;
+    start = dsp_get_cpu_cycle_count();
+    FFTPlanMagnitude(&plan, signal, fft);
+    end = dsp_get_cpu_cycle_count();
+    printf("%i bins | SDFTUpdate %.1f cycles/sample | SDFTProcess %.1f cycles/sample | FFT of %i points %u cycles\n",
+           BENCH_BINS, (float)cycles_update / SDFT_LENGHT, (float)cycles_process / SDFT_LENGHT, SDFT_LENGHT, (unsigned)(end - start));
+    SDFTDestroy(&sdft);
+    FFTPlanDestroy(&plan);
+    return 0;
+}
+
+int test_sdft(void)
+{
+    int failed = 0;
+    failed += test_sdft_accuracy();
+    failed += test_sdft_benchmark();
+    if (failed == 0) {
+        printf("Sliding DFT test Pass!\n");
+    }
+    return failed;
+}
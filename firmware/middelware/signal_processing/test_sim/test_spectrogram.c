@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "dsp_common.h"
+#include "spectrogram.h"
+
+#define SAMPLE_FREC     8000.0f
+#define FRAME_LENGHT    256
+#define N_SAMPLES       32768
+#define TONE_BIN        32
+#define TONE_AMPLITUDE  1.0f
+#define NOISE_RANGE     0.1f
+#define CHUNK           37
+
+static float signal[N_SAMPLES];
+static uint16_t adc[N_SAMPLES];
+static float psd[FRAME_LENGHT / 2];
+static float psd_chunked[FRAME_LENGHT / 2];
+
+static void generate_signal(void)
+{
+    // Tone centered on a bin plus uniform noise of variance NOISE_RANGE^2 / 3
+    for (int i = 0 ; i < N_SAMPLES ; i++) {
+        signal[i] = TONE_AMPLITUDE * sinf(2 * M_PI * TONE_BIN * i / FRAME_LENGHT)
+                    + NOISE_RANGE * (2.0f * rand() / RAND_MAX - 1.0f);
+        adc[i] = lroundf(2048 + 1000 * signal[i]);
+    }
+}
+
+static void count_rows(const float *row, uint16_t n_bins, void *param)
+{
+    (*(int *)param)++;
+}
+
+// Tone power is the PSD integrated around the tone bin, noise floor is the mean PSD far from it
+static void psd_levels(const float *x, float *tone, float *noise)
+{
+    float bin_width = SAMPLE_FREC / FRAME_LENGHT;
+    *tone = 0;
+    for (int k = TONE_BIN - 4 ; k <= TONE_BIN + 4 ; k++) {
+        *tone += x[k] * bin_width;
+    }
+    float sum = 0;
+    int n = 0;
+    for (int k = 4 ; k < FRAME_LENGHT / 2 ; k++) {
+        if (abs(k - TONE_BIN) > 8) {
+            sum += x[k];
+            n++;
+        }
+    }
+    *noise = sum / n;
+}
+
+static int test_spectrogram_psd(void)
+{
+    int failed = 0;
+    const spectrogram_overlap_t overlaps[] = {SPECTROGRAM_OVERLAP_50, SPECTROGRAM_OVERLAP_75};
+    const float expected_tone = TONE_AMPLITUDE * TONE_AMPLITUDE / 2;
+    const float expected_noise = 2 * (NOISE_RANGE * NOISE_RANGE / 3) / SAMPLE_FREC;
+    generate_signal();
+    printf("Overlap | rows | tone power (%.3f) | noise floor (%.3e) | cycles/sample\n", expected_tone, expected_noise);
+    for (int o = 0 ; o < 2 ; o++) {
+        spectrogram_t spec;
+        spectrogram_t spec_chunked;
+        int callbacks = 0;
+        if (!SpectrogramCreate(&spec, SAMPLE_FREC, FRAME_LENGHT, overlaps[o], FFT_WINDOW_HANN, count_rows, &callbacks)
+            || !SpectrogramCreate(&spec_chunked, SAMPLE_FREC, FRAME_LENGHT, overlaps[o], FFT_WINDOW_HANN, NULL, NULL)) {
+            printf("Error creating spectrogram\n");
+            return 1;
+        }
+        uint32_t start = dsp_get_cpu_cycle_count();
+        uint16_t rows = SpectrogramWrite(&spec, signal, N_SAMPLES);
+        uint32_t end = dsp_get_cpu_cycle_count();
+        // Same samples in blocks that are not aligned to the hop nor to the ring buffer
+        for (int n = 0 ; n < N_SAMPLES ; n += CHUNK) {
+            int chunk = (N_SAMPLES - n) < CHUNK ? (N_SAMPLES - n) : CHUNK;
+            SpectrogramWrite(&spec_chunked, &signal[n], chunk);
+        }
+        uint32_t frames = SpectrogramPSD(&spec, psd);
+        SpectrogramPSD(&spec_chunked, psd_chunked);
+
+        float tone, noise;
+        psd_levels(psd, &tone, &noise);
+        printf("   %2i%% | %4u | %17.3f | %18.3e | %.1f\n", 100 - 100 / overlaps[o], (unsigned)rows, tone, noise,
+               (float)(end - start) / N_SAMPLES);
+        int expected_rows = (N_SAMPLES - FRAME_LENGHT) / spec.hop + 1;
+        if ((rows != expected_rows) || (frames != rows) || (callbacks != rows) || (spec_chunked.n_frames != rows)) {
+            printf("Error: %u rows, %u frames, %i callbacks, expected %i\n", (unsigned)rows, (unsigned)frames, callbacks, expected_rows);
+            failed++;
+        }
+        if (memcmp(psd, psd_chunked, sizeof(psd)) || memcmp(spec.row, spec_chunked.row, sizeof(psd))) {
+            printf("Error: chunked writes give a different spectrogram\n");
+            failed++;
+        }
+        if ((fabsf(tone - expected_tone) > 0.02f * expected_tone) || (fabsf(noise - expected_noise) > 0.1f * expected_noise)) {
+            printf("Error: PSD levels out of range\n");
+            failed++;
+        }
+        SpectrogramDestroy(&spec);
+        SpectrogramDestroy(&spec_chunked);
+    }
+    return failed;
+}
+
+// ADC readings converted while they are written into the ring buffer
+static int test_spectrogram_adc(void)
+{
+    spectrogram_t spec;
+    float tone, noise;
+    SpectrogramCreate(&spec, SAMPLE_FREC, FRAME_LENGHT, SPECTROGRAM_OVERLAP_50, FFT_WINDOW_BLACKMAN_HARRIS, NULL, NULL);
+    SpectrogramWrite(&spec, signal, N_SAMPLES);
+    SpectrogramPSD(&spec, psd);
+    psd_levels(psd, &tone, &noise);
+    SpectrogramReset(&spec);
+    for (int n = 0 ; n < N_SAMPLES ; n += CHUNK) {
+        int chunk = (N_SAMPLES - n) < CHUNK ? (N_SAMPLES - n) : CHUNK;
+        SpectrogramWriteADC(&spec, &adc[n], chunk, 2048, 1e-3f);
+    }
+    float tone_adc, noise_adc;
+    SpectrogramPSD(&spec, psd);
+    psd_levels(psd, &tone_adc, &noise_adc);
+    printf("ADC input | tone power %.4f (float %.4f) | noise floor %.3e (float %.3e)\n", tone_adc, tone, noise_adc, noise);
+    SpectrogramDestroy(&spec);
+    if ((fabsf(tone_adc - tone) > 0.01f * tone) || (fabsf(noise_adc - noise) > 0.1f * noise)) {
+        printf("Error: ADC input PSD differs from float input\n");
+        return 1;
+    }
+    return 0;
+}
+
+int test_spectrogram(void)
+{
+    int failed = 0;
+    failed += test_spectrogram_psd();
+    failed += test_spectrogram_adc();
+    if (failed == 0) {
+        printf("Spectrogram test Pass!\n");
+    }
+    return failed;
+}